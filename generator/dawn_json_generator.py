@@ -667,7 +667,7 @@ class MultiGeneratorFromDawnJSON(Generator):
     def add_commandline_arguments(self, parser):
         allowed_targets = [
             'dawn_headers', 'dawncpp_headers', 'dawncpp', 'dawn_proc',
-            'mock_webgpu', 'dawn_wire', "dawn_native_utils"
+            'mock_webgpu', 'dawn_wire', "dawn_native_utils", "dawn_native_cpp"
         ]
 
         parser.add_argument('--dawn-json',
@@ -826,6 +826,10 @@ class MultiGeneratorFromDawnJSON(Generator):
                 FileRender('dawn_native/wgpu_structs.cpp',
                            'src/dawn_native/wgpu_structs_autogen.cpp',
                            frontend_params))
+            renders.append(
+                FileRender('dawn_native/NativeProcs.h',
+                           'src/dawn_native/NativeProcs_autogen.h',
+                           frontend_params))
             renders.append(
                 FileRender('dawn_native/ProcTable.cpp',
                            'src/dawn_native/ProcTable.cpp', frontend_params))
@@ -854,6 +858,14 @@ class MultiGeneratorFromDawnJSON(Generator):
                            'src/dawn_native/ObjectType_autogen.cpp',
                            frontend_params))
 
+        if 'dawn_native_cpp' in targets:
+            renders.append(
+                FileRender('webgpu_cpp.cpp',
+                           'src/dawn_native/webgpu_dawn_native_cpp.h',
+                           [RENDER_PARAMS_BASE, params_dawn, {
+                               'native_procs': True
+                           }]))
+
         if 'dawn_wire' in targets:
             additional_params = compute_wire_params(params_dawn, wire_json)
 
@@ -1,24 +1,32 @@
 #include "dawn/dawn_thread_dispatch_proc.h"
 
+#include "common/Compiler.h"
+
 #include <thread>
 
+// The per-thread procs are looked up on every call, so they are reached through a pointer that
+// uses the initial-exec TLS model where it is supported. Only the pointer uses it because the
+// static TLS space left for shared libraries that are loaded at runtime is small, while the proc
+// table itself is a few kilobytes.
 static DawnProcTable nullProcs;
-thread_local DawnProcTable perThreadProcs;
+static thread_local DawnProcTable perThreadProcsStorage;
+static thread_local const DawnProcTable* perThreadProcs DAWN_TLS_INITIAL_EXEC = &nullProcs;
 
 void dawnProcSetPerThreadProcs(const DawnProcTable* procs) {
     if (procs) {
-        perThreadProcs = *procs;
+        perThreadProcsStorage = *procs;
+        perThreadProcs = &perThreadProcsStorage;
     } else {
-        perThreadProcs = nullProcs;
+        perThreadProcs = &nullProcs;
     }
 }
 
 static WGPUProc ThreadDispatchGetProcAddress(WGPUDevice device, const char* procName) {
-    return perThreadProcs.getProcAddress(device, procName);
+    return perThreadProcs->getProcAddress(device, procName);
 }
 
 static WGPUInstance ThreadDispatchCreateInstance(WGPUInstanceDescriptor const * descriptor) {
-    return perThreadProcs.createInstance(descriptor);
+    return perThreadProcs->createInstance(descriptor);
 }
 
 {% for type in by_category["object"] %}
@@ -30,7 +38,44 @@ static WGPUInstance ThreadDispatchCreateInstance(WGPUInstanceDescriptor const *
             {%- endfor -%}
         ) {
             {% if method.return_type.name.canonical_case() != "void" %}return {% endif %}
-            perThreadProcs.{{as_varName(type.name, method.name)}}({{as_varName(type.name)}}
+            perThreadProcs->{{as_varName(type.name, method.name)}}({{as_varName(type.name)}}
+                {%- for arg in method.arguments -%}
+                    , {{as_varName(arg.name)}}
+                {%- endfor -%}
+            );
+        }
+    {% endfor %}
+{% endfor %}
+
+// The objects of dawn_native and of the dawn_wire client start with a DispatchableObject (see
+// common/DispatchableObject.h) so their DawnProcTable is right after their vtable pointer.
+template <typename T>
+static const DawnProcTable* ObjectProcs(T object) {
+    return *reinterpret_cast<const DawnProcTable* const*>(reinterpret_cast<const char*>(object) +
+                                                          sizeof(void*));
+}
+
+static WGPUProc ObjectDispatchGetProcAddress(WGPUDevice device, const char* procName) {
+    if (device == nullptr) {
+        return perThreadProcs->getProcAddress(device, procName);
+    }
+    return ObjectProcs(device)->getProcAddress(device, procName);
+}
+
+static WGPUInstance ObjectDispatchCreateInstance(WGPUInstanceDescriptor const * descriptor) {
+    return perThreadProcs->createInstance(descriptor);
+}
+
+{% for type in by_category["object"] %}
+    {% for method in c_methods(type) %}
+        static {{as_cType(method.return_type.name)}} ObjectDispatch{{as_MethodSuffix(type.name, method.name)}}(
+            {{-as_cType(type.name)}} {{as_varName(type.name)}}
+            {%- for arg in method.arguments -%}
+                , {{as_annotated_cType(arg)}}
+            {%- endfor -%}
+        ) {
+            {% if method.return_type.name.canonical_case() != "void" %}return {% endif %}
+            ObjectProcs({{as_varName(type.name)}})->{{as_varName(type.name, method.name)}}({{as_varName(type.name)}}
                 {%- for arg in method.arguments -%}
                     , {{as_varName(arg.name)}}
                 {%- endfor -%}
@@ -47,6 +92,16 @@ extern "C" {
     {% for method in c_methods(type) %}
         ThreadDispatch{{as_MethodSuffix(type.name, method.name)}},
     {% endfor %}
+{% endfor %}
+    };
+
+    DawnProcTable dawnObjectDispatchProcTable = {
+        ObjectDispatchGetProcAddress,
+        ObjectDispatchCreateInstance,
+{% for type in by_category["object"] %}
+    {% for method in c_methods(type) %}
+        ObjectDispatch{{as_MethodSuffix(type.name, method.name)}},
+    {% endfor %}
 {% endfor %}
     };
 }
@@ -705,6 +705,51 @@ namespace dawn_wire {
         {{ write_command_serialization_methods(command, True) }}
     {% endfor %}
 
+    WireResult PeekCommandObjects(const volatile char* command,
+                                  size_t size,
+                                  CommandObjects* objects) {
+        if (size < sizeof(CmdHeader) + sizeof(WireCmd)) {
+            return WireResult::FatalError;
+        }
+        DeserializeBuffer deserializeBuffer(command, size);
+
+        WireCmd cmdId = *reinterpret_cast<const volatile WireCmd*>(command + sizeof(CmdHeader));
+
+        switch (cmdId) {
+            {% for command in cmd_records["command"] %}
+                {% set Name = command.name.CamelCase() %}
+                {% set target = command.members[0] %}
+                case WireCmd::{{Name}}: {
+                    const volatile {{Name}}Transfer* transfer;
+                    WIRE_TRY(deserializeBuffer.Read(&transfer));
+
+                    //* Methods start with their object, and the other commands with the ID of the
+                    //* object they are about.
+                    {% if Name == "DestroyObject" %}
+                        objects->targetType = transfer->objectType;
+                        objects->targetId = transfer->objectId;
+                    {% elif target.type.category == "object" %}
+                        objects->targetType = ObjectType::{{target.type.name.CamelCase()}};
+                        objects->targetId = transfer->{{as_varName(target.name)}};
+                    {% else %}
+                        {% for type in by_category["object"] if type.name.get() + " id" == target.name.get() %}
+                            objects->targetType = ObjectType::{{type.name.CamelCase()}};
+                            objects->targetId = transfer->{{as_varName(target.name)}};
+                        {% endfor %}
+                    {% endif %}
+
+                    {% for member in command.members if member.handle_type and member.annotation == "value" %}
+                        objects->resultType = ObjectType::{{member.handle_type.name.CamelCase()}};
+                        objects->resultId = transfer->{{as_varName(member.name)}}.id;
+                    {% endfor %}
+                    return WireResult::Success;
+                }
+            {% endfor %}
+            default:
+                return WireResult::FatalError;
+        }
+    }
+
     // Implementation of ObjectIdResolver that always errors.
     // Used when the generator adds a provider argument because of a chained
     // struct, but in practice, a chained struct in that location is invalid.
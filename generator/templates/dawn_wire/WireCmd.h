@@ -89,6 +89,23 @@ namespace dawn_wire {
         uint64_t commandSize;
     };
 
+    // The objects a command is about, as found by PeekCommandObjects.
+    struct CommandObjects {
+        // The object the command is called on, or the destroyed object for DestroyObject.
+        ObjectType targetType;
+        ObjectId targetId = 0;
+
+        // The object created by the command. |resultId| is 0 if it doesn't create one.
+        ObjectType resultType;
+        ObjectId resultId = 0;
+    };
+
+    // Reads the objects |command| is about without deserializing the rest of it. |size| is the
+    // size of the whole command.
+    WireResult PeekCommandObjects(const volatile char* command,
+                                  size_t size,
+                                  CommandObjects* objects);
+
 {% macro write_command_struct(command, is_return_command) %}
     {% set Return = "Return" if is_return_command else "" %}
     {% set Cmd = command.name.CamelCase() + "Cmd" %}
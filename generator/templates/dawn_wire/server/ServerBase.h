@@ -49,6 +49,26 @@ namespace dawn_wire { namespace server {
             }
         }
 
+        //* Used when the commands of different devices are handled on different threads.
+        void SetObjectsThreadSafe(bool threadSafe) {
+            {% for type in by_category["object"] %}
+                mKnown{{type.name.CamelCase()}}.SetThreadSafe(threadSafe);
+            {% endfor %}
+        }
+
+        //* Used to make room for the objects in the order they are created in the commands, when
+        //* they can be allocated out of order by the threads handling the commands.
+        bool ExtendObjects(ObjectType type, ObjectId id) {
+            switch (type) {
+                {% for type in by_category["object"] %}
+                    case ObjectType::{{type.name.CamelCase()}}:
+                        return mKnown{{type.name.CamelCase()}}.Extend(id);
+                {% endfor %}
+                default:
+                    return false;
+            }
+        }
+
         {% for type in by_category["object"] %}
             const KnownObjects<{{as_cType(type.name)}}>& {{type.name.CamelCase()}}Objects() const {
                 return mKnown{{type.name.CamelCase()}};
@@ -23,9 +23,10 @@ namespace dawn_wire { namespace server {
 
         {% set Suffix = command.name.CamelCase() %}
         //* The generic command handlers
-        bool Server::Handle{{Suffix}}(DeserializeBuffer* deserializeBuffer) {
+        bool Server::Handle{{Suffix}}(DeserializeBuffer* deserializeBuffer,
+                                      DeserializeAllocator* allocator) {
             {{Suffix}}Cmd cmd;
-            WireResult deserializeResult = cmd.Deserialize(deserializeBuffer, &mAllocator
+            WireResult deserializeResult = cmd.Deserialize(deserializeBuffer, allocator
                 {%- if command.may_have_dawn_object -%}
                     , *this
                 {%- endif -%}
@@ -106,7 +107,30 @@ namespace dawn_wire { namespace server {
         }
     {% endfor %}
 
+    bool Server::HandleCommand(DeserializeBuffer* deserializeBuffer,
+                               WireDeserializeAllocator* allocator) {
+        WireCmd cmdId = *static_cast<const volatile WireCmd*>(static_cast<const volatile void*>(
+            deserializeBuffer->Buffer() + sizeof(CmdHeader)));
+        bool success = false;
+        switch (cmdId) {
+            {% for command in cmd_records["command"] %}
+                case WireCmd::{{command.name.CamelCase()}}:
+                    success = Handle{{command.name.CamelCase()}}(deserializeBuffer, allocator);
+                    break;
+            {% endfor %}
+            default:
+                success = false;
+        }
+
+        allocator->Reset();
+        return success;
+    }
+
     const volatile char* Server::HandleCommandsImpl(const volatile char* commands, size_t size) {
+        if (mPartitionCommandsByDevice) {
+            return HandlePartitionedCommands(commands, size);
+        }
+
         DeserializeBuffer deserializeBuffer(commands, size);
 
         while (deserializeBuffer.AvailableSize() >= sizeof(CmdHeader) + sizeof(WireCmd)) {
@@ -121,23 +145,9 @@ namespace dawn_wire { namespace server {
                     break;
             }
 
-            WireCmd cmdId = *static_cast<const volatile WireCmd*>(static_cast<const volatile void*>(
-                deserializeBuffer.Buffer() + sizeof(CmdHeader)));
-            bool success = false;
-            switch (cmdId) {
-                {% for command in cmd_records["command"] %}
-                    case WireCmd::{{command.name.CamelCase()}}:
-                        success = Handle{{command.name.CamelCase()}}(&deserializeBuffer);
-                        break;
-                {% endfor %}
-                default:
-                    success = false;
-            }
-
-            if (!success) {
+            if (!HandleCommand(&deserializeBuffer, &mAllocator)) {
                 return nullptr;
             }
-            mAllocator.Reset();
         }
 
         if (deserializeBuffer.AvailableSize() != 0) {
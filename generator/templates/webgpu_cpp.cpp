@@ -11,17 +11,43 @@
 //* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 //* See the License for the specific language governing permissions and
 //* limitations under the License.
+
+//* When rendered for dawn_native, the bindings are a header where all the definitions are inline
+//* so that they compile to direct calls to the API* methods of the frontend.
+{% set inline = "inline " if native_procs else "" %}
+{% if native_procs %}
+    #ifndef DAWNNATIVE_WEBGPU_DAWN_NATIVE_CPP_H_
+    #define DAWNNATIVE_WEBGPU_DAWN_NATIVE_CPP_H_
+
+    // The C++ bindings for an application that links dawn_native statically. It must be
+    // included instead of dawn/webgpu_cpp.h in every file that uses them, and replaces dawncpp.
+{% endif %}
 {% if 'dawn' in enabled_tags %}
     #include "dawn/webgpu_cpp.h"
 {% else %}
     #include "webgpu/webgpu_cpp.h"
 {% endif %}
+{% if native_procs %}
+    #include "dawn_native/NativeProcs_autogen.h"
+{% endif %}
 
 #ifdef __GNUC__
+{% if native_procs %}
+    #pragma GCC diagnostic push
+{% endif %}
 // error: 'offsetof' within non-standard-layout type 'wgpu::XXX' is conditionally-supported
 #pragma GCC diagnostic ignored "-Winvalid-offsetof"
 #endif
 
+//* When rendered for dawn_native, the bindings call the inline implementation of the procs of
+//* dawn_native instead of the procs set in dawn_proc.
+{% macro as_cppCallee(type_name, method_name) -%}
+    {%- if native_procs -%}
+        dawn_native::Native{{as_MethodSuffix(type_name, method_name)}}
+    {%- else -%}
+        {{as_cMethod(type_name, method_name)}}
+    {%- endif -%}
+{%- endmacro %}
 namespace wgpu {
     {% for type in by_category["enum"] %}
         {% set CppType = as_cppType(type.name) %}
@@ -105,7 +131,7 @@ namespace wgpu {
         {%- endmacro -%}
 
         {%- macro render_cpp_to_c_method_call(type, method) -%}
-            {{as_cMethod(type.name, method.name)}}(Get()
+            {{as_cppCallee(type.name, method.name)}}(Get()
                 {%- for arg in method.arguments -%},{{" "}}
                     {%- if arg.annotation == "value" -%}
                         {%- if arg.type.category == "object" -%}
@@ -125,7 +151,7 @@ namespace wgpu {
         {%- endmacro -%}
 
         {% for method in type.methods -%}
-            {{render_cpp_method_declaration(type, method)}} {
+            {{inline}}{{render_cpp_method_declaration(type, method)}} {
                 {% if method.return_type.name.concatcase() == "void" %}
                     {{render_cpp_to_c_method_call(type, method)}};
                 {% else %}
@@ -134,28 +160,44 @@ namespace wgpu {
                 {% endif %}
             }
         {% endfor %}
-        void {{CppType}}::WGPUReference({{CType}} handle) {
+        {{inline}}void {{CppType}}::WGPUReference({{CType}} handle) {
             if (handle != nullptr) {
-                {{as_cMethod(type.name, Name("reference"))}}(handle);
+                {{as_cppCallee(type.name, Name("reference"))}}(handle);
             }
         }
-        void {{CppType}}::WGPURelease({{CType}} handle) {
+        {{inline}}void {{CppType}}::WGPURelease({{CType}} handle) {
             if (handle != nullptr) {
-                {{as_cMethod(type.name, Name("release"))}}(handle);
+                {{as_cppCallee(type.name, Name("release"))}}(handle);
             }
         }
     {% endfor %}
 
     // Instance
 
-    Instance CreateInstance(const InstanceDescriptor* descriptor) {
+    {{inline}}Instance CreateInstance(const InstanceDescriptor* descriptor) {
         const WGPUInstanceDescriptor* cDescriptor =
             reinterpret_cast<const WGPUInstanceDescriptor*>(descriptor);
-        return Instance::Acquire(wgpuCreateInstance(cDescriptor));
+        {% if native_procs %}
+            return Instance::Acquire(dawn_native::NativeCreateInstance(cDescriptor));
+        {% else %}
+            return Instance::Acquire(wgpuCreateInstance(cDescriptor));
+        {% endif %}
     }
 
-    Proc GetProcAddress(Device const& device, const char* procName) {
-        return reinterpret_cast<Proc>(wgpuGetProcAddress(device.Get(), procName));
+    {{inline}}Proc GetProcAddress(Device const& device, const char* procName) {
+        {% if native_procs %}
+            return reinterpret_cast<Proc>(dawn_native::NativeGetProcAddress(device.Get(), procName));
+        {% else %}
+            return reinterpret_cast<Proc>(wgpuGetProcAddress(device.Get(), procName));
+        {% endif %}
     }
 
 }
+{% if native_procs %}
+
+    #ifdef __GNUC__
+    #pragma GCC diagnostic pop
+    #endif
+
+    #endif  // DAWNNATIVE_WEBGPU_DAWN_NATIVE_CPP_H_
+{% endif %}
@@ -22,6 +22,8 @@
 //  - DAWN_NO_DISCARD: An attribute that is C++17 [[nodiscard]] where available
 //  - DAWN_(UN)?LIKELY(EXPR): Where available, hints the compiler that the expression will be true
 //      (resp. false) to help it generate code that leads to better branch prediction.
+//  - DAWN_TLS_INITIAL_EXEC: Where available, makes a thread_local variable use the initial-exec
+//      TLS model so that shared libraries access it without calling __tls_get_addr.
 //  - DAWN_UNUSED(EXPR): Prevents unused variable/expression warnings on EXPR.
 //  - DAWN_UNUSED_FUNC(FUNC): Prevents unused function warnings on FUNC.
 //  - DAWN_DECLARE_UNUSED:    Prevents unused function warnings a subsequent declaration.
@@ -61,6 +63,9 @@
 #    endif
 
 #    define DAWN_DECLARE_UNUSED __attribute__((unused))
+#    if defined(__linux__) && !defined(__ANDROID__)
+#        define DAWN_TLS_INITIAL_EXEC __attribute__((tls_model("initial-exec")))
+#    endif
 #    if defined(NDEBUG)
 #        define DAWN_FORCE_INLINE inline __attribute__((always_inline))
 #    endif
@@ -106,6 +111,9 @@ extern void __cdecl __debugbreak(void);
 #if !defined(DAWN_FORCE_INLINE)
 #    define DAWN_FORCE_INLINE inline
 #endif
+#if !defined(DAWN_TLS_INITIAL_EXEC)
+#    define DAWN_TLS_INITIAL_EXEC
+#endif
 
 #if defined(__clang__)
 #    define DAWN_FALLTHROUGH [[clang::fallthrough]]
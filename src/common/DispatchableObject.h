@@ -0,0 +1,43 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef COMMON_DISPATCHABLEOBJECT_H_
+#define COMMON_DISPATCHABLEOBJECT_H_
+
+#include "dawn/dawn_proc_table.h"
+
+// The objects that dawn_native and the dawn_wire client return to the application start with a
+// DispatchableObject so that dawnObjectDispatchProcTable can find the procs of the implementation
+// that created them. It must be the first base of the root of each object hierarchy. It is
+// polymorphic so that it is the primary base, placed at the start of the object with the vtable
+// pointer, and the procs are right after the vtable pointer. See
+// dawn/dawn_thread_dispatch_proc.h.
+class DispatchableObject {
+  public:
+    explicit DispatchableObject(const DawnProcTable* procs) : mProcs(procs) {
+    }
+
+    const DawnProcTable* GetProcTable() const {
+        return mProcs;
+    }
+
+  protected:
+    virtual ~DispatchableObject() = default;
+
+  private:
+    const DawnProcTable* mProcs;
+};
+
+#endif  // COMMON_DISPATCHABLEOBJECT_H_
@@ -15,9 +15,11 @@
 #ifndef COMMON_REFCOUNTED_H_
 #define COMMON_REFCOUNTED_H_
 
+#include "common/Assert.h"
 #include "common/RefBase.h"
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 
 class RefCounted {
@@ -39,9 +41,58 @@ class RefCounted {
     virtual void DeleteThis();
 
   private:
+    static constexpr size_t kPayloadBits = 1;
+    static constexpr uint64_t kPayloadMask = (uint64_t(1) << kPayloadBits) - 1;
+    static constexpr uint64_t kRefCountIncrement = (uint64_t(1) << kPayloadBits);
+
     std::atomic<uint64_t> mRefCount;
 };
 
+// Reference and Release are defined inline because they are called for every Ref copy and, when
+// the C++ bindings call dawn_native directly, for every copy of a wgpu:: object.
+inline void RefCounted::Reference() {
+    ASSERT((mRefCount & ~kPayloadMask) != 0);
+
+    // The relaxed ordering guarantees only the atomicity of the update, which is enough here
+    // because the reference we are copying from still exists and makes sure other threads
+    // don't delete `this`.
+    // See the explanation in the Boost documentation:
+    //     https://www.boost.org/doc/libs/1_55_0/doc/html/atomic/usage_examples.html
+    mRefCount.fetch_add(kRefCountIncrement, std::memory_order_relaxed);
+}
+
+inline void RefCounted::Release() {
+    ASSERT((mRefCount & ~kPayloadMask) != 0);
+
+    // The release fence here is to make sure all accesses to the object on a thread A
+    // happen-before the object is deleted on a thread B. The release memory order ensures that
+    // all accesses on thread A happen-before the refcount is decreased and the atomic variable
+    // makes sure the refcount decrease in A happens-before the refcount decrease in B. Finally
+    // the acquire fence in the destruction case makes sure the refcount decrease in B
+    // happens-before the `delete this`.
+    //
+    // See the explanation in the Boost documentation:
+    //     https://www.boost.org/doc/libs/1_55_0/doc/html/atomic/usage_examples.html
+    uint64_t previousRefCount = mRefCount.fetch_sub(kRefCountIncrement, std::memory_order_release);
+
+    // Check that the previous reference count was strictly less than 2, ignoring payload bits.
+    if (previousRefCount < 2 * kRefCountIncrement) {
+        // Note that on ARM64 this will generate a `dmb ish` instruction which is a global
+        // memory barrier, when an acquire load on mRefCount (using the `ldar` instruction)
+        // should be enough and could end up being faster.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        DeleteThis();
+    }
+}
+
+inline void RefCounted::APIReference() {
+    Reference();
+}
+
+inline void RefCounted::APIRelease() {
+    Release();
+}
+
 template <typename T>
 struct RefCountedTraits {
     static constexpr T* kNullValue = nullptr;
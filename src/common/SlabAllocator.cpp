@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <initializer_list>
 #include <limits>
 #include <new>
 
@@ -83,11 +84,54 @@ SlabAllocatorImpl::SlabAllocatorImpl(SlabAllocatorImpl&& rhs)
       mTotalAllocationSize(rhs.mTotalAllocationSize),
       mAvailableSlabs(std::move(rhs.mAvailableSlabs)),
       mFullSlabs(std::move(rhs.mFullSlabs)),
-      mRecycledSlabs(std::move(rhs.mRecycledSlabs)) {
+      mRecycledSlabs(std::move(rhs.mRecycledSlabs)),
+      mBlocksInUse(rhs.mBlocksInUse),
+      mSlabCount(rhs.mSlabCount),
+      mEmptySlabCount(rhs.mEmptySlabCount) {
 }
 
 SlabAllocatorImpl::~SlabAllocatorImpl() = default;
 
+size_t SlabAllocatorImpl::GetBlocksInUse() const {
+    return mBlocksInUse;
+}
+
+size_t SlabAllocatorImpl::GetSlabCount() const {
+    return mSlabCount;
+}
+
+size_t SlabAllocatorImpl::GetReservedBytes() const {
+    return mSlabCount * mTotalAllocationSize;
+}
+
+size_t SlabAllocatorImpl::GetEmptySlabCount() const {
+    return mEmptySlabCount;
+}
+
+size_t SlabAllocatorImpl::ReleaseEmptySlabs(size_t emptySlabsToKeep) {
+    size_t releasedSlabs = 0;
+
+    // Release the recycled slabs first, so that the slab currently servicing allocations, at the
+    // front of the available list, is the last one released.
+    for (SentinelSlab* list : {&mRecycledSlabs, &mAvailableSlabs}) {
+        Slab* slab = list->next;
+        while (slab != nullptr && mEmptySlabCount > emptySlabsToKeep) {
+            Slab* next = slab->next;
+            if (slab->blocksInUse == 0) {
+                slab->Splice();
+                // The slab is allocated inside slab->allocation.
+                delete[] slab->allocation;
+                mEmptySlabCount--;
+                mSlabCount--;
+                releasedSlabs++;
+            }
+            slab = next;
+        }
+    }
+
+    return releasedSlabs;
+}
+
 SlabAllocatorImpl::IndexLinkNode* SlabAllocatorImpl::OffsetFrom(
     IndexLinkNode* node,
     std::make_signed_t<Index> offset) const {
@@ -180,12 +224,17 @@ void* SlabAllocatorImpl::Allocate() {
     IndexLinkNode* node = PopFront(slab);
     ASSERT(node != nullptr);
 
+    if (slab->blocksInUse == 1) {
+        mEmptySlabCount--;
+    }
+
     // Move full slabs to a separate list, so allocate can always return quickly.
     if (slab->blocksInUse == mBlocksPerSlab) {
         slab->Splice();
         mFullSlabs.Prepend(slab);
     }
 
+    mBlocksInUse++;
     return ObjectFromNode(node);
 }
 
@@ -201,6 +250,7 @@ void SlabAllocatorImpl::Deallocate(void* ptr) {
 
     ASSERT(slab->blocksInUse != 0);
     PushFront(slab, node);
+    mBlocksInUse--;
 
     if (slabWasFull) {
         // Slab is in the full list. Move it to the recycled list.
@@ -209,8 +259,11 @@ void SlabAllocatorImpl::Deallocate(void* ptr) {
         mRecycledSlabs.Prepend(slab);
     }
 
-    // TODO(crbug.com/dawn/825): Occasionally prune slabs if |blocksInUse == 0|.
-    // Doing so eagerly hurts performance.
+    // Empty slabs aren't freed eagerly because doing so hurts performance. The owner of the
+    // allocator prunes them with ReleaseEmptySlabs instead.
+    if (slab->blocksInUse == 0) {
+        mEmptySlabCount++;
+    }
 }
 
 void SlabAllocatorImpl::GetNewSlab() {
@@ -243,4 +296,6 @@ void SlabAllocatorImpl::GetNewSlab() {
     lastNode->nextIndex = kInvalidIndex;
 
     mAvailableSlabs.Prepend(new (alignedPtr) Slab(allocation, node));
+    mSlabCount++;
+    mEmptySlabCount++;
 }
@@ -17,6 +17,7 @@
 
 #include "common/PlacementAllocated.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 #include <utility>
@@ -62,6 +63,20 @@ class SlabAllocatorImpl {
 
     SlabAllocatorImpl(SlabAllocatorImpl&& rhs);
 
+    // Statistics of the allocator: the number of blocks currently allocated, the number of slabs
+    // and the number of bytes of memory they use.
+    size_t GetBlocksInUse() const;
+    size_t GetSlabCount() const;
+    size_t GetReservedBytes() const;
+    // The number of slabs that have no block in use.
+    size_t GetEmptySlabCount() const;
+
+    // Frees the memory of the slabs that have no block in use, keeping at most
+    // |emptySlabsToKeep| of them to serve the next allocations. Returns the number of slabs
+    // freed. Slabs are never freed otherwise, so that allocating and deallocating a block
+    // repeatedly doesn't allocate and free a slab each time.
+    size_t ReleaseEmptySlabs(size_t emptySlabsToKeep);
+
   protected:
     // This is essentially a singly linked list using indices instead of pointers,
     // so we store the index of "this" in |this->index|.
@@ -159,6 +174,10 @@ class SlabAllocatorImpl {
     SentinelSlab mFullSlabs;       // Full slabs. Stored here so we can skip checking them.
     SentinelSlab mRecycledSlabs;   // Recycled slabs. Not immediately added to |mAvailableSlabs| so
                                    // we don't thrash the current "active" slab.
+
+    size_t mBlocksInUse = 0;
+    size_t mSlabCount = 0;
+    size_t mEmptySlabCount = 0;
 };
 
 template <typename T>
@@ -181,4 +200,21 @@ class SlabAllocator : public SlabAllocatorImpl {
     }
 };
 
+// A SlabAllocator for blocks of memory whose size is only known at runtime. The caller is
+// responsible for constructing and destroying objects in the blocks.
+class UntypedSlabAllocator : public SlabAllocatorImpl {
+  public:
+    UntypedSlabAllocator(Index blocksPerSlab, uint32_t blockSize, uint32_t blockAlignment)
+        : SlabAllocatorImpl(blocksPerSlab, blockSize, blockAlignment) {
+    }
+
+    void* Allocate() {
+        return SlabAllocatorImpl::Allocate();
+    }
+
+    void Deallocate(void* block) {
+        SlabAllocatorImpl::Deallocate(block);
+    }
+};
+
 #endif  // COMMON_SLABALLOCATOR_H_
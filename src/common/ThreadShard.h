@@ -0,0 +1,32 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_THREADSHARD_H_
+#define COMMON_THREADSHARD_H_
+
+#include <atomic>
+#include <cstdint>
+
+// Returns the index of the calling thread for sharded data structures, which is assigned in a
+// round-robin fashion the first time the thread calls it. Data structures that are accessed from
+// many threads use it modulo their number of shards, so that threads mostly use their own shard
+// and rarely contend with each other.
+inline uint32_t GetThreadShardIndex() {
+    static std::atomic<uint32_t> nextThreadShardIndex{0};
+    thread_local uint32_t shardIndex =
+        nextThreadShardIndex.fetch_add(1, std::memory_order_relaxed);
+    return shardIndex;
+}
+
+#endif  // COMMON_THREADSHARD_H_
@@ -140,6 +140,11 @@ namespace dawn_native { namespace vulkan {
         return reinterpret_cast<HandleType*>(handle);
     }
 
+    template <typename Tag, typename HandleType>
+    const HandleType* AsVkArray(const detail::VkHandle<Tag, HandleType>* handle) {
+        return reinterpret_cast<const HandleType*>(handle);
+    }
+
 }}  // namespace dawn_native::vulkan
 
 #define VK_DEFINE_NON_DISPATCHABLE_HANDLE(object)                                   \
@@ -19,7 +19,7 @@
 namespace dawn_native {
 
     AdapterBase::AdapterBase(InstanceBase* instance, wgpu::BackendType backend)
-        : mInstance(instance), mBackend(backend) {
+        : DispatchableObject(&GetProcs()), mInstance(instance), mBackend(backend) {
         GetDefaultLimits(&mLimits.v1);
         mSupportedFeatures.EnableFeature(Feature::DawnInternalUsages);
     }
@@ -17,6 +17,7 @@
 
 #include "dawn_native/DawnNative.h"
 
+#include "common/DispatchableObject.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Features.h"
 #include "dawn_native/Limits.h"
@@ -28,7 +29,7 @@ namespace dawn_native {
 
     class DeviceBase;
 
-    class AdapterBase {
+    class AdapterBase : public DispatchableObject {
       public:
         AdapterBase(InstanceBase* instance, wgpu::BackendType backend);
         virtual ~AdapterBase() = default;
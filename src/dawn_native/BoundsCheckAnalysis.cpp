@@ -0,0 +1,359 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/BoundsCheckAnalysis.h"
+
+#include "common/BitSetIterator.h"
+#include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/PipelineLayout.h"
+#include "dawn_native/ShaderModule.h"
+
+#include "src/ast/array_accessor_expression.h"
+#include "src/ast/assignment_statement.h"
+#include "src/ast/binary_expression.h"
+#include "src/ast/for_loop_statement.h"
+#include "src/ast/identifier_expression.h"
+#include "src/ast/member_accessor_expression.h"
+#include "src/ast/scalar_constructor_expression.h"
+#include "src/ast/sint_literal.h"
+#include "src/ast/uint_literal.h"
+#include "src/ast/unary_op_expression.h"
+#include "src/ast/variable_decl_statement.h"
+#include "src/castable.h"
+#include "src/clone_context.h"
+#include "src/program_builder.h"
+#include "src/sem/array.h"
+#include "src/sem/matrix_type.h"
+#include "src/sem/member_accessor_expression.h"
+#include "src/sem/struct.h"
+#include "src/sem/variable.h"
+#include "src/sem/vector_type.h"
+
+#include <algorithm>
+
+namespace dawn_native {
+
+    namespace {
+
+        // Returns whether the expression is an integer literal and its value if it is.
+        bool GetIntegerLiteral(const tint::ast::Expression* expr, int64_t* value) {
+            const auto* scalar = expr->As<tint::ast::ScalarConstructorExpression>();
+            if (scalar == nullptr) {
+                return false;
+            }
+            if (const auto* sint = scalar->literal()->As<tint::ast::SintLiteral>()) {
+                *value = sint->value();
+                return true;
+            }
+            if (const auto* uint = scalar->literal()->As<tint::ast::UintLiteral>()) {
+                *value = uint->value();
+                return true;
+            }
+            return false;
+        }
+
+        // Returns the variable the expression is an identifier for, or nullptr.
+        const tint::sem::Variable* GetIdentifiedVariable(const tint::Program* program,
+                                                         const tint::ast::Expression* expr) {
+            if (!expr->Is<tint::ast::IdentifierExpression>()) {
+                return nullptr;
+            }
+            const auto* user = program->Sem().Get<tint::sem::VariableUser>(expr);
+            return user != nullptr ? user->Variable() : nullptr;
+        }
+
+        // Returns the type of the array, vector or matrix the expression evaluates to.
+        const tint::sem::Type* GetIndexedType(const tint::Program* program,
+                                              const tint::ast::Expression* expr) {
+            const tint::sem::Expression* semExpr = program->Sem().Get(expr);
+            return semExpr != nullptr ? semExpr->Type()->UnwrapRef() : nullptr;
+        }
+
+        // Returns the number of elements of the array, vector or matrix type, or 0 if it isn't
+        // known statically.
+        uint32_t GetElementCount(const tint::sem::Type* type) {
+            if (type == nullptr) {
+                return 0;
+            }
+            if (const auto* array = type->As<tint::sem::Array>()) {
+                return array->IsRuntimeSized() ? 0 : array->Count();
+            }
+            if (const auto* vector = type->As<tint::sem::Vector>()) {
+                return vector->Width();
+            }
+            if (const auto* matrix = type->As<tint::sem::Matrix>()) {
+                return matrix->columns();
+            }
+            return 0;
+        }
+
+        // Returns the number of elements that the runtime-sized array the expression evaluates to
+        // is known to have at least, or 0. The array must be the last member of the structure of
+        // a buffer bound at a binding point of minBufferBindingSizes.
+        uint64_t GetMinRuntimeSizedArrayLength(const tint::Program* program,
+                                               const tint::ast::Expression* expr,
+                                               const tint::sem::Array* array,
+                                               const MinBufferBindingSizes& minBufferBindingSizes) {
+            const auto* memberAccess = expr->As<tint::ast::MemberAccessorExpression>();
+            if (memberAccess == nullptr || array->Stride() == 0) {
+                return 0;
+            }
+            const auto* semMemberAccess =
+                program->Sem().Get<tint::sem::StructMemberAccess>(memberAccess);
+            const tint::sem::Variable* buffer =
+                GetIdentifiedVariable(program, memberAccess->structure());
+            if (semMemberAccess == nullptr || buffer == nullptr) {
+                return 0;
+            }
+
+            tint::ast::Variable::BindingPoint bindingPoint = buffer->Declaration()->binding_point();
+            if (!bindingPoint) {
+                return 0;
+            }
+            auto it = minBufferBindingSizes.find(
+                {bindingPoint.group->value(), bindingPoint.binding->value()});
+            if (it == minBufferBindingSizes.end()) {
+                return 0;
+            }
+
+            uint64_t arrayOffset = semMemberAccess->Member()->Offset();
+            if (it->second <= arrayOffset) {
+                return 0;
+            }
+            return (it->second - arrayOffset) / array->Stride();
+        }
+
+        struct LoopCounter {
+            // The exclusive upper bound of the counter in the loop. Its lower bound is known to be
+            // non-negative.
+            int64_t end;
+            // The statement incrementing the counter, which is the only one allowed to write it.
+            const tint::ast::Statement* increment;
+        };
+        using LoopCounterMap = std::unordered_map<const tint::sem::Variable*, LoopCounter>;
+
+        // Returns whether the statement is `counter = counter + 1`.
+        bool IsCounterIncrement(const tint::Program* program,
+                                const tint::ast::Statement* statement,
+                                const tint::sem::Variable* counter) {
+            const auto* assignment = statement->As<tint::ast::AssignmentStatement>();
+            if (assignment == nullptr ||
+                GetIdentifiedVariable(program, assignment->lhs()) != counter) {
+                return false;
+            }
+
+            const auto* sum = assignment->rhs()->As<tint::ast::BinaryExpression>();
+            int64_t step;
+            return sum != nullptr && sum->op() == tint::ast::BinaryOp::kAdd &&
+                   GetIdentifiedVariable(program, sum->lhs()) == counter &&
+                   GetIntegerLiteral(sum->rhs(), &step) && step == 1;
+        }
+
+        // Finds the counters of the loops of the form `for (var i = A; i < B; i = i + 1)` with
+        // 0 <= A. The counters written outside of the loop continuing statement are removed
+        // later.
+        void FindLoopCounters(const tint::Program* program,
+                              const tint::ast::ForLoopStatement* loop,
+                              LoopCounterMap* counters) {
+            if (loop->initializer() == nullptr || loop->condition() == nullptr ||
+                loop->continuing() == nullptr) {
+                return;
+            }
+
+            const auto* declaration = loop->initializer()->As<tint::ast::VariableDeclStatement>();
+            if (declaration == nullptr || declaration->variable()->constructor() == nullptr) {
+                return;
+            }
+            int64_t begin;
+            if (!GetIntegerLiteral(declaration->variable()->constructor(), &begin) || begin < 0) {
+                return;
+            }
+            const tint::sem::Variable* counter = program->Sem().Get(declaration->variable());
+            if (counter == nullptr) {
+                return;
+            }
+
+            const auto* condition = loop->condition()->As<tint::ast::BinaryExpression>();
+            int64_t end;
+            if (condition == nullptr || condition->op() != tint::ast::BinaryOp::kLessThan ||
+                GetIdentifiedVariable(program, condition->lhs()) != counter ||
+                !GetIntegerLiteral(condition->rhs(), &end)) {
+                return;
+            }
+
+            if (!IsCounterIncrement(program, loop->continuing(), counter)) {
+                return;
+            }
+
+            counters->emplace(counter, LoopCounter{end, loop->continuing()});
+        }
+
+        // Returns whether the index is known to be in [0, *end).
+        bool GetIndexBound(const tint::Program* program,
+                           const LoopCounterMap& counters,
+                           const tint::ast::Expression* index,
+                           int64_t* end) {
+            int64_t value;
+            if (GetIntegerLiteral(index, &value)) {
+                *end = value + 1;
+                return value >= 0;
+            }
+
+            auto it = counters.find(GetIdentifiedVariable(program, index));
+            if (it != counters.end()) {
+                *end = it->second.end;
+                return true;
+            }
+            return false;
+        }
+
+        // Returns the access with its index clamped to the number of elements of the array,
+        // vector or matrix, or nullptr if the access can't be clamped and must be cloned as is.
+        tint::ast::ArrayAccessorExpression* ClampIndex(tint::CloneContext* ctx,
+                                                       tint::ast::ArrayAccessorExpression* access) {
+            using u32 = tint::ProgramBuilder::u32;
+            tint::ProgramBuilder* b = ctx->dst;
+
+            const tint::sem::Type* type = GetIndexedType(ctx->src, access->array());
+            uint32_t elementCount = GetElementCount(type);
+
+            tint::ast::Expression* maxIndex = nullptr;
+            if (elementCount != 0) {
+                maxIndex = b->Expr(elementCount - 1u);
+            } else if (type != nullptr && type->Is<tint::sem::Array>()) {
+                // The array is runtime-sized.
+                maxIndex = b->Sub(b->Call("arrayLength", b->AddressOf(ctx->Clone(access->array()))),
+                                  1u);
+            } else {
+                return nullptr;
+            }
+
+            tint::ast::Expression* index =
+                b->Call("min", b->Construct<u32>(ctx->Clone(access->idx_expr())), maxIndex);
+            return b->IndexAccessor(ctx->Clone(access->array()), index);
+        }
+
+    }  // anonymous namespace
+
+    BoundsCheckAnalysis AnalyzeBoundsChecks(const tint::Program* program,
+                                            const MinBufferBindingSizes& minBufferBindingSizes) {
+        // Find the loop counters with known bounds.
+        LoopCounterMap counters;
+        for (const tint::ast::Node* node : program->ASTNodes().Objects()) {
+            if (const auto* loop = node->As<tint::ast::ForLoopStatement>()) {
+                FindLoopCounters(program, loop, &counters);
+            }
+        }
+
+        // Remove the counters that could have other values because they are written by another
+        // statement, or could be written through a pointer.
+        if (!counters.empty()) {
+            for (const tint::ast::Node* node : program->ASTNodes().Objects()) {
+                if (const auto* assignment = node->As<tint::ast::AssignmentStatement>()) {
+                    auto it = counters.find(GetIdentifiedVariable(program, assignment->lhs()));
+                    if (it != counters.end() && it->second.increment != assignment) {
+                        counters.erase(it);
+                    }
+                } else if (const auto* unary = node->As<tint::ast::UnaryOpExpression>()) {
+                    if (unary->op() == tint::ast::UnaryOp::kAddressOf) {
+                        counters.erase(GetIdentifiedVariable(program, unary->expr()));
+                    }
+                }
+            }
+        }
+
+        BoundsCheckAnalysis analysis;
+        for (const tint::ast::Node* node : program->ASTNodes().Objects()) {
+            const auto* access = node->As<tint::ast::ArrayAccessorExpression>();
+            if (access == nullptr) {
+                continue;
+            }
+            analysis.indexAccessCount++;
+
+            int64_t end;
+            if (!GetIndexBound(program, counters, access->idx_expr(), &end)) {
+                continue;
+            }
+            if (end <= 0) {
+                // The loop never runs.
+                analysis.inBoundsAccesses.insert(access);
+                continue;
+            }
+
+            const tint::sem::Type* type = GetIndexedType(program, access->array());
+            uint64_t elementCount = GetElementCount(type);
+            if (elementCount == 0 && type != nullptr && type->Is<tint::sem::Array>()) {
+                elementCount = GetMinRuntimeSizedArrayLength(
+                    program, access->array(), type->As<tint::sem::Array>(), minBufferBindingSizes);
+            }
+            if (static_cast<uint64_t>(end) <= elementCount) {
+                analysis.inBoundsAccesses.insert(access);
+            }
+        }
+
+        return analysis;
+    }
+
+    MinBufferBindingSizes GetMinBufferBindingSizes(const EntryPointMetadata& entryPoint,
+                                                   const PipelineLayoutBase* layout) {
+        MinBufferBindingSizes sizes;
+        for (BindGroupIndex group : IterateBitSet(layout->GetBindGroupLayoutsMask())) {
+            const BindGroupLayoutBase* bgl = layout->GetBindGroupLayout(group);
+            for (const auto& it : entryPoint.bindings[group]) {
+                const ShaderBindingInfo& shaderInfo = it.second;
+                if (shaderInfo.bindingType != BindingInfoType::Buffer) {
+                    continue;
+                }
+
+                // A layout with a minBindingSize of 0 uses the size required by the shader,
+                // which is validated at draw and dispatch time instead.
+                const BindingInfo& layoutInfo = bgl->GetBindingInfo(bgl->GetBindingIndex(it.first));
+                sizes[{static_cast<uint32_t>(group), static_cast<uint32_t>(it.first)}] =
+                    std::max(layoutInfo.buffer.minBindingSize, shaderInfo.buffer.minBindingSize);
+            }
+        }
+        return sizes;
+    }
+
+    ClampUnprovenIndexAccesses::Config::Config(MinBufferBindingSizes minBufferBindingSizes)
+        : minBufferBindingSizes(std::move(minBufferBindingSizes)) {
+    }
+
+    ClampUnprovenIndexAccesses::Config::~Config() = default;
+
+    tint::transform::Output ClampUnprovenIndexAccesses::Run(
+        const tint::Program* program,
+        const tint::transform::DataMap& data) {
+        const Config* config = data.Get<Config>();
+        BoundsCheckAnalysis analysis = AnalyzeBoundsChecks(
+            program, config != nullptr ? config->minBufferBindingSizes : MinBufferBindingSizes{});
+
+        tint::ProgramBuilder builder;
+        tint::CloneContext ctx(&builder, program);
+        ctx.ReplaceAll(
+            [&](tint::ast::ArrayAccessorExpression* access) -> tint::ast::ArrayAccessorExpression* {
+                if (analysis.inBoundsAccesses.count(access) != 0) {
+                    // Returning nullptr clones the access without changes.
+                    return nullptr;
+                }
+                return ClampIndex(&ctx, access);
+            });
+        ctx.Clone();
+
+        return tint::transform::Output(tint::Program(std::move(builder)));
+    }
+
+}  // namespace dawn_native
+
+TINT_INSTANTIATE_TYPEINFO(dawn_native::ClampUnprovenIndexAccesses::Config);
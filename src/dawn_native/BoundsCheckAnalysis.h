@@ -0,0 +1,77 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_BOUNDSCHECKANALYSIS_H_
+#define DAWNNATIVE_BOUNDSCHECKANALYSIS_H_
+
+#include <tint/tint.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace dawn_native {
+
+    class PipelineLayoutBase;
+    struct EntryPointMetadata;
+
+    // The size that the buffer bound at each binding point is known to be at least, because it
+    // is validated when the bind group is created or when it is used in a draw or dispatch.
+    using MinBufferBindingSizes = std::unordered_map<tint::transform::BindingPoint, uint64_t>;
+
+    struct BoundsCheckAnalysis {
+        // The number of array, vector and matrix index accesses in the program.
+        uint32_t indexAccessCount = 0;
+        // The accesses that are proven to always be in bounds.
+        std::unordered_set<const tint::ast::ArrayAccessorExpression*> inBoundsAccesses;
+    };
+
+    // Finds the index accesses of the program that are statically known to be in bounds, so that
+    // the robustness transform doesn't need to clamp them. The index of an access is known to be
+    // in [0, B) if it is either:
+    //  - An integer literal I >= 0, with B = I + 1.
+    //  - The counter of a loop of the form `for (var i = A; i < B; i = i + 1)`, where A and B are
+    //    integer literals, 0 <= A, and the counter isn't written anywhere else or used through a
+    //    pointer.
+    // The access is proven to be in bounds if it indexes an array of fixed size, a vector or a
+    // matrix with at least B elements, or if it indexes the runtime-sized array of a buffer bound
+    // at a binding point of minBufferBindingSizes that is large enough to hold B elements.
+    BoundsCheckAnalysis AnalyzeBoundsChecks(
+        const tint::Program* program,
+        const MinBufferBindingSizes& minBufferBindingSizes = {});
+
+    // Returns the minimum size of the buffers bound to the entry point when it is used with the
+    // layout, which is the minBindingSize of the layout or the size required by the shader.
+    MinBufferBindingSizes GetMinBufferBindingSizes(const EntryPointMetadata& entryPoint,
+                                                   const PipelineLayoutBase* layout);
+
+    // Clamps the index accesses like tint::transform::BoundArrayAccessors, except for the ones
+    // that AnalyzeBoundsChecks proves to be in bounds.
+    class ClampUnprovenIndexAccesses final : public tint::transform::Transform {
+      public:
+        // Optional input with the binding sizes of the pipeline the program is compiled for.
+        struct Config final : public tint::Castable<Config, tint::transform::Data> {
+            explicit Config(MinBufferBindingSizes minBufferBindingSizes);
+            ~Config() override;
+
+            MinBufferBindingSizes minBufferBindingSizes;
+        };
+
+        tint::transform::Output Run(const tint::Program* program,
+                                    const tint::transform::DataMap& data = {}) override;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_BOUNDSCHECKANALYSIS_H_
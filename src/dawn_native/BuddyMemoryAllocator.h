@@ -18,6 +18,7 @@
 #include "dawn_native/BuddyAllocator.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/ResourceMemoryAllocation.h"
+#include "dawn_native/ResourceMemorySubAllocator.h"
 
 #include <memory>
 #include <vector>
@@ -37,18 +38,18 @@ namespace dawn_native {
     //
     // The MemoryAllocator should return ResourceHeaps that are all compatible with each other.
     // It should also outlive all the resources that are in the buddy allocator.
-    class BuddyMemoryAllocator {
+    class BuddyMemoryAllocator : public ResourceMemorySubAllocator {
       public:
         BuddyMemoryAllocator(uint64_t maxSystemSize,
                              uint64_t memoryBlockSize,
                              ResourceHeapAllocator* heapAllocator);
-        ~BuddyMemoryAllocator() = default;
+        ~BuddyMemoryAllocator() override = default;
 
         ResultOrError<ResourceMemoryAllocation> Allocate(uint64_t allocationSize,
-                                                         uint64_t alignment);
-        void Deallocate(const ResourceMemoryAllocation& allocation);
+                                                         uint64_t alignment) override;
+        void Deallocate(const ResourceMemoryAllocation& allocation) override;
 
-        uint64_t GetMemoryBlockSize() const;
+        uint64_t GetMemoryBlockSize() const override;
 
         // For testing purposes.
         uint64_t ComputeTotalNumOfHeapsForTesting() const;
@@ -175,7 +175,7 @@ namespace dawn_native {
 
     // static
     BufferBase* BufferBase::MakeError(DeviceBase* device, const BufferDescriptor* descriptor) {
-        return new ErrorBuffer(device, descriptor);
+        return new (device) ErrorBuffer(device, descriptor);
     }
 
     ObjectType BufferBase::GetType() const {
@@ -380,6 +380,13 @@ namespace dawn_native {
         DestroyInternal();
     }
 
+    void BufferBase::DestroyOnDeviceShutDown() {
+        // Map callbacks aren't called here because the device is shutting down with the API
+        // objects list locked. Pending map requests were completed when the GPU became idle.
+        mStagingBuffer.reset();
+        DestroyInternal();
+    }
+
     MaybeError BufferBase::CopyFromStagingBuffer() {
         ASSERT(mStagingBuffer);
         if (mSize == 0) {
@@ -19,6 +19,7 @@
 #include "dawn_native/Forward.h"
 #include "dawn_native/IntegerTypes.h"
 #include "dawn_native/ObjectBase.h"
+#include "dawn_native/ObjectPool.h"
 
 #include "dawn_native/dawn_platform.h"
 
@@ -40,7 +41,7 @@ namespace dawn_native {
     static constexpr wgpu::BufferUsage kMappableBufferUsages =
         wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapWrite;
 
-    class BufferBase : public ApiObjectBase {
+    class BufferBase : public ApiObjectBase, public DevicePoolAllocated<ObjectType::Buffer> {
         enum class BufferState {
             Unmapped,
             Mapped,
@@ -54,6 +55,7 @@ namespace dawn_native {
         static BufferBase* MakeError(DeviceBase* device, const BufferDescriptor* descriptor);
 
         ObjectType GetType() const override;
+        void DestroyOnDeviceShutDown() override;
 
         uint64_t GetSize() const;
         uint64_t GetAllocatedSize() const;
@@ -31,21 +31,25 @@ namespace dawn_native {
     }
 
     CommandIterator::~CommandIterator() {
-        ASSERT(IsEmpty());
+        ASSERT(IsEmpty() || mIsView);
     }
 
     CommandIterator::CommandIterator(CommandIterator&& other) {
+        ASSERT(!other.mIsView);
         if (!other.IsEmpty()) {
             mBlocks = std::move(other.mBlocks);
+            mRetainedObjects = std::move(other.mRetainedObjects);
             other.Reset();
         }
         Reset();
     }
 
     CommandIterator& CommandIterator::operator=(CommandIterator&& other) {
-        ASSERT(IsEmpty());
+        ASSERT(IsEmpty() && !mIsView);
+        ASSERT(!other.mIsView);
         if (!other.IsEmpty()) {
             mBlocks = std::move(other.mBlocks);
+            mRetainedObjects = std::move(other.mRetainedObjects);
             other.Reset();
         }
         Reset();
@@ -53,7 +57,8 @@ namespace dawn_native {
     }
 
     CommandIterator::CommandIterator(CommandAllocator allocator)
-        : mBlocks(allocator.AcquireBlocks()) {
+        : mBlocks(allocator.AcquireBlocks()),
+          mRetainedObjects(std::move(allocator.mRetainedObjects)) {
         Reset();
     }
 
@@ -68,10 +73,21 @@ namespace dawn_native {
                     mBlocks.push_back(std::move(block));
                 }
             }
+            for (Ref<RefCounted>& object : allocator.mRetainedObjects) {
+                mRetainedObjects.push_back(std::move(object));
+            }
         }
         Reset();
     }
 
+    void CommandIterator::InitializeAsViewOf(const CommandIterator& other) {
+        ASSERT(IsEmpty() && !mIsView);
+        mIsView = true;
+        mBlocks = other.mBlocks;
+        mCurrentBlock = other.mCurrentBlock;
+        mCurrentPtr = other.mCurrentPtr;
+    }
+
     bool CommandIterator::NextCommandIdInNewBlock(uint32_t* commandId) {
         mCurrentBlock++;
         if (mCurrentBlock >= mBlocks.size()) {
@@ -99,6 +115,7 @@ namespace dawn_native {
     }
 
     void CommandIterator::MakeEmptyAsDataWasDestroyed() {
+        ASSERT(!mIsView);
         if (IsEmpty()) {
             return;
         }
@@ -106,7 +123,10 @@ namespace dawn_native {
         for (BlockDef& block : mBlocks) {
             free(block.block);
         }
-        mBlocks.clear();
+        // Release the storage of the vectors too, since the iterator of a submitted command
+        // buffer can be kept alive for a long time.
+        CommandBlocks().swap(mBlocks);
+        std::vector<Ref<RefCounted>>().swap(mRetainedObjects);
         Reset();
         ASSERT(IsEmpty());
     }
@@ -115,6 +135,18 @@ namespace dawn_native {
         return mBlocks[0].block == reinterpret_cast<const uint8_t*>(&mEndOfBlock);
     }
 
+    size_t CommandIterator::GetAllocatedSize() const {
+        if (IsEmpty()) {
+            return 0;
+        }
+
+        size_t size = 0;
+        for (const BlockDef& block : mBlocks) {
+            size += block.size;
+        }
+        return size;
+    }
+
     // Potential TODO(crbug.com/dawn/835):
     //  - Host the size and pointer to next block in the block itself to avoid having an allocation
     //    in the vector
@@ -134,7 +166,12 @@ namespace dawn_native {
     }
 
     CommandAllocator::CommandAllocator(CommandAllocator&& other)
-        : mBlocks(std::move(other.mBlocks)), mLastAllocationSize(other.mLastAllocationSize) {
+        : mBlocks(std::move(other.mBlocks)),
+          mLastAllocationSize(other.mLastAllocationSize),
+          mCommandCount(other.mCommandCount),
+          mRetainedObjects(std::move(other.mRetainedObjects)),
+          mRetainedObjectSet(std::move(other.mRetainedObjectSet)),
+          mLastRetainedObject(other.mLastRetainedObject) {
         other.mBlocks.clear();
         if (!other.IsEmpty()) {
             mCurrentPtr = other.mCurrentPtr;
@@ -147,9 +184,13 @@ namespace dawn_native {
 
     CommandAllocator& CommandAllocator::operator=(CommandAllocator&& other) {
         Reset();
+        std::swap(mRetainedObjects, other.mRetainedObjects);
+        std::swap(mRetainedObjectSet, other.mRetainedObjectSet);
+        std::swap(mLastRetainedObject, other.mLastRetainedObject);
         if (!other.IsEmpty()) {
             std::swap(mBlocks, other.mBlocks);
             mLastAllocationSize = other.mLastAllocationSize;
+            mCommandCount = other.mCommandCount;
             mCurrentPtr = other.mCurrentPtr;
             mEndPtr = other.mEndPtr;
         }
@@ -162,7 +203,11 @@ namespace dawn_native {
             free(block.block);
         }
         mBlocks.clear();
+        mRetainedObjects.clear();
+        mRetainedObjectSet.clear();
+        mLastRetainedObject = nullptr;
         mLastAllocationSize = kDefaultBaseAllocationSize;
+        mCommandCount = 0;
         ResetPointers();
     }
 
@@ -170,6 +215,22 @@ namespace dawn_native {
         return mCurrentPtr == reinterpret_cast<const uint8_t*>(&mDummyEnum[0]);
     }
 
+    size_t CommandAllocator::GetCommandCount() const {
+        return mCommandCount;
+    }
+
+    size_t CommandAllocator::GetBlockCount() const {
+        return mBlocks.size();
+    }
+
+    size_t CommandAllocator::GetAllocatedSize() const {
+        size_t size = 0;
+        for (const BlockDef& block : mBlocks) {
+            size += block.size;
+        }
+        return size;
+    }
+
     CommandBlocks&& CommandAllocator::AcquireBlocks() {
         ASSERT(mCurrentPtr != nullptr && mEndPtr != nullptr);
         ASSERT(IsPtrAligned(mCurrentPtr, alignof(uint32_t)));
@@ -204,6 +265,32 @@ namespace dawn_native {
         return Allocate(commandId, commandSize, commandAlignment);
     }
 
+    void CommandAllocator::RetainObjectSlow(RefCounted* object) {
+        mLastRetainedObject = object;
+
+        if (mRetainedObjectSet.empty()) {
+            for (const Ref<RefCounted>& retained : mRetainedObjects) {
+                if (retained.Get() == object) {
+                    return;
+                }
+            }
+
+            if (mRetainedObjects.size() < kMaxLinearScanRetainedObjects) {
+                mRetainedObjects.emplace_back(object);
+                return;
+            }
+
+            // There are too many retained objects for the linear scan, switch to the set.
+            for (const Ref<RefCounted>& retained : mRetainedObjects) {
+                mRetainedObjectSet.insert(retained.Get());
+            }
+        }
+
+        if (mRetainedObjectSet.insert(object).second) {
+            mRetainedObjects.emplace_back(object);
+        }
+    }
+
     bool CommandAllocator::GetNewBlock(size_t minimumSize) {
         // Allocate blocks doubling sizes each time, to a maximum of 16k (or at least minimumSize).
         mLastAllocationSize =
@@ -18,9 +18,11 @@
 #include "common/Assert.h"
 #include "common/Math.h"
 #include "common/NonCopyable.h"
+#include "common/RefCounted.h"
 
 #include <cstddef>
 #include <cstdint>
+#include <unordered_set>
 #include <vector>
 
 namespace dawn_native {
@@ -52,6 +54,11 @@ namespace dawn_native {
     // and must tell the CommandIterator when the allocated commands have been processed for
     // deletion.
 
+    // Commands can store non-owning pointers to objects instead of Ref<>s if the objects are
+    // retained with CommandAllocator::RetainObject. Each object is then referenced once per
+    // allocator instead of once per command, and the references are moved to the CommandIterator
+    // with the blocks and released when the commands are deleted.
+
     // These are the lists of blocks, should not be used directly, only through CommandAllocator
     // and CommandIterator
     struct BlockDef {
@@ -80,13 +87,29 @@ namespace dawn_native {
 
         void AcquireCommandBlocks(std::vector<CommandAllocator> allocators);
 
+        // Makes this empty iterator a view of the commands of |other|, starting where |other|
+        // currently is. A view doesn't own the commands so |other| must keep them alive while the
+        // view is used, and it can be iterated on another thread than |other|. Views cannot be
+        // moved.
+        void InitializeAsViewOf(const CommandIterator& other);
+
         template <typename E>
         bool NextCommandId(E* commandId) {
             return NextCommandId(reinterpret_cast<uint32_t*>(commandId));
         }
+        // The command follows its uint32_t id so it is always at least 4-byte aligned and the
+        // pointer only needs to be aligned, at compile time, for commands with larger alignments.
         template <typename T>
-        T* NextCommand() {
-            return static_cast<T*>(NextCommand(sizeof(T), alignof(T)));
+        DAWN_FORCE_INLINE T* NextCommand() {
+            uint8_t* commandPtr = alignof(T) > alignof(uint32_t)
+                                      ? AlignPtr(mCurrentPtr, alignof(T))
+                                      : mCurrentPtr;
+            ASSERT(IsPtrAligned(commandPtr, alignof(T)));
+            ASSERT(commandPtr + sizeof(T) <=
+                   mBlocks[mCurrentBlock].block + mBlocks[mCurrentBlock].size);
+
+            mCurrentPtr = commandPtr + sizeof(T);
+            return reinterpret_cast<T*>(commandPtr);
         }
         template <typename T>
         T* NextData(size_t count) {
@@ -101,6 +124,9 @@ namespace dawn_native {
         // commands have been submitted and they are no longer valid.
         void MakeEmptyAsDataWasDestroyed();
 
+        // The total size of the blocks holding the commands.
+        size_t GetAllocatedSize() const;
+
       private:
         bool IsEmpty() const;
 
@@ -140,8 +166,10 @@ namespace dawn_native {
         }
 
         CommandBlocks mBlocks;
+        std::vector<Ref<RefCounted>> mRetainedObjects;
         uint8_t* mCurrentPtr = nullptr;
         size_t mCurrentBlock = 0;
+        bool mIsView = false;
         // Used to avoid a special case for empty iterators.
         uint32_t mEndOfBlock = detail::kEndOfBlock;
     };
@@ -160,6 +188,22 @@ namespace dawn_native {
 
         bool IsEmpty() const;
 
+        // The number of commands (not counting additional data), of blocks and of bytes in these
+        // blocks allocated since the last Reset().
+        size_t GetCommandCount() const;
+        size_t GetBlockCount() const;
+        size_t GetAllocatedSize() const;
+
+        // Keeps |object| alive until the commands are deleted, for commands that store a
+        // non-owning pointer to it. Passes typically set the same few objects over and over, so
+        // retaining the last retained object again is a single comparison and the first few
+        // objects are found with a linear scan before falling back to a set lookup.
+        void RetainObject(RefCounted* object) {
+            if (object != mLastRetainedObject) {
+                RetainObjectSlow(object);
+            }
+        }
+
         template <typename T, typename E>
         T* Allocate(E commandId) {
             static_assert(sizeof(E) == sizeof(uint32_t), "");
@@ -171,6 +215,7 @@ namespace dawn_native {
                 return nullptr;
             }
             new (result) T;
+            mCommandCount++;
             return result;
         }
 
@@ -200,6 +245,9 @@ namespace dawn_native {
         // The default value of mLastAllocationSize.
         static constexpr size_t kDefaultBaseAllocationSize = 2048;
 
+        // The number of retained objects looked up with a linear scan before using the set.
+        static constexpr size_t kMaxLinearScanRetainedObjects = 16;
+
         friend CommandIterator;
         CommandBlocks&& AcquireBlocks();
 
@@ -251,10 +299,19 @@ namespace dawn_native {
 
         bool GetNewBlock(size_t minimumSize);
 
+        void RetainObjectSlow(RefCounted* object);
+
         void ResetPointers();
 
         CommandBlocks mBlocks;
         size_t mLastAllocationSize = kDefaultBaseAllocationSize;
+        size_t mCommandCount = 0;
+
+        // mRetainedObjectSet is only filled once there are more than
+        // kMaxLinearScanRetainedObjects retained objects.
+        std::vector<Ref<RefCounted>> mRetainedObjects;
+        std::unordered_set<RefCounted*> mRetainedObjectSet;
+        RefCounted* mLastRetainedObject = nullptr;
 
         // Data used for the block range at initialization so that the first call to Allocate sees
         // there is not enough space and calls GetNewBlock. This avoids having to special case the
@@ -19,6 +19,7 @@
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/CommandValidation.h"
 #include "dawn_native/Commands.h"
+#include "dawn_native/Device.h"
 #include "dawn_native/Format.h"
 #include "dawn_native/ObjectType_autogen.h"
 #include "dawn_native/Texture.h"
@@ -29,6 +30,7 @@ namespace dawn_native {
         : ApiObjectBase(encoder->GetDevice(), kLabelNotImplemented),
           mCommands(encoder->AcquireCommands()),
           mResourceUsages(encoder->AcquireResourceUsages()) {
+        GetDevice()->GetStatistics()->commandBytesInUse.Add(mCommands.GetAllocatedSize());
     }
 
     CommandBufferBase::CommandBufferBase(DeviceBase* device, ObjectBase::ErrorTag tag)
@@ -49,7 +51,7 @@ namespace dawn_native {
 
     // static
     CommandBufferBase* CommandBufferBase::MakeError(DeviceBase* device) {
-        return new CommandBufferBase(device, ObjectBase::kError);
+        return new (device) CommandBufferBase(device, ObjectBase::kError);
     }
 
     ObjectType CommandBufferBase::GetType() const {
@@ -66,6 +68,13 @@ namespace dawn_native {
     }
 
     void CommandBufferBase::Destroy() {
+        // Called on submit, after the backend consumed the commands, so that the memory of
+        // command buffers the application keeps references to is released right away.
+        size_t commandsSize = mCommands.GetAllocatedSize();
+        if (commandsSize > 0 && IsAlive()) {
+            GetDevice()->GetStatistics()->commandBytesInUse.Sub(commandsSize);
+        }
+
         FreeCommands(&mCommands);
         mResourceUsages = {};
         mDestroyed = true;
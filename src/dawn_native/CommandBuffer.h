@@ -21,6 +21,7 @@
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
+#include "dawn_native/ObjectPool.h"
 #include "dawn_native/PassResourceUsage.h"
 #include "dawn_native/Texture.h"
 
@@ -30,7 +31,8 @@ namespace dawn_native {
     struct CopyTextureToBufferCmd;
     struct TextureCopy;
 
-    class CommandBufferBase : public ApiObjectBase {
+    class CommandBufferBase : public ApiObjectBase,
+                              public DevicePoolAllocated<ObjectType::CommandBuffer> {
       public:
         CommandBufferBase(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor);
 
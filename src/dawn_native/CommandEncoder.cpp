@@ -514,7 +514,7 @@ namespace dawn_native {
 
         if (success) {
             ComputePassEncoder* passEncoder =
-                new ComputePassEncoder(device, this, &mEncodingContext);
+                new (device) ComputePassEncoder(device, this, &mEncodingContext);
             mEncodingContext.EnterPass(passEncoder);
             return passEncoder;
         }
@@ -610,7 +610,7 @@ namespace dawn_native {
             "encoding BeginRenderPass(%s).", descriptor);
 
         if (success) {
-            RenderPassEncoder* passEncoder = new RenderPassEncoder(
+            RenderPassEncoder* passEncoder = new (device) RenderPassEncoder(
                 device, this, &mEncodingContext, std::move(usageTracker),
                 std::move(attachmentState), descriptor->occlusionQuerySet, width, height);
             mEncodingContext.EnterPass(passEncoder);
@@ -20,13 +20,15 @@
 #include "dawn_native/EncodingContext.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/ObjectBase.h"
+#include "dawn_native/ObjectPool.h"
 #include "dawn_native/PassResourceUsage.h"
 
 #include <string>
 
 namespace dawn_native {
 
-    class CommandEncoder final : public ApiObjectBase {
+    class CommandEncoder final : public ApiObjectBase,
+                                 public DevicePoolAllocated<ObjectType::CommandEncoder> {
       public:
         CommandEncoder(DeviceBase* device, const CommandEncoderDescriptor* descriptor);
 
@@ -20,12 +20,14 @@
 #include "dawn_native/AttachmentState.h"
 #include "dawn_native/BindingInfo.h"
 #include "dawn_native/BufferLocation.h"
+#include "dawn_native/CommandAllocator.h"
 #include "dawn_native/Texture.h"
 
 #include "dawn_native/dawn_platform.h"
 
 #include <array>
 #include <bitset>
+#include <type_traits>
 
 namespace dawn_native {
 
@@ -33,40 +35,47 @@ namespace dawn_native {
     // CommandBufferBuilder. There are not defined in CommandBuffer.h to break some header
     // dependencies: Ref<Object> needs Object to be defined.
 
+    // The list of all the commands, used to generate the Command enum and the typed dispatch in
+    // VisitCommand. The data of each command Name is stored in the CommandIterator as a NameCmd.
+#define DAWN_FOR_EACH_COMMAND(X)           \
+    X(BeginComputePass)                    \
+    X(BeginOcclusionQuery)                 \
+    X(BeginRenderPass)                     \
+    X(CopyBufferToBuffer)                  \
+    X(CopyBufferToTexture)                 \
+    X(CopyTextureToBuffer)                 \
+    X(CopyTextureToTexture)                \
+    X(Dispatch)                            \
+    X(DispatchIndirect)                    \
+    X(Draw)                                \
+    X(DrawIndexed)                         \
+    X(DrawIndirect)                        \
+    X(DrawIndexedIndirect)                 \
+    X(EndComputePass)                      \
+    X(EndOcclusionQuery)                   \
+    X(EndRenderPass)                       \
+    X(ExecuteBundles)                      \
+    X(InsertDebugMarker)                   \
+    X(PopDebugGroup)                       \
+    X(PushDebugGroup)                      \
+    X(ResolveQuerySet)                     \
+    X(SetComputePipeline)                  \
+    X(SetRenderPipeline)                   \
+    X(SetStencilReference)                 \
+    X(SetViewport)                         \
+    X(SetScissorRect)                      \
+    X(SetBlendConstant)                    \
+    X(SetBindGroup)                        \
+    X(SetIndexBuffer)                      \
+    X(SetValidatedBufferLocationsInternal) \
+    X(SetVertexBuffer)                     \
+    X(WriteBuffer)                         \
+    X(WriteTimestamp)
+
     enum class Command {
-        BeginComputePass,
-        BeginOcclusionQuery,
-        BeginRenderPass,
-        CopyBufferToBuffer,
-        CopyBufferToTexture,
-        CopyTextureToBuffer,
-        CopyTextureToTexture,
-        Dispatch,
-        DispatchIndirect,
-        Draw,
-        DrawIndexed,
-        DrawIndirect,
-        DrawIndexedIndirect,
-        EndComputePass,
-        EndOcclusionQuery,
-        EndRenderPass,
-        ExecuteBundles,
-        InsertDebugMarker,
-        PopDebugGroup,
-        PushDebugGroup,
-        ResolveQuerySet,
-        SetComputePipeline,
-        SetRenderPipeline,
-        SetStencilReference,
-        SetViewport,
-        SetScissorRect,
-        SetBlendConstant,
-        SetBindGroup,
-        SetIndexBuffer,
-        SetValidatedBufferLocationsInternal,
-        SetVertexBuffer,
-        WriteBuffer,
-        WriteTimestamp,
+#define DAWN_COMMAND_ENUM_ENTRY(Name) Name,
+        DAWN_FOR_EACH_COMMAND(DAWN_COMMAND_ENUM_ENTRY)
+#undef DAWN_COMMAND_ENUM_ENTRY
     };
 
     struct BeginComputePassCmd {};
@@ -213,12 +222,17 @@ namespace dawn_native {
         uint64_t destinationOffset;
     };
 
+    // SetPipeline, SetBindGroup, SetIndexBuffer and SetVertexBuffer are the most frequent commands
+    // after draws and dispatches. They store non-owning pointers to objects retained with
+    // CommandAllocator::RetainObject, and their fields are ordered to avoid padding, so that they
+    // are small and trivially destructible.
+
     struct SetComputePipelineCmd {
-        Ref<ComputePipelineBase> pipeline;
+        ComputePipelineBase* pipeline;
     };
 
     struct SetRenderPipelineCmd {
-        Ref<RenderPipelineBase> pipeline;
+        RenderPipelineBase* pipeline;
     };
 
     struct SetStencilReferenceCmd {
@@ -248,25 +262,28 @@ namespace dawn_native {
     };
 
     struct SetBindGroupCmd {
+        BindGroupBase* group;
         BindGroupIndex index;
-        Ref<BindGroupBase> group;
         uint32_t dynamicOffsetCount;
     };
 
     struct SetIndexBufferCmd {
-        Ref<BufferBase> buffer;
-        wgpu::IndexFormat format;
+        BufferBase* buffer;
         uint64_t offset;
         uint64_t size;
+        wgpu::IndexFormat format;
     };
 
     struct SetVertexBufferCmd {
-        VertexBufferSlot slot;
-        Ref<BufferBase> buffer;
+        BufferBase* buffer;
         uint64_t offset;
         uint64_t size;
+        VertexBufferSlot slot;
     };
 
+    static_assert(std::is_trivially_destructible<SetBindGroupCmd>::value, "");
+    static_assert(std::is_trivially_destructible<SetVertexBufferCmd>::value, "");
+
     struct WriteBufferCmd {
         Ref<BufferBase> buffer;
         uint64_t offset;
@@ -278,9 +295,45 @@ namespace dawn_native {
         uint32_t queryIndex;
     };
 
+    // Consumes the next command of |commands|, which must be of type |type|, and calls |visitor|
+    // with a pointer to its typed NameCmd structure. The switch is generated from the command list
+    // so each case reads its command with a size and alignment known at compile time, and
+    // |visitor| is usually a generic lambda or a set of overloads that is inlined in each case.
+    // The visitor is responsible for consuming the additional data of the command, if any.
+    template <typename Visitor>
+    void VisitCommand(CommandIterator* commands, Command type, Visitor&& visitor) {
+        switch (type) {
+#define DAWN_VISIT_COMMAND_CASE(Name)                \
+    case Command::Name:                              \
+        visitor(commands->NextCommand<Name##Cmd>()); \
+        break;
+            DAWN_FOR_EACH_COMMAND(DAWN_VISIT_COMMAND_CASE)
+#undef DAWN_VISIT_COMMAND_CASE
+        }
+    }
+
+    // Calls VisitCommand for each of the remaining commands of |commands|.
+    template <typename Visitor>
+    void VisitCommands(CommandIterator* commands, Visitor&& visitor) {
+        Command type;
+        while (commands->NextCommandId(&type)) {
+            VisitCommand(commands, type, visitor);
+        }
+    }
+
+    // Consumes the additional data that follows |cmd| in |commands|, if any. Visitors that don't
+    // use the additional data of the commands call this for all of them.
+    template <typename T>
+    void SkipCommandData(CommandIterator*, T*) {
+    }
+    void SkipCommandData(CommandIterator* commands, ExecuteBundlesCmd* cmd);
+    void SkipCommandData(CommandIterator* commands, InsertDebugMarkerCmd* cmd);
+    void SkipCommandData(CommandIterator* commands, PushDebugGroupCmd* cmd);
+    void SkipCommandData(CommandIterator* commands, SetBindGroupCmd* cmd);
+    void SkipCommandData(CommandIterator* commands, WriteBufferCmd* cmd);
+
     // This needs to be called before the CommandIterator is freed so that the Ref<> present in
     // the commands have a chance to run their destructor and remove internal references.
-    class CommandIterator;
     void FreeCommands(CommandIterator* commands);
 
     // Helper function to allow skipping over a command when it is unimplemented, while still
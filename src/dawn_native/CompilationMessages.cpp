@@ -115,6 +115,16 @@ namespace dawn_native {
         AddFormattedTintMessages(diagnostics);
     }
 
+    void OwnedCompilationMessages::AddInfoMessage(std::string message) {
+        // Cannot add messages after GetCompilationInfo has been called.
+        ASSERT(mCompilationInfo.messages == nullptr);
+
+        mMessageStrings.push_back(std::move(message));
+        mMessages.push_back(
+            {nullptr, static_cast<WGPUCompilationMessageType>(wgpu::CompilationMessageType::Info),
+             0, 0, 0, 0});
+    }
+
     void OwnedCompilationMessages::ClearMessages() {
         // Cannot clear messages after GetCompilationInfo has been called.
         ASSERT(mCompilationInfo.messages == nullptr);
@@ -42,6 +42,8 @@ namespace dawn_native {
             uint64_t offset = 0,
             uint64_t length = 0);
         void AddMessages(const tint::diag::List& diagnostics);
+        // Adds an informational message from Dawn that isn't attached to a location in the source.
+        void AddInfoMessage(std::string message);
         void ClearMessages();
 
         const WGPUCompilationInfo* GetCompilationInfo();
@@ -55,7 +55,8 @@ namespace dawn_native {
     ComputePassEncoder* ComputePassEncoder::MakeError(DeviceBase* device,
                                                       CommandEncoder* commandEncoder,
                                                       EncodingContext* encodingContext) {
-        return new ComputePassEncoder(device, commandEncoder, encodingContext, ObjectBase::kError);
+        return new (device)
+            ComputePassEncoder(device, commandEncoder, encodingContext, ObjectBase::kError);
     }
 
     ObjectType ComputePassEncoder::GetType() const {
@@ -164,6 +165,7 @@ namespace dawn_native {
                 SetComputePipelineCmd* cmd =
                     allocator->Allocate<SetComputePipelineCmd>(Command::SetComputePipeline);
                 cmd->pipeline = pipeline;
+                allocator->RetainObject(pipeline);
 
                 return {};
             },
@@ -18,6 +18,7 @@
 #include "dawn_native/CommandBufferStateTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
+#include "dawn_native/ObjectPool.h"
 #include "dawn_native/PassResourceUsageTracker.h"
 #include "dawn_native/ProgrammablePassEncoder.h"
 
@@ -25,7 +26,8 @@ namespace dawn_native {
 
     class SyncScopeUsageTracker;
 
-    class ComputePassEncoder final : public ProgrammablePassEncoder {
+    class ComputePassEncoder final : public ProgrammablePassEncoder,
+                                     public DevicePoolAllocated<ObjectType::ComputePassEncoder> {
       public:
         ComputePassEncoder(DeviceBase* device,
                            CommandEncoder* commandEncoder,
@@ -41,6 +41,7 @@ namespace dawn_native {
         ASSERT(mCreateComputePipelineAsyncCallback != nullptr);
 
         if (mPipeline.Get() != nullptr) {
+            mPipeline->TrackAliveForStatistics();
             mCreateComputePipelineAsyncCallback(
                 WGPUCreatePipelineAsyncStatus_Success,
                 reinterpret_cast<WGPUComputePipeline>(mPipeline.Detach()), "", mUserData);
@@ -78,6 +79,7 @@ namespace dawn_native {
         ASSERT(mCreateRenderPipelineAsyncCallback != nullptr);
 
         if (mPipeline.Get() != nullptr) {
+            mPipeline->TrackAliveForStatistics();
             mCreateRenderPipelineAsyncCallback(
                 WGPUCreatePipelineAsyncStatus_Success,
                 reinterpret_cast<WGPURenderPipeline>(mPipeline.Detach()), "", mUserData);
@@ -18,6 +18,7 @@
 #include "dawn_native/Buffer.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/Instance.h"
+#include "dawn_native/ReadbackStream.h"
 #include "dawn_native/Texture.h"
 #include "dawn_platform/DawnPlatform.h"
 
@@ -201,6 +202,10 @@ namespace dawn_native {
         mImpl->SetPlatform(platform);
     }
 
+    std::string Instance::DumpBuiltinTraceEvents() {
+        return mImpl->DumpBuiltinTraceEvents();
+    }
+
     WGPUInstance Instance::Get() const {
         return reinterpret_cast<WGPUInstance>(mImpl);
     }
@@ -215,6 +220,83 @@ namespace dawn_native {
         return deviceBase->GetDeprecationWarningCountForTesting();
     }
 
+    DeviceStatistics GetDeviceStatistics(WGPUDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        DeviceStatistics statistics;
+        deviceBase->GetStatistics()->Snapshot(&statistics);
+
+        ObjectPoolStatistics poolStatistics = deviceBase->GetObjectPool()->GetTotalStatistics();
+        statistics.pooledObjects = poolStatistics.objectsInUse;
+        statistics.objectPoolReservedBytes = poolStatistics.reservedBytes;
+        return statistics;
+    }
+
+    std::vector<std::pair<std::string, uint64_t>> GetDeviceStatisticsCounters(WGPUDevice device) {
+        DeviceStatistics statistics = GetDeviceStatistics(device);
+
+        std::vector<std::pair<std::string, uint64_t>> counters = {
+            {"commandsEncoded", statistics.commandsEncoded},
+            {"commandAllocatorBlocks", statistics.commandAllocatorBlocks},
+            {"commandAllocatorBytes", statistics.commandAllocatorBytes},
+            {"commandBytesInUse", statistics.commandBytesInUse},
+            {"tintCompileTimeNs", statistics.tintCompileTimeNs},
+            {"dynamicUploaderBytes", statistics.dynamicUploaderBytes},
+            {"callbacksFlushed", statistics.callbacksFlushed},
+            {"pooledObjects", statistics.pooledObjects},
+            {"objectPoolReservedBytes", statistics.objectPoolReservedBytes},
+        };
+
+        auto AddCache = [&](const char* name, const CacheStatistics& cache) {
+            counters.emplace_back(std::string(name) + ".hits", cache.hits);
+            counters.emplace_back(std::string(name) + ".misses", cache.misses);
+        };
+        AddCache("attachmentStateCache", statistics.attachmentStateCache);
+        AddCache("bindGroupLayoutCache", statistics.bindGroupLayoutCache);
+        AddCache("computePipelineCache", statistics.computePipelineCache);
+        AddCache("pipelineLayoutCache", statistics.pipelineLayoutCache);
+        AddCache("renderPipelineCache", statistics.renderPipelineCache);
+        AddCache("samplerCache", statistics.samplerCache);
+        AddCache("shaderModuleCache", statistics.shaderModuleCache);
+
+        for (const auto& objectsAlive : statistics.objectsAlive) {
+            counters.emplace_back(std::string("objectsAlive.") + objectsAlive.first,
+                                  objectsAlive.second);
+        }
+        return counters;
+    }
+
+    // ReadbackStream
+
+    ReadbackStream::ReadbackStream(WGPUDevice device,
+                                   const ReadbackStreamDescriptor* descriptor,
+                                   ReadbackCallback callback,
+                                   void* userdata)
+        : mImpl(new ReadbackStreamBase(reinterpret_cast<DeviceBase*>(device),
+                                       descriptor,
+                                       callback,
+                                       userdata)) {
+    }
+
+    ReadbackStream::~ReadbackStream() {
+        delete mImpl;
+        mImpl = nullptr;
+    }
+
+    bool ReadbackStream::EnqueueCopy(WGPUBuffer buffer,
+                                     uint64_t offset,
+                                     uint64_t size,
+                                     uint64_t tag) {
+        return mImpl->EnqueueCopy(reinterpret_cast<BufferBase*>(buffer), offset, size, tag);
+    }
+
+    void ReadbackStream::Flush() {
+        mImpl->Flush();
+    }
+
+    uint32_t ReadbackStream::GetFreeChunkCount() const {
+        return mImpl->GetFreeChunkCount();
+    }
+
     bool IsTextureSubresourceInitialized(WGPUTexture cTexture,
                                          uint32_t baseMipLevel,
                                          uint32_t levelCount,
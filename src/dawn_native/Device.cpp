@@ -168,17 +168,42 @@ namespace dawn_native {
             return layoutRef;
         }
 
+        // Modules created with Toggle::AsyncShaderModuleCreation must be done initializing before
+        // a pipeline is validated or created with them.
+        MaybeError WaitForShaderModuleInitialization(ShaderModuleBase* module) {
+            if (module == nullptr) {
+                return {};
+            }
+            return module->WaitForInitialization();
+        }
+
+        MaybeError WaitForShaderModulesInitialization(const RenderPipelineDescriptor* descriptor) {
+            DAWN_TRY(WaitForShaderModuleInitialization(descriptor->vertex.module));
+            if (descriptor->fragment != nullptr) {
+                DAWN_TRY(WaitForShaderModuleInitialization(descriptor->fragment->module));
+            }
+            return {};
+        }
+
     }  // anonymous namespace
 
     // DeviceBase
 
     DeviceBase::DeviceBase(AdapterBase* adapter, const DeviceDescriptor* descriptor)
-        : mInstance(adapter->GetInstance()), mAdapter(adapter), mNextPipelineCompatibilityToken(1) {
+        : DispatchableObject(&GetProcs()),
+          mObjectPool(AcquireRef(new DeviceObjectPool())),
+          mInstance(adapter->GetInstance()),
+          mAdapter(adapter),
+          mNextPipelineCompatibilityToken(1) {
         if (descriptor != nullptr) {
             ApplyToggleOverrides(descriptor);
             ApplyFeatures(descriptor);
         }
 
+        if (IsToggleEnabled(Toggle::EnableBuiltinTracing)) {
+            GetPlatform()->EnableBuiltinTracing(true);
+        }
+
         if (descriptor != nullptr && descriptor->requiredLimits != nullptr) {
             mLimits.v1 = ReifyDefaultLimits(
                 reinterpret_cast<const RequiredLimits*>(descriptor->requiredLimits)->limits);
@@ -324,11 +349,25 @@ namespace dawn_native {
 
         mInternalPipelineStore = nullptr;
 
+        // The application can still hold API objects of the device. Release their backend
+        // resources now that the GPU is idle, so that they are returned to the backend's
+        // allocators and deleters before ShutDownImpl destroys them.
+        mApiObjects.ForEach([](ApiObjectBase* object) {
+            if (!object->IsError()) {
+                object->DestroyOnDeviceShutDown();
+            }
+        });
+
         AssumeCommandsComplete();
         // Tell the backend that it can free all the objects now that the GPU timeline is empty.
         ShutDownImpl();
 
         mCaches = nullptr;
+
+        // The objects the application still holds keep the object pool alive, so free the
+        // memory of the ones already deleted instead of keeping it for objects that will never
+        // be created.
+        mObjectPool->Trim();
     }
 
     void DeviceBase::HandleError(InternalErrorType type, const char* message) {
@@ -499,8 +538,8 @@ namespace dawn_native {
         return mState != State::Alive;
     }
 
-    std::mutex* DeviceBase::GetObjectListMutex(ObjectType type) {
-        return &mObjectLists[type].mutex;
+    ApiObjectList* DeviceBase::GetApiObjectList() {
+        return &mApiObjects;
     }
 
     AdapterBase* DeviceBase::GetAdapter() const {
@@ -608,8 +647,10 @@ namespace dawn_native {
         Ref<BindGroupLayoutBase> result;
         auto iter = mCaches->bindGroupLayouts.find(&blueprint);
         if (iter != mCaches->bindGroupLayouts.end()) {
+            mStatistics.bindGroupLayoutCache.hits.Increment();
             result = *iter;
         } else {
+            mStatistics.bindGroupLayoutCache.misses.Increment();
             DAWN_TRY_ASSIGN(result,
                             CreateBindGroupLayoutImpl(descriptor, pipelineCompatibilityToken));
             result->SetIsCachedReference();
@@ -650,7 +691,10 @@ namespace dawn_native {
         Ref<ComputePipelineBase> result;
         auto iter = mCaches->computePipelines.find(&blueprint);
         if (iter != mCaches->computePipelines.end()) {
+            mStatistics.computePipelineCache.hits.Increment();
             result = *iter;
+        } else {
+            mStatistics.computePipelineCache.misses.Increment();
         }
 
         return std::make_pair(result, blueprintHash);
@@ -661,7 +705,10 @@ namespace dawn_native {
         Ref<RenderPipelineBase> cachedPipeline;
         auto iter = mCaches->renderPipelines.find(uninitializedRenderPipeline);
         if (iter != mCaches->renderPipelines.end()) {
+            mStatistics.renderPipelineCache.hits.Increment();
             cachedPipeline = *iter;
+        } else {
+            mStatistics.renderPipelineCache.misses.Increment();
         }
         return cachedPipeline;
     }
@@ -706,8 +753,10 @@ namespace dawn_native {
         Ref<PipelineLayoutBase> result;
         auto iter = mCaches->pipelineLayouts.find(&blueprint);
         if (iter != mCaches->pipelineLayouts.end()) {
+            mStatistics.pipelineLayoutCache.hits.Increment();
             result = *iter;
         } else {
+            mStatistics.pipelineLayoutCache.misses.Increment();
             DAWN_TRY_ASSIGN(result, CreatePipelineLayoutImpl(descriptor));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
@@ -739,8 +788,10 @@ namespace dawn_native {
         Ref<SamplerBase> result;
         auto iter = mCaches->samplers.find(&blueprint);
         if (iter != mCaches->samplers.end()) {
+            mStatistics.samplerCache.hits.Increment();
             result = *iter;
         } else {
+            mStatistics.samplerCache.misses.Increment();
             DAWN_TRY_ASSIGN(result, CreateSamplerImpl(descriptor));
             result->SetIsCachedReference();
             result->SetContentHash(blueprintHash);
@@ -770,8 +821,11 @@ namespace dawn_native {
         Ref<ShaderModuleBase> result;
         auto iter = mCaches->shaderModules.find(&blueprint);
         if (iter != mCaches->shaderModules.end()) {
+            mStatistics.shaderModuleCache.hits.Increment();
             result = *iter;
+            DAWN_TRY(result->WaitForInitialization());
         } else {
+            mStatistics.shaderModuleCache.misses.Increment();
             if (!parseResult->HasParsedShader()) {
                 // We skip the parse on creation if validation isn't enabled which let's us quickly
                 // lookup in the cache without validating and parsing. We need the parsed module
@@ -800,8 +854,10 @@ namespace dawn_native {
         AttachmentStateBlueprint* blueprint) {
         auto iter = mCaches->attachmentStates.find(blueprint);
         if (iter != mCaches->attachmentStates.end()) {
+            mStatistics.attachmentStateCache.hits.Increment();
             return static_cast<AttachmentState*>(*iter);
         }
+        mStatistics.attachmentStateCache.misses.Increment();
 
         Ref<AttachmentState> attachmentState = AcquireRef(new AttachmentState(this, *blueprint));
         attachmentState->SetIsCachedReference();
@@ -864,7 +920,7 @@ namespace dawn_native {
     }
     CommandEncoder* DeviceBase::APICreateCommandEncoder(
         const CommandEncoderDescriptor* descriptor) {
-        return new CommandEncoder(this, descriptor);
+        return new (this) CommandEncoder(this, descriptor);
     }
     ComputePipelineBase* DeviceBase::APICreateComputePipeline(
         const ComputePipelineDescriptor* descriptor) {
@@ -951,8 +1007,14 @@ namespace dawn_native {
         Ref<ShaderModuleBase> result;
         std::unique_ptr<OwnedCompilationMessages> compilationMessages(
             std::make_unique<OwnedCompilationMessages>());
-        if (ConsumedError(CreateShaderModule(descriptor, compilationMessages.get()), &result,
-                          "calling CreateShaderModule(%s).", descriptor)) {
+        // Only the modules of the application are initialized asynchronously because dawn_native
+        // uses its internal modules right after creating them.
+        ResultOrError<Ref<ShaderModuleBase>> maybeResult =
+            IsToggleEnabled(Toggle::AsyncShaderModuleCreation)
+                ? CreateShaderModuleAsync(descriptor)
+                : CreateShaderModule(descriptor, compilationMessages.get());
+        if (ConsumedError(std::move(maybeResult), &result, "calling CreateShaderModule(%s).",
+                          descriptor)) {
             DAWN_ASSERT(result == nullptr);
             result = ShaderModuleBase::MakeError(this);
         }
@@ -1183,6 +1245,7 @@ namespace dawn_native {
     ResultOrError<Ref<ComputePipelineBase>> DeviceBase::CreateComputePipeline(
         const ComputePipelineDescriptor* descriptor) {
         DAWN_TRY(ValidateIsAlive());
+        DAWN_TRY(WaitForShaderModuleInitialization(descriptor->compute.module));
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateComputePipelineDescriptor(this, descriptor));
         }
@@ -1210,6 +1273,7 @@ namespace dawn_native {
         WGPUCreateComputePipelineAsyncCallback callback,
         void* userdata) {
         DAWN_TRY(ValidateIsAlive());
+        DAWN_TRY(WaitForShaderModuleInitialization(descriptor->compute.module));
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateComputePipelineDescriptor(this, descriptor));
         }
@@ -1323,6 +1387,7 @@ namespace dawn_native {
     ResultOrError<Ref<RenderPipelineBase>> DeviceBase::CreateRenderPipeline(
         const RenderPipelineDescriptor* descriptor) {
         DAWN_TRY(ValidateIsAlive());
+        DAWN_TRY(WaitForShaderModulesInitialization(descriptor));
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateRenderPipelineDescriptor(this, descriptor));
         }
@@ -1351,6 +1416,7 @@ namespace dawn_native {
                                                      WGPUCreateRenderPipelineAsyncCallback callback,
                                                      void* userdata) {
         DAWN_TRY(ValidateIsAlive());
+        DAWN_TRY(WaitForShaderModulesInitialization(descriptor));
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateRenderPipelineDescriptor(this, descriptor));
         }
@@ -1411,6 +1477,39 @@ namespace dawn_native {
         return GetOrCreateShaderModule(descriptor, &parseResult, compilationMessages);
     }
 
+    ResultOrError<Ref<ShaderModuleBase>> DeviceBase::CreateShaderModuleAsync(
+        const ShaderModuleDescriptor* descriptor) {
+        DAWN_TRY(ValidateIsAlive());
+
+        // Only the chained structs can be validated before parsing. The rest of the validation is
+        // done by the initialization of the module.
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateShaderModuleDescriptorChain(descriptor));
+        }
+
+        ShaderModuleBase blueprint(this, descriptor);
+
+        const size_t blueprintHash = blueprint.ComputeContentHash();
+        blueprint.SetContentHash(blueprintHash);
+
+        // Modules found in the cache might still be initializing, in which case they are shared
+        // with the pending initialization.
+        auto iter = mCaches->shaderModules.find(&blueprint);
+        if (iter != mCaches->shaderModules.end()) {
+            mStatistics.shaderModuleCache.hits.Increment();
+            return Ref<ShaderModuleBase>(*iter);
+        }
+
+        mStatistics.shaderModuleCache.misses.Increment();
+        Ref<ShaderModuleBase> result = CreateUninitializedShaderModuleImpl(descriptor);
+        result->SetIsCachedReference();
+        result->SetContentHash(blueprintHash);
+        mCaches->shaderModules.insert(result.Get());
+
+        result->InitializeAsync();
+        return std::move(result);
+    }
+
     ResultOrError<Ref<SwapChainBase>> DeviceBase::CreateSwapChain(
         Surface* surface,
         const SwapChainDescriptor* descriptor) {
@@ -1470,6 +1569,14 @@ namespace dawn_native {
         return mDynamicUploader.get();
     }
 
+    DeviceStatisticsCounters* DeviceBase::GetStatistics() const {
+        return &mStatistics;
+    }
+
+    DeviceObjectPool* DeviceBase::GetObjectPool() const {
+        return mObjectPool.Get();
+    }
+
     // The Toggle device facility
 
     std::vector<const char*> DeviceBase::GetTogglesUsed() const {
@@ -1529,6 +1636,7 @@ namespace dawn_native {
             for (std::unique_ptr<CallbackTask>& callbackTask : callbackTasks) {
                 callbackTask->Finish();
             }
+            mStatistics.callbacksFlushed.Add(callbackTasks.size());
         }
     }
 
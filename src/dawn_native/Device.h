@@ -16,12 +16,14 @@
 #define DAWNNATIVE_DEVICE_H_
 
 #include "dawn_native/Commands.h"
+#include "dawn_native/DeviceStatistics.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Features.h"
 #include "dawn_native/Format.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/Limits.h"
 #include "dawn_native/ObjectBase.h"
+#include "dawn_native/ObjectPool.h"
 #include "dawn_native/ObjectType_autogen.h"
 #include "dawn_native/StagingBuffer.h"
 #include "dawn_native/Toggles.h"
@@ -53,7 +55,7 @@ namespace dawn_native {
     struct InternalPipelineStore;
     struct ShaderModuleParseResult;
 
-    class DeviceBase : public RefCounted {
+    class DeviceBase : public DispatchableObject, public RefCounted {
       public:
         DeviceBase(AdapterBase* adapter, const DeviceDescriptor* descriptor);
         virtual ~DeviceBase();
@@ -213,6 +215,11 @@ namespace dawn_native {
         ResultOrError<Ref<ShaderModuleBase>> CreateShaderModule(
             const ShaderModuleDescriptor* descriptor,
             OwnedCompilationMessages* compilationMessages = nullptr);
+        // Returns the module right away and parses, validates and reflects it on a worker thread.
+        // Used for the modules created by the application when
+        // Toggle::AsyncShaderModuleCreation is enabled.
+        ResultOrError<Ref<ShaderModuleBase>> CreateShaderModuleAsync(
+            const ShaderModuleDescriptor* descriptor);
         ResultOrError<Ref<SwapChainBase>> CreateSwapChain(Surface* surface,
                                                           const SwapChainDescriptor* descriptor);
         ResultOrError<Ref<TextureBase>> CreateTexture(const TextureDescriptor* descriptor);
@@ -278,6 +285,11 @@ namespace dawn_native {
 
         DynamicUploader* GetDynamicUploader() const;
 
+        // The counters are thread-safe so they can be updated through a const device.
+        DeviceStatisticsCounters* GetStatistics() const;
+
+        DeviceObjectPool* GetObjectPool() const;
+
         // The device state which is a combination of creation state and loss state.
         //
         //   - BeingCreated: the device didn't finish creation yet and the frontend cannot be used
@@ -298,7 +310,7 @@ namespace dawn_native {
         };
         State GetState() const;
         bool IsLost() const;
-        std::mutex* GetObjectListMutex(ObjectType type);
+        ApiObjectList* GetApiObjectList();
 
         std::vector<const char*> GetEnabledFeatures() const;
         std::vector<const char*> GetTogglesUsed() const;
@@ -383,6 +395,8 @@ namespace dawn_native {
         virtual ResultOrError<Ref<ShaderModuleBase>> CreateShaderModuleImpl(
             const ShaderModuleDescriptor* descriptor,
             ShaderModuleParseResult* parseResult) = 0;
+        virtual Ref<ShaderModuleBase> CreateUninitializedShaderModuleImpl(
+            const ShaderModuleDescriptor* descriptor) = 0;
         virtual ResultOrError<Ref<SwapChainBase>> CreateSwapChainImpl(
             const SwapChainDescriptor* descriptor) = 0;
         // Note that previousSwapChain may be nullptr, or come from a different backend.
@@ -471,6 +485,19 @@ namespace dawn_native {
 
         std::unique_ptr<ErrorScopeStack> mErrorScopeStack;
 
+        // Declared before any member that can hold references to API objects so that it is still
+        // valid when they are released during the destruction of the device.
+        mutable DeviceStatisticsCounters mStatistics;
+
+        // Objects allocated from the pool keep a reference to it, so it doesn't matter when it
+        // is released in the destruction of the device.
+        Ref<DeviceObjectPool> mObjectPool;
+
+        // All the live API objects "owned" by the device. Declared before any member that can
+        // hold references to API objects so that they can remove themselves from it when released
+        // during the destruction of the device.
+        ApiObjectList mApiObjects;
+
         // The Device keeps a ref to the Instance so that any live Device keeps the Instance alive.
         // The Instance shouldn't need to ref child objects so this shouldn't introduce ref cycles.
         // The Device keeps a simple pointer to the Adapter because the Adapter is owned by the
@@ -494,14 +521,6 @@ namespace dawn_native {
 
         State mState = State::BeingCreated;
 
-        // Encompasses the mutex and the actual list that contains all live objects "owned" by the
-        // device.
-        struct ApiObjectList {
-            std::mutex mutex;
-            LinkedList<ApiObjectBase> objects;
-        };
-        PerObjectType<ApiObjectList> mObjectLists;
-
         FormatTable mFormatTable;
 
         TogglesSet mEnabledToggles;
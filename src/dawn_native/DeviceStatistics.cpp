@@ -0,0 +1,56 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/DeviceStatistics.h"
+
+#include "dawn_native/DawnNative.h"
+
+namespace dawn_native {
+
+    namespace {
+
+        void SnapshotCache(const CacheStatisticsCounters& counters, CacheStatistics* statistics) {
+            statistics->hits = counters.hits.Get();
+            statistics->misses = counters.misses.Get();
+        }
+
+    }  // anonymous namespace
+
+    void DeviceStatisticsCounters::Snapshot(DeviceStatistics* statistics) const {
+        statistics->commandsEncoded = commandsEncoded.Get();
+        statistics->commandAllocatorBlocks = commandAllocatorBlocks.Get();
+        statistics->commandAllocatorBytes = commandAllocatorBytes.Get();
+        statistics->commandBytesInUse = commandBytesInUse.Get();
+        statistics->tintCompileTimeNs = tintCompileTimeNs.Get();
+        statistics->dynamicUploaderBytes = dynamicUploaderBytes.Get();
+        statistics->callbacksFlushed = callbacksFlushed.Get();
+
+        SnapshotCache(attachmentStateCache, &statistics->attachmentStateCache);
+        SnapshotCache(bindGroupLayoutCache, &statistics->bindGroupLayoutCache);
+        SnapshotCache(computePipelineCache, &statistics->computePipelineCache);
+        SnapshotCache(pipelineLayoutCache, &statistics->pipelineLayoutCache);
+        SnapshotCache(renderPipelineCache, &statistics->renderPipelineCache);
+        SnapshotCache(samplerCache, &statistics->samplerCache);
+        SnapshotCache(shaderModuleCache, &statistics->shaderModuleCache);
+
+        statistics->objectsAlive.clear();
+        statistics->objectsAlive.reserve(static_cast<uint32_t>(objectsAlive.size()));
+        for (uint32_t i = 0; i < static_cast<uint32_t>(objectsAlive.size()); ++i) {
+            ObjectType type = static_cast<ObjectType>(i);
+            statistics->objectsAlive.emplace_back(ObjectTypeAsString(type),
+                                                  objectsAlive[type].Get());
+        }
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,102 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_DEVICESTATISTICS_H_
+#define DAWNNATIVE_DEVICESTATISTICS_H_
+
+#include "common/NonCopyable.h"
+#include "dawn_native/ObjectType_autogen.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace dawn_native {
+
+    struct DeviceStatistics;
+
+    // A monotonic statistics counter. Updates use relaxed atomics: they are only a locked add on
+    // the CPU and don't order other memory operations, so counters can stay enabled in
+    // production. Readers may observe values of different counters that are slightly out of sync.
+    class StatisticsCounter : public NonCopyable {
+      public:
+        void Add(uint64_t value) {
+            mValue.fetch_add(value, std::memory_order_relaxed);
+        }
+        void Increment() {
+            Add(1);
+        }
+        void Sub(uint64_t value) {
+            mValue.fetch_sub(value, std::memory_order_relaxed);
+        }
+        void Decrement() {
+            Sub(1);
+        }
+        uint64_t Get() const {
+            return mValue.load(std::memory_order_relaxed);
+        }
+
+      private:
+        std::atomic<uint64_t> mValue{0};
+    };
+
+    struct CacheStatisticsCounters {
+        StatisticsCounter hits;
+        StatisticsCounter misses;
+    };
+
+    // The CPU-side statistics of a device. See dawn_native::DeviceStatistics in DawnNative.h for
+    // a description of each counter.
+    struct DeviceStatisticsCounters : public NonCopyable {
+        StatisticsCounter commandsEncoded;
+        StatisticsCounter commandAllocatorBlocks;
+        StatisticsCounter commandAllocatorBytes;
+        StatisticsCounter commandBytesInUse;
+        StatisticsCounter tintCompileTimeNs;
+        StatisticsCounter dynamicUploaderBytes;
+        StatisticsCounter callbacksFlushed;
+
+        // One per DeviceBase::Caches member.
+        CacheStatisticsCounters attachmentStateCache;
+        CacheStatisticsCounters bindGroupLayoutCache;
+        CacheStatisticsCounters computePipelineCache;
+        CacheStatisticsCounters pipelineLayoutCache;
+        CacheStatisticsCounters renderPipelineCache;
+        CacheStatisticsCounters samplerCache;
+        CacheStatisticsCounters shaderModuleCache;
+
+        PerObjectType<StatisticsCounter> objectsAlive;
+
+        void Snapshot(DeviceStatistics* statistics) const;
+    };
+
+    // Adds the time elapsed during its lifetime, in nanoseconds, to a counter.
+    class ScopedStatisticsTimer : public NonCopyable {
+      public:
+        explicit ScopedStatisticsTimer(StatisticsCounter* counter)
+            : mCounter(counter), mStart(std::chrono::steady_clock::now()) {
+        }
+        ~ScopedStatisticsTimer() {
+            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - mStart;
+            mCounter->Add(static_cast<uint64_t>(elapsed.count()));
+        }
+
+      private:
+        StatisticsCounter* mCounter;
+        std::chrono::steady_clock::time_point mStart;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_DEVICESTATISTICS_H_
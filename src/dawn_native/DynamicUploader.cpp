@@ -124,6 +124,7 @@ namespace dawn_native {
         uploadHandle.mappedBuffer =
             static_cast<uint8_t*>(uploadHandle.mappedBuffer) + additionalOffset;
         uploadHandle.startOffset += additionalOffset;
+        mDevice->GetStatistics()->dynamicUploaderBytes.Add(allocationSize);
         return uploadHandle;
     }
 }  // namespace dawn_native
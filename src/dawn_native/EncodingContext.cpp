@@ -186,6 +186,10 @@ namespace dawn_native {
 
     void EncodingContext::CommitCommands(CommandAllocator allocator) {
         if (!allocator.IsEmpty()) {
+            DeviceStatisticsCounters* statistics = mDevice->GetStatistics();
+            statistics->commandsEncoded.Add(allocator.GetCommandCount());
+            statistics->commandAllocatorBlocks.Add(allocator.GetBlockCount());
+            statistics->commandAllocatorBytes.Add(allocator.GetAllocatedSize());
             mAllocators.push_back(std::move(allocator));
         }
     }
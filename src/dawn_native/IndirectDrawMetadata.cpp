@@ -14,9 +14,7 @@
 
 #include "dawn_native/IndirectDrawMetadata.h"
 
-#include "common/Constants.h"
 #include "common/RefCounted.h"
-#include "dawn_native/IndirectDrawValidationEncoder.h"
 #include "dawn_native/RenderBundle.h"
 
 #include <algorithm>
@@ -24,16 +22,6 @@
 
 namespace dawn_native {
 
-    namespace {
-
-        // In the unlikely scenario that indirect offsets used over a single buffer span more than
-        // this length of the buffer, we split the validation work into multiple batches.
-        constexpr uint64_t kMaxBatchOffsetRange = kMaxStorageBufferBindingSize -
-                                                  kMinStorageBufferOffsetAlignment -
-                                                  kDrawIndexedIndirectSize;
-
-    }  // namespace
-
     IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::IndexedIndirectBufferValidationInfo(
         BufferBase* indirectBuffer)
         : mIndirectBuffer(indirectBuffer) {
@@ -41,87 +29,57 @@ namespace dawn_native {
 
     void IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::AddIndexedIndirectDraw(
         IndexedIndirectDraw draw) {
-        const uint64_t newOffset = draw.clientBufferOffset;
-        auto it = mBatches.begin();
-        while (it != mBatches.end()) {
-            IndexedIndirectValidationBatch& batch = *it;
-            if (batch.draws.size() >= kMaxDrawCallsPerIndirectValidationBatch) {
-                // This batch is full. If its minOffset is to the right of the new offset, we can
-                // just insert a new batch here.
-                if (newOffset < batch.minOffset) {
-                    break;
-                }
-
-                // Otherwise keep looking.
-                ++it;
-                continue;
-            }
-
-            if (newOffset >= batch.minOffset && newOffset <= batch.maxOffset) {
-                batch.draws.push_back(std::move(draw));
-                return;
-            }
-
-            if (newOffset < batch.minOffset &&
-                batch.maxOffset - newOffset <= kMaxBatchOffsetRange) {
-                // We can extend this batch to the left in order to fit the new offset.
-                batch.minOffset = newOffset;
-                batch.draws.push_back(std::move(draw));
-                return;
-            }
-
-            if (newOffset > batch.maxOffset &&
-                newOffset - batch.minOffset <= kMaxBatchOffsetRange) {
-                // We can extend this batch to the right in order to fit the new offset.
-                batch.maxOffset = newOffset;
-                batch.draws.push_back(std::move(draw));
-                return;
-            }
-
-            if (newOffset < batch.minOffset) {
-                // We want to insert a new batch just before this one.
-                break;
-            }
+        AddOffsetRange(draw.clientBufferOffset, draw.clientBufferOffset);
+        mDrawCount++;
+        mDraws.push_back(std::move(draw));
+    }
 
-            ++it;
+    void IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::AddBundleDraws(
+        const IndexedIndirectBufferValidationInfo& bundleInfo) {
+        ASSERT(bundleInfo.mIndirectBuffer.Get() == mIndirectBuffer.Get());
+        // Render bundles cannot execute other bundles.
+        ASSERT(bundleInfo.mBundleDraws.empty());
+        if (bundleInfo.mDraws.empty()) {
+            return;
         }
 
-        IndexedIndirectValidationBatch newBatch;
-        newBatch.minOffset = newOffset;
-        newBatch.maxOffset = newOffset;
-        newBatch.draws.push_back(std::move(draw));
+        AddOffsetRange(bundleInfo.mMinOffset, bundleInfo.mMaxOffset);
+        mDrawCount += bundleInfo.mDrawCount;
+        mBundleDraws.push_back(&bundleInfo.mDraws);
+    }
 
-        mBatches.insert(it, std::move(newBatch));
+    void IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::AddOffsetRange(
+        uint64_t minOffset,
+        uint64_t maxOffset) {
+        mMinOffset = std::min(mMinOffset, minOffset);
+        mMaxOffset = std::max(mMaxOffset, maxOffset);
     }
 
-    void IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::AddBatch(
-        const IndexedIndirectValidationBatch& newBatch) {
-        auto it = mBatches.begin();
-        while (it != mBatches.end()) {
-            IndexedIndirectValidationBatch& batch = *it;
-            uint64_t min = std::min(newBatch.minOffset, batch.minOffset);
-            uint64_t max = std::max(newBatch.maxOffset, batch.maxOffset);
-            if (max - min <= kMaxBatchOffsetRange && batch.draws.size() + newBatch.draws.size() <=
-                                                         kMaxDrawCallsPerIndirectValidationBatch) {
-                // This batch fits within the limits of an existing batch. Merge it.
-                batch.minOffset = min;
-                batch.maxOffset = max;
-                batch.draws.insert(batch.draws.end(), newBatch.draws.begin(), newBatch.draws.end());
-                return;
-            }
-
-            if (newBatch.minOffset < batch.minOffset) {
-                break;
-            }
+    BufferBase* IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::GetIndirectBuffer()
+        const {
+        return mIndirectBuffer.Get();
+    }
 
-            ++it;
-        }
-        mBatches.push_back(newBatch);
+    uint64_t IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::GetMinOffset() const {
+        return mMinOffset;
+    }
+
+    uint64_t IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::GetMaxOffset() const {
+        return mMaxOffset;
     }
 
-    const std::vector<IndirectDrawMetadata::IndexedIndirectValidationBatch>&
-    IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::GetBatches() const {
-        return mBatches;
+    uint64_t IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::GetDrawCount() const {
+        return mDrawCount;
+    }
+
+    const std::vector<IndirectDrawMetadata::IndexedIndirectDraw>&
+    IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::GetDraws() const {
+        return mDraws;
+    }
+
+    const std::vector<const std::vector<IndirectDrawMetadata::IndexedIndirectDraw>*>&
+    IndirectDrawMetadata::IndexedIndirectBufferValidationInfo::GetBundleDraws() const {
+        return mBundleDraws;
     }
 
     IndirectDrawMetadata::IndirectDrawMetadata() = default;
@@ -132,9 +90,26 @@ namespace dawn_native {
 
     IndirectDrawMetadata& IndirectDrawMetadata::operator=(IndirectDrawMetadata&&) = default;
 
-    IndirectDrawMetadata::IndexedIndirectBufferValidationInfoMap*
-    IndirectDrawMetadata::GetIndexedIndirectBufferValidationInfo() {
-        return &mIndexedIndirectBufferValidationInfo;
+    const std::vector<IndirectDrawMetadata::IndexedIndirectBufferValidationInfo>&
+    IndirectDrawMetadata::GetIndexedIndirectBufferValidationInfos() const {
+        return mIndexedIndirectBufferValidationInfos;
+    }
+
+    IndirectDrawMetadata::IndexedIndirectBufferValidationInfo*
+    IndirectDrawMetadata::GetOrCreateBufferValidationInfo(BufferBase* indirectBuffer) {
+        if (mLastUsedInfoIndex < mIndexedIndirectBufferValidationInfos.size() &&
+            mIndexedIndirectBufferValidationInfos[mLastUsedInfoIndex].GetIndirectBuffer() ==
+                indirectBuffer) {
+            return &mIndexedIndirectBufferValidationInfos[mLastUsedInfoIndex];
+        }
+
+        auto result = mIndexedIndirectBufferValidationInfoIndices.emplace(
+            indirectBuffer, mIndexedIndirectBufferValidationInfos.size());
+        if (result.second) {
+            mIndexedIndirectBufferValidationInfos.emplace_back(indirectBuffer);
+        }
+        mLastUsedInfoIndex = result.first->second;
+        return &mIndexedIndirectBufferValidationInfos[mLastUsedInfoIndex];
     }
 
     void IndirectDrawMetadata::AddBundle(RenderBundleBase* bundle) {
@@ -143,18 +118,12 @@ namespace dawn_native {
             return;
         }
 
-        for (const auto& entry :
-             bundle->GetIndirectDrawMetadata().mIndexedIndirectBufferValidationInfo) {
-            const IndexedIndirectConfig& config = entry.first;
-            auto it = mIndexedIndirectBufferValidationInfo.lower_bound(config);
-            if (it != mIndexedIndirectBufferValidationInfo.end() && it->first == config) {
-                // We already have batches for the same config. Merge the new ones in.
-                for (const IndexedIndirectValidationBatch& batch : entry.second.GetBatches()) {
-                    it->second.AddBatch(batch);
-                }
-            } else {
-                mIndexedIndirectBufferValidationInfo.emplace_hint(it, config, entry.second);
-            }
+        // The bundle's infos were computed once when it was finished. Only references to their
+        // draw calls are added here, so executing a bundle doesn't depend on its number of draws.
+        for (const IndexedIndirectBufferValidationInfo& bundleInfo :
+             bundle->GetIndirectDrawMetadata().mIndexedIndirectBufferValidationInfos) {
+            GetOrCreateBufferValidationInfo(bundleInfo.GetIndirectBuffer())
+                ->AddBundleDraws(bundleInfo);
         }
     }
 
@@ -176,18 +145,11 @@ namespace dawn_native {
                 UNREACHABLE();
         }
 
-        const IndexedIndirectConfig config(indirectBuffer, numIndexBufferElements);
-        auto it = mIndexedIndirectBufferValidationInfo.find(config);
-        if (it == mIndexedIndirectBufferValidationInfo.end()) {
-            auto result = mIndexedIndirectBufferValidationInfo.emplace(
-                config, IndexedIndirectBufferValidationInfo(indirectBuffer));
-            it = result.first;
-        }
-
         IndexedIndirectDraw draw;
         draw.clientBufferOffset = indirectOffset;
+        draw.numIndexBufferElements = numIndexBufferElements;
         draw.bufferLocation = drawCmdIndirectBufferLocation;
-        it->second.AddIndexedIndirectDraw(std::move(draw));
+        GetOrCreateBufferValidationInfo(indirectBuffer)->AddIndexedIndirectDraw(std::move(draw));
     }
 
 }  // namespace dawn_native
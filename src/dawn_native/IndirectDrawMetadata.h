@@ -23,9 +23,9 @@
 #include "dawn_native/Commands.h"
 
 #include <cstdint>
-#include <map>
-#include <set>
-#include <utility>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace dawn_native {
@@ -40,60 +40,60 @@ namespace dawn_native {
       public:
         struct IndexedIndirectDraw {
             uint64_t clientBufferOffset;
+            // The number of addressable index buffer elements at the time of the draw call.
+            uint64_t numIndexBufferElements;
             Ref<BufferLocation> bufferLocation;
         };
 
-        struct IndexedIndirectValidationBatch {
-            uint64_t minOffset;
-            uint64_t maxOffset;
-            std::vector<IndexedIndirectDraw> draws;
-        };
-
-        // Tracks information about every draw call in this render pass which uses the same indirect
-        // buffer and the same-sized index buffer. Calls are grouped by indirect offset ranges so
-        // that validation work can be chunked efficiently if necessary.
+        // Tracks information about every draw call in this render pass which uses the same
+        // indirect buffer, including the draw calls of the render bundles it executes. They are
+        // all validated together, so that the validation work for a render pass is usually a
+        // single dispatch per indirect buffer.
         class IndexedIndirectBufferValidationInfo {
           public:
             explicit IndexedIndirectBufferValidationInfo(BufferBase* indirectBuffer);
 
-            // Logs a new drawIndexedIndirect call for the render pass. `cmd` is updated with an
-            // assigned (and deferred) buffer ref and relative offset before returning.
+            // Logs a new drawIndexedIndirect call for the render pass.
             void AddIndexedIndirectDraw(IndexedIndirectDraw draw);
 
-            // Adds draw calls from an already-computed batch, e.g. from a previously encoded
-            // RenderBundle. The added batch is merged into an existing batch if possible, otherwise
-            // it's added to mBatch.
-            void AddBatch(const IndexedIndirectValidationBatch& batch);
+            // Adds the draw calls of a render bundle for the same indirect buffer. They are
+            // referenced instead of copied, so |bundleInfo| must outlive this object, which is
+            // the case since the render pass's commands hold a reference to its bundles.
+            void AddBundleDraws(const IndexedIndirectBufferValidationInfo& bundleInfo);
 
-            const std::vector<IndexedIndirectValidationBatch>& GetBatches() const;
+            BufferBase* GetIndirectBuffer() const;
+            uint64_t GetMinOffset() const;
+            uint64_t GetMaxOffset() const;
+            uint64_t GetDrawCount() const;
+
+            // The draw calls encoded directly in the render pass or bundle.
+            const std::vector<IndexedIndirectDraw>& GetDraws() const;
+            // The draw calls of the render bundles added with AddBundleDraws.
+            const std::vector<const std::vector<IndexedIndirectDraw>*>& GetBundleDraws() const;
 
           private:
+            void AddOffsetRange(uint64_t minOffset, uint64_t maxOffset);
+
             Ref<BufferBase> mIndirectBuffer;
 
-            // A list of information about validation batches that will need to be executed for the
-            // corresponding indirect buffer prior to a single render pass. These are kept sorted by
-            // minOffset and may overlap iff the number of offsets in one batch would otherwise
-            // exceed some large upper bound (roughly ~33M draw calls).
-            //
-            // Since the most common expected cases will overwhelmingly require only a single
-            // validation pass per render pass, this is optimized for efficient updates to a single
-            // batch rather than for efficient manipulation of a large number of batches.
-            std::vector<IndexedIndirectValidationBatch> mBatches;
+            // The draw calls are not sorted. The range of their offsets is tracked so that the
+            // encoder only needs to sort them in the rare case where they don't all fit in a
+            // single validation dispatch.
+            std::vector<IndexedIndirectDraw> mDraws;
+            std::vector<const std::vector<IndexedIndirectDraw>*> mBundleDraws;
+            uint64_t mMinOffset = std::numeric_limits<uint64_t>::max();
+            uint64_t mMaxOffset = 0;
+            uint64_t mDrawCount = 0;
         };
 
-        // Combination of an indirect buffer reference, and the number of addressable index buffer
-        // elements at the time of a draw call.
-        using IndexedIndirectConfig = std::pair<BufferBase*, uint64_t>;
-        using IndexedIndirectBufferValidationInfoMap =
-            std::map<IndexedIndirectConfig, IndexedIndirectBufferValidationInfo>;
-
         IndirectDrawMetadata();
         ~IndirectDrawMetadata();
 
         IndirectDrawMetadata(IndirectDrawMetadata&&);
         IndirectDrawMetadata& operator=(IndirectDrawMetadata&&);
 
-        IndexedIndirectBufferValidationInfoMap* GetIndexedIndirectBufferValidationInfo();
+        const std::vector<IndexedIndirectBufferValidationInfo>&
+        GetIndexedIndirectBufferValidationInfos() const;
 
         void AddBundle(RenderBundleBase* bundle);
         void AddIndexedIndirectDraw(wgpu::IndexFormat indexFormat,
@@ -103,8 +103,17 @@ namespace dawn_native {
                                     BufferLocation* drawCmdIndirectBufferLocation);
 
       private:
-        IndexedIndirectBufferValidationInfoMap mIndexedIndirectBufferValidationInfo;
-        std::set<RenderBundleBase*> mAddedBundles;
+        IndexedIndirectBufferValidationInfo* GetOrCreateBufferValidationInfo(
+            BufferBase* indirectBuffer);
+
+        // The infos are stored in a flat vector in the order their indirect buffer is first used,
+        // and indexed by a hash map. Consecutive draws usually use the same indirect buffer, so
+        // the last info used is checked before doing a lookup.
+        std::vector<IndexedIndirectBufferValidationInfo> mIndexedIndirectBufferValidationInfos;
+        std::unordered_map<BufferBase*, size_t> mIndexedIndirectBufferValidationInfoIndices;
+        size_t mLastUsedInfoIndex = 0;
+
+        std::unordered_set<RenderBundleBase*> mAddedBundles;
     };
 
 }  // namespace dawn_native
@@ -25,8 +25,9 @@
 #include "dawn_native/InternalPipelineStore.h"
 #include "dawn_native/Queue.h"
 
-#include <cstdlib>
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 namespace dawn_native {
 
@@ -34,13 +35,27 @@ namespace dawn_native {
         // NOTE: This must match the workgroup_size attribute on the compute entry point below.
         constexpr uint64_t kWorkgroupSize = 64;
 
+        // In the unlikely scenario that indirect offsets used over a single buffer span more than
+        // this length of the buffer, we split the validation work into multiple batches.
+        constexpr uint64_t kMaxBatchOffsetRange = kMaxStorageBufferBindingSize -
+                                                  kMinStorageBufferOffsetAlignment -
+                                                  kDrawIndexedIndirectSize;
+
         // Equivalent to the BatchInfo struct defined in the shader below.
         struct BatchInfo {
-            uint64_t numIndexBufferElements;
             uint32_t numDraws;
             uint32_t padding;
         };
 
+        // Equivalent to the DrawInfo struct defined in the shader below. Each draw has its own
+        // number of index buffer elements so that draws using index buffers of different sizes can
+        // be validated in the same batch.
+        struct DrawInfo {
+            uint32_t indirectOffset;
+            uint32_t numIndexBufferElementsLow;
+            uint32_t numIndexBufferElementsHigh;
+        };
+
         // TODO(https://crbug.com/dawn/1108): Propagate validation feedback from this shader in
         // various failure modes.
         static const char sRenderValidationShaderSource[] = R"(
@@ -52,12 +67,16 @@ namespace dawn_native {
             let kBaseVertexEntry = 3u;
             let kFirstInstanceEntry = 4u;
 
-            [[block]] struct BatchInfo {
+            struct DrawInfo {
+                indirectOffset: u32;
                 numIndexBufferElementsLow: u32;
                 numIndexBufferElementsHigh: u32;
+            };
+
+            [[block]] struct BatchInfo {
                 numDraws: u32;
                 padding: u32;
-                indirectOffsets: array<u32>;
+                draws: array<DrawInfo>;
             };
 
             [[block]] struct IndirectParams {
@@ -79,7 +98,7 @@ namespace dawn_native {
 
             fn pass(drawIndex: u32) {
                 let vIndex = drawIndex * kNumIndirectParamsPerDrawCall;
-                let cIndex = batch.indirectOffsets[drawIndex];
+                let cIndex = batch.draws[drawIndex].indirectOffset;
                 validatedParams.data[vIndex + kIndexCountEntry] =
                     clientParams.data[cIndex + kIndexCountEntry];
                 validatedParams.data[vIndex + kInstanceCountEntry] =
@@ -98,14 +117,15 @@ namespace dawn_native {
                     return;
                 }
 
-                let clientIndex = batch.indirectOffsets[id.x];
+                let draw = batch.draws[id.x];
+                let clientIndex = draw.indirectOffset;
                 let firstInstance = clientParams.data[clientIndex + kFirstInstanceEntry];
                 if (firstInstance != 0u) {
                     fail(id.x);
                     return;
                 }
 
-                if (batch.numIndexBufferElementsHigh >= 2u) {
+                if (draw.numIndexBufferElementsHigh >= 2u) {
                     // firstIndex and indexCount are both u32. The maximum possible sum of these
                     // values is 0x1fffffffe, which is less than 0x200000000. Nothing to validate.
                     pass(id.x);
@@ -113,15 +133,15 @@ namespace dawn_native {
                 }
 
                 let firstIndex = clientParams.data[clientIndex + kFirstIndexEntry];
-                if (batch.numIndexBufferElementsHigh == 0u &&
-                    batch.numIndexBufferElementsLow < firstIndex) {
+                if (draw.numIndexBufferElementsHigh == 0u &&
+                    draw.numIndexBufferElementsLow < firstIndex) {
                     fail(id.x);
                     return;
                 }
 
                 // Note that this subtraction may underflow, but only when
                 // numIndexBufferElementsHigh is 1u. The result is still correct in that case.
-                let maxIndexCount = batch.numIndexBufferElementsLow - firstIndex;
+                let maxIndexCount = draw.numIndexBufferElementsLow - firstIndex;
                 let indexCount = clientParams.data[clientIndex + kIndexCountEntry];
                 if (indexCount > maxIndexCount) {
                     fail(id.x);
@@ -183,7 +203,7 @@ namespace dawn_native {
         }
 
         size_t GetBatchDataSize(uint32_t numDraws) {
-            return sizeof(BatchInfo) + numDraws * sizeof(uint32_t);
+            return sizeof(BatchInfo) + numDraws * sizeof(DrawInfo);
         }
 
     }  // namespace
@@ -191,7 +211,7 @@ namespace dawn_native {
     const uint32_t kBatchDrawCallLimitByDispatchSize =
         kMaxComputePerDimensionDispatchSize * kWorkgroupSize;
     const uint32_t kBatchDrawCallLimitByStorageBindingSize =
-        (kMaxStorageBufferBindingSize - sizeof(BatchInfo)) / sizeof(uint32_t);
+        (kMaxStorageBufferBindingSize - sizeof(BatchInfo)) / sizeof(DrawInfo);
     const uint32_t kMaxDrawCallsPerIndirectValidationBatch =
         std::min(kBatchDrawCallLimitByDispatchSize, kBatchDrawCallLimitByStorageBindingSize);
 
@@ -199,88 +219,117 @@ namespace dawn_native {
                                                     CommandEncoder* commandEncoder,
                                                     RenderPassResourceUsageTracker* usageTracker,
                                                     IndirectDrawMetadata* indirectDrawMetadata) {
+        using IndexedIndirectDraw = IndirectDrawMetadata::IndexedIndirectDraw;
+
+        // A contiguous range of draws validated by a batch.
+        struct DrawRange {
+            const IndexedIndirectDraw* begin;
+            const IndexedIndirectDraw* end;
+        };
+
         struct Batch {
-            const IndirectDrawMetadata::IndexedIndirectValidationBatch* metadata;
-            uint64_t numIndexBufferElements;
+            BufferBase* clientIndirectBuffer;
+            uint64_t minOffset;
+            uint64_t maxOffset;
+            uint32_t numDraws = 0;
+            std::vector<DrawRange> draws;
+
             uint64_t dataBufferOffset;
             uint64_t dataSize;
             uint64_t clientIndirectOffset;
             uint64_t clientIndirectSize;
             uint64_t validatedParamsOffset;
             uint64_t validatedParamsSize;
-            BatchInfo* batchInfo;
-        };
-
-        struct Pass {
-            BufferBase* clientIndirectBuffer;
-            uint64_t validatedParamsSize = 0;
-            uint64_t batchDataSize = 0;
-            std::unique_ptr<void, void (*)(void*)> batchData{nullptr, std::free};
-            std::vector<Batch> batches;
         };
 
-        // First stage is grouping all batches into passes. We try to pack as many batches into a
-        // single pass as possible. Batches can be grouped together as long as they're validating
-        // data from the same indirect buffer, but they may still be split into multiple passes if
-        // the number of draw calls in a pass would exceed some (very high) upper bound.
-        uint64_t numTotalDrawCalls = 0;
-        size_t validatedParamsSize = 0;
-        std::vector<Pass> passes;
-        IndirectDrawMetadata::IndexedIndirectBufferValidationInfoMap& bufferInfoMap =
-            *indirectDrawMetadata->GetIndexedIndirectBufferValidationInfo();
-        if (bufferInfoMap.empty()) {
+        const std::vector<IndirectDrawMetadata::IndexedIndirectBufferValidationInfo>& bufferInfos =
+            indirectDrawMetadata->GetIndexedIndirectBufferValidationInfos();
+        if (bufferInfos.empty()) {
             return {};
         }
 
-        for (auto& entry : bufferInfoMap) {
-            const IndirectDrawMetadata::IndexedIndirectConfig& config = entry.first;
-            BufferBase* clientIndirectBuffer = config.first;
-            for (const IndirectDrawMetadata::IndexedIndirectValidationBatch& batch :
-                 entry.second.GetBatches()) {
-                const uint64_t minOffsetFromAlignedBoundary =
-                    batch.minOffset % kMinStorageBufferOffsetAlignment;
-                const uint64_t minOffsetAlignedDown =
-                    batch.minOffset - minOffsetFromAlignedBoundary;
-
-                Batch newBatch;
-                newBatch.metadata = &batch;
-                newBatch.numIndexBufferElements = config.second;
-                newBatch.dataSize = GetBatchDataSize(batch.draws.size());
-                newBatch.clientIndirectOffset = minOffsetAlignedDown;
-                newBatch.clientIndirectSize =
-                    batch.maxOffset + kDrawIndexedIndirectSize - minOffsetAlignedDown;
-                numTotalDrawCalls += batch.draws.size();
-
-                newBatch.validatedParamsSize = batch.draws.size() * kDrawIndexedIndirectSize;
-                newBatch.validatedParamsOffset =
-                    Align(validatedParamsSize, kMinStorageBufferOffsetAlignment);
-                validatedParamsSize = newBatch.validatedParamsOffset + newBatch.validatedParamsSize;
-                if (validatedParamsSize > kMaxStorageBufferBindingSize) {
-                    return DAWN_INTERNAL_ERROR("Too many drawIndexedIndirect calls to validate");
+        // First stage is grouping the draws into batches. All the draws using the same indirect
+        // buffer, including those from render bundles, are validated by a single batch unless
+        // their offsets span too much of the buffer or there are too many of them. In that rare
+        // case the draws are sorted by offset and split into as few batches as possible.
+        std::vector<Batch> batches;
+        std::vector<std::vector<IndexedIndirectDraw>> sortedDraws;
+        sortedDraws.reserve(bufferInfos.size());
+        for (const IndirectDrawMetadata::IndexedIndirectBufferValidationInfo& info : bufferInfos) {
+            Batch batch;
+            batch.clientIndirectBuffer = info.GetIndirectBuffer();
+
+            if (info.GetMaxOffset() - info.GetMinOffset() <= kMaxBatchOffsetRange &&
+                info.GetDrawCount() <= kMaxDrawCallsPerIndirectValidationBatch) {
+                batch.minOffset = info.GetMinOffset();
+                batch.maxOffset = info.GetMaxOffset();
+                batch.numDraws = static_cast<uint32_t>(info.GetDrawCount());
+                if (!info.GetDraws().empty()) {
+                    batch.draws.push_back({info.GetDraws().data(),
+                                           info.GetDraws().data() + info.GetDraws().size()});
+                }
+                for (const std::vector<IndexedIndirectDraw>* bundleDraws : info.GetBundleDraws()) {
+                    batch.draws.push_back(
+                        {bundleDraws->data(), bundleDraws->data() + bundleDraws->size()});
                 }
+                batches.push_back(std::move(batch));
+                continue;
+            }
 
-                Pass* currentPass = passes.empty() ? nullptr : &passes.back();
-                if (currentPass && currentPass->clientIndirectBuffer == clientIndirectBuffer) {
-                    uint64_t nextBatchDataOffset =
-                        Align(currentPass->batchDataSize, kMinStorageBufferOffsetAlignment);
-                    uint64_t newPassBatchDataSize = nextBatchDataOffset + newBatch.dataSize;
-                    if (newPassBatchDataSize <= kMaxStorageBufferBindingSize) {
-                        // We can fit this batch in the current pass.
-                        newBatch.dataBufferOffset = nextBatchDataOffset;
-                        currentPass->batchDataSize = newPassBatchDataSize;
-                        currentPass->batches.push_back(newBatch);
-                        continue;
-                    }
+            sortedDraws.emplace_back(info.GetDraws());
+            std::vector<IndexedIndirectDraw>& draws = sortedDraws.back();
+            for (const std::vector<IndexedIndirectDraw>* bundleDraws : info.GetBundleDraws()) {
+                draws.insert(draws.end(), bundleDraws->begin(), bundleDraws->end());
+            }
+            std::sort(draws.begin(), draws.end(),
+                      [](const IndexedIndirectDraw& a, const IndexedIndirectDraw& b) {
+                          return a.clientBufferOffset < b.clientBufferOffset;
+                      });
+
+            size_t batchBegin = 0;
+            for (size_t i = 0; i <= draws.size(); ++i) {
+                if (i < draws.size() &&
+                    draws[i].clientBufferOffset - draws[batchBegin].clientBufferOffset <=
+                        kMaxBatchOffsetRange &&
+                    i - batchBegin < kMaxDrawCallsPerIndirectValidationBatch) {
+                    continue;
                 }
 
-                // We need to start a new pass for this batch.
-                newBatch.dataBufferOffset = 0;
+                Batch splitBatch;
+                splitBatch.clientIndirectBuffer = info.GetIndirectBuffer();
+                splitBatch.minOffset = draws[batchBegin].clientBufferOffset;
+                splitBatch.maxOffset = draws[i - 1].clientBufferOffset;
+                splitBatch.numDraws = static_cast<uint32_t>(i - batchBegin);
+                splitBatch.draws.push_back({draws.data() + batchBegin, draws.data() + i});
+                batches.push_back(std::move(splitBatch));
+                batchBegin = i;
+            }
+        }
 
-                Pass newPass;
-                newPass.clientIndirectBuffer = clientIndirectBuffer;
-                newPass.batchDataSize = newBatch.dataSize;
-                newPass.batches.push_back(newBatch);
-                passes.push_back(std::move(newPass));
+        // All the batches share a single layout in the scratch buffers: the batch data is packed
+        // in one buffer so that it is uploaded with a single WriteBuffer, and the validated
+        // parameters of all the draws are packed in another.
+        uint64_t numTotalDrawCalls = 0;
+        uint64_t batchDataSize = 0;
+        uint64_t validatedParamsSize = 0;
+        for (Batch& batch : batches) {
+            const uint64_t minOffsetFromAlignedBoundary =
+                batch.minOffset % kMinStorageBufferOffsetAlignment;
+            batch.clientIndirectOffset = batch.minOffset - minOffsetFromAlignedBoundary;
+            batch.clientIndirectSize =
+                batch.maxOffset + kDrawIndexedIndirectSize - batch.clientIndirectOffset;
+            numTotalDrawCalls += batch.numDraws;
+
+            batch.dataSize = GetBatchDataSize(batch.numDraws);
+            batch.dataBufferOffset = Align(batchDataSize, kMinStorageBufferOffsetAlignment);
+            batchDataSize = batch.dataBufferOffset + batch.dataSize;
+
+            batch.validatedParamsSize = batch.numDraws * kDrawIndexedIndirectSize;
+            batch.validatedParamsOffset =
+                Align(validatedParamsSize, kMinStorageBufferOffsetAlignment);
+            validatedParamsSize = batch.validatedParamsOffset + batch.validatedParamsSize;
+            if (validatedParamsSize > kMaxStorageBufferBindingSize) {
+                return DAWN_INTERNAL_ERROR("Too many drawIndexedIndirect calls to validate");
             }
         }
 
@@ -288,39 +337,38 @@ namespace dawn_native {
         ScratchBuffer& validatedParamsBuffer = store->scratchIndirectStorage;
         ScratchBuffer& batchDataBuffer = store->scratchStorage;
 
-        uint64_t requiredBatchDataBufferSize = 0;
-        for (const Pass& pass : passes) {
-            requiredBatchDataBufferSize = std::max(requiredBatchDataBufferSize, pass.batchDataSize);
-        }
-        DAWN_TRY(batchDataBuffer.EnsureCapacity(requiredBatchDataBufferSize));
+        DAWN_TRY(batchDataBuffer.EnsureCapacity(batchDataSize));
         usageTracker->BufferUsedAs(batchDataBuffer.GetBuffer(), wgpu::BufferUsage::Storage);
 
         DAWN_TRY(validatedParamsBuffer.EnsureCapacity(validatedParamsSize));
         usageTracker->BufferUsedAs(validatedParamsBuffer.GetBuffer(), wgpu::BufferUsage::Indirect);
 
-        // Now we allocate and populate host-side batch data to be copied to the GPU, and prepare to
-        // update all DrawIndexedIndirectCmd buffer references.
+        // Now we populate the host-side batch data to be copied to the GPU, and prepare to update
+        // all DrawIndexedIndirectCmd buffer references. std::vector value-initializes its
+        // elements so the padding between batches is zeroed.
+        std::vector<uint8_t> batchData(batchDataSize);
         std::vector<DeferredBufferLocationUpdate> deferredBufferLocationUpdates;
         deferredBufferLocationUpdates.reserve(numTotalDrawCalls);
-        for (Pass& pass : passes) {
-            // We use std::malloc here because it guarantees maximal scalar alignment.
-            pass.batchData = {std::malloc(pass.batchDataSize), std::free};
-            memset(pass.batchData.get(), 0, pass.batchDataSize);
-            uint8_t* batchData = static_cast<uint8_t*>(pass.batchData.get());
-            for (Batch& batch : pass.batches) {
-                batch.batchInfo = new (&batchData[batch.dataBufferOffset]) BatchInfo();
-                batch.batchInfo->numIndexBufferElements = batch.numIndexBufferElements;
-                batch.batchInfo->numDraws = static_cast<uint32_t>(batch.metadata->draws.size());
-
-                uint32_t* indirectOffsets = reinterpret_cast<uint32_t*>(batch.batchInfo + 1);
-                uint64_t validatedParamsOffset = batch.validatedParamsOffset;
-                for (const auto& draw : batch.metadata->draws) {
-                    // The shader uses this to index an array of u32, hence the division by 4 bytes.
-                    *indirectOffsets++ = static_cast<uint32_t>(
-                        (draw.clientBufferOffset - batch.clientIndirectOffset) / 4);
+        for (const Batch& batch : batches) {
+            BatchInfo* batchInfo = reinterpret_cast<BatchInfo*>(&batchData[batch.dataBufferOffset]);
+            batchInfo->numDraws = batch.numDraws;
+
+            DrawInfo* drawInfo = reinterpret_cast<DrawInfo*>(batchInfo + 1);
+            uint64_t validatedParamsOffset = batch.validatedParamsOffset;
+            for (const DrawRange& range : batch.draws) {
+                for (const IndexedIndirectDraw* draw = range.begin; draw != range.end; ++draw) {
+                    // The shader uses this to index an array of u32, hence the division by 4
+                    // bytes.
+                    drawInfo->indirectOffset = static_cast<uint32_t>(
+                        (draw->clientBufferOffset - batch.clientIndirectOffset) / 4);
+                    drawInfo->numIndexBufferElementsLow =
+                        static_cast<uint32_t>(draw->numIndexBufferElements);
+                    drawInfo->numIndexBufferElementsHigh =
+                        static_cast<uint32_t>(draw->numIndexBufferElements >> 32);
+                    drawInfo++;
 
                     DeferredBufferLocationUpdate deferredUpdate;
-                    deferredUpdate.location = draw.bufferLocation;
+                    deferredUpdate.location = draw->bufferLocation;
                     deferredUpdate.buffer = validatedParamsBuffer.GetBuffer();
                     deferredUpdate.offset = validatedParamsOffset;
                     deferredBufferLocationUpdates.push_back(std::move(deferredUpdate));
@@ -353,44 +401,40 @@ namespace dawn_native {
         bindGroupDescriptor.entryCount = 3;
         bindGroupDescriptor.entries = bindings;
 
-        // Finally, we can now encode our validation passes. Each pass first does a single
-        // WriteBuffer to get batch data over to the GPU, followed by a single compute pass. The
-        // compute pass encodes a separate SetBindGroup and Dispatch command for each batch.
+        // Finally, we can now encode our validation commands: a single WriteBuffer to get all the
+        // batch data over to the GPU, followed by a single compute pass with a SetBindGroup and
+        // Dispatch command for each batch.
         commandEncoder->EncodeSetValidatedBufferLocationsInternal(
             std::move(deferredBufferLocationUpdates));
-        for (const Pass& pass : passes) {
-            commandEncoder->APIWriteBuffer(batchDataBuffer.GetBuffer(), 0,
-                                           static_cast<const uint8_t*>(pass.batchData.get()),
-                                           pass.batchDataSize);
-
-            // TODO(dawn:723): change to not use AcquireRef for reentrant object creation.
-            ComputePassDescriptor descriptor = {};
-            Ref<ComputePassEncoder> passEncoder =
-                AcquireRef(commandEncoder->APIBeginComputePass(&descriptor));
-            passEncoder->APISetPipeline(pipeline);
-
-            clientIndirectBinding.buffer = pass.clientIndirectBuffer;
-
-            for (const Batch& batch : pass.batches) {
-                bufferDataBinding.offset = batch.dataBufferOffset;
-                bufferDataBinding.size = batch.dataSize;
-                clientIndirectBinding.offset = batch.clientIndirectOffset;
-                clientIndirectBinding.size = batch.clientIndirectSize;
-                validatedParamsBinding.offset = batch.validatedParamsOffset;
-                validatedParamsBinding.size = batch.validatedParamsSize;
-
-                Ref<BindGroupBase> bindGroup;
-                DAWN_TRY_ASSIGN(bindGroup, device->CreateBindGroup(&bindGroupDescriptor));
-
-                const uint32_t numDrawsRoundedUp =
-                    (batch.batchInfo->numDraws + kWorkgroupSize - 1) / kWorkgroupSize;
-                passEncoder->APISetBindGroup(0, bindGroup.Get());
-                passEncoder->APIDispatch(numDrawsRoundedUp);
-            }
-
-            passEncoder->APIEndPass();
+        commandEncoder->APIWriteBuffer(batchDataBuffer.GetBuffer(), 0, batchData.data(),
+                                       batchDataSize);
+
+        // TODO(dawn:723): change to not use AcquireRef for reentrant object creation.
+        ComputePassDescriptor descriptor = {};
+        Ref<ComputePassEncoder> passEncoder =
+            AcquireRef(commandEncoder->APIBeginComputePass(&descriptor));
+        passEncoder->APISetPipeline(pipeline);
+
+        for (const Batch& batch : batches) {
+            bufferDataBinding.offset = batch.dataBufferOffset;
+            bufferDataBinding.size = batch.dataSize;
+            clientIndirectBinding.buffer = batch.clientIndirectBuffer;
+            clientIndirectBinding.offset = batch.clientIndirectOffset;
+            clientIndirectBinding.size = batch.clientIndirectSize;
+            validatedParamsBinding.offset = batch.validatedParamsOffset;
+            validatedParamsBinding.size = batch.validatedParamsSize;
+
+            Ref<BindGroupBase> bindGroup;
+            DAWN_TRY_ASSIGN(bindGroup, device->CreateBindGroup(&bindGroupDescriptor));
+
+            const uint32_t numDrawsRoundedUp =
+                (batch.numDraws + kWorkgroupSize - 1) / kWorkgroupSize;
+            passEncoder->APISetBindGroup(0, bindGroup.Get());
+            passEncoder->APIDispatch(numDrawsRoundedUp);
         }
 
+        passEncoder->APIEndPass();
+
         return {};
     }
 
@@ -25,8 +25,8 @@ namespace dawn_native {
     class RenderPassResourceUsageTracker;
 
     // The maximum number of draws call we can fit into a single validation batch. This is
-    // essentially limited by the number of indirect parameter blocks that can fit into the maximum
-    // allowed storage binding size (about 6.7M).
+    // essentially limited by the maximum dispatch size (about 4.2M), since the per-draw data of a
+    // batch and its validated parameters fit into the maximum allowed storage binding size.
     extern const uint32_t kMaxDrawCallsPerIndirectValidationBatch;
 
     MaybeError EncodeIndirectDrawValidationCommands(DeviceBase* device,
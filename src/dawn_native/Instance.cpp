@@ -56,6 +56,9 @@ namespace dawn_native {
 
     // InstanceBase
 
+    InstanceBase::InstanceBase() : DispatchableObject(&GetProcs()) {
+    }
+
     // static
     InstanceBase* InstanceBase::Create(const InstanceDescriptor* descriptor) {
         Ref<InstanceBase> instance = AcquireRef(new InstanceBase);
@@ -238,6 +241,10 @@ namespace dawn_native {
         return mDefaultPlatform.get();
     }
 
+    std::string InstanceBase::DumpBuiltinTraceEvents() {
+        return GetPlatform()->DumpBuiltinTraceEvents();
+    }
+
     const XlibXcbFunctions* InstanceBase::GetOrCreateXlibXcbFunctions() {
 #if defined(DAWN_USE_X11)
         if (mXlibXcbFunctions == nullptr) {
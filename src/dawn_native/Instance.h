@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_INSTANCE_H_
 #define DAWNNATIVE_INSTANCE_H_
 
+#include "common/DispatchableObject.h"
 #include "common/RefCounted.h"
 #include "dawn_native/Adapter.h"
 #include "dawn_native/BackendConnection.h"
@@ -24,6 +25,7 @@
 
 #include <array>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -38,7 +40,7 @@ namespace dawn_native {
 
     // This is called InstanceBase for consistency across the frontend, even if the backends don't
     // specialize this class.
-    class InstanceBase final : public RefCounted {
+    class InstanceBase final : public DispatchableObject, public RefCounted {
       public:
         static InstanceBase* Create(const InstanceDescriptor* descriptor = nullptr);
 
@@ -71,6 +73,8 @@ namespace dawn_native {
         void SetPlatform(dawn_platform::Platform* platform);
         dawn_platform::Platform* GetPlatform();
 
+        std::string DumpBuiltinTraceEvents();
+
         // Get backend-independent libraries that need to be loaded dynamically.
         const XlibXcbFunctions* GetOrCreateXlibXcbFunctions();
 
@@ -78,7 +82,7 @@ namespace dawn_native {
         Surface* APICreateSurface(const SurfaceDescriptor* descriptor);
 
       private:
-        InstanceBase() = default;
+        InstanceBase();
         ~InstanceBase() = default;
 
         InstanceBase(const InstanceBase& other) = delete;
@@ -13,20 +13,25 @@
 // limitations under the License.
 
 #include "dawn_native/ObjectBase.h"
+
+#include "common/Math.h"
+#include "common/ThreadShard.h"
+#include "dawn_native/DawnNative.h"
 #include "dawn_native/Device.h"
 
-#include <mutex>
+#include <new>
 
 namespace dawn_native {
 
     static constexpr uint64_t kErrorPayload = 0;
     static constexpr uint64_t kNotErrorPayload = 1;
 
-    ObjectBase::ObjectBase(DeviceBase* device) : RefCounted(kNotErrorPayload), mDevice(device) {
+    ObjectBase::ObjectBase(DeviceBase* device)
+        : DispatchableObject(&GetProcs()), RefCounted(kNotErrorPayload), mDevice(device) {
     }
 
     ObjectBase::ObjectBase(DeviceBase* device, ErrorTag)
-        : RefCounted(kErrorPayload), mDevice(device) {
+        : DispatchableObject(&GetProcs()), RefCounted(kErrorPayload), mDevice(device) {
     }
 
     DeviceBase* ObjectBase::GetDevice() const {
@@ -49,13 +54,20 @@ namespace dawn_native {
         if (label) {
             mLabel = label;
         }
+        TrackInDevice();
     }
 
     ApiObjectBase::ApiObjectBase(DeviceBase* device, ErrorTag tag) : ObjectBase(device, tag) {
+        TrackInDevice();
     }
 
     ApiObjectBase::ApiObjectBase(DeviceBase* device, LabelNotImplementedTag tag)
         : ObjectBase(device) {
+        TrackInDevice();
+    }
+
+    ApiObjectBase::~ApiObjectBase() {
+        UntrackInDevice();
     }
 
     void ApiObjectBase::APISetLabel(const char* label) {
@@ -70,4 +82,71 @@ namespace dawn_native {
     void ApiObjectBase::SetLabelImpl() {
     }
 
+    void ApiObjectBase::DestroyOnDeviceShutDown() {
+    }
+
+    void ApiObjectBase::TrackAliveForStatistics() {
+        if (!mIsTrackedForStatistics.exchange(true, std::memory_order_relaxed)) {
+            GetDevice()->GetStatistics()->objectsAlive[GetType()].Increment();
+        }
+    }
+
+    void ApiObjectBase::TrackInDevice() {
+        GetDevice()->GetApiObjectList()->Track(this);
+    }
+
+    void ApiObjectBase::UntrackInDevice() {
+        if (mTrackingShard != kNotTracked && IsAlive()) {
+            GetDevice()->GetApiObjectList()->Untrack(this);
+        }
+    }
+
+    void ApiObjectBase::DeleteThis() {
+        if (mIsTrackedForStatistics.load(std::memory_order_relaxed) && IsAlive()) {
+            GetDevice()->GetStatistics()->objectsAlive[GetType()].Decrement();
+        }
+        ObjectBase::DeleteThis();
+    }
+
+    ApiObjectList::ApiObjectList()
+        : mShardStorage(new char[sizeof(Shard) * kShardCount + alignof(Shard)]),
+          mShards(reinterpret_cast<Shard*>(AlignPtr(mShardStorage.get(), alignof(Shard)))) {
+        for (uint32_t i = 0; i < kShardCount; ++i) {
+            new (&mShards[i]) Shard();
+        }
+    }
+
+    ApiObjectList::~ApiObjectList() {
+        // Detach the objects still alive, so that they don't try to remove themselves from the
+        // list when they are released.
+        for (uint32_t i = 0; i < kShardCount; ++i) {
+            Shard& shard = mShards[i];
+            while (!shard.objects.empty()) {
+                LinkNode<ApiObjectBase>* node = shard.objects.head();
+                node->value()->mTrackingShard = ApiObjectBase::kNotTracked;
+                node->RemoveFromList();
+            }
+            shard.~Shard();
+        }
+    }
+
+    void ApiObjectList::Track(ApiObjectBase* object) {
+        ASSERT(object->mTrackingShard == ApiObjectBase::kNotTracked);
+        uint32_t shardIndex = GetThreadShardIndex() % kShardCount;
+        object->mTrackingShard = shardIndex;
+
+        Shard& shard = mShards[shardIndex];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.objects.Append(object);
+    }
+
+    void ApiObjectList::Untrack(ApiObjectBase* object) {
+        ASSERT(object->mTrackingShard < kShardCount);
+        Shard& shard = mShards[object->mTrackingShard];
+        object->mTrackingShard = ApiObjectBase::kNotTracked;
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        object->RemoveFromList();
+    }
+
 }  // namespace dawn_native
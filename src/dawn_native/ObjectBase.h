@@ -15,17 +15,22 @@
 #ifndef DAWNNATIVE_OBJECTBASE_H_
 #define DAWNNATIVE_OBJECTBASE_H_
 
+#include "common/DispatchableObject.h"
 #include "common/LinkedList.h"
+#include "common/NonCopyable.h"
 #include "common/RefCounted.h"
 #include "dawn_native/Forward.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace dawn_native {
 
     class DeviceBase;
 
-    class ObjectBase : public RefCounted {
+    class ObjectBase : public DispatchableObject, public RefCounted {
       public:
         struct ErrorTag {};
         static constexpr ErrorTag kError = {};
@@ -52,6 +57,10 @@ namespace dawn_native {
         ApiObjectBase(DeviceBase* device, LabelNotImplementedTag tag);
         ApiObjectBase(DeviceBase* device, const char* label);
         ApiObjectBase(DeviceBase* device, ErrorTag tag);
+        // Removes the object from the device's list. This is done in the destructor rather than
+        // in DeleteThis so that objects that aren't reference counted, like the blueprints used
+        // for cache lookups on the stack, are removed as well.
+        ~ApiObjectBase() override;
 
         virtual ObjectType GetType() const = 0;
         const std::string& GetLabel() const;
@@ -59,12 +68,84 @@ namespace dawn_native {
         // Dawn API
         void APISetLabel(const char* label);
 
+        // Releases the backend resources of the object when its device is shut down while the
+        // object is still alive, so that they are returned to the backend before it is destroyed.
+        // Called once, after the GPU is idle, by DeviceBase::ShutDownBase.
+        virtual void DestroyOnDeviceShutDown();
+
+        // Counts this object in the device's statistics of objects alive until it is deleted.
+        // Called when the object is returned to the application. Idempotent so that objects
+        // returned multiple times, like cached objects, are counted once.
+        void TrackAliveForStatistics();
+
+      protected:
+        void DeleteThis() override;
+
       private:
         virtual void SetLabelImpl();
 
+        void TrackInDevice();
+        void UntrackInDevice();
+
+        friend class ApiObjectList;
+
         std::string mLabel;
+        std::atomic<bool> mIsTrackedForStatistics{false};
+
+        // The shard of the device's ApiObjectList this object is in, or kNotTracked.
+        static constexpr uint32_t kNotTracked = ~uint32_t(0);
+        uint32_t mTrackingShard = kNotTracked;
+    };
+
+    // ApiObjectList tracks the live API objects of a device so that all of them can be reached
+    // when the device is destroyed. Objects are created and released on many threads so instead
+    // of a single list behind a single mutex, they are spread over shards that each have their
+    // own lock. Each thread inserts objects in the shard assigned to it, so object creation on
+    // different threads doesn't contend unless there are more threads than shards. Objects are
+    // removed from the shard they were inserted in, whichever thread releases them.
+    class ApiObjectList : NonCopyable {
+      public:
+        ApiObjectList();
+        ~ApiObjectList();
+
+        void Track(ApiObjectBase* object);
+        void Untrack(ApiObjectBase* object);
+
+        // Calls |func| on every tracked object, locking each shard in turn. Objects are tracked
+        // before their construction completes and untracked after their destruction started, so
+        // this must only be used when no other thread creates or releases objects, like during
+        // the destruction of the device. |func| must not create or release objects of the device.
+        template <typename F>
+        void ForEach(F&& func);
+
+      private:
+        static constexpr uint32_t kShardCount = 16;
+
+        // Each shard is on its own cache line so that threads locking different shards don't
+        // contend on the same line.
+        struct alignas(64) Shard {
+            std::mutex mutex;
+            LinkedList<ApiObjectBase> objects;
+        };
+
+        // The shards are constructed in a buffer aligned by hand because new doesn't honor the
+        // alignment of over-aligned types before C++17.
+        std::unique_ptr<char[]> mShardStorage;
+        Shard* mShards;
     };
 
+    template <typename F>
+    void ApiObjectList::ForEach(F&& func) {
+        for (uint32_t i = 0; i < kShardCount; ++i) {
+            Shard& shard = mShards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (LinkNode<ApiObjectBase>* node = shard.objects.head(); node != shard.objects.end();
+                 node = node->next()) {
+                func(node->value());
+            }
+        }
+    }
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_OBJECTBASE_H_
@@ -0,0 +1,309 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/ObjectPool.h"
+
+#include "common/Assert.h"
+#include "common/Math.h"
+#include "common/ThreadShard.h"
+#include "dawn_native/Device.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <new>
+
+namespace dawn_native {
+
+    namespace {
+
+        // Objects are aligned like the default operator new does.
+        constexpr size_t kBlockAlignment = alignof(std::max_align_t);
+
+        // Slabs are sized to hold a few dozen objects, which is enough to amortize the slab
+        // allocation while not reserving too much memory for types that are rarely used.
+        constexpr size_t kTargetSlabSize = 16 * 1024;
+
+        // Each size class has a few thread caches, and threads are spread over them like over
+        // the shards of ApiObjectList, so that a cache is usually used by a single thread.
+        constexpr uint32_t kThreadCacheCount = 8;
+        // The maximum number of blocks in a thread cache. When it is full, its oldest half is
+        // returned to the slabs at once, to amortize locking the TypePool.
+        constexpr uint32_t kThreadCacheSize = 16;
+
+        // When returning blocks leaves more than kMaxEmptySlabs slabs of a size class empty,
+        // they are freed down to kEmptySlabsKept. A few empty slabs are kept so that objects
+        // created and deleted in bursts, like each frame, don't allocate slabs each time.
+        constexpr size_t kMaxEmptySlabs = 2;
+        constexpr size_t kEmptySlabsKept = 1;
+
+    }  // anonymous namespace
+
+    struct DeviceObjectPool::SizeClass {
+        SizeClass(DeviceObjectPool* pool, std::mutex* mutex, size_t size, size_t blockSize)
+            : pool(pool),
+              mutex(mutex),
+              size(size),
+              allocator(static_cast<SlabAllocatorImpl::Index>(
+                            std::min(std::max(kTargetSlabSize / blockSize, size_t(1)),
+                                     size_t(std::numeric_limits<SlabAllocatorImpl::Index>::max() -
+                                            1))),
+                        static_cast<uint32_t>(blockSize),
+                        kBlockAlignment),
+              threadCacheStorage(
+                  new char[sizeof(ThreadCache) * kThreadCacheCount + alignof(ThreadCache)]),
+              threadCaches(reinterpret_cast<ThreadCache*>(
+                  AlignPtr(threadCacheStorage.get(), alignof(ThreadCache)))) {
+            for (uint32_t i = 0; i < kThreadCacheCount; ++i) {
+                new (&threadCaches[i]) ThreadCache();
+            }
+        }
+
+        ~SizeClass() {
+            for (uint32_t i = 0; i < kThreadCacheCount; ++i) {
+                ASSERT(threadCaches[i].blockCount == 0);
+                threadCaches[i].~ThreadCache();
+            }
+        }
+
+        // Each cache is on its own cache line so that threads using different caches don't
+        // contend on the same line.
+        struct alignas(64) ThreadCache {
+            std::mutex mutex;
+            uint32_t blockCount = 0;
+            void* blocks[kThreadCacheSize];
+        };
+
+        ThreadCache* GetThreadCache() {
+            return &threadCaches[GetThreadShardIndex() % kThreadCacheCount];
+        }
+
+        // Removes all the blocks of |cache| and copies them to |blocks|. Returns their number.
+        static uint32_t TakeCachedBlocks(ThreadCache* cache, void** blocks) {
+            std::lock_guard<std::mutex> lock(cache->mutex);
+            uint32_t blockCount = cache->blockCount;
+            std::copy(cache->blocks, cache->blocks + blockCount, blocks);
+            cache->blockCount = 0;
+            return blockCount;
+        }
+
+        // Returns blocks to the slabs. |mutex| must be held.
+        void DeallocateBlocks(void* const* blocks, uint32_t blockCount) {
+            for (uint32_t i = 0; i < blockCount; ++i) {
+                allocator.Deallocate(blocks[i]);
+            }
+        }
+
+        DeviceObjectPool* pool;
+        // The mutex of the TypePool this size class is part of, protecting |allocator|.
+        std::mutex* mutex;
+        size_t size;
+        // The next size class of the TypePool. Immutable once the size class is published.
+        SizeClass* next = nullptr;
+        UntypedSlabAllocator allocator;
+
+        std::unique_ptr<char[]> threadCacheStorage;
+        ThreadCache* threadCaches;
+    };
+
+    namespace {
+
+        // The header written before each object to find the SizeClass it was allocated from.
+        struct BlockHeader {
+            void* sizeClass;
+        };
+        constexpr size_t kHeaderSize = kBlockAlignment;
+        static_assert(sizeof(BlockHeader) <= kHeaderSize, "");
+
+        BlockHeader* HeaderFromObject(void* object) {
+            return reinterpret_cast<BlockHeader*>(static_cast<char*>(object) - kHeaderSize);
+        }
+
+    }  // anonymous namespace
+
+    DeviceObjectPool::DeviceObjectPool() = default;
+
+    DeviceObjectPool::~DeviceObjectPool() {
+        // All the objects are deleted since each of them holds a reference on the pool, but
+        // their blocks might still be in the thread caches.
+        Trim();
+
+        for (TypePool& typePool : mTypePools) {
+            SizeClass* sizeClass = typePool.sizeClasses.load(std::memory_order_acquire);
+            while (sizeClass != nullptr) {
+                ASSERT(sizeClass->allocator.GetBlocksInUse() == 0);
+                SizeClass* next = sizeClass->next;
+                delete sizeClass;
+                sizeClass = next;
+            }
+        }
+    }
+
+    DeviceObjectPool::SizeClass* DeviceObjectPool::GetOrCreateSizeClass(TypePool* typePool,
+                                                                        size_t size) {
+        // There is usually a single size class per type, for the backend object.
+        for (SizeClass* sizeClass = typePool->sizeClasses.load(std::memory_order_acquire);
+             sizeClass != nullptr; sizeClass = sizeClass->next) {
+            if (sizeClass->size == size) {
+                return sizeClass;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(typePool->mutex);
+
+        // Another thread might have created the size class while the lock wasn't held.
+        SizeClass* head = typePool->sizeClasses.load(std::memory_order_relaxed);
+        for (SizeClass* sizeClass = head; sizeClass != nullptr; sizeClass = sizeClass->next) {
+            if (sizeClass->size == size) {
+                return sizeClass;
+            }
+        }
+
+        size_t blockSize = kHeaderSize + Align(size, kBlockAlignment);
+        SizeClass* sizeClass = new SizeClass(this, &typePool->mutex, size, blockSize);
+        sizeClass->next = head;
+        typePool->sizeClasses.store(sizeClass, std::memory_order_release);
+        return sizeClass;
+    }
+
+    void* DeviceObjectPool::Allocate(ObjectType type, size_t size) {
+        SizeClass* sizeClass = GetOrCreateSizeClass(&mTypePools[type], size);
+
+        // Reuse the block of the last object deleted on this thread if possible. Cached blocks
+        // already have their header.
+        void* block = nullptr;
+        SizeClass::ThreadCache* cache = sizeClass->GetThreadCache();
+        {
+            std::lock_guard<std::mutex> lock(cache->mutex);
+            if (cache->blockCount > 0) {
+                block = cache->blocks[--cache->blockCount];
+            }
+        }
+
+        if (block == nullptr) {
+            std::lock_guard<std::mutex> lock(*sizeClass->mutex);
+            block = sizeClass->allocator.Allocate();
+            static_cast<BlockHeader*>(block)->sizeClass = sizeClass;
+        }
+
+        // Keep the pool alive while any of its memory is in use.
+        Reference();
+        return static_cast<char*>(block) + kHeaderSize;
+    }
+
+    // static
+    void DeviceObjectPool::Deallocate(void* object) {
+        if (object == nullptr) {
+            return;
+        }
+
+        BlockHeader* header = HeaderFromObject(object);
+        SizeClass* sizeClass = static_cast<SizeClass*>(header->sizeClass);
+        DeviceObjectPool* pool = sizeClass->pool;
+
+        // Keep the block in the thread cache. If it is full, make room by taking its oldest
+        // half, which is the least likely to still be in the CPU caches.
+        constexpr uint32_t kReturnedBlockCount = kThreadCacheSize / 2;
+        void* returnedBlocks[kReturnedBlockCount];
+        bool cacheWasFull = false;
+
+        SizeClass::ThreadCache* cache = sizeClass->GetThreadCache();
+        {
+            std::lock_guard<std::mutex> lock(cache->mutex);
+            if (cache->blockCount == kThreadCacheSize) {
+                cacheWasFull = true;
+                std::copy(cache->blocks, cache->blocks + kReturnedBlockCount, returnedBlocks);
+                std::copy(cache->blocks + kReturnedBlockCount, cache->blocks + kThreadCacheSize,
+                          cache->blocks);
+                cache->blockCount -= kReturnedBlockCount;
+            }
+            cache->blocks[cache->blockCount++] = header;
+        }
+
+        if (cacheWasFull) {
+            std::lock_guard<std::mutex> lock(*sizeClass->mutex);
+            sizeClass->DeallocateBlocks(returnedBlocks, kReturnedBlockCount);
+            if (sizeClass->allocator.GetEmptySlabCount() > kMaxEmptySlabs) {
+                sizeClass->allocator.ReleaseEmptySlabs(kEmptySlabsKept);
+            }
+        }
+
+        // This might delete the pool if the device is already destroyed.
+        pool->Release();
+    }
+
+    void DeviceObjectPool::Trim() {
+        for (TypePool& typePool : mTypePools) {
+            for (SizeClass* sizeClass = typePool.sizeClasses.load(std::memory_order_acquire);
+                 sizeClass != nullptr; sizeClass = sizeClass->next) {
+                for (uint32_t i = 0; i < kThreadCacheCount; ++i) {
+                    void* blocks[kThreadCacheSize];
+                    uint32_t blockCount =
+                        SizeClass::TakeCachedBlocks(&sizeClass->threadCaches[i], blocks);
+
+                    std::lock_guard<std::mutex> lock(*sizeClass->mutex);
+                    sizeClass->DeallocateBlocks(blocks, blockCount);
+                }
+
+                std::lock_guard<std::mutex> lock(*sizeClass->mutex);
+                sizeClass->allocator.ReleaseEmptySlabs(0);
+            }
+        }
+    }
+
+    ObjectPoolStatistics DeviceObjectPool::GetStatistics(ObjectType type) {
+        TypePool* typePool = &mTypePools[type];
+
+        ObjectPoolStatistics statistics;
+        for (SizeClass* sizeClass = typePool->sizeClasses.load(std::memory_order_acquire);
+             sizeClass != nullptr; sizeClass = sizeClass->next) {
+            // The thread caches are never locked before the TypePool, so they can be locked
+            // while holding it to keep the slabs consistent with the caches.
+            std::lock_guard<std::mutex> lock(typePool->mutex);
+
+            uint64_t cachedBlocks = 0;
+            for (uint32_t i = 0; i < kThreadCacheCount; ++i) {
+                SizeClass::ThreadCache* cache = &sizeClass->threadCaches[i];
+                std::lock_guard<std::mutex> cacheLock(cache->mutex);
+                cachedBlocks += cache->blockCount;
+            }
+
+            // Cached blocks are in use from the point of view of the slabs. A block can be
+            // counted in two caches if it moves between them while they are read.
+            uint64_t blocksInUse = sizeClass->allocator.GetBlocksInUse();
+            statistics.objectsInUse += blocksInUse - std::min(blocksInUse, cachedBlocks);
+            statistics.cachedBlocks += cachedBlocks;
+            statistics.slabCount += sizeClass->allocator.GetSlabCount();
+            statistics.reservedBytes += sizeClass->allocator.GetReservedBytes();
+        }
+        return statistics;
+    }
+
+    ObjectPoolStatistics DeviceObjectPool::GetTotalStatistics() {
+        ObjectPoolStatistics total;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(mTypePools.size()); ++i) {
+            ObjectPoolStatistics statistics = GetStatistics(static_cast<ObjectType>(i));
+            total.objectsInUse += statistics.objectsInUse;
+            total.cachedBlocks += statistics.cachedBlocks;
+            total.slabCount += statistics.slabCount;
+            total.reservedBytes += statistics.reservedBytes;
+        }
+        return total;
+    }
+
+    void* AllocateFromDeviceObjectPool(DeviceBase* device, ObjectType type, size_t size) {
+        return device->GetObjectPool()->Allocate(type, size);
+    }
+
+}  // namespace dawn_native
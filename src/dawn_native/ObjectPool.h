@@ -0,0 +1,112 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_OBJECTPOOL_H_
+#define DAWNNATIVE_OBJECTPOOL_H_
+
+#include "common/RefCounted.h"
+#include "common/SlabAllocator.h"
+#include "dawn_native/ObjectType_autogen.h"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+namespace dawn_native {
+
+    class DeviceBase;
+
+    struct ObjectPoolStatistics {
+        uint64_t objectsInUse = 0;
+        // Blocks of deleted objects kept in the thread caches for the next allocations.
+        uint64_t cachedBlocks = 0;
+        uint64_t slabCount = 0;
+        uint64_t reservedBytes = 0;
+    };
+
+    // DeviceObjectPool hosts the memory of the frontend objects of a device that are created and
+    // destroyed at a high rate, for example a texture view or command buffer per frame. Objects of
+    // each ObjectType are allocated from their own SlabAllocators so that allocation is mostly an
+    // index lookup in memory that is already hot, instead of a trip through the global heap.
+    //
+    // The objects of a type are all of the same backend class, except error objects, so memory is
+    // allocated from a slab for each distinct size requested for the type.
+    //
+    // The slabs of a type are protected by a lock, so the blocks of deleted objects are first
+    // kept in per-thread caches, from which the next objects of the same size created on the
+    // thread are allocated without touching the slabs. When a cache is full, half of it is
+    // returned to the slabs at once, and the slabs that are left empty are freed if there are
+    // more than a couple of them. Trim returns all the cached blocks and frees all the empty
+    // slabs.
+    //
+    // Each block is prefixed by a header pointing to the slab allocator it comes from, so objects
+    // can be deallocated without knowing their device. Every allocation also holds a reference on
+    // the pool so that the memory stays valid even if the device is destroyed first.
+    class DeviceObjectPool final : public RefCounted {
+      public:
+        DeviceObjectPool();
+
+        void* Allocate(ObjectType type, size_t size);
+        static void Deallocate(void* object);
+
+        // Returns the blocks of the thread caches to the slabs and frees the empty slabs.
+        void Trim();
+
+        // The statistics are approximate while objects are created or deleted concurrently.
+        ObjectPoolStatistics GetStatistics(ObjectType type);
+        ObjectPoolStatistics GetTotalStatistics();
+
+      private:
+        ~DeviceObjectPool() override;
+
+        struct SizeClass;
+        struct TypePool {
+            // Protects the slabs of the size classes and the creation of size classes.
+            std::mutex mutex;
+            // A list of the size classes of the type, newest first. Size classes are never
+            // removed so the list is read without |mutex|.
+            std::atomic<SizeClass*> sizeClasses{nullptr};
+        };
+
+        SizeClass* GetOrCreateSizeClass(TypePool* typePool, size_t size);
+
+        PerObjectType<TypePool> mTypePools;
+    };
+
+    void* AllocateFromDeviceObjectPool(DeviceBase* device, ObjectType type, size_t size);
+
+    // Base class for the frontend objects allocated from their device's DeviceObjectPool. They
+    // must be created with `new (device) Object(...)` and are freed by their usual `delete this`.
+    template <ObjectType Type>
+    class DevicePoolAllocated {
+      public:
+        void* operator new(size_t) = delete;
+
+        void* operator new(size_t size, DeviceBase* device) {
+            return AllocateFromDeviceObjectPool(device, Type, size);
+        }
+
+        void operator delete(void* object) {
+            DeviceObjectPool::Deallocate(object);
+        }
+
+        // Matches operator new(size_t, DeviceBase*), called if a constructor throws.
+        void operator delete(void* object, DeviceBase*) {
+            DeviceObjectPool::Deallocate(object);
+        }
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_OBJECTPOOL_H_
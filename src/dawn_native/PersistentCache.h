@@ -35,7 +35,7 @@ namespace dawn_native {
 
     class DeviceBase;
 
-    enum class PersistentKeyType { Shader };
+    enum class PersistentKeyType { Shader, VulkanPipelineCache };
 
     // This class should always be thread-safe as it is used in Create*PipelineAsync() where it is
     // called asynchronously.
@@ -75,11 +75,12 @@ namespace dawn_native {
             return std::move(blob);
         }
 
-      private:
-        // PersistentCache impl
+        // Direct load/store operations, for blobs that are updated after they are first loaded.
+        // An empty blob is returned if there is no entry for |key|.
         ScopedCachedBlob LoadData(const PersistentCacheKey& key);
         void StoreData(const PersistentCacheKey& key, const void* value, size_t size);
 
+      private:
         dawn_platform::CachingInterface* GetPlatformCache();
 
         DeviceBase* mDevice = nullptr;
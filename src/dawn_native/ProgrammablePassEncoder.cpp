@@ -187,6 +187,7 @@ namespace dawn_native {
         SetBindGroupCmd* cmd = allocator->Allocate<SetBindGroupCmd>(Command::SetBindGroup);
         cmd->index = index;
         cmd->group = group;
+        allocator->RetainObject(group);
         cmd->dynamicOffsetCount = dynamicOffsetCount;
         if (dynamicOffsetCount > 0) {
             uint32_t* offsets = allocator->AllocateData<uint32_t>(cmd->dynamicOffsetCount);
@@ -163,6 +163,10 @@ namespace dawn_native {
         DestroyInternal();
     }
 
+    void QuerySetBase::DestroyOnDeviceShutDown() {
+        DestroyInternal();
+    }
+
     MaybeError QuerySetBase::ValidateDestroy() const {
         DAWN_TRY(GetDevice()->ValidateObject(this));
         return {};
@@ -32,6 +32,7 @@ namespace dawn_native {
         static QuerySetBase* MakeError(DeviceBase* device);
 
         ObjectType GetType() const override;
+        void DestroyOnDeviceShutDown() override;
 
         wgpu::QueryType GetQueryType() const;
         uint32_t GetQueryCount() const;
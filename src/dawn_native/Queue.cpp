@@ -480,23 +480,24 @@ namespace dawn_native {
         return {};
     }
 
-    void QueueBase::SubmitInternal(uint32_t commandCount, CommandBufferBase* const* commands) {
+    bool QueueBase::SubmitInternal(uint32_t commandCount, CommandBufferBase* const* commands) {
         DeviceBase* device = GetDevice();
         if (device->ConsumedError(device->ValidateIsAlive())) {
             // If device is lost, don't let any commands be submitted
-            return;
+            return false;
         }
 
         TRACE_EVENT0(device->GetPlatform(), General, "Queue::Submit");
         if (device->IsValidationEnabled() &&
             device->ConsumedError(ValidateSubmit(commandCount, commands))) {
-            return;
+            return false;
         }
         ASSERT(!IsError());
 
         if (device->ConsumedError(SubmitImpl(commandCount, commands))) {
-            return;
+            return false;
         }
+        return true;
     }
 
 }  // namespace dawn_native
@@ -62,6 +62,10 @@ namespace dawn_native {
                                uint64_t bufferOffset,
                                const void* data,
                                size_t size);
+        // Returns false if the commands weren't submitted because of an error, which is reported
+        // on the device.
+        bool SubmitInternal(uint32_t commandCount, CommandBufferBase* const* commands);
+
         void TrackTask(std::unique_ptr<TaskInFlight> task, ExecutionSerial serial);
         void Tick(ExecutionSerial finishedSerial);
         void HandleDeviceLoss();
@@ -100,8 +104,6 @@ namespace dawn_native {
                                         const TextureDataLayout& dataLayout,
                                         const Extent3D* writeSize) const;
 
-        void SubmitInternal(uint32_t commandCount, CommandBufferBase* const* commands);
-
         SerialQueue<ExecutionSerial, std::unique_ptr<TaskInFlight>> mTasksInFlight;
     };
 
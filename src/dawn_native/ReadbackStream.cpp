@@ -0,0 +1,194 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/ReadbackStream.h"
+
+#include "common/Math.h"
+#include "dawn_native/Buffer.h"
+#include "dawn_native/CommandBuffer.h"
+#include "dawn_native/CommandEncoder.h"
+#include "dawn_native/CommandValidation.h"
+#include "dawn_native/Device.h"
+#include "dawn_native/Queue.h"
+
+#include <algorithm>
+
+namespace dawn_native {
+
+    ReadbackStreamBase::ReadbackStreamBase(DeviceBase* device,
+                                           const ReadbackStreamDescriptor* descriptor,
+                                           ReadbackCallback callback,
+                                           void* userdata)
+        : mDevice(device),
+          mCallback(callback),
+          mUserdata(userdata),
+          mChunkSize(Align(descriptor->chunkSize, 4)) {
+        BufferDescriptor bufferDesc = {};
+        bufferDesc.size = mChunkSize;
+        bufferDesc.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+
+        mChunks.resize(descriptor->chunkCount);
+        mFreeChunks.reserve(descriptor->chunkCount);
+        mPendingChunks.reserve(descriptor->chunkCount);
+        for (uint32_t i = 0; i < descriptor->chunkCount; ++i) {
+            Chunk& chunk = mChunks[i];
+            chunk.stream = this;
+            chunk.index = i;
+
+            // Chunks that fail to allocate are never used. The error is reported on the device.
+            if (mDevice->ConsumedError(mDevice->CreateBuffer(&bufferDesc), &chunk.buffer)) {
+                continue;
+            }
+            mFreeChunks.push_back(i);
+        }
+    }
+
+    ReadbackStreamBase::~ReadbackStreamBase() {
+        // Cancel the readbacks in the order their copies were enqueued: first the flushed ones,
+        // in the order they were mapped, then the ones that weren't flushed. Destroying a buffer
+        // cancels its map request, which calls CompleteChunk synchronously.
+        std::deque<uint32_t> inFlightChunks = mInFlightChunks;
+        for (uint32_t index : inFlightChunks) {
+            mChunks[index].buffer->APIDestroy();
+        }
+        ASSERT(mInFlightChunks.empty());
+
+        // The copies that weren't flushed are dropped with their encoder.
+        for (uint32_t index : mPendingChunks) {
+            const Chunk& chunk = mChunks[index];
+            mCallback(WGPUBufferMapAsyncStatus_DestroyedBeforeCallback, nullptr, chunk.size,
+                      chunk.tag, mUserdata);
+        }
+        mPendingChunks.clear();
+        mPendingEncoder = nullptr;
+
+        for (Chunk& chunk : mChunks) {
+            if (chunk.buffer != nullptr) {
+                chunk.buffer->APIDestroy();
+            }
+        }
+    }
+
+    bool ReadbackStreamBase::EnqueueCopy(BufferBase* buffer,
+                                         uint64_t offset,
+                                         uint64_t size,
+                                         uint64_t tag) {
+        if (size == 0 || size > mChunkSize || mFreeChunks.empty()) {
+            return false;
+        }
+
+        // Invalid copies are rejected here, otherwise they would make the whole batch fail in
+        // Flush.
+        if (mDevice->IsValidationEnabled() &&
+            mDevice->ConsumedError(ValidateCopy(buffer, offset, size),
+                                   "validating ReadbackStream::EnqueueCopy(%s, %u, %u).", buffer,
+                                   offset, size)) {
+            return false;
+        }
+
+        if (mPendingEncoder == nullptr) {
+            CommandEncoderDescriptor encoderDesc = {};
+            mPendingEncoder = AcquireRef(mDevice->APICreateCommandEncoder(&encoderDesc));
+        }
+
+        uint32_t index = mFreeChunks.back();
+        mFreeChunks.pop_back();
+
+        Chunk& chunk = mChunks[index];
+        chunk.size = size;
+        chunk.tag = tag;
+        mPendingEncoder->APICopyBufferToBuffer(buffer, offset, chunk.buffer.Get(), 0, size);
+        mPendingChunks.push_back(index);
+        return true;
+    }
+
+    void ReadbackStreamBase::Flush() {
+        if (mPendingChunks.empty()) {
+            return;
+        }
+
+        Ref<CommandBufferBase> commandBuffer = AcquireRef(mPendingEncoder->APIFinish());
+        mPendingEncoder = nullptr;
+
+        // The copies can still fail if a source buffer was destroyed or mapped since it was
+        // enqueued. The error is reported on the device by the encoder or the queue.
+        bool submitted = false;
+        if (!commandBuffer->IsError()) {
+            CommandBufferBase* commands = commandBuffer.Get();
+            submitted = mDevice->GetQueue()->SubmitInternal(1, &commands);
+        }
+
+        // The map requests complete in the order they are made, after the copies are done. The
+        // chunks of a failed submit are still mapped so that their callbacks are called in order.
+        // A map request that fails validation calls its callback immediately, so the chunk must
+        // be marked as in flight before.
+        for (uint32_t index : mPendingChunks) {
+            Chunk& chunk = mChunks[index];
+            chunk.inFlight = true;
+            mInFlightChunks.push_back(index);
+            chunk.copyFailed = !submitted;
+            chunk.buffer->APIMapAsync(wgpu::MapMode::Read, 0, chunk.size, OnChunkMapped, &chunk);
+        }
+        mPendingChunks.clear();
+    }
+
+    MaybeError ReadbackStreamBase::ValidateCopy(BufferBase* buffer,
+                                                uint64_t offset,
+                                                uint64_t size) const {
+        DAWN_TRY(mDevice->ValidateObject(buffer));
+        DAWN_TRY(ValidateCopySizeFitsInBuffer(buffer, offset, size));
+        DAWN_INVALID_IF(offset % 4 != 0 || size % 4 != 0,
+                        "Offset (%u) or size (%u) is not a multiple of 4 bytes.", offset, size);
+        DAWN_TRY(ValidateCanUseAs(buffer, wgpu::BufferUsage::CopySrc));
+        DAWN_TRY(buffer->ValidateCanUseOnQueueNow());
+        return {};
+    }
+
+    uint32_t ReadbackStreamBase::GetFreeChunkCount() const {
+        return static_cast<uint32_t>(mFreeChunks.size());
+    }
+
+    // static
+    void ReadbackStreamBase::OnChunkMapped(WGPUBufferMapAsyncStatus status, void* userdata) {
+        Chunk* chunk = static_cast<Chunk*>(userdata);
+        chunk->stream->CompleteChunk(chunk, status);
+    }
+
+    void ReadbackStreamBase::CompleteChunk(Chunk* chunk, WGPUBufferMapAsyncStatus status) {
+        ASSERT(chunk->inFlight);
+        chunk->inFlight = false;
+        auto it = std::find(mInFlightChunks.begin(), mInFlightChunks.end(), chunk->index);
+        ASSERT(it != mInFlightChunks.end());
+        mInFlightChunks.erase(it);
+
+        if (chunk->copyFailed) {
+            chunk->copyFailed = false;
+            if (status == WGPUBufferMapAsyncStatus_Success) {
+                chunk->buffer->APIUnmap();
+                status = WGPUBufferMapAsyncStatus_Error;
+            }
+            mCallback(status, nullptr, chunk->size, chunk->tag, mUserdata);
+        } else if (status == WGPUBufferMapAsyncStatus_Success) {
+            const void* data = chunk->buffer->APIGetConstMappedRange(0, chunk->size);
+            mCallback(status, data, chunk->size, chunk->tag, mUserdata);
+            chunk->buffer->APIUnmap();
+        } else {
+            // The buffer is already unmapped, or can't be used anymore if the device is lost.
+            mCallback(status, nullptr, chunk->size, chunk->tag, mUserdata);
+        }
+
+        mFreeChunks.push_back(chunk->index);
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,84 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_READBACKSTREAM_H_
+#define DAWNNATIVE_READBACKSTREAM_H_
+
+#include "common/RefCounted.h"
+#include "dawn_native/DawnNative.h"
+#include "dawn_native/Error.h"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace dawn_native {
+
+    class BufferBase;
+    class CommandEncoder;
+    class DeviceBase;
+
+    // The implementation of dawn_native::ReadbackStream. Each chunk is a MapRead staging buffer
+    // that cycles between being free, being the destination of a pending copy, and being mapped
+    // for reading. Chunks are only allocated when the stream is created.
+    class ReadbackStreamBase {
+      public:
+        ReadbackStreamBase(DeviceBase* device,
+                           const ReadbackStreamDescriptor* descriptor,
+                           ReadbackCallback callback,
+                           void* userdata);
+        ~ReadbackStreamBase();
+
+        bool EnqueueCopy(BufferBase* buffer, uint64_t offset, uint64_t size, uint64_t tag);
+        void Flush();
+        uint32_t GetFreeChunkCount() const;
+
+      private:
+        struct Chunk {
+            ReadbackStreamBase* stream = nullptr;
+            Ref<BufferBase> buffer;
+            uint32_t index = 0;
+            uint64_t size = 0;
+            uint64_t tag = 0;
+            // Whether the chunk is waiting on its map request.
+            bool inFlight = false;
+            // Whether the copy into the chunk wasn't submitted, in which case its contents are
+            // stale and the readback completes with an error once the chunk is mapped.
+            bool copyFailed = false;
+        };
+
+        MaybeError ValidateCopy(BufferBase* buffer, uint64_t offset, uint64_t size) const;
+
+        static void OnChunkMapped(WGPUBufferMapAsyncStatus status, void* userdata);
+        void CompleteChunk(Chunk* chunk, WGPUBufferMapAsyncStatus status);
+
+        Ref<DeviceBase> mDevice;
+        ReadbackCallback mCallback;
+        void* mUserdata;
+        uint64_t mChunkSize;
+
+        // Never resized after creation so that the chunks can be used as map callback userdata.
+        std::vector<Chunk> mChunks;
+        std::vector<uint32_t> mFreeChunks;
+        // The chunks waiting on their map request, in the order the requests were made.
+        std::deque<uint32_t> mInFlightChunks;
+
+        // The chunks that are the destination of copies recorded in mPendingEncoder.
+        std::vector<uint32_t> mPendingChunks;
+        Ref<CommandEncoder> mPendingEncoder;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_READBACKSTREAM_H_
@@ -15,26 +15,263 @@
 #include "dawn_native/RenderBundle.h"
 
 #include "common/BitSetIterator.h"
+#include "common/ityp_array.h"
+#include "dawn_native/BindGroup.h"
+#include "dawn_native/Buffer.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/ObjectType_autogen.h"
 #include "dawn_native/RenderBundleEncoder.h"
+#include "dawn_native/RenderPipeline.h"
+
+#include <cstring>
+#include <vector>
 
 namespace dawn_native {
 
+    namespace {
+
+        struct BindGroupState {
+            Ref<BindGroupBase> group;
+            std::vector<uint32_t> dynamicOffsets;
+        };
+
+        struct VertexBufferState {
+            Ref<BufferBase> buffer;
+            uint64_t offset = 0;
+            uint64_t size = 0;
+        };
+
+        struct IndexBufferState {
+            Ref<BufferBase> buffer;
+            wgpu::IndexFormat format = wgpu::IndexFormat::Undefined;
+            uint64_t offset = 0;
+            uint64_t size = 0;
+        };
+
+        // The state set by the commands of a render bundle. Bundles start with no state set and
+        // their state is reset after they are executed, so a state command only needs to be
+        // replayed if a draw uses it.
+        struct BundleState {
+            Ref<RenderPipelineBase> pipeline;
+            ityp::array<BindGroupIndex, BindGroupState, kMaxBindGroups> bindGroups;
+            IndexBufferState indexBuffer;
+            ityp::array<VertexBufferSlot, VertexBufferState, kMaxVertexBuffers> vertexBuffers;
+        };
+
+        bool IsSameState(const BindGroupState& a, const BindGroupState& b) {
+            return a.group.Get() == b.group.Get() && a.dynamicOffsets == b.dynamicOffsets;
+        }
+
+        bool IsSameState(const VertexBufferState& a, const VertexBufferState& b) {
+            return a.buffer.Get() == b.buffer.Get() && a.offset == b.offset && a.size == b.size;
+        }
+
+        bool IsSameState(const IndexBufferState& a, const IndexBufferState& b) {
+            return a.buffer.Get() == b.buffer.Get() && a.format == b.format &&
+                   a.offset == b.offset && a.size == b.size;
+        }
+
+        // Records the state commands needed before a draw to go from the state set by the
+        // already recorded commands to the state the draw was encoded with. State that is the
+        // same as the recorded state is skipped.
+        void RecordStateForDraw(CommandAllocator* allocator,
+                                const BundleState& pending,
+                                BundleState* recorded) {
+            if (pending.pipeline.Get() != recorded->pipeline.Get()) {
+                SetRenderPipelineCmd* cmd =
+                    allocator->Allocate<SetRenderPipelineCmd>(Command::SetRenderPipeline);
+                cmd->pipeline = pending.pipeline.Get();
+                allocator->RetainObject(cmd->pipeline);
+                recorded->pipeline = pending.pipeline;
+            }
+
+            for (BindGroupIndex i(0); i < kMaxBindGroupsTyped; ++i) {
+                if (pending.bindGroups[i].group == nullptr ||
+                    IsSameState(pending.bindGroups[i], recorded->bindGroups[i])) {
+                    continue;
+                }
+
+                const std::vector<uint32_t>& dynamicOffsets = pending.bindGroups[i].dynamicOffsets;
+                SetBindGroupCmd* cmd = allocator->Allocate<SetBindGroupCmd>(Command::SetBindGroup);
+                cmd->index = i;
+                cmd->group = pending.bindGroups[i].group.Get();
+                allocator->RetainObject(cmd->group);
+                cmd->dynamicOffsetCount = static_cast<uint32_t>(dynamicOffsets.size());
+                if (!dynamicOffsets.empty()) {
+                    uint32_t* offsets = allocator->AllocateData<uint32_t>(dynamicOffsets.size());
+                    memcpy(offsets, dynamicOffsets.data(),
+                           dynamicOffsets.size() * sizeof(uint32_t));
+                }
+                recorded->bindGroups[i] = pending.bindGroups[i];
+            }
+
+            if (pending.indexBuffer.buffer != nullptr &&
+                !IsSameState(pending.indexBuffer, recorded->indexBuffer)) {
+                SetIndexBufferCmd* cmd =
+                    allocator->Allocate<SetIndexBufferCmd>(Command::SetIndexBuffer);
+                cmd->buffer = pending.indexBuffer.buffer.Get();
+                allocator->RetainObject(cmd->buffer);
+                cmd->format = pending.indexBuffer.format;
+                cmd->offset = pending.indexBuffer.offset;
+                cmd->size = pending.indexBuffer.size;
+                recorded->indexBuffer = pending.indexBuffer;
+            }
+
+            for (VertexBufferSlot slot(uint8_t(0)); slot < kMaxVertexBuffersTyped; ++slot) {
+                const VertexBufferState& vertexBuffer = pending.vertexBuffers[slot];
+                if (vertexBuffer.buffer == nullptr ||
+                    IsSameState(vertexBuffer, recorded->vertexBuffers[slot])) {
+                    continue;
+                }
+
+                SetVertexBufferCmd* cmd =
+                    allocator->Allocate<SetVertexBufferCmd>(Command::SetVertexBuffer);
+                cmd->slot = slot;
+                cmd->buffer = vertexBuffer.buffer.Get();
+                allocator->RetainObject(cmd->buffer);
+                cmd->offset = vertexBuffer.offset;
+                cmd->size = vertexBuffer.size;
+                recorded->vertexBuffers[slot] = vertexBuffer;
+            }
+        }
+
+        // Bundles are executed many more times than they are encoded, so their commands are
+        // re-encoded once when the bundle is finished, in the form that is the cheapest for the
+        // backends to replay. Each draw is preceded only by the state commands that changed since
+        // the previous draw, so redundant state commands and state that is overwritten or never
+        // drawn with don't have to be replayed. Vertex and index buffer sizes are already
+        // resolved by the encoder.
+        CommandIterator CompactRenderBundleCommands(CommandIterator commands) {
+            CommandAllocator allocator;
+            BundleState pending;
+            BundleState recorded;
+
+            Command type;
+            while (commands.NextCommandId(&type)) {
+                switch (type) {
+                    case Command::SetRenderPipeline: {
+                        SetRenderPipelineCmd* cmd = commands.NextCommand<SetRenderPipelineCmd>();
+                        pending.pipeline = cmd->pipeline;
+                        break;
+                    }
+
+                    case Command::SetBindGroup: {
+                        SetBindGroupCmd* cmd = commands.NextCommand<SetBindGroupCmd>();
+                        BindGroupState* bindGroup = &pending.bindGroups[cmd->index];
+                        bindGroup->group = cmd->group;
+                        bindGroup->dynamicOffsets.clear();
+                        if (cmd->dynamicOffsetCount > 0) {
+                            uint32_t* offsets =
+                                commands.NextData<uint32_t>(cmd->dynamicOffsetCount);
+                            bindGroup->dynamicOffsets.assign(offsets,
+                                                             offsets + cmd->dynamicOffsetCount);
+                        }
+                        break;
+                    }
+
+                    case Command::SetIndexBuffer: {
+                        SetIndexBufferCmd* cmd = commands.NextCommand<SetIndexBufferCmd>();
+                        pending.indexBuffer.buffer = cmd->buffer;
+                        pending.indexBuffer.format = cmd->format;
+                        pending.indexBuffer.offset = cmd->offset;
+                        pending.indexBuffer.size = cmd->size;
+                        break;
+                    }
+
+                    case Command::SetVertexBuffer: {
+                        SetVertexBufferCmd* cmd = commands.NextCommand<SetVertexBufferCmd>();
+                        VertexBufferState* vertexBuffer = &pending.vertexBuffers[cmd->slot];
+                        vertexBuffer->buffer = cmd->buffer;
+                        vertexBuffer->offset = cmd->offset;
+                        vertexBuffer->size = cmd->size;
+                        break;
+                    }
+
+                    case Command::Draw: {
+                        DrawCmd* cmd = commands.NextCommand<DrawCmd>();
+                        RecordStateForDraw(&allocator, pending, &recorded);
+                        *allocator.Allocate<DrawCmd>(Command::Draw) = *cmd;
+                        break;
+                    }
+
+                    case Command::DrawIndexed: {
+                        DrawIndexedCmd* cmd = commands.NextCommand<DrawIndexedCmd>();
+                        RecordStateForDraw(&allocator, pending, &recorded);
+                        *allocator.Allocate<DrawIndexedCmd>(Command::DrawIndexed) = *cmd;
+                        break;
+                    }
+
+                    case Command::DrawIndirect: {
+                        DrawIndirectCmd* cmd = commands.NextCommand<DrawIndirectCmd>();
+                        RecordStateForDraw(&allocator, pending, &recorded);
+                        *allocator.Allocate<DrawIndirectCmd>(Command::DrawIndirect) = *cmd;
+                        break;
+                    }
+
+                    case Command::DrawIndexedIndirect: {
+                        DrawIndexedIndirectCmd* cmd =
+                            commands.NextCommand<DrawIndexedIndirectCmd>();
+                        RecordStateForDraw(&allocator, pending, &recorded);
+                        *allocator.Allocate<DrawIndexedIndirectCmd>(Command::DrawIndexedIndirect) =
+                            *cmd;
+                        break;
+                    }
+
+                    case Command::InsertDebugMarker: {
+                        InsertDebugMarkerCmd* cmd = commands.NextCommand<InsertDebugMarkerCmd>();
+                        const char* label = commands.NextData<char>(cmd->length + 1);
+                        *allocator.Allocate<InsertDebugMarkerCmd>(Command::InsertDebugMarker) =
+                            *cmd;
+                        memcpy(allocator.AllocateData<char>(cmd->length + 1), label,
+                               cmd->length + 1);
+                        break;
+                    }
+
+                    case Command::PushDebugGroup: {
+                        PushDebugGroupCmd* cmd = commands.NextCommand<PushDebugGroupCmd>();
+                        const char* label = commands.NextData<char>(cmd->length + 1);
+                        *allocator.Allocate<PushDebugGroupCmd>(Command::PushDebugGroup) = *cmd;
+                        memcpy(allocator.AllocateData<char>(cmd->length + 1), label,
+                               cmd->length + 1);
+                        break;
+                    }
+
+                    case Command::PopDebugGroup: {
+                        commands.NextCommand<PopDebugGroupCmd>();
+                        allocator.Allocate<PopDebugGroupCmd>(Command::PopDebugGroup);
+                        break;
+                    }
+
+                    default:
+                        UNREACHABLE();
+                }
+            }
+
+            FreeCommands(&commands);
+            return CommandIterator(std::move(allocator));
+        }
+
+    }  // anonymous namespace
+
     RenderBundleBase::RenderBundleBase(RenderBundleEncoder* encoder,
                                        const RenderBundleDescriptor* descriptor,
                                        Ref<AttachmentState> attachmentState,
                                        RenderPassResourceUsage resourceUsage,
                                        IndirectDrawMetadata indirectDrawMetadata)
         : ApiObjectBase(encoder->GetDevice(), kLabelNotImplemented),
-          mCommands(encoder->AcquireCommands()),
+          mCommands(CompactRenderBundleCommands(encoder->AcquireCommands())),
           mIndirectDrawMetadata(std::move(indirectDrawMetadata)),
           mAttachmentState(std::move(attachmentState)),
           mResourceUsage(std::move(resourceUsage)) {
+        GetDevice()->GetStatistics()->commandBytesInUse.Add(mCommands.GetAllocatedSize());
     }
 
     RenderBundleBase::~RenderBundleBase() {
+        size_t commandsSize = mCommands.GetAllocatedSize();
+        if (commandsSize > 0 && IsAlive()) {
+            GetDevice()->GetStatistics()->commandBytesInUse.Sub(commandsSize);
+        }
         FreeCommands(&mCommands);
     }
 
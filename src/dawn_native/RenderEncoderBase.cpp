@@ -227,6 +227,7 @@ namespace dawn_native {
                 SetRenderPipelineCmd* cmd =
                     allocator->Allocate<SetRenderPipelineCmd>(Command::SetRenderPipeline);
                 cmd->pipeline = pipeline;
+                allocator->RetainObject(pipeline);
 
                 return {};
             },
@@ -293,6 +294,7 @@ namespace dawn_native {
                 SetIndexBufferCmd* cmd =
                     allocator->Allocate<SetIndexBufferCmd>(Command::SetIndexBuffer);
                 cmd->buffer = buffer;
+                allocator->RetainObject(buffer);
                 cmd->format = format;
                 cmd->offset = offset;
                 cmd->size = size;
@@ -362,6 +364,7 @@ namespace dawn_native {
                     allocator->Allocate<SetVertexBufferCmd>(Command::SetVertexBuffer);
                 cmd->slot = VertexBufferSlot(static_cast<uint8_t>(slot));
                 cmd->buffer = buffer;
+                allocator->RetainObject(buffer);
                 cmd->offset = offset;
                 cmd->size = size;
 
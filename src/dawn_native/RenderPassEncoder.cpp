@@ -74,7 +74,8 @@ namespace dawn_native {
     RenderPassEncoder* RenderPassEncoder::MakeError(DeviceBase* device,
                                                     CommandEncoder* commandEncoder,
                                                     EncodingContext* encodingContext) {
-        return new RenderPassEncoder(device, commandEncoder, encodingContext, ObjectBase::kError);
+        return new (device)
+            RenderPassEncoder(device, commandEncoder, encodingContext, ObjectBase::kError);
     }
 
     ObjectType RenderPassEncoder::GetType() const {
@@ -17,13 +17,15 @@
 
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
+#include "dawn_native/ObjectPool.h"
 #include "dawn_native/RenderEncoderBase.h"
 
 namespace dawn_native {
 
     class RenderBundleBase;
 
-    class RenderPassEncoder final : public RenderEncoderBase {
+    class RenderPassEncoder final : public RenderEncoderBase,
+                                    public DevicePoolAllocated<ObjectType::RenderPassEncoder> {
       public:
         RenderPassEncoder(DeviceBase* device,
                           CommandEncoder* commandEncoder,
@@ -0,0 +1,40 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_RESOURCEMEMORYSUBALLOCATOR_H_
+#define DAWNNATIVE_RESOURCEMEMORYSUBALLOCATOR_H_
+
+#include "dawn_native/Error.h"
+#include "dawn_native/ResourceMemoryAllocation.h"
+
+namespace dawn_native {
+
+    // Interface for the allocators that sub-allocate resources in memory heaps created by a
+    // ResourceHeapAllocator, so that backends can choose the allocation strategy for each kind of
+    // heap. An invalid allocation is returned if the request can't be sub-allocated, for example
+    // if it is larger than the memory blocks.
+    class ResourceMemorySubAllocator {
+      public:
+        virtual ~ResourceMemorySubAllocator() = default;
+
+        virtual ResultOrError<ResourceMemoryAllocation> Allocate(uint64_t allocationSize,
+                                                                 uint64_t alignment) = 0;
+        virtual void Deallocate(const ResourceMemoryAllocation& allocation) = 0;
+
+        virtual uint64_t GetMemoryBlockSize() const = 0;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_RESOURCEMEMORYSUBALLOCATOR_H_
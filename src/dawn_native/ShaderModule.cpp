@@ -17,7 +17,10 @@
 #include "absl/strings/str_format.h"
 #include "common/Constants.h"
 #include "common/HashUtils.h"
+#include "dawn_native/AsyncTask.h"
 #include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/BoundsCheckAnalysis.h"
+#include "dawn_native/CallbackTaskManager.h"
 #include "dawn_native/ChainUtils_autogen.h"
 #include "dawn_native/CompilationMessages.h"
 #include "dawn_native/Device.h"
@@ -26,9 +29,13 @@
 #include "dawn_native/PipelineLayout.h"
 #include "dawn_native/RenderPipeline.h"
 #include "dawn_native/TintUtils.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 #include <tint/tint.h>
 
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
 
 namespace dawn_native {
@@ -967,12 +974,7 @@ namespace dawn_native {
         tint::Source::File file;
     };
 
-    MaybeError ValidateShaderModuleDescriptor(DeviceBase* device,
-                                              const ShaderModuleDescriptor* descriptor,
-                                              ShaderModuleParseResult* parseResult,
-                                              OwnedCompilationMessages* outMessages) {
-        ASSERT(parseResult != nullptr);
-
+    MaybeError ValidateShaderModuleDescriptorChain(const ShaderModuleDescriptor* descriptor) {
         const ChainedStruct* chainedDescriptor = descriptor->nextInChain;
         if (chainedDescriptor == nullptr) {
             return DAWN_VALIDATION_ERROR("Shader module descriptor missing chained descriptor");
@@ -980,6 +982,18 @@ namespace dawn_native {
         // For now only a single SPIRV or WGSL subdescriptor is allowed.
         DAWN_TRY(ValidateSingleSType(chainedDescriptor, wgpu::SType::ShaderModuleSPIRVDescriptor,
                                      wgpu::SType::ShaderModuleWGSLDescriptor));
+        return {};
+    }
+
+    MaybeError ValidateShaderModuleDescriptor(DeviceBase* device,
+                                              const ShaderModuleDescriptor* descriptor,
+                                              ShaderModuleParseResult* parseResult,
+                                              OwnedCompilationMessages* outMessages) {
+        ASSERT(parseResult != nullptr);
+        TRACE_EVENT0(device->GetPlatform(), Validation, "ShaderModule::Parse");
+
+        DAWN_TRY(ValidateShaderModuleDescriptorChain(descriptor));
+        const ChainedStruct* chainedDescriptor = descriptor->nextInChain;
 
         ScopedTintICEHandler scopedICEHandler(device);
 
@@ -1028,7 +1042,7 @@ namespace dawn_native {
             if (device->IsToggleEnabled(Toggle::DumpShaders)) {
                 std::ostringstream dumpedMsg;
                 dumpedMsg << "// Dumped WGSL:" << std::endl << wgslDesc->source;
-                device->EmitLog(WGPULoggingType_Info, dumpedMsg.str().c_str());
+                EmitShaderLog(device, WGPULoggingType_Info, dumpedMsg.str().c_str());
             }
 
             tint::Program program;
@@ -1037,6 +1051,20 @@ namespace dawn_native {
             parseResult->tintSource = std::move(tintSource);
         }
 
+        // The backends clamp the index accesses that aren't proven to be in bounds. Report the
+        // ones that are proven in bounds regardless of the pipeline the module is used in. The
+        // backends that compile per pipeline can prove more accesses to runtime-sized arrays
+        // with the minimum binding sizes of the pipeline layout.
+        if (device->IsRobustnessEnabled() && parseResult->tintProgram != nullptr &&
+            outMessages != nullptr) {
+            BoundsCheckAnalysis analysis = AnalyzeBoundsChecks(parseResult->tintProgram.get());
+            if (!analysis.inBoundsAccesses.empty()) {
+                outMessages->AddInfoMessage(absl::StrFormat(
+                    "%u of %u bounds checks elided: the index accesses are statically in bounds.",
+                    analysis.inBoundsAccesses.size(), analysis.indexAccessCount));
+            }
+        }
+
         return {};
     }
 
@@ -1162,6 +1190,26 @@ namespace dawn_native {
 
     // ShaderModuleBase
 
+    // The state of the initialization of a module created with
+    // Toggle::AsyncShaderModuleCreation, shared by the worker task and the threads waiting for it.
+    struct ShaderModuleBase::AsyncInitialization {
+        std::mutex mutex;
+        std::condition_variable finishedCondition;
+        bool started = false;
+        bool finished = false;
+
+        // The error of the initialization, kept to be returned to every caller of
+        // WaitForInitialization.
+        bool failed = false;
+        InternalErrorType errorType = InternalErrorType::Validation;
+        std::string errorMessage;
+
+        // The logs and Tint internal compiler errors of the initialization, emitted once from the
+        // device's thread after it is finished.
+        DeferredShaderMessages messages;
+        bool messagesEmitted = false;
+    };
+
     ShaderModuleBase::ShaderModuleBase(DeviceBase* device, const ShaderModuleDescriptor* descriptor)
         : ApiObjectBase(device, descriptor->label), mType(Type::Undefined) {
         ASSERT(descriptor->nextInChain != nullptr);
@@ -1233,6 +1281,13 @@ namespace dawn_native {
             return;
         }
 
+        // The messages of the parsing are only complete once the initialization is done. Its
+        // error, if any, is part of the messages.
+        MaybeError initialization = WaitForInitialization();
+        if (initialization.IsError()) {
+            initialization.AcquireError();
+        }
+
         callback(WGPUCompilationInfoRequestStatus_Success,
                  mCompilationMessages->GetCompilationInfo(), userdata);
     }
@@ -1251,8 +1306,11 @@ namespace dawn_native {
         }
         // Move the compilationMessages into the shader module and emit the tint errors and warnings
         mCompilationMessages = std::move(compilationMessages);
+        EmitFormattedTintMessages();
+    }
 
-        // Emit the formatted Tint errors and warnings within the moved compilationMessages
+    void ShaderModuleBase::EmitFormattedTintMessages() {
+        // Emit the formatted Tint errors and warnings within the compilationMessages
         const std::vector<std::string>& formattedTintMessages =
             mCompilationMessages->GetFormattedTintMessages();
         if (formattedTintMessages.empty()) {
@@ -1273,10 +1331,149 @@ namespace dawn_native {
         return mCompilationMessages.get();
     }
 
+    void ShaderModuleBase::InitializeAsync() {
+        ASSERT(mAsyncInitialization == nullptr && mTintProgram == nullptr);
+        mAsyncInitialization = std::make_unique<AsyncInitialization>();
+
+        // The compilation messages are filled by the initialization so they are owned by the
+        // module from the start. This also makes APICreateShaderModule skip injecting its own.
+        mCompilationMessages = std::make_unique<OwnedCompilationMessages>();
+
+        // The task keeps the module alive until it has run, but the reference is released on the
+        // device's thread with the callback tasks because the last release removes the module
+        // from the device's cache. The messages of the initialization are emitted there too,
+        // unless the module was used before.
+        struct ReleaseShaderModuleCallbackTask final : CallbackTask {
+            explicit ReleaseShaderModuleCallbackTask(Ref<ShaderModuleBase> module)
+                : module(std::move(module)) {
+            }
+            void Finish() override {
+                module->EmitDeferredMessages();
+            }
+            void HandleShutDown() override {
+            }
+            void HandleDeviceLoss() override {
+            }
+
+            Ref<ShaderModuleBase> module;
+        };
+
+        Ref<ShaderModuleBase> module = this;
+        GetDevice()->GetAsyncTaskManager()->PostTask([module]() mutable {
+            module->RunAsyncInitialization();
+
+            DeviceBase* device = module->GetDevice();
+            device->GetCallbackTaskManager()->AddCallbackTask(
+                std::make_unique<ReleaseShaderModuleCallbackTask>(std::move(module)));
+        });
+    }
+
+    void ShaderModuleBase::RunAsyncInitialization() {
+        {
+            std::lock_guard<std::mutex> lock(mAsyncInitialization->mutex);
+            if (mAsyncInitialization->started) {
+                return;
+            }
+            mAsyncInitialization->started = true;
+        }
+
+        // Rebuild the descriptor from the source copied in the constructor.
+        ShaderModuleDescriptor descriptor;
+        ShaderModuleSPIRVDescriptor spirvDesc;
+        ShaderModuleWGSLDescriptor wgslDesc;
+        if (mType == Type::Spirv) {
+            spirvDesc.codeSize = static_cast<uint32_t>(mOriginalSpirv.size());
+            spirvDesc.code = mOriginalSpirv.data();
+            descriptor.nextInChain = &spirvDesc;
+        } else {
+            ASSERT(mType == Type::Wgsl);
+            wgslDesc.source = mWgsl.c_str();
+            descriptor.nextInChain = &wgslDesc;
+        }
+
+        // This may run on a worker thread, so the messages for the device are kept until
+        // EmitDeferredMessages is called from the device's thread.
+        MaybeError maybeError;
+        {
+            ScopedDeferShaderMessages deferMessages(&mAsyncInitialization->messages);
+
+            ShaderModuleParseResult parseResult;
+            maybeError = ValidateShaderModuleDescriptor(GetDevice(), &descriptor, &parseResult,
+                                                        mCompilationMessages.get());
+            if (!maybeError.IsError()) {
+                maybeError = Initialize(&parseResult);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mAsyncInitialization->mutex);
+            if (maybeError.IsError()) {
+                std::unique_ptr<ErrorData> error = maybeError.AcquireError();
+                mAsyncInitialization->failed = true;
+                mAsyncInitialization->errorType = error->GetType();
+                mAsyncInitialization->errorMessage = error->GetMessage();
+            }
+            mAsyncInitialization->finished = true;
+        }
+        mAsyncInitialization->finishedCondition.notify_all();
+    }
+
+    MaybeError ShaderModuleBase::WaitForInitialization() {
+        if (mAsyncInitialization == nullptr) {
+            return {};
+        }
+
+        // Steal the initialization if the worker hasn't started it yet, instead of waiting for a
+        // worker to be available.
+        RunAsyncInitialization();
+
+        {
+            std::unique_lock<std::mutex> lock(mAsyncInitialization->mutex);
+            mAsyncInitialization->finishedCondition.wait(
+                lock, [this] { return mAsyncInitialization->finished; });
+        }
+
+        EmitDeferredMessages();
+
+        // The error is immutable once the initialization is finished.
+        if (mAsyncInitialization->failed) {
+            return DAWN_MAKE_ERROR(
+                mAsyncInitialization->errorType,
+                "Shader module is invalid: " + mAsyncInitialization->errorMessage);
+        }
+        return {};
+    }
+
+    void ShaderModuleBase::EmitDeferredMessages() {
+        DeferredShaderMessages messages;
+        {
+            std::lock_guard<std::mutex> lock(mAsyncInitialization->mutex);
+            if (!mAsyncInitialization->finished || mAsyncInitialization->messagesEmitted) {
+                return;
+            }
+            mAsyncInitialization->messagesEmitted = true;
+            messages = std::move(mAsyncInitialization->messages);
+        }
+
+        DeviceBase* device = GetDevice();
+        for (const auto& log : messages.logs) {
+            device->EmitLog(log.first, log.second.c_str());
+        }
+        for (const std::string& message : messages.internalCompilerErrors) {
+            device->HandleError(InternalErrorType::Validation, message.c_str());
+        }
+        EmitFormattedTintMessages();
+    }
+
+    MaybeError ShaderModuleBase::Initialize(ShaderModuleParseResult* parseResult) {
+        return InitializeBase(parseResult);
+    }
+
     MaybeError ShaderModuleBase::InitializeBase(ShaderModuleParseResult* parseResult) {
         mTintProgram = std::move(parseResult->tintProgram);
         mTintSource = std::move(parseResult->tintSource);
 
+        TRACE_EVENT0(GetDevice()->GetPlatform(), General, "ShaderModule::Reflect");
         DAWN_TRY_ASSIGN(mEntryPoints, ReflectShaderUsingTint(GetDevice(), mTintProgram.get()));
         return {};
     }
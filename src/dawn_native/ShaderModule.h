@@ -94,6 +94,9 @@ namespace dawn_native {
         std::unique_ptr<TintSource> tintSource;
     };
 
+    // Validates only the chained structs of the descriptor, which is what can be checked before
+    // parsing the shader.
+    MaybeError ValidateShaderModuleDescriptorChain(const ShaderModuleDescriptor* descriptor);
     MaybeError ValidateShaderModuleDescriptor(DeviceBase* device,
                                               const ShaderModuleDescriptor* descriptor,
                                               ShaderModuleParseResult* parseResult,
@@ -238,12 +241,30 @@ namespace dawn_native {
 
         OwnedCompilationMessages* GetCompilationMessages() const;
 
+        // Starts parsing, validating and reflecting the module on a worker thread. Used instead of
+        // Initialize for uninitialized modules when Toggle::AsyncShaderModuleCreation is enabled.
+        void InitializeAsync();
+
+        // Waits for the asynchronous initialization of the module to finish, or runs it on the
+        // calling thread if no worker has started it yet, and returns its error if it failed.
+        // Does nothing for modules that were initialized synchronously. It must be called before
+        // using the module's program or entry points.
+        MaybeError WaitForInitialization();
+
       protected:
+        // Backends override Initialize to transform the program before calling InitializeBase.
+        virtual MaybeError Initialize(ShaderModuleParseResult* parseResult);
         MaybeError InitializeBase(ShaderModuleParseResult* parseResult);
 
       private:
         ShaderModuleBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
+        void RunAsyncInitialization();
+        // Emits the messages of the asynchronous initialization on the device once it is
+        // finished. Must be called from the device's thread.
+        void EmitDeferredMessages();
+        void EmitFormattedTintMessages();
+
         // The original data in the descriptor for caching.
         enum class Type { Undefined, Spirv, Wgsl };
         Type mType;
@@ -255,6 +276,9 @@ namespace dawn_native {
         std::unique_ptr<TintSource> mTintSource;  // Keep the tint::Source::File alive
 
         std::unique_ptr<OwnedCompilationMessages> mCompilationMessages;
+
+        struct AsyncInitialization;
+        std::unique_ptr<AsyncInitialization> mAsyncInitialization;
     };
 
 }  // namespace dawn_native
@@ -16,6 +16,7 @@
 
 #include "common/Platform.h"
 #include "dawn_native/ChainUtils_autogen.h"
+#include "dawn_native/DawnNative.h"
 #include "dawn_native/Instance.h"
 #include "dawn_native/SwapChain.h"
 
@@ -122,7 +123,7 @@ namespace dawn_native {
     }
 
     Surface::Surface(InstanceBase* instance, const SurfaceDescriptor* descriptor)
-        : mInstance(instance) {
+        : DispatchableObject(&GetProcs()), mInstance(instance) {
         ASSERT(descriptor->nextInChain != nullptr);
         const SurfaceDescriptorFromMetalLayer* metalDesc = nullptr;
         const SurfaceDescriptorFromWindowsHWND* hwndDesc = nullptr;
@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_SURFACE_H_
 #define DAWNNATIVE_SURFACE_H_
 
+#include "common/DispatchableObject.h"
 #include "common/RefCounted.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
@@ -42,7 +43,7 @@ namespace dawn_native {
     // ObjectiveC).
     // The surface is also used to store the current swapchain so that we can detach it when it is
     // replaced.
-    class Surface final : public RefCounted {
+    class Surface final : public DispatchableObject, public RefCounted {
       public:
         Surface(InstanceBase* instance, const SurfaceDescriptor* descriptor);
 
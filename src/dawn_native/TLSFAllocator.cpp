@@ -0,0 +1,271 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/TLSFAllocator.h"
+
+#include "common/Assert.h"
+#include "common/Math.h"
+
+#include <algorithm>
+
+namespace dawn_native {
+
+    TLSFAllocator::TLSFAllocator(uint64_t maxSize, uint64_t poolSize)
+        : mMaxSize(maxSize), mPoolSize(poolSize) {
+        ASSERT(IsPowerOfTwo(poolSize) && poolSize <= maxSize);
+        ASSERT(maxSize % poolSize == 0);
+
+        // Bins of the first level hold the sizes in [2^(firstLevel + kSecondLevelLog2 - 1),
+        // 2^(firstLevel + kSecondLevelLog2)), except the first one that holds the small sizes.
+        mFirstLevelCount = ComputeBinIndex(poolSize).firstLevel + 1;
+        ASSERT(mFirstLevelCount <= 32);
+
+        mSecondLevelBitmaps.resize(mFirstLevelCount, 0);
+        mFreeLists.resize(mFirstLevelCount * kSecondLevelCount, nullptr);
+    }
+
+    TLSFAllocator::~TLSFAllocator() {
+        for (Block* block : mPools) {
+            while (block != nullptr) {
+                Block* next = block->pNextPhysical;
+                delete block;
+                block = next;
+            }
+        }
+    }
+
+    // static
+    TLSFAllocator::BinIndex TLSFAllocator::ComputeBinIndex(uint64_t size) {
+        ASSERT(size > 0);
+        if (size < kSecondLevelCount) {
+            return {0, static_cast<uint32_t>(size)};
+        }
+
+        // The top kSecondLevelLog2 + 1 bits of the size select the bin.
+        uint32_t log2Size = Log2(size);
+        uint32_t firstLevel = log2Size - kSecondLevelLog2 + 1;
+        uint32_t secondLevel =
+            static_cast<uint32_t>(size >> (log2Size - kSecondLevelLog2)) - kSecondLevelCount;
+        return {firstLevel, secondLevel};
+    }
+
+    TLSFAllocator::Block* TLSFAllocator::FindFreeBlock(uint64_t size) const {
+        // Round the size up to the next bin boundary so that any block in the bin found is large
+        // enough. This is the "good fit" policy of TLSF: it doesn't search for the best fit
+        // inside a bin, which makes it constant time.
+        uint64_t searchSize = size;
+        if (searchSize >= kSecondLevelCount) {
+            searchSize += (uint64_t(1) << (Log2(searchSize) - kSecondLevelLog2)) - 1;
+        }
+        // The bin of the pool size only contains blocks of a whole pool since the pool size is a
+        // power of two and blocks can't be larger.
+        searchSize = std::min(searchSize, mPoolSize);
+
+        Block* block = FindFreeBlockInLargerBins(searchSize);
+        if (block != nullptr) {
+            return block;
+        }
+
+        // As a last resort before adding a pool, look for a large enough block in the bin of the
+        // size itself, which contains blocks both smaller and larger than it.
+        BinIndex index = ComputeBinIndex(size);
+        for (block = mFreeLists[index.firstLevel * kSecondLevelCount + index.secondLevel];
+             block != nullptr; block = block->pNextFree) {
+            if (block->mSize >= size) {
+                return block;
+            }
+        }
+        return nullptr;
+    }
+
+    TLSFAllocator::Block* TLSFAllocator::FindFreeBlockInLargerBins(uint64_t size) const {
+        BinIndex index = ComputeBinIndex(size);
+        ASSERT(index.firstLevel < mFirstLevelCount);
+
+        // Look for a non-empty bin in the same range of sizes first, then in larger ranges.
+        uint32_t secondLevelBitmap =
+            mSecondLevelBitmaps[index.firstLevel] & (~0u << index.secondLevel);
+        if (secondLevelBitmap == 0) {
+            uint32_t firstLevelBitmap =
+                index.firstLevel + 1 < 32 ? mFirstLevelBitmap & (~0u << (index.firstLevel + 1))
+                                          : 0;
+            if (firstLevelBitmap == 0) {
+                return nullptr;
+            }
+            index.firstLevel = ScanForward(firstLevelBitmap);
+            secondLevelBitmap = mSecondLevelBitmaps[index.firstLevel];
+        }
+        index.secondLevel = ScanForward(secondLevelBitmap);
+
+        return mFreeLists[index.firstLevel * kSecondLevelCount + index.secondLevel];
+    }
+
+    TLSFAllocator::Block* TLSFAllocator::AddPool() {
+        uint64_t poolOffset = mPools.size() * mPoolSize;
+        if (poolOffset >= mMaxSize) {
+            return nullptr;
+        }
+
+        Block* block = new Block(poolOffset, mPoolSize);
+        mPools.push_back(block);
+        InsertFreeBlock(block);
+        return block;
+    }
+
+    void TLSFAllocator::InsertFreeBlock(Block* block) {
+        ASSERT(block->mIsFree);
+        BinIndex index = ComputeBinIndex(block->mSize);
+        Block** head = &mFreeLists[index.firstLevel * kSecondLevelCount + index.secondLevel];
+
+        block->pPrevFree = nullptr;
+        block->pNextFree = *head;
+        if (*head != nullptr) {
+            (*head)->pPrevFree = block;
+        }
+        *head = block;
+
+        mFirstLevelBitmap |= 1u << index.firstLevel;
+        mSecondLevelBitmaps[index.firstLevel] |= 1u << index.secondLevel;
+    }
+
+    void TLSFAllocator::RemoveFreeBlock(Block* block) {
+        ASSERT(block->mIsFree);
+        BinIndex index = ComputeBinIndex(block->mSize);
+        Block** head = &mFreeLists[index.firstLevel * kSecondLevelCount + index.secondLevel];
+
+        if (block->pPrevFree != nullptr) {
+            block->pPrevFree->pNextFree = block->pNextFree;
+        } else {
+            ASSERT(*head == block);
+            *head = block->pNextFree;
+        }
+        if (block->pNextFree != nullptr) {
+            block->pNextFree->pPrevFree = block->pPrevFree;
+        }
+        block->pPrevFree = nullptr;
+        block->pNextFree = nullptr;
+
+        if (*head == nullptr) {
+            mSecondLevelBitmaps[index.firstLevel] &= ~(1u << index.secondLevel);
+            if (mSecondLevelBitmaps[index.firstLevel] == 0) {
+                mFirstLevelBitmap &= ~(1u << index.firstLevel);
+            }
+        }
+    }
+
+    TLSFAllocator::Block* TLSFAllocator::SplitBlock(Block* block, uint64_t size) {
+        ASSERT(size < block->mSize);
+        Block* remainder = new Block(block->mOffset + size, block->mSize - size);
+        block->mSize = size;
+
+        remainder->pPrevPhysical = block;
+        remainder->pNextPhysical = block->pNextPhysical;
+        if (block->pNextPhysical != nullptr) {
+            block->pNextPhysical->pPrevPhysical = remainder;
+        }
+        block->pNextPhysical = remainder;
+        return remainder;
+    }
+
+    void TLSFAllocator::MergeBlocks(Block* block, Block* next) {
+        ASSERT(block->pNextPhysical == next);
+        block->mSize += next->mSize;
+        block->pNextPhysical = next->pNextPhysical;
+        if (next->pNextPhysical != nullptr) {
+            next->pNextPhysical->pPrevPhysical = block;
+        }
+        delete next;
+    }
+
+    uint64_t TLSFAllocator::Allocate(uint64_t allocationSize, uint64_t alignment) {
+        ASSERT(IsPowerOfTwo(alignment));
+        if (allocationSize == 0 || allocationSize > mPoolSize || alignment > mPoolSize) {
+            return kInvalidOffset;
+        }
+
+        // Try a block of the requested size first, which is usually aligned since allocations
+        // tend to have the same alignment in a given allocator. Otherwise use a block that is
+        // large enough to fit the allocation whatever the alignment of its offset.
+        auto FitsAligned = [&](const Block* block) {
+            return Align(block->mOffset, alignment) + allocationSize <=
+                   block->mOffset + block->mSize;
+        };
+        Block* block = FindFreeBlock(allocationSize);
+        if (block == nullptr || !FitsAligned(block)) {
+            block = alignment > 1 ? FindFreeBlock(allocationSize + alignment - 1) : nullptr;
+        }
+        if (block == nullptr) {
+            // New pools start at a multiple of the pool size so they are always aligned.
+            block = AddPool();
+            if (block == nullptr) {
+                return kInvalidOffset;
+            }
+        }
+        ASSERT(FitsAligned(block));
+        RemoveFreeBlock(block);
+
+        // Give back the padding needed for the alignment and the unused end of the block. They
+        // can't be merged with their neighbors since free blocks are always merged eagerly.
+        uint64_t alignedOffset = Align(block->mOffset, alignment);
+        if (alignedOffset != block->mOffset) {
+            Block* padding = block;
+            block = SplitBlock(padding, alignedOffset - padding->mOffset);
+            InsertFreeBlock(padding);
+        }
+        if (block->mSize > allocationSize) {
+            InsertFreeBlock(SplitBlock(block, allocationSize));
+        }
+
+        block->mIsFree = false;
+        mAllocatedBlocks[block->mOffset] = block;
+        return block->mOffset;
+    }
+
+    void TLSFAllocator::Deallocate(uint64_t offset) {
+        auto it = mAllocatedBlocks.find(offset);
+        ASSERT(it != mAllocatedBlocks.end());
+        Block* block = it->second;
+        mAllocatedBlocks.erase(it);
+
+        block->mIsFree = true;
+
+        Block* next = block->pNextPhysical;
+        if (next != nullptr && next->mIsFree) {
+            RemoveFreeBlock(next);
+            MergeBlocks(block, next);
+        }
+
+        Block* previous = block->pPrevPhysical;
+        if (previous != nullptr && previous->mIsFree) {
+            RemoveFreeBlock(previous);
+            MergeBlocks(previous, block);
+            block = previous;
+        }
+
+        InsertFreeBlock(block);
+    }
+
+    uint64_t TLSFAllocator::ComputeTotalNumOfFreeBlocksForTesting() const {
+        uint64_t count = 0;
+        for (Block* block : mPools) {
+            for (; block != nullptr; block = block->pNextPhysical) {
+                if (block->mIsFree) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+}  // namespace dawn_native
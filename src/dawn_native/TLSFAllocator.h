@@ -0,0 +1,113 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_TLSFALLOCATOR_H_
+#define DAWNNATIVE_TLSFALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace dawn_native {
+
+    // TLSFAllocator uses the two-level segregated fit (TLSF) technique to satisfy allocation
+    // requests of any size in constant time. Unlike the BuddyAllocator, sizes aren't rounded up to
+    // a power-of-two so there is no internal fragmentation other than for alignment.
+    //
+    // Free blocks are binned by size in a two-level index: the first level is the power-of-two
+    // range of the size and the second level linearly subdivides that range in
+    // kSecondLevelCount bins. A bitmap for each level tracks which bins are non-empty, so that
+    // finding a free block that is large enough takes a couple of bit scans. Allocated blocks are
+    // split to the requested size and free blocks are merged with their free neighbors
+    // immediately, which bounds fragmentation.
+    //
+    // The range [0, maxSize) is split in pools of |poolSize| bytes that are added when all the
+    // others are full. Allocations never straddle two pools so each pool can be backed by a
+    // separate memory heap.
+    class TLSFAllocator {
+      public:
+        TLSFAllocator(uint64_t maxSize, uint64_t poolSize);
+        ~TLSFAllocator();
+
+        // Required methods.
+        uint64_t Allocate(uint64_t allocationSize, uint64_t alignment = 1);
+        void Deallocate(uint64_t offset);
+
+        // For testing purposes only.
+        uint64_t ComputeTotalNumOfFreeBlocksForTesting() const;
+
+        static constexpr uint64_t kInvalidOffset = std::numeric_limits<uint64_t>::max();
+
+      private:
+        static constexpr uint32_t kSecondLevelLog2 = 4;
+        static constexpr uint32_t kSecondLevelCount = 1u << kSecondLevelLog2;
+
+        struct Block {
+            Block(uint64_t offset, uint64_t size) : mOffset(offset), mSize(size) {
+            }
+
+            uint64_t mOffset;
+            uint64_t mSize;
+            bool mIsFree = true;
+
+            // Neighbors in the pool, used to merge free blocks. nullptr at the pool boundaries.
+            Block* pPrevPhysical = nullptr;
+            Block* pNextPhysical = nullptr;
+
+            // Links in the free list of the block's bin, only valid if the block is free.
+            Block* pPrevFree = nullptr;
+            Block* pNextFree = nullptr;
+        };
+
+        struct BinIndex {
+            uint32_t firstLevel;
+            uint32_t secondLevel;
+        };
+        static BinIndex ComputeBinIndex(uint64_t size);
+
+        // Returns a free block of at least |size| bytes, or nullptr if there is none.
+        Block* FindFreeBlock(uint64_t size) const;
+        // Returns the first free block in the bins for sizes larger or equal to |size|.
+        Block* FindFreeBlockInLargerBins(uint64_t size) const;
+        Block* AddPool();
+
+        void InsertFreeBlock(Block* block);
+        void RemoveFreeBlock(Block* block);
+
+        // Splits |block| at |size| bytes and returns the free block for the remainder.
+        Block* SplitBlock(Block* block, uint64_t size);
+        // Merges |next| into its physical predecessor |block|.
+        void MergeBlocks(Block* block, Block* next);
+
+        uint64_t mMaxSize;
+        uint64_t mPoolSize;
+
+        uint32_t mFirstLevelCount;
+        uint32_t mFirstLevelBitmap = 0;
+        std::vector<uint32_t> mSecondLevelBitmaps;
+        // The head of the list of free blocks in each bin, indexed by
+        // firstLevel * kSecondLevelCount + secondLevel.
+        std::vector<Block*> mFreeLists;
+
+        // The first block of each pool. It is never merged into another block.
+        std::vector<Block*> mPools;
+
+        std::unordered_map<uint64_t, Block*> mAllocatedBlocks;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_TLSFALLOCATOR_H_
@@ -0,0 +1,75 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_TLSFMEMORYALLOCATOR_H_
+#define DAWNNATIVE_TLSFMEMORYALLOCATOR_H_
+
+#include "dawn_native/Error.h"
+#include "dawn_native/ResourceMemoryAllocation.h"
+#include "dawn_native/ResourceMemorySubAllocator.h"
+#include "dawn_native/TLSFAllocator.h"
+
+#include <memory>
+#include <vector>
+
+namespace dawn_native {
+
+    class ResourceHeapAllocator;
+
+    // TLSFMemoryAllocator uses the TLSF allocator to sub-allocate blocks of device memory created
+    // by MemoryAllocator clients. It is a drop-in replacement for the BuddyMemoryAllocator that
+    // doesn't round allocations up to a power-of-two, which wastes less memory for resources of
+    // arbitrary sizes like buffers.
+    //
+    // Each TLSF pool is backed by a memory block created on the first sub-allocation in it. Like
+    // in the BuddyMemoryAllocator, the memory is refcounted by its sub-allocations and released
+    // when the last of them is deallocated.
+    //
+    // The MemoryAllocator should return ResourceHeaps that are all compatible with each other.
+    // It should also outlive all the resources that are in the TLSF allocator.
+    class TLSFMemoryAllocator : public ResourceMemorySubAllocator {
+      public:
+        TLSFMemoryAllocator(uint64_t maxSystemSize,
+                            uint64_t memoryBlockSize,
+                            ResourceHeapAllocator* heapAllocator);
+        ~TLSFMemoryAllocator() override = default;
+
+        ResultOrError<ResourceMemoryAllocation> Allocate(uint64_t allocationSize,
+                                                         uint64_t alignment) override;
+        void Deallocate(const ResourceMemoryAllocation& allocation) override;
+
+        uint64_t GetMemoryBlockSize() const override;
+
+        // For testing purposes.
+        uint64_t ComputeTotalNumOfHeapsForTesting() const;
+
+      private:
+        uint64_t GetMemoryIndex(uint64_t offset) const;
+
+        uint64_t mMemoryBlockSize = 0;
+
+        TLSFAllocator mTLSFBlockAllocator;
+        ResourceHeapAllocator* mHeapAllocator;
+
+        struct TrackedSubAllocations {
+            size_t refcount = 0;
+            std::unique_ptr<ResourceHeapBase> mMemoryAllocation;
+        };
+
+        std::vector<TrackedSubAllocations> mTrackedSubAllocations;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_TLSFMEMORYALLOCATOR_H_
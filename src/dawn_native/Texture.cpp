@@ -681,6 +681,10 @@ namespace dawn_native {
     void TextureBase::DestroyImpl() {
     }
 
+    void TextureBase::DestroyOnDeviceShutDown() {
+        DestroyInternal();
+    }
+
     void TextureBase::DestroyInternal() {
         DestroyImpl();
         mState = TextureState::Destroyed;
@@ -709,7 +713,7 @@ namespace dawn_native {
 
     // static
     TextureViewBase* TextureViewBase::MakeError(DeviceBase* device) {
-        return new TextureViewBase(device, ObjectBase::kError);
+        return new (device) TextureViewBase(device, ObjectBase::kError);
     }
 
     ObjectType TextureViewBase::GetType() const {
@@ -20,6 +20,7 @@
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
+#include "dawn_native/ObjectPool.h"
 #include "dawn_native/Subresource.h"
 
 #include "dawn_native/dawn_platform.h"
@@ -52,6 +53,7 @@ namespace dawn_native {
         static TextureBase* MakeError(DeviceBase* device);
 
         ObjectType GetType() const override;
+        void DestroyOnDeviceShutDown() override;
 
         wgpu::TextureDimension GetDimension() const;
         const Format& GetFormat() const;
@@ -116,7 +118,8 @@ namespace dawn_native {
         std::vector<bool> mIsSubresourceContentInitializedAtIndex;
     };
 
-    class TextureViewBase : public ApiObjectBase {
+    class TextureViewBase : public ApiObjectBase,
+                            public DevicePoolAllocated<ObjectType::TextureView> {
       public:
         TextureViewBase(TextureBase* texture, const TextureViewDescriptor* descriptor);
 
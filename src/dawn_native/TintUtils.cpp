@@ -22,9 +22,12 @@ namespace dawn_native {
     namespace {
 
         thread_local DeviceBase* tlDevice = nullptr;
+        thread_local DeferredShaderMessages* tlDeferredMessages = nullptr;
 
         void TintICEReporter(const tint::diag::List& diagnostics) {
-            if (tlDevice) {
+            if (tlDeferredMessages) {
+                tlDeferredMessages->internalCompilerErrors.push_back(diagnostics.str());
+            } else if (tlDevice) {
                 tlDevice->HandleError(InternalErrorType::Validation, diagnostics.str().c_str());
             }
         }
@@ -36,7 +39,8 @@ namespace dawn_native {
 
     }  // namespace
 
-    ScopedTintICEHandler::ScopedTintICEHandler(DeviceBase* device) {
+    ScopedTintICEHandler::ScopedTintICEHandler(DeviceBase* device)
+        : mCompileTimer(&device->GetStatistics()->tintCompileTimeNs) {
         // Call tint::SetInternalCompilerErrorReporter() the first time
         // this constructor is called. Static initialization is
         // guaranteed to be thread-safe, and only occur once.
@@ -52,4 +56,21 @@ namespace dawn_native {
         tlDevice = nullptr;
     }
 
+    ScopedDeferShaderMessages::ScopedDeferShaderMessages(DeferredShaderMessages* messages) {
+        ASSERT(tlDeferredMessages == nullptr);
+        tlDeferredMessages = messages;
+    }
+
+    ScopedDeferShaderMessages::~ScopedDeferShaderMessages() {
+        tlDeferredMessages = nullptr;
+    }
+
+    void EmitShaderLog(DeviceBase* device, WGPULoggingType loggingType, const char* message) {
+        if (tlDeferredMessages) {
+            tlDeferredMessages->logs.emplace_back(loggingType, message);
+        } else {
+            device->EmitLog(loggingType, message);
+        }
+    }
+
 }  // namespace dawn_native
\ No newline at end of file
@@ -16,13 +16,21 @@
 #define DAWNNATIVE_TINTUTILS_H_
 
 #include "common/NonCopyable.h"
+#include "dawn_native/DeviceStatistics.h"
+
+#include <dawn/webgpu.h>
+
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace dawn_native {
 
     class DeviceBase;
 
     // Indicates that for the lifetime of this object tint internal compiler errors should be
-    // reported to the given device.
+    // reported to the given device. Also accounts the lifetime of this object in the Tint
+    // compilation time statistic of the device, as it scopes all uses of Tint.
     class ScopedTintICEHandler : public NonCopyable {
       public:
         ScopedTintICEHandler(DeviceBase* device);
@@ -30,8 +38,34 @@ namespace dawn_native {
 
       private:
         ScopedTintICEHandler(ScopedTintICEHandler&&) = delete;
+
+        ScopedStatisticsTimer mCompileTimer;
     };
 
+    // The messages for the device produced while processing a shader away from the device's
+    // thread. The logging callback and the error handling of the device aren't thread-safe, so
+    // the messages are kept until they can be emitted from the device's thread.
+    struct DeferredShaderMessages {
+        std::vector<std::pair<WGPULoggingType, std::string>> logs;
+        std::vector<std::string> internalCompilerErrors;
+    };
+
+    // Indicates that for the lifetime of this object, the Tint internal compiler errors and the
+    // logs of EmitShaderLog on this thread are appended to |messages| instead of being sent to
+    // the device.
+    class ScopedDeferShaderMessages : public NonCopyable {
+      public:
+        explicit ScopedDeferShaderMessages(DeferredShaderMessages* messages);
+        ~ScopedDeferShaderMessages();
+
+      private:
+        ScopedDeferShaderMessages(ScopedDeferShaderMessages&&) = delete;
+    };
+
+    // Emits a log about a shader on |device|, or defers it if a ScopedDeferShaderMessages is
+    // alive on this thread.
+    void EmitShaderLog(DeviceBase* device, WGPULoggingType loggingType, const char* message);
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_TEXTURE_H_
\ No newline at end of file
@@ -99,6 +99,24 @@ namespace dawn_native {
               "backend will use D32S8 (toggle to on) but setting the toggle to off will make it"
               "use the D24S8 format when possible.",
               "https://crbug.com/dawn/286"}},
+            {Toggle::VulkanUseTimelineSemaphore,
+             {"vulkan_use_timeline_semaphore",
+              "Track the completion of the submits with the value of a single timeline semaphore "
+              "instead of a fence per submit. Enabled by default when VK_KHR_timeline_semaphore is "
+              "supported. Setting the toggle to off makes the backend use fences.",
+              "https://crbug.com/dawn/833"}},
+            {Toggle::VulkanUseSubmissionThread,
+             {"vulkan_use_submission_thread",
+              "Call vkQueueSubmit and check for completed commands on a thread owned by the device, "
+              "so that neither blocks the thread calling the API. Completed commands are seen by "
+              "the device the next time it is ticked after the thread noticed them.",
+              "https://crbug.com/dawn/833"}},
+            {Toggle::VulkanRecordRenderPassesInParallel,
+             {"vulkan_record_render_passes_in_parallel",
+              "Record the render passes of command buffers with more than one render pass in "
+              "secondary command buffers on worker threads, while the rest of the commands are "
+              "recorded in the primary command buffer.",
+              "https://crbug.com/dawn/826"}},
             {Toggle::MetalDisableSamplerCompare,
              {"metal_disable_sampler_compare",
               "Disables the use of sampler compare on Metal. This is unsupported before A9 "
@@ -228,6 +246,26 @@ namespace dawn_native {
               "be enabled for OpenGL ES backend, and serves as a workaround by default enabled on "
               "some Metal devices with Intel GPU to ensure the depth result is correct.",
               "https://crbug.com/dawn/136"}},
+            {Toggle::UseTLSFSubAllocator,
+             {"use_tlsf_suballocator",
+              "Sub-allocate resources in memory heaps with a two-level segregated fit allocator "
+              "instead of a buddy allocator. It doesn't round allocation sizes up to a "
+              "power-of-two which reduces the memory wasted by resources of arbitrary sizes.",
+              "https://crbug.com/dawn/849"}},
+            {Toggle::AsyncShaderModuleCreation,
+             {"async_shader_module_creation",
+              "Parse, validate and reflect shader modules on worker threads. Creating a shader "
+              "module returns immediately and pipeline creation waits for the module to be ready, "
+              "or does the work itself if it hasn't started. Errors in the shader are reported "
+              "when creating a pipeline with the module instead of when creating the module.",
+              "https://crbug.com/dawn/826"}},
+            {Toggle::EnableBuiltinTracing,
+             {"enable_builtin_tracing",
+              "Enables the trace event recorder built into the instance's dawn_platform::Platform "
+              "when the device is created. The recorder is shared by all the devices of the "
+              "instance and stays enabled after the device is destroyed. It has no effect if the "
+              "platform overrides the trace event methods.",
+              "https://crbug.com/dawn/826"}},
             // Dummy comment to separate the }} so it is clearer what to copy-paste to add a toggle.
         }};
     }  // anonymous namespace
@@ -35,6 +35,9 @@ namespace dawn_native {
         UseD3D12ResidencyManagement,
         SkipValidation,
         VulkanUseD32S8,
+        VulkanUseTimelineSemaphore,
+        VulkanUseSubmissionThread,
+        VulkanRecordRenderPassesInParallel,
         MetalDisableSamplerCompare,
         MetalUseSharedModeForCounterSampleBuffer,
         DisableBaseVertex,
@@ -61,6 +64,9 @@ namespace dawn_native {
         UseUserDefinedLabelsInBackend,
         DisableR8RG8Mipmaps,
         UseDummyFragmentInVertexOnlyPipeline,
+        UseTLSFSubAllocator,
+        AsyncShaderModuleCreation,
+        EnableBuiltinTracing,
 
         EnumCount,
         InvalidEnum = EnumCount,
@@ -97,7 +97,7 @@ namespace dawn_native { namespace d3d12 {
 
     // static
     ResultOrError<Ref<Buffer>> Buffer::Create(Device* device, const BufferDescriptor* descriptor) {
-        Ref<Buffer> buffer = AcquireRef(new Buffer(device, descriptor));
+        Ref<Buffer> buffer = AcquireRef(new (device) Buffer(device, descriptor));
         DAWN_TRY(buffer->Initialize(descriptor->mappedAtCreation));
         return buffer;
     }
@@ -640,7 +640,7 @@ namespace dawn_native { namespace d3d12 {
     // static
     Ref<CommandBuffer> CommandBuffer::Create(CommandEncoder* encoder,
                                              const CommandBufferDescriptor* descriptor) {
-        return AcquireRef(new CommandBuffer(encoder, descriptor));
+        return AcquireRef(new (encoder->GetDevice()) CommandBuffer(encoder, descriptor));
     }
 
     CommandBuffer::CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor)
@@ -1073,7 +1073,7 @@ namespace dawn_native { namespace d3d12 {
 
                 case Command::SetComputePipeline: {
                     SetComputePipelineCmd* cmd = mCommands.NextCommand<SetComputePipelineCmd>();
-                    ComputePipeline* pipeline = ToBackend(cmd->pipeline).Get();
+                    ComputePipeline* pipeline = ToBackend(cmd->pipeline);
 
                     commandList->SetPipelineState(pipeline->GetPipelineState());
 
@@ -1083,7 +1083,7 @@ namespace dawn_native { namespace d3d12 {
 
                 case Command::SetBindGroup: {
                     SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
-                    BindGroup* group = ToBackend(cmd->group.Get());
+                    BindGroup* group = ToBackend(cmd->group);
                     uint32_t* dynamicOffsets = nullptr;
 
                     if (cmd->dynamicOffsetCount > 0) {
@@ -1441,7 +1441,7 @@ namespace dawn_native { namespace d3d12 {
 
                 case Command::SetRenderPipeline: {
                     SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
+                    RenderPipeline* pipeline = ToBackend(cmd->pipeline);
 
                     commandList->SetPipelineState(pipeline->GetPipelineState());
                     commandList->IASetPrimitiveTopology(pipeline->GetD3D12PrimitiveTopology());
@@ -1454,7 +1454,7 @@ namespace dawn_native { namespace d3d12 {
 
                 case Command::SetBindGroup: {
                     SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
-                    BindGroup* group = ToBackend(cmd->group.Get());
+                    BindGroup* group = ToBackend(cmd->group);
                     uint32_t* dynamicOffsets = nullptr;
 
                     if (cmd->dynamicOffsetCount > 0) {
@@ -1481,7 +1481,7 @@ namespace dawn_native { namespace d3d12 {
                 case Command::SetVertexBuffer: {
                     SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
 
-                    vertexBufferTracker.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer.Get()),
+                    vertexBufferTracker.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer),
                                                           cmd->offset, cmd->size);
                     break;
                 }
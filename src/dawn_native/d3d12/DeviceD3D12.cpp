@@ -358,6 +358,10 @@ namespace dawn_native { namespace d3d12 {
         ShaderModuleParseResult* parseResult) {
         return ShaderModule::Create(this, descriptor, parseResult);
     }
+    Ref<ShaderModuleBase> Device::CreateUninitializedShaderModuleImpl(
+        const ShaderModuleDescriptor* descriptor) {
+        return ShaderModule::CreateUninitialized(this, descriptor);
+    }
     ResultOrError<Ref<SwapChainBase>> Device::CreateSwapChainImpl(
         const SwapChainDescriptor* descriptor) {
         return OldSwapChain::Create(this, descriptor);
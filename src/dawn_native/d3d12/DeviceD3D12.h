@@ -162,6 +162,8 @@ namespace dawn_native { namespace d3d12 {
         ResultOrError<Ref<ShaderModuleBase>> CreateShaderModuleImpl(
             const ShaderModuleDescriptor* descriptor,
             ShaderModuleParseResult* parseResult) override;
+        Ref<ShaderModuleBase> CreateUninitializedShaderModuleImpl(
+            const ShaderModuleDescriptor* descriptor) override;
         ResultOrError<Ref<SwapChainBase>> CreateSwapChainImpl(
             const SwapChainDescriptor* descriptor) override;
         ResultOrError<Ref<NewSwapChainBase>> CreateSwapChainImpl(
@@ -14,6 +14,8 @@
 
 #include "dawn_native/d3d12/ResourceAllocatorManagerD3D12.h"
 
+#include "dawn_native/BuddyMemoryAllocator.h"
+#include "dawn_native/TLSFMemoryAllocator.h"
 #include "dawn_native/d3d12/D3D12Error.h"
 #include "dawn_native/d3d12/DeviceD3D12.h"
 #include "dawn_native/d3d12/HeapAllocatorD3D12.h"
@@ -174,8 +176,13 @@ namespace dawn_native { namespace d3d12 {
                 GetMemorySegment(device, GetD3D12HeapType(resourceHeapKind)));
             mPooledHeapAllocators[i] =
                 std::make_unique<PooledResourceMemoryAllocator>(mHeapAllocators[i].get());
-            mSubAllocatedResourceAllocators[i] = std::make_unique<BuddyMemoryAllocator>(
-                kMaxHeapSize, kMinHeapSize, mPooledHeapAllocators[i].get());
+            if (mDevice->IsToggleEnabled(Toggle::UseTLSFSubAllocator)) {
+                mSubAllocatedResourceAllocators[i] = std::make_unique<TLSFMemoryAllocator>(
+                    kMaxHeapSize, kMinHeapSize, mPooledHeapAllocators[i].get());
+            } else {
+                mSubAllocatedResourceAllocators[i] = std::make_unique<BuddyMemoryAllocator>(
+                    kMaxHeapSize, kMinHeapSize, mPooledHeapAllocators[i].get());
+            }
         }
     }
 
@@ -302,7 +309,7 @@ namespace dawn_native { namespace d3d12 {
             return DAWN_OUT_OF_MEMORY_ERROR("Resource allocation size was invalid.");
         }
 
-        BuddyMemoryAllocator* allocator =
+        ResourceMemorySubAllocator* allocator =
             mSubAllocatedResourceAllocators[static_cast<size_t>(resourceHeapKind)].get();
 
         ResourceMemoryAllocation allocation;
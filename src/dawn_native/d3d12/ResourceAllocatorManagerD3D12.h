@@ -16,9 +16,9 @@
 #define DAWNNATIVE_D3D12_RESOURCEALLOCATORMANAGERD3D12_H_
 
 #include "common/SerialQueue.h"
-#include "dawn_native/BuddyMemoryAllocator.h"
 #include "dawn_native/IntegerTypes.h"
 #include "dawn_native/PooledResourceMemoryAllocator.h"
+#include "dawn_native/ResourceMemorySubAllocator.h"
 #include "dawn_native/d3d12/HeapAllocatorD3D12.h"
 #include "dawn_native/d3d12/ResourceHeapAllocationD3D12.h"
 
@@ -92,7 +92,7 @@ namespace dawn_native { namespace d3d12 {
         static constexpr uint64_t kMaxHeapSize = 32ll * 1024ll * 1024ll * 1024ll;  // 32GB
         static constexpr uint64_t kMinHeapSize = 4ll * 1024ll * 1024ll;            // 4MB
 
-        std::array<std::unique_ptr<BuddyMemoryAllocator>, ResourceHeapKind::EnumCount>
+        std::array<std::unique_ptr<ResourceMemorySubAllocator>, ResourceHeapKind::EnumCount>
             mSubAllocatedResourceAllocators;
         std::array<std::unique_ptr<HeapAllocator>, ResourceHeapKind::EnumCount> mHeapAllocators;
 
@@ -17,6 +17,7 @@
 #include "common/Assert.h"
 #include "common/BitSetIterator.h"
 #include "common/Log.h"
+#include "dawn_native/BoundsCheckAnalysis.h"
 #include "dawn_native/TintUtils.h"
 #include "dawn_native/d3d12/BindGroupLayoutD3D12.h"
 #include "dawn_native/d3d12/D3D12Error.h"
@@ -67,6 +68,10 @@ namespace dawn_native { namespace d3d12 {
             output << access;
         }
 
+        void Serialize(std::stringstream& output, uint64_t value) {
+            output << value;
+        }
+
         void Serialize(std::stringstream& output,
                        const tint::transform::BindingPoint& binding_point) {
             output << "(BindingPoint";
@@ -106,6 +111,7 @@ namespace dawn_native { namespace d3d12 {
             tint::transform::BindingRemapper::BindingPoints bindingPoints;
             tint::transform::BindingRemapper::AccessControls accessControls;
             bool isRobustnessEnabled;
+            MinBufferBindingSizes minBufferBindingSizes;
 
             // FXC/DXC common inputs
             bool disableWorkgroupInit;
@@ -125,7 +131,7 @@ namespace dawn_native { namespace d3d12 {
                 uint32_t compileFlags,
                 const Device* device,
                 const tint::Program* program,
-                const BindingInfoArray& moduleBindingInfo) {
+                const EntryPointMetadata& entryPoint) {
                 Compiler compiler;
                 uint64_t dxcVersion = 0;
                 if (device->IsToggleEnabled(Toggle::UseDXC)) {
@@ -147,7 +153,7 @@ namespace dawn_native { namespace d3d12 {
                 // assigned to each interface variable.
                 for (BindGroupIndex group : IterateBitSet(layout->GetBindGroupLayoutsMask())) {
                     const BindGroupLayout* bgl = ToBackend(layout->GetBindGroupLayout(group));
-                    const auto& groupBindingInfo = moduleBindingInfo[group];
+                    const auto& groupBindingInfo = entryPoint.bindings[group];
                     for (const auto& it : groupBindingInfo) {
                         BindingNumber binding = it.first;
                         auto const& bindingInfo = it.second;
@@ -187,6 +193,9 @@ namespace dawn_native { namespace d3d12 {
                 request.bindingPoints = std::move(bindingPoints);
                 request.accessControls = std::move(accessControls);
                 request.isRobustnessEnabled = device->IsRobustnessEnabled();
+                if (request.isRobustnessEnabled) {
+                    request.minBufferBindingSizes = GetMinBufferBindingSizes(entryPoint, layout);
+                }
                 request.disableWorkgroupInit =
                     device->IsToggleEnabled(Toggle::DisableWorkgroupInit);
                 request.fxcVersion = compiler == Compiler::FXC ? GetD3DCompilerVersion() : 0;
@@ -237,6 +246,10 @@ namespace dawn_native { namespace d3d12 {
                 stream << " shaderModel=" << deviceInfo->shaderModel;
                 stream << " disableWorkgroupInit=" << disableWorkgroupInit;
                 stream << " isRobustnessEnabled=" << isRobustnessEnabled;
+
+                stream << " minBufferBindingSizes=";
+                Serialize(stream, minBufferBindingSizes);
+
                 stream << " fxcVersion=" << fxcVersion;
                 stream << " dxcVersion=" << dxcVersion;
                 stream << " hasShaderFloat16Feature=" << hasShaderFloat16Feature;
@@ -380,7 +393,9 @@ namespace dawn_native { namespace d3d12 {
             tint::transform::DataMap transformInputs;
 
             if (request.isRobustnessEnabled) {
-                transformManager.Add<tint::transform::BoundArrayAccessors>();
+                transformManager.Add<ClampUnprovenIndexAccesses>();
+                transformInputs.Add<ClampUnprovenIndexAccesses::Config>(
+                    request.minBufferBindingSizes);
             }
             transformManager.Add<tint::transform::BindingRemapper>();
 
@@ -475,6 +490,12 @@ namespace dawn_native { namespace d3d12 {
         return module;
     }
 
+    // static
+    Ref<ShaderModule> ShaderModule::CreateUninitialized(Device* device,
+                                                        const ShaderModuleDescriptor* descriptor) {
+        return AcquireRef(new ShaderModule(device, descriptor));
+    }
+
     ShaderModule::ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor)
         : ShaderModuleBase(device, descriptor) {
     }
@@ -533,7 +554,7 @@ namespace dawn_native { namespace d3d12 {
         ShaderCompilationRequest request;
         DAWN_TRY_ASSIGN(request, ShaderCompilationRequest::Create(
                                      entryPointName, stage, layout, compileFlags, device, program,
-                                     GetEntryPoint(entryPointName).bindings));
+                                     GetEntryPoint(entryPointName)));
 
         PersistentCacheKey shaderCacheKey;
         DAWN_TRY_ASSIGN(shaderCacheKey, request.CreateCacheKey());
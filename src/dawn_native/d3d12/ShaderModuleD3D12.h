@@ -48,6 +48,8 @@ namespace dawn_native { namespace d3d12 {
         static ResultOrError<Ref<ShaderModule>> Create(Device* device,
                                                        const ShaderModuleDescriptor* descriptor,
                                                        ShaderModuleParseResult* parseResult);
+        static Ref<ShaderModule> CreateUninitialized(Device* device,
+                                                     const ShaderModuleDescriptor* descriptor);
 
         ResultOrError<CompiledShader> Compile(const char* entryPointName,
                                               SingleShaderStage stage,
@@ -57,7 +59,7 @@ namespace dawn_native { namespace d3d12 {
       private:
         ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
         ~ShaderModule() override = default;
-        MaybeError Initialize(ShaderModuleParseResult* parseResult);
+        MaybeError Initialize(ShaderModuleParseResult* parseResult) override;
     };
 
 }}  // namespace dawn_native::d3d12
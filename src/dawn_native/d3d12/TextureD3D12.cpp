@@ -1143,7 +1143,7 @@ namespace dawn_native { namespace d3d12 {
     // static
     Ref<TextureView> TextureView::Create(TextureBase* texture,
                                          const TextureViewDescriptor* descriptor) {
-        return AcquireRef(new TextureView(texture, descriptor));
+        return AcquireRef(new (texture->GetDevice()) TextureView(texture, descriptor));
     }
 
     TextureView::TextureView(TextureBase* texture, const TextureViewDescriptor* descriptor)
@@ -32,7 +32,7 @@ namespace dawn_native { namespace metal {
 
     // static
     ResultOrError<Ref<Buffer>> Buffer::Create(Device* device, const BufferDescriptor* descriptor) {
-        Ref<Buffer> buffer = AcquireRef(new Buffer(device, descriptor));
+        Ref<Buffer> buffer = AcquireRef(new (device) Buffer(device, descriptor));
         DAWN_TRY(buffer->Initialize(descriptor->mappedAtCreation));
         return std::move(buffer);
     }
@@ -664,7 +664,7 @@ namespace dawn_native { namespace metal {
     // static
     Ref<CommandBuffer> CommandBuffer::Create(CommandEncoder* encoder,
                                              const CommandBufferDescriptor* descriptor) {
-        return AcquireRef(new CommandBuffer(encoder, descriptor));
+        return AcquireRef(new (encoder->GetDevice()) CommandBuffer(encoder, descriptor));
     }
 
     MaybeError CommandBuffer::FillCommands(CommandRecordingContext* commandContext) {
@@ -1079,7 +1079,7 @@ namespace dawn_native { namespace metal {
 
                 case Command::SetComputePipeline: {
                     SetComputePipelineCmd* cmd = mCommands.NextCommand<SetComputePipelineCmd>();
-                    lastPipeline = ToBackend(cmd->pipeline).Get();
+                    lastPipeline = ToBackend(cmd->pipeline);
 
                     bindGroups.OnSetPipeline(lastPipeline);
 
@@ -1094,7 +1094,7 @@ namespace dawn_native { namespace metal {
                         dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
                     }
 
-                    bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group.Get()),
+                    bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group),
                                               cmd->dynamicOffsetCount, dynamicOffsets);
                     break;
                 }
@@ -1381,7 +1381,7 @@ namespace dawn_native { namespace metal {
 
                 case Command::SetRenderPipeline: {
                     SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    RenderPipeline* newPipeline = ToBackend(cmd->pipeline).Get();
+                    RenderPipeline* newPipeline = ToBackend(cmd->pipeline);
 
                     vertexBuffers.OnSetPipeline(lastPipeline, newPipeline);
                     bindGroups.OnSetPipeline(newPipeline);
@@ -1410,14 +1410,14 @@ namespace dawn_native { namespace metal {
                         dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
                     }
 
-                    bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group.Get()),
+                    bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group),
                                               cmd->dynamicOffsetCount, dynamicOffsets);
                     break;
                 }
 
                 case Command::SetIndexBuffer: {
                     SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                    auto b = ToBackend(cmd->buffer.Get());
+                    auto b = ToBackend(cmd->buffer);
                     indexBuffer = b->GetMTLBuffer();
                     indexBufferBaseOffset = cmd->offset;
                     indexBufferType = MTLIndexFormat(cmd->format);
@@ -1428,8 +1428,7 @@ namespace dawn_native { namespace metal {
                 case Command::SetVertexBuffer: {
                     SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
 
-                    vertexBuffers.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer.Get()),
-                                                    cmd->offset);
+                    vertexBuffers.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer), cmd->offset);
                     break;
                 }
 
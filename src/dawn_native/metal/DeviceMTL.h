@@ -102,6 +102,8 @@ namespace dawn_native { namespace metal {
         ResultOrError<Ref<ShaderModuleBase>> CreateShaderModuleImpl(
             const ShaderModuleDescriptor* descriptor,
             ShaderModuleParseResult* parseResult) override;
+        Ref<ShaderModuleBase> CreateUninitializedShaderModuleImpl(
+            const ShaderModuleDescriptor* descriptor) override;
         ResultOrError<Ref<SwapChainBase>> CreateSwapChainImpl(
             const SwapChainDescriptor* descriptor) override;
         ResultOrError<Ref<NewSwapChainBase>> CreateSwapChainImpl(
@@ -267,6 +267,10 @@ namespace dawn_native { namespace metal {
         ShaderModuleParseResult* parseResult) {
         return ShaderModule::Create(this, descriptor, parseResult);
     }
+    Ref<ShaderModuleBase> Device::CreateUninitializedShaderModuleImpl(
+        const ShaderModuleDescriptor* descriptor) {
+        return ShaderModule::CreateUninitialized(this, descriptor);
+    }
     ResultOrError<Ref<SwapChainBase>> Device::CreateSwapChainImpl(
         const SwapChainDescriptor* descriptor) {
         return OldSwapChain::Create(this, descriptor);
@@ -33,6 +33,8 @@ namespace dawn_native { namespace metal {
         static ResultOrError<Ref<ShaderModule>> Create(Device* device,
                                                        const ShaderModuleDescriptor* descriptor,
                                                        ShaderModuleParseResult* parseResult);
+        static Ref<ShaderModule> CreateUninitialized(Device* device,
+                                                     const ShaderModuleDescriptor* descriptor);
 
         struct MetalFunctionData {
             NSPRef<id<MTLFunction>> function;
@@ -58,7 +60,7 @@ namespace dawn_native { namespace metal {
                                                   std::vector<uint32_t>* workgroupAllocations);
         ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
         ~ShaderModule() override = default;
-        MaybeError Initialize(ShaderModuleParseResult* parseResult);
+        MaybeError Initialize(ShaderModuleParseResult* parseResult) override;
     };
 
 }}  // namespace dawn_native::metal
@@ -15,6 +15,7 @@
 #include "dawn_native/metal/ShaderModuleMTL.h"
 
 #include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/BoundsCheckAnalysis.h"
 #include "dawn_native/TintUtils.h"
 #include "dawn_native/metal/DeviceMTL.h"
 #include "dawn_native/metal/PipelineLayoutMTL.h"
@@ -35,6 +36,12 @@ namespace dawn_native { namespace metal {
         return module;
     }
 
+    // static
+    Ref<ShaderModule> ShaderModule::CreateUninitialized(Device* device,
+                                                        const ShaderModuleDescriptor* descriptor) {
+        return AcquireRef(new ShaderModule(device, descriptor));
+    }
+
     ShaderModule::ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor)
         : ShaderModuleBase(device, descriptor) {
     }
@@ -118,7 +125,11 @@ namespace dawn_native { namespace metal {
             }
         }
         if (GetDevice()->IsRobustnessEnabled()) {
-            transformManager.Add<tint::transform::BoundArrayAccessors>();
+            // The accesses to the vertex buffers added by vertex pulling use bindings that aren't
+            // in the layout, so they are always clamped.
+            transformManager.Add<ClampUnprovenIndexAccesses>();
+            transformInputs.Add<ClampUnprovenIndexAccesses::Config>(
+                GetMinBufferBindingSizes(GetEntryPoint(entryPointName), layout));
         }
         transformManager.Add<tint::transform::BindingRemapper>();
         transformManager.Add<tint::transform::Renamer>();
@@ -105,12 +105,12 @@ namespace dawn_native { namespace null {
     }
     ResultOrError<Ref<BufferBase>> Device::CreateBufferImpl(const BufferDescriptor* descriptor) {
         DAWN_TRY(IncrementMemoryUsage(descriptor->size));
-        return AcquireRef(new Buffer(this, descriptor));
+        return AcquireRef(new (this) Buffer(this, descriptor));
     }
     ResultOrError<Ref<CommandBufferBase>> Device::CreateCommandBuffer(
         CommandEncoder* encoder,
         const CommandBufferDescriptor* descriptor) {
-        return AcquireRef(new CommandBuffer(encoder, descriptor));
+        return AcquireRef(new (this) CommandBuffer(encoder, descriptor));
     }
     ResultOrError<Ref<ComputePipelineBase>> Device::CreateComputePipelineImpl(
         const ComputePipelineDescriptor* descriptor) {
@@ -138,6 +138,10 @@ namespace dawn_native { namespace null {
         DAWN_TRY(module->Initialize(parseResult));
         return module;
     }
+    Ref<ShaderModuleBase> Device::CreateUninitializedShaderModuleImpl(
+        const ShaderModuleDescriptor* descriptor) {
+        return AcquireRef(new ShaderModule(this, descriptor));
+    }
     ResultOrError<Ref<SwapChainBase>> Device::CreateSwapChainImpl(
         const SwapChainDescriptor* descriptor) {
         return AcquireRef(new OldSwapChain(this, descriptor));
@@ -154,7 +158,7 @@ namespace dawn_native { namespace null {
     ResultOrError<Ref<TextureViewBase>> Device::CreateTextureViewImpl(
         TextureBase* texture,
         const TextureViewDescriptor* descriptor) {
-        return AcquireRef(new TextureView(texture, descriptor));
+        return AcquireRef(new (this) TextureView(texture, descriptor));
     }
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
@@ -142,6 +142,8 @@ namespace dawn_native { namespace null {
         ResultOrError<Ref<ShaderModuleBase>> CreateShaderModuleImpl(
             const ShaderModuleDescriptor* descriptor,
             ShaderModuleParseResult* parseResult) override;
+        Ref<ShaderModuleBase> CreateUninitializedShaderModuleImpl(
+            const ShaderModuleDescriptor* descriptor) override;
         ResultOrError<Ref<SwapChainBase>> CreateSwapChainImpl(
             const SwapChainDescriptor* descriptor) override;
         ResultOrError<Ref<NewSwapChainBase>> CreateSwapChainImpl(
@@ -262,7 +264,7 @@ namespace dawn_native { namespace null {
       public:
         using ShaderModuleBase::ShaderModuleBase;
 
-        MaybeError Initialize(ShaderModuleParseResult* parseResult);
+        MaybeError Initialize(ShaderModuleParseResult* parseResult) override;
     };
 
     class SwapChain final : public NewSwapChainBase {
@@ -25,7 +25,7 @@ namespace dawn_native { namespace opengl {
     ResultOrError<Ref<Buffer>> Buffer::CreateInternalBuffer(Device* device,
                                                             const BufferDescriptor* descriptor,
                                                             bool shouldLazyClear) {
-        Ref<Buffer> buffer = AcquireRef(new Buffer(device, descriptor, shouldLazyClear));
+        Ref<Buffer> buffer = AcquireRef(new (device) Buffer(device, descriptor, shouldLazyClear));
         if (descriptor->mappedAtCreation) {
             DAWN_TRY(buffer->MapAtCreationInternal());
         }
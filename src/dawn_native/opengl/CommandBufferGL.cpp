@@ -910,7 +910,7 @@ namespace dawn_native { namespace opengl {
 
                 case Command::SetComputePipeline: {
                     SetComputePipelineCmd* cmd = mCommands.NextCommand<SetComputePipelineCmd>();
-                    lastPipeline = ToBackend(cmd->pipeline).Get();
+                    lastPipeline = ToBackend(cmd->pipeline);
                     lastPipeline->ApplyNow();
 
                     bindGroupTracker.OnSetPipeline(lastPipeline);
@@ -923,7 +923,7 @@ namespace dawn_native { namespace opengl {
                     if (cmd->dynamicOffsetCount > 0) {
                         dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
                     }
-                    bindGroupTracker.OnSetBindGroup(cmd->index, cmd->group.Get(),
+                    bindGroupTracker.OnSetBindGroup(cmd->index, cmd->group,
                                                     cmd->dynamicOffsetCount, dynamicOffsets);
                     break;
                 }
@@ -1212,7 +1212,7 @@ namespace dawn_native { namespace opengl {
 
                 case Command::SetRenderPipeline: {
                     SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    lastPipeline = ToBackend(cmd->pipeline).Get();
+                    lastPipeline = ToBackend(cmd->pipeline);
                     lastPipeline->ApplyNow(persistentPipelineState);
 
                     vertexStateBufferBindingTracker.OnSetPipeline(lastPipeline);
@@ -1226,7 +1226,7 @@ namespace dawn_native { namespace opengl {
                     if (cmd->dynamicOffsetCount > 0) {
                         dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
                     }
-                    bindGroupTracker.OnSetBindGroup(cmd->index, cmd->group.Get(),
+                    bindGroupTracker.OnSetBindGroup(cmd->index, cmd->group,
                                                     cmd->dynamicOffsetCount, dynamicOffsets);
                     break;
                 }
@@ -1237,13 +1237,13 @@ namespace dawn_native { namespace opengl {
                     indexBufferBaseOffset = cmd->offset;
                     indexBufferFormat = IndexFormatType(cmd->format);
                     indexFormatSize = IndexFormatSize(cmd->format);
-                    vertexStateBufferBindingTracker.OnSetIndexBuffer(cmd->buffer.Get());
+                    vertexStateBufferBindingTracker.OnSetIndexBuffer(cmd->buffer);
                     break;
                 }
 
                 case Command::SetVertexBuffer: {
                     SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
-                    vertexStateBufferBindingTracker.OnSetVertexBuffer(cmd->slot, cmd->buffer.Get(),
+                    vertexStateBufferBindingTracker.OnSetVertexBuffer(cmd->slot, cmd->buffer,
                                                                       cmd->offset);
                     break;
                 }
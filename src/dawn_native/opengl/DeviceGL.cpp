@@ -123,12 +123,12 @@ namespace dawn_native { namespace opengl {
         return AcquireRef(new BindGroupLayout(this, descriptor, pipelineCompatibilityToken));
     }
     ResultOrError<Ref<BufferBase>> Device::CreateBufferImpl(const BufferDescriptor* descriptor) {
-        return AcquireRef(new Buffer(this, descriptor));
+        return AcquireRef(new (this) Buffer(this, descriptor));
     }
     ResultOrError<Ref<CommandBufferBase>> Device::CreateCommandBuffer(
         CommandEncoder* encoder,
         const CommandBufferDescriptor* descriptor) {
-        return AcquireRef(new CommandBuffer(encoder, descriptor));
+        return AcquireRef(new (this) CommandBuffer(encoder, descriptor));
     }
     ResultOrError<Ref<ComputePipelineBase>> Device::CreateComputePipelineImpl(
         const ComputePipelineDescriptor* descriptor) {
@@ -154,6 +154,10 @@ namespace dawn_native { namespace opengl {
         ShaderModuleParseResult* parseResult) {
         return ShaderModule::Create(this, descriptor, parseResult);
     }
+    Ref<ShaderModuleBase> Device::CreateUninitializedShaderModuleImpl(
+        const ShaderModuleDescriptor* descriptor) {
+        return ShaderModule::CreateUninitialized(this, descriptor);
+    }
     ResultOrError<Ref<SwapChainBase>> Device::CreateSwapChainImpl(
         const SwapChainDescriptor* descriptor) {
         return AcquireRef(new SwapChain(this, descriptor));
@@ -170,7 +174,7 @@ namespace dawn_native { namespace opengl {
     ResultOrError<Ref<TextureViewBase>> Device::CreateTextureViewImpl(
         TextureBase* texture,
         const TextureViewDescriptor* descriptor) {
-        return AcquireRef(new TextureView(texture, descriptor));
+        return AcquireRef(new (this) TextureView(texture, descriptor));
     }
 
     void Device::SubmitFenceSync() {
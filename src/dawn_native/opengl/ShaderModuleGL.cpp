@@ -232,6 +232,12 @@ namespace dawn_native { namespace opengl {
         return module;
     }
 
+    // static
+    Ref<ShaderModule> ShaderModule::CreateUninitialized(Device* device,
+                                                        const ShaderModuleDescriptor* descriptor) {
+        return AcquireRef(new ShaderModule(device, descriptor));
+    }
+
     ShaderModule::ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor)
         : ShaderModuleBase(device, descriptor) {
     }
@@ -52,6 +52,8 @@ namespace dawn_native { namespace opengl {
         static ResultOrError<Ref<ShaderModule>> Create(Device* device,
                                                        const ShaderModuleDescriptor* descriptor,
                                                        ShaderModuleParseResult* parseResult);
+        static Ref<ShaderModule> CreateUninitialized(Device* device,
+                                                     const ShaderModuleDescriptor* descriptor);
 
         ResultOrError<std::string> TranslateToGLSL(const char* entryPointName,
                                                    SingleShaderStage stage,
@@ -62,7 +64,7 @@ namespace dawn_native { namespace opengl {
       private:
         ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
         ~ShaderModule() override = default;
-        MaybeError Initialize(ShaderModuleParseResult* parseResult);
+        MaybeError Initialize(ShaderModuleParseResult* parseResult) override;
         static ResultOrError<BindingInfoArrayTable> ReflectShaderUsingSPIRVCross(
             DeviceBase* device,
             const std::vector<uint32_t>& spirv);
@@ -15,7 +15,10 @@
 #include "dawn_native/vulkan/BindGroupLayoutVk.h"
 
 #include "common/BitSetIterator.h"
+#include "common/HashUtils.h"
 #include "common/ityp_vector.h"
+#include "dawn_native/ExternalTexture.h"
+#include "dawn_native/Sampler.h"
 #include "dawn_native/vulkan/BindGroupVk.h"
 #include "dawn_native/vulkan/DescriptorSetAllocator.h"
 #include "dawn_native/vulkan/DeviceVk.h"
@@ -44,6 +47,40 @@ namespace dawn_native { namespace vulkan {
             return flags;
         }
 
+        // Gets the resources that determine the content of the descriptor set of |bindGroup|.
+        void GetDescriptorSetResources(
+            BindGroup* bindGroup,
+            std::vector<BindGroupLayout::CachedDescriptorSet::Resource>* resources) {
+            const BindGroupLayoutBase* layout = bindGroup->GetLayout();
+            resources->resize(static_cast<uint32_t>(layout->GetBindingCount()));
+
+            for (BindingIndex bindingIndex{0}; bindingIndex < layout->GetBindingCount();
+                 ++bindingIndex) {
+                auto& resource = (*resources)[static_cast<uint32_t>(bindingIndex)];
+                resource = {};
+
+                switch (layout->GetBindingInfo(bindingIndex).bindingType) {
+                    case BindingInfoType::Buffer: {
+                        BufferBinding binding = bindGroup->GetBindingAsBufferBinding(bindingIndex);
+                        resource.object = binding.buffer;
+                        resource.offset = binding.offset;
+                        resource.size = binding.size;
+                        break;
+                    }
+                    case BindingInfoType::Sampler:
+                        resource.object = bindGroup->GetBindingAsSampler(bindingIndex);
+                        break;
+                    case BindingInfoType::Texture:
+                    case BindingInfoType::StorageTexture:
+                        resource.object = bindGroup->GetBindingAsTextureView(bindingIndex);
+                        break;
+                    case BindingInfoType::ExternalTexture:
+                        resource.object = bindGroup->GetBindingAsExternalTexture(bindingIndex);
+                        break;
+                }
+            }
+        }
+
     }  // anonymous namespace
 
     VkDescriptorType VulkanDescriptorType(const BindingInfo& bindingInfo) {
@@ -138,9 +175,45 @@ namespace dawn_native { namespace vulkan {
         // counts.
         mDescriptorSetAllocator =
             std::make_unique<DescriptorSetAllocator>(this, std::move(descriptorCountPerType));
+
+        if (device->GetDeviceInfo().HasExt(DeviceExt::DescriptorUpdateTemplate) &&
+            GetBindingCount() > BindingIndex(0)) {
+            DAWN_TRY(InitializeUpdateTemplate());
+        }
         return {};
     }
 
+    MaybeError BindGroupLayout::InitializeUpdateTemplate() {
+        ityp::vector<BindingIndex, VkDescriptorUpdateTemplateEntry> entries(GetBindingCount());
+        for (BindingIndex bindingIndex{0}; bindingIndex < GetBindingCount(); ++bindingIndex) {
+            VkDescriptorUpdateTemplateEntry& entry = entries[bindingIndex];
+            entry.dstBinding = static_cast<uint32_t>(bindingIndex);
+            entry.dstArrayElement = 0;
+            entry.descriptorCount = 1;
+            entry.descriptorType = VulkanDescriptorType(GetBindingInfo(bindingIndex));
+            entry.offset = static_cast<uint32_t>(bindingIndex) * sizeof(DescriptorWriteData);
+            entry.stride = sizeof(DescriptorWriteData);
+        }
+
+        VkDescriptorUpdateTemplateCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+        createInfo.pDescriptorUpdateEntries = entries.data();
+        createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        createInfo.descriptorSetLayout = mHandle;
+        // The following are only used for VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR.
+        createInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        createInfo.pipelineLayout = VK_NULL_HANDLE;
+        createInfo.set = 0;
+
+        Device* device = ToBackend(GetDevice());
+        return CheckVkSuccess(device->fn.CreateDescriptorUpdateTemplate(
+                                  device->GetVkDevice(), &createInfo, nullptr, &*mUpdateTemplate),
+                              "CreateDescriptorUpdateTemplate");
+    }
+
     BindGroupLayout::BindGroupLayout(DeviceBase* device,
                                      const BindGroupLayoutDescriptor* descriptor,
                                      PipelineCompatibilityToken pipelineCompatibilityToken)
@@ -161,30 +234,151 @@ namespace dawn_native { namespace vulkan {
             device->fn.DestroyDescriptorSetLayout(device->GetVkDevice(), mHandle, nullptr);
             mHandle = VK_NULL_HANDLE;
         }
+        // Same for the update template, which is only used on the host.
+        if (mUpdateTemplate != VK_NULL_HANDLE) {
+            device->fn.DestroyDescriptorUpdateTemplate(device->GetVkDevice(), mUpdateTemplate,
+                                                       nullptr);
+            mUpdateTemplate = VK_NULL_HANDLE;
+        }
+
+        // Drop the unused sets. The GPU might still be using some of them, but their pools are
+        // deleted with the FencedDeleter.
+        while (!mUnusedDescriptorSets.empty()) {
+            CachedDescriptorSet* descriptorSet = mUnusedDescriptorSets.head()->value();
+            descriptorSet->RemoveFromList();
+            mDescriptorSetCache.erase(descriptorSet);
+            mDescriptorSetAllocator->DeallocateOnDestruction(&descriptorSet->allocation);
+            delete descriptorSet;
+        }
+        mUnusedDescriptorSetCount = 0;
+
+        ASSERT(mDescriptorSetCache.empty());
     }
 
     VkDescriptorSetLayout BindGroupLayout::GetHandle() const {
         return mHandle;
     }
 
+    VkDescriptorUpdateTemplate BindGroupLayout::GetUpdateTemplate() const {
+        return mUpdateTemplate;
+    }
+
     ResultOrError<Ref<BindGroup>> BindGroupLayout::AllocateBindGroup(
         Device* device,
         const BindGroupDescriptor* descriptor) {
-        DescriptorSetAllocation descriptorSetAllocation;
-        DAWN_TRY_ASSIGN(descriptorSetAllocation, mDescriptorSetAllocator->Allocate());
+        Ref<BindGroup> bindGroup = AcquireRef(mBindGroupAllocator.Allocate(device, descriptor));
 
-        return AcquireRef(
-            mBindGroupAllocator.Allocate(device, descriptor, descriptorSetAllocation));
+        GetDescriptorSetResources(bindGroup.Get(), &mLookupBlueprint.resources);
+        mLookupBlueprint.contentHash = mLookupBlueprint.ComputeContentHash();
+
+        CachedDescriptorSet* descriptorSet;
+        auto iter = mDescriptorSetCache.find(&mLookupBlueprint);
+        if (iter != mDescriptorSetCache.end()) {
+            descriptorSet = *iter;
+            if (descriptorSet->refCount == 0) {
+                // The set has the same content so it can be used again even if the GPU isn't
+                // done with it. The bind group now keeps its resources alive.
+                descriptorSet->RemoveFromList();
+                mUnusedDescriptorSetCount--;
+                descriptorSet->retainedResources.clear();
+            }
+        } else {
+            descriptorSet = RecycleUnusedDescriptorSet();
+            if (descriptorSet == nullptr) {
+                DescriptorSetAllocation allocation;
+                DAWN_TRY_ASSIGN(allocation, mDescriptorSetAllocator->Allocate());
+                descriptorSet = new CachedDescriptorSet();
+                descriptorSet->allocation = allocation;
+            }
+            bindGroup->WriteDescriptorSet(descriptorSet->allocation.set);
+
+            // Swap the vectors so that the blueprint reuses the storage of the recycled set.
+            std::swap(descriptorSet->resources, mLookupBlueprint.resources);
+            descriptorSet->contentHash = mLookupBlueprint.contentHash;
+            mDescriptorSetCache.insert(descriptorSet);
+        }
+
+        descriptorSet->refCount++;
+        bindGroup->SetDescriptorSet(descriptorSet);
+        return bindGroup;
     }
 
     void BindGroupLayout::DeallocateBindGroup(BindGroup* bindGroup,
-                                              DescriptorSetAllocation* descriptorSetAllocation) {
-        mDescriptorSetAllocator->Deallocate(descriptorSetAllocation);
+                                              CachedDescriptorSet* descriptorSet) {
+        // The descriptor set is null if the bind group failed to allocate it.
+        if (descriptorSet != nullptr) {
+            ASSERT(descriptorSet->refCount > 0);
+            descriptorSet->refCount--;
+            if (descriptorSet->refCount == 0) {
+                // The bind group still references the resources at this point.
+                for (const CachedDescriptorSet::Resource& resource : descriptorSet->resources) {
+                    descriptorSet->retainedResources.emplace_back(resource.object);
+                }
+                descriptorSet->lastUsageSerial =
+                    ToBackend(GetDevice())->GetPendingCommandSerial();
+                mUnusedDescriptorSets.Append(descriptorSet);
+                mUnusedDescriptorSetCount++;
+
+                if (mUnusedDescriptorSetCount > kMaxUnusedDescriptorSets) {
+                    EvictUnusedDescriptorSet(mUnusedDescriptorSets.head()->value());
+                }
+            }
+        }
         mBindGroupAllocator.Deallocate(bindGroup);
     }
 
+    BindGroupLayout::CachedDescriptorSet* BindGroupLayout::RecycleUnusedDescriptorSet() {
+        if (mUnusedDescriptorSets.empty()) {
+            return nullptr;
+        }
+
+        CachedDescriptorSet* descriptorSet = mUnusedDescriptorSets.head()->value();
+        if (descriptorSet->lastUsageSerial > GetDevice()->GetCompletedCommandSerial()) {
+            return nullptr;
+        }
+
+        descriptorSet->RemoveFromList();
+        mUnusedDescriptorSetCount--;
+        mDescriptorSetCache.erase(descriptorSet);
+        descriptorSet->retainedResources.clear();
+        return descriptorSet;
+    }
+
+    void BindGroupLayout::EvictUnusedDescriptorSet(CachedDescriptorSet* descriptorSet) {
+        ASSERT(descriptorSet->refCount == 0);
+        descriptorSet->RemoveFromList();
+        mUnusedDescriptorSetCount--;
+        mDescriptorSetCache.erase(descriptorSet);
+        // The allocator waits for the GPU to be done with the set before reusing it.
+        mDescriptorSetAllocator->Deallocate(&descriptorSet->allocation);
+        delete descriptorSet;
+    }
+
     void BindGroupLayout::FinishDeallocation(ExecutionSerial completedSerial) {
         mDescriptorSetAllocator->FinishDeallocation(completedSerial);
     }
 
+    bool BindGroupLayout::CachedDescriptorSet::Resource::operator==(const Resource& other) const {
+        return object == other.object && offset == other.offset && size == other.size;
+    }
+
+    size_t BindGroupLayout::CachedDescriptorSet::ComputeContentHash() const {
+        size_t hash = Hash(resources.size());
+        for (const Resource& resource : resources) {
+            HashCombine(&hash, resource.object, resource.offset, resource.size);
+        }
+        return hash;
+    }
+
+    size_t BindGroupLayout::CachedDescriptorSet::HashFunc::operator()(
+        const CachedDescriptorSet* set) const {
+        return set->contentHash;
+    }
+
+    bool BindGroupLayout::CachedDescriptorSet::EqualityFunc::operator()(
+        const CachedDescriptorSet* a,
+        const CachedDescriptorSet* b) const {
+        return a->resources == b->resources;
+    }
+
 }}  // namespace dawn_native::vulkan
@@ -17,20 +17,33 @@
 
 #include "dawn_native/BindGroupLayout.h"
 
+#include "common/LinkedList.h"
 #include "common/SlabAllocator.h"
 #include "common/vulkan_platform.h"
+#include "dawn_native/IntegerTypes.h"
+#include "dawn_native/vulkan/DescriptorSetAllocation.h"
 
+#include <unordered_set>
 #include <vector>
 
 namespace dawn_native { namespace vulkan {
 
     class BindGroup;
-    struct DescriptorSetAllocation;
     class DescriptorSetAllocator;
     class Device;
 
     VkDescriptorType VulkanDescriptorType(const BindingInfo& bindingInfo);
 
+    // The data written to the descriptor of a binding. The VkDescriptorUpdateTemplate of a layout
+    // reads an array of them indexed by BindingIndex.
+    union DescriptorWriteData {
+        DescriptorWriteData() : buffer() {
+        }
+
+        VkDescriptorBufferInfo buffer;
+        VkDescriptorImageInfo image;
+    };
+
     // In Vulkan descriptor pools have to be sized to an exact number of descriptors. This means
     // it's hard to have something where we can mix different types of descriptor sets because
     // we don't know if their vector of number of descriptors will be similar.
@@ -55,21 +68,77 @@ namespace dawn_native { namespace vulkan {
                         PipelineCompatibilityToken pipelineCompatibilityToken);
 
         VkDescriptorSetLayout GetHandle() const;
+        // VK_NULL_HANDLE when VK_KHR_descriptor_update_template isn't available.
+        VkDescriptorUpdateTemplate GetUpdateTemplate() const;
+
+        // Bind groups of the layout that have the same resources share a descriptor set, so that
+        // recreating an identical bind group doesn't write descriptors again. Sets no longer used
+        // by any bind group stay in the cache, in least recently used order, until they are
+        // reused by an identical bind group, recycled for different resources once the GPU is
+        // done with them, or evicted.
+        struct CachedDescriptorSet : public LinkNode<CachedDescriptorSet> {
+            // The resource of a binding. It is kept alive by the bind groups using the set, or by
+            // retainedResources while the set is unused.
+            struct Resource {
+                ObjectBase* object;
+                uint64_t offset;
+                uint64_t size;
+
+                bool operator==(const Resource& other) const;
+            };
+            struct HashFunc {
+                size_t operator()(const CachedDescriptorSet* set) const;
+            };
+            struct EqualityFunc {
+                bool operator()(const CachedDescriptorSet* a, const CachedDescriptorSet* b) const;
+            };
+
+            // Computed once when the set is looked up and returned by HashFunc.
+            size_t ComputeContentHash() const;
+
+            std::vector<Resource> resources;
+            size_t contentHash = 0;
+            DescriptorSetAllocation allocation;
+            uint32_t refCount = 0;
+
+            // Only used while the set is unused. The resources are referenced so that their
+            // addresses can't be reused by other objects while the set is in the cache.
+            std::vector<Ref<ObjectBase>> retainedResources;
+            ExecutionSerial lastUsageSerial = ExecutionSerial(0);
+        };
 
         ResultOrError<Ref<BindGroup>> AllocateBindGroup(Device* device,
                                                         const BindGroupDescriptor* descriptor);
-        void DeallocateBindGroup(BindGroup* bindGroup,
-                                 DescriptorSetAllocation* descriptorSetAllocation);
+        void DeallocateBindGroup(BindGroup* bindGroup, CachedDescriptorSet* descriptorSet);
         void FinishDeallocation(ExecutionSerial completedSerial);
 
       private:
         ~BindGroupLayout() override;
         MaybeError Initialize();
+        MaybeError InitializeUpdateTemplate();
+
+        // Returns the least recently used unused set, removed from the cache, if the GPU is done
+        // with it so that it can be written with other resources. Returns nullptr otherwise.
+        CachedDescriptorSet* RecycleUnusedDescriptorSet();
+        void EvictUnusedDescriptorSet(CachedDescriptorSet* descriptorSet);
 
         VkDescriptorSetLayout mHandle = VK_NULL_HANDLE;
+        VkDescriptorUpdateTemplate mUpdateTemplate = VK_NULL_HANDLE;
 
         SlabAllocator<BindGroup> mBindGroupAllocator;
         std::unique_ptr<DescriptorSetAllocator> mDescriptorSetAllocator;
+        std::unordered_set<CachedDescriptorSet*,
+                           CachedDescriptorSet::HashFunc,
+                           CachedDescriptorSet::EqualityFunc>
+            mDescriptorSetCache;
+
+        // The sets of mDescriptorSetCache that no bind group uses, least recently used first.
+        static constexpr uint32_t kMaxUnusedDescriptorSets = 32;
+        LinkedList<CachedDescriptorSet> mUnusedDescriptorSets;
+        uint32_t mUnusedDescriptorSetCount = 0;
+
+        // Reused for every lookup so that its vector of resources keeps its capacity.
+        CachedDescriptorSet mLookupBlueprint;
     };
 
 }}  // namespace dawn_native::vulkan
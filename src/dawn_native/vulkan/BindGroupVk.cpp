@@ -15,6 +15,7 @@
 #include "dawn_native/vulkan/BindGroupVk.h"
 
 #include "common/BitSetIterator.h"
+#include "common/ityp_bitset.h"
 #include "common/ityp_stack_vec.h"
 #include "dawn_native/ExternalTexture.h"
 #include "dawn_native/vulkan/BindGroupLayoutVk.h"
@@ -33,34 +34,25 @@ namespace dawn_native { namespace vulkan {
         return ToBackend(descriptor->layout)->AllocateBindGroup(device, descriptor);
     }
 
-    BindGroup::BindGroup(Device* device,
-                         const BindGroupDescriptor* descriptor,
-                         DescriptorSetAllocation descriptorSetAllocation)
-        : BindGroupBase(this, device, descriptor),
-          mDescriptorSetAllocation(descriptorSetAllocation) {
-        // Now do a write of a single descriptor set with all possible chained data allocated on the
-        // stack.
-        const uint32_t bindingCount = static_cast<uint32_t>((GetLayout()->GetBindingCount()));
-        ityp::stack_vec<uint32_t, VkWriteDescriptorSet, kMaxOptimalBindingsPerGroup> writes(
-            bindingCount);
-        ityp::stack_vec<uint32_t, VkDescriptorBufferInfo, kMaxOptimalBindingsPerGroup>
-            writeBufferInfo(bindingCount);
-        ityp::stack_vec<uint32_t, VkDescriptorImageInfo, kMaxOptimalBindingsPerGroup>
-            writeImageInfo(bindingCount);
+    BindGroup::BindGroup(Device* device, const BindGroupDescriptor* descriptor)
+        : BindGroupBase(this, device, descriptor) {
+    }
 
-        uint32_t numWrites = 0;
-        for (const auto& it : GetLayout()->GetBindingMap()) {
-            BindingIndex bindingIndex = it.second;
-            const BindingInfo& bindingInfo = GetLayout()->GetBindingInfo(bindingIndex);
+    void BindGroup::WriteDescriptorSet(VkDescriptorSet set) {
+        Device* device = ToBackend(GetDevice());
+        BindGroupLayout* layout = ToBackend(GetLayout());
 
-            auto& write = writes[numWrites];
-            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            write.pNext = nullptr;
-            write.dstSet = GetHandle();
-            write.dstBinding = static_cast<uint32_t>(bindingIndex);
-            write.dstArrayElement = 0;
-            write.descriptorCount = 1;
-            write.descriptorType = VulkanDescriptorType(bindingInfo);
+        // Gather the data of all the descriptors on the stack, indexed by BindingIndex so that
+        // the update template of the layout can consume it directly.
+        const BindingIndex bindingCount = layout->GetBindingCount();
+        ityp::stack_vec<BindingIndex, DescriptorWriteData, kMaxOptimalBindingsPerGroup> writeData(
+            bindingCount);
+        ityp::bitset<BindingIndex, kMaxBindingsPerPipelineLayout> isWritten;
+
+        bool allWritten = true;
+        for (BindingIndex bindingIndex{0}; bindingIndex < bindingCount; ++bindingIndex) {
+            const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+            DescriptorWriteData& data = writeData[bindingIndex];
 
             switch (bindingInfo.bindingType) {
                 case BindingInfoType::Buffer: {
@@ -72,19 +64,19 @@ namespace dawn_native { namespace vulkan {
                         // a Vulkan Validation Layers error. This bind group won't be used as it
                         // is an error to submit a command buffer that references destroyed
                         // resources.
+                        allWritten = false;
                         continue;
                     }
-                    writeBufferInfo[numWrites].buffer = handle;
-                    writeBufferInfo[numWrites].offset = binding.offset;
-                    writeBufferInfo[numWrites].range = binding.size;
-                    write.pBufferInfo = &writeBufferInfo[numWrites];
+                    data.buffer.buffer = handle;
+                    data.buffer.offset = binding.offset;
+                    data.buffer.range = binding.size;
                     break;
                 }
 
                 case BindingInfoType::Sampler: {
                     Sampler* sampler = ToBackend(GetBindingAsSampler(bindingIndex));
-                    writeImageInfo[numWrites].sampler = sampler->GetHandle();
-                    write.pImageInfo = &writeImageInfo[numWrites];
+                    data.image = {};
+                    data.image.sampler = sampler->GetHandle();
                     break;
                 }
 
@@ -98,16 +90,16 @@ namespace dawn_native { namespace vulkan {
                         // a Vulkan Validation Layers error. This bind group won't be used as it
                         // is an error to submit a command buffer that references destroyed
                         // resources.
+                        allWritten = false;
                         continue;
                     }
-                    writeImageInfo[numWrites].imageView = handle;
+                    data.image = {};
+                    data.image.imageView = handle;
 
                     // The layout may be GENERAL here because of interactions between the Sampled
                     // and ReadOnlyStorage usages. See the logic in VulkanImageLayout.
-                    writeImageInfo[numWrites].imageLayout = VulkanImageLayout(
-                        ToBackend(view->GetTexture()), wgpu::TextureUsage::TextureBinding);
-
-                    write.pImageInfo = &writeImageInfo[numWrites];
+                    data.image.imageLayout = VulkanImageLayout(ToBackend(view->GetTexture()),
+                                                               wgpu::TextureUsage::TextureBinding);
                     break;
                 }
 
@@ -121,12 +113,12 @@ namespace dawn_native { namespace vulkan {
                         // a Vulkan Validation Layers error. This bind group won't be used as it
                         // is an error to submit a command buffer that references destroyed
                         // resources.
+                        allWritten = false;
                         continue;
                     }
-                    writeImageInfo[numWrites].imageView = handle;
-                    writeImageInfo[numWrites].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-
-                    write.pImageInfo = &writeImageInfo[numWrites];
+                    data.image = {};
+                    data.image.imageView = handle;
+                    data.image.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
                     break;
                 }
 
@@ -141,15 +133,50 @@ namespace dawn_native { namespace vulkan {
 
                     TextureView* view = ToBackend(textureViews[0].Get());
 
-                    writeImageInfo[numWrites].imageView = view->GetHandle();
-                    writeImageInfo[numWrites].imageLayout = VulkanImageLayout(
-                        ToBackend(view->GetTexture()), wgpu::TextureUsage::TextureBinding);
-
-                    write.pImageInfo = &writeImageInfo[numWrites];
+                    data.image = {};
+                    data.image.imageView = view->GetHandle();
+                    data.image.imageLayout = VulkanImageLayout(ToBackend(view->GetTexture()),
+                                                               wgpu::TextureUsage::TextureBinding);
                     break;
                 }
             }
 
+            isWritten.set(bindingIndex);
+        }
+
+        // The template writes every binding, so it can't be used when some are skipped.
+        VkDescriptorUpdateTemplate updateTemplate = layout->GetUpdateTemplate();
+        if (updateTemplate != VK_NULL_HANDLE && allWritten) {
+            device->fn.UpdateDescriptorSetWithTemplate(device->GetVkDevice(), set, updateTemplate,
+                                                       writeData.data());
+            return;
+        }
+
+        ityp::stack_vec<uint32_t, VkWriteDescriptorSet, kMaxOptimalBindingsPerGroup> writes(
+            static_cast<uint32_t>(bindingCount));
+        uint32_t numWrites = 0;
+        for (BindingIndex bindingIndex{0}; bindingIndex < bindingCount; ++bindingIndex) {
+            if (!isWritten[bindingIndex]) {
+                continue;
+            }
+            const BindingInfo& bindingInfo = layout->GetBindingInfo(bindingIndex);
+
+            auto& write = writes[numWrites];
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.pNext = nullptr;
+            write.dstSet = set;
+            write.dstBinding = static_cast<uint32_t>(bindingIndex);
+            write.dstArrayElement = 0;
+            write.descriptorCount = 1;
+            write.descriptorType = VulkanDescriptorType(bindingInfo);
+            write.pImageInfo = nullptr;
+            write.pBufferInfo = nullptr;
+            write.pTexelBufferView = nullptr;
+            if (bindingInfo.bindingType == BindingInfoType::Buffer) {
+                write.pBufferInfo = &writeData[bindingIndex].buffer;
+            } else {
+                write.pImageInfo = &writeData[bindingIndex].image;
+            }
             numWrites++;
         }
 
@@ -158,12 +185,18 @@ namespace dawn_native { namespace vulkan {
                                         nullptr);
     }
 
+    void BindGroup::SetDescriptorSet(BindGroupLayout::CachedDescriptorSet* descriptorSet) {
+        ASSERT(mDescriptorSet == nullptr);
+        mDescriptorSet = descriptorSet;
+        mHandle = descriptorSet->allocation.set;
+    }
+
     BindGroup::~BindGroup() {
-        ToBackend(GetLayout())->DeallocateBindGroup(this, &mDescriptorSetAllocation);
+        ToBackend(GetLayout())->DeallocateBindGroup(this, mDescriptorSet);
     }
 
     VkDescriptorSet BindGroup::GetHandle() const {
-        return mDescriptorSetAllocation.set;
+        return mHandle;
     }
 
 }}  // namespace dawn_native::vulkan
@@ -20,7 +20,6 @@
 #include "common/PlacementAllocated.h"
 #include "common/vulkan_platform.h"
 #include "dawn_native/vulkan/BindGroupLayoutVk.h"
-#include "dawn_native/vulkan/DescriptorSetAllocation.h"
 
 namespace dawn_native { namespace vulkan {
 
@@ -31,18 +30,24 @@ namespace dawn_native { namespace vulkan {
         static ResultOrError<Ref<BindGroup>> Create(Device* device,
                                                     const BindGroupDescriptor* descriptor);
 
-        BindGroup(Device* device,
-                  const BindGroupDescriptor* descriptor,
-                  DescriptorSetAllocation descriptorSetAllocation);
+        BindGroup(Device* device, const BindGroupDescriptor* descriptor);
 
         VkDescriptorSet GetHandle() const;
 
       private:
+        friend class BindGroupLayout;
+
         ~BindGroup() override;
 
-        // The descriptor set in this allocation outlives the BindGroup because it is owned by
-        // the BindGroupLayout which is referenced by the BindGroup.
-        DescriptorSetAllocation mDescriptorSetAllocation;
+        // Writes the descriptors of the bindings of this bind group in |set|.
+        void WriteDescriptorSet(VkDescriptorSet set);
+        void SetDescriptorSet(BindGroupLayout::CachedDescriptorSet* descriptorSet);
+
+        // The descriptor set outlives the BindGroup because it is owned by the BindGroupLayout
+        // which is referenced by the BindGroup. It may be shared with other bind groups of the
+        // layout that have the same resources.
+        BindGroupLayout::CachedDescriptorSet* mDescriptorSet = nullptr;
+        VkDescriptorSet mHandle = VK_NULL_HANDLE;
     };
 
 }}  // namespace dawn_native::vulkan
@@ -14,6 +14,7 @@
 
 #include "dawn_native/vulkan/CommandBufferVk.h"
 
+#include "dawn_native/AsyncTask.h"
 #include "dawn_native/BindGroupTracker.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/CommandValidation.h"
@@ -37,6 +38,11 @@
 #include "dawn_native/vulkan/VulkanError.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
 
 namespace dawn_native { namespace vulkan {
 
@@ -130,9 +136,7 @@ namespace dawn_native { namespace vulkan {
           public:
             DescriptorSetTracker() = default;
 
-            void Apply(Device* device,
-                       CommandRecordingContext* recordingContext,
-                       VkPipelineBindPoint bindPoint) {
+            void Apply(Device* device, VkCommandBuffer commands, VkPipelineBindPoint bindPoint) {
                 BeforeApply();
                 for (BindGroupIndex dirtyIndex :
                      IterateBitSet(mDirtyBindGroupsObjectChangedOrIsDynamic)) {
@@ -141,7 +145,7 @@ namespace dawn_native { namespace vulkan {
                                                         ? mDynamicOffsets[dirtyIndex].data()
                                                         : nullptr;
                     device->fn.CmdBindDescriptorSets(
-                        recordingContext->commandBuffer, bindPoint,
+                        commands, bindPoint,
                         ToBackend(mPipelineLayout)->GetHandle(), static_cast<uint32_t>(dirtyIndex),
                         1, &*set, mDynamicOffsetCounts[dirtyIndex], dynamicOffset);
                 }
@@ -194,39 +198,43 @@ namespace dawn_native { namespace vulkan {
             }
         }
 
-        MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
-                                         Device* device,
-                                         BeginRenderPassCmd* renderPass) {
-            VkCommandBuffer commands = recordingContext->commandBuffer;
+        // Queries the VkRenderPass for |renderPass| from the cache.
+        ResultOrError<VkRenderPass> QueryRenderPass(Device* device,
+                                                    BeginRenderPassCmd* renderPass) {
+            RenderPassCacheQuery query;
 
-            // Query a VkRenderPass from the cache
-            VkRenderPass renderPassVK = VK_NULL_HANDLE;
-            {
-                RenderPassCacheQuery query;
+            for (ColorAttachmentIndex i :
+                 IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
+                const auto& attachmentInfo = renderPass->colorAttachments[i];
 
-                for (ColorAttachmentIndex i :
-                     IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
-                    const auto& attachmentInfo = renderPass->colorAttachments[i];
+                bool hasResolveTarget = attachmentInfo.resolveTarget != nullptr;
 
-                    bool hasResolveTarget = attachmentInfo.resolveTarget != nullptr;
+                query.SetColor(i, attachmentInfo.view->GetFormat().format,
+                               attachmentInfo.loadOp, attachmentInfo.storeOp, hasResolveTarget);
+            }
 
-                    query.SetColor(i, attachmentInfo.view->GetFormat().format,
-                                   attachmentInfo.loadOp, attachmentInfo.storeOp, hasResolveTarget);
-                }
+            if (renderPass->attachmentState->HasDepthStencilAttachment()) {
+                const auto& attachmentInfo = renderPass->depthStencilAttachment;
 
-                if (renderPass->attachmentState->HasDepthStencilAttachment()) {
-                    const auto& attachmentInfo = renderPass->depthStencilAttachment;
+                query.SetDepthStencil(attachmentInfo.view->GetTexture()->GetFormat().format,
+                                      attachmentInfo.depthLoadOp, attachmentInfo.depthStoreOp,
+                                      attachmentInfo.stencilLoadOp,
+                                      attachmentInfo.stencilStoreOp);
+            }
 
-                    query.SetDepthStencil(attachmentInfo.view->GetTexture()->GetFormat().format,
-                                          attachmentInfo.depthLoadOp, attachmentInfo.depthStoreOp,
-                                          attachmentInfo.stencilLoadOp,
-                                          attachmentInfo.stencilStoreOp);
-                }
+            query.SetSampleCount(renderPass->attachmentState->GetSampleCount());
 
-                query.SetSampleCount(renderPass->attachmentState->GetSampleCount());
+            return device->GetRenderPassCache()->GetRenderPass(query);
+        }
 
-                DAWN_TRY_ASSIGN(renderPassVK, device->GetRenderPassCache()->GetRenderPass(query));
-            }
+        MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
+                                         Device* device,
+                                         BeginRenderPassCmd* renderPass,
+                                         VkSubpassContents contents) {
+            VkCommandBuffer commands = recordingContext->commandBuffer;
+
+            VkRenderPass renderPassVK = VK_NULL_HANDLE;
+            DAWN_TRY_ASSIGN(renderPassVK, QueryRenderPass(device, renderPass));
 
             // Create a framebuffer that will be used once for the render pass and gather the clear
             // values for the attachments at the same time.
@@ -335,7 +343,7 @@ namespace dawn_native { namespace vulkan {
             beginInfo.clearValueCount = attachmentCount;
             beginInfo.pClearValues = clearValues.data();
 
-            device->fn.CmdBeginRenderPass(commands, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+            device->fn.CmdBeginRenderPass(commands, &beginInfo, contents);
 
             return {};
         }
@@ -373,10 +381,9 @@ namespace dawn_native { namespace vulkan {
             }
         }
 
-        void RecordWriteTimestampCmd(CommandRecordingContext* recordingContext,
+        void RecordWriteTimestampCmd(VkCommandBuffer commands,
                                      Device* device,
                                      WriteTimestampCmd* cmd) {
-            VkCommandBuffer commands = recordingContext->commandBuffer;
             QuerySet* querySet = ToBackend(cmd->querySet.Get());
 
             device->fn.CmdWriteTimestamp(commands, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
@@ -424,12 +431,410 @@ namespace dawn_native { namespace vulkan {
             }
         }
 
+        // Visitor used with VisitCommand to record the commands of a render pass, and of the
+        // render bundles it executes, in a VkCommandBuffer. Each command has its own overload, so
+        // the commands are read with their static size and alignment and recorded without going
+        // through a second switch. Commands that can't be in a render pass are unreachable.
+        class RenderPassCommandRecorder {
+          public:
+            RenderPassCommandRecorder(Device* device,
+                                      VkCommandBuffer commands,
+                                      CommandIterator* passCommands)
+                : mDevice(device), mCommands(commands), mIterator(passCommands) {
+            }
+
+            bool HasEnded() const {
+                return mHasEnded;
+            }
+
+            void operator()(EndRenderPassCmd*) {
+                mHasEnded = true;
+            }
+
+            void operator()(DrawCmd* draw) {
+                mDescriptorSets.Apply(mDevice, mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                mDevice->fn.CmdDraw(mCommands, draw->vertexCount, draw->instanceCount,
+                                    draw->firstVertex, draw->firstInstance);
+            }
+
+            void operator()(DrawIndexedCmd* draw) {
+                mDescriptorSets.Apply(mDevice, mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                mDevice->fn.CmdDrawIndexed(mCommands, draw->indexCount, draw->instanceCount,
+                                           draw->firstIndex, draw->baseVertex,
+                                           draw->firstInstance);
+            }
+
+            void operator()(DrawIndirectCmd* draw) {
+                VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
+
+                mDescriptorSets.Apply(mDevice, mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                mDevice->fn.CmdDrawIndirect(mCommands, indirectBuffer,
+                                            static_cast<VkDeviceSize>(draw->indirectOffset), 1,
+                                            0);
+            }
+
+            void operator()(DrawIndexedIndirectCmd* draw) {
+                ASSERT(!draw->indirectBufferLocation->IsNull());
+                VkBuffer indirectBuffer =
+                    ToBackend(draw->indirectBufferLocation->GetBuffer())->GetHandle();
+
+                mDescriptorSets.Apply(mDevice, mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS);
+                mDevice->fn.CmdDrawIndexedIndirect(
+                    mCommands, indirectBuffer,
+                    static_cast<VkDeviceSize>(draw->indirectBufferLocation->GetOffset()), 1, 0);
+            }
+
+            void operator()(InsertDebugMarkerCmd* cmd) {
+                const char* label = mIterator->NextData<char>(cmd->length + 1);
+                if (mDevice->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                    VkDebugUtilsLabelEXT utilsLabel = MakeDebugUtilsLabel(label);
+                    mDevice->fn.CmdInsertDebugUtilsLabelEXT(mCommands, &utilsLabel);
+                }
+            }
+
+            void operator()(PopDebugGroupCmd*) {
+                if (mDevice->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                    mDevice->fn.CmdEndDebugUtilsLabelEXT(mCommands);
+                }
+            }
+
+            void operator()(PushDebugGroupCmd* cmd) {
+                const char* label = mIterator->NextData<char>(cmd->length + 1);
+                if (mDevice->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
+                    VkDebugUtilsLabelEXT utilsLabel = MakeDebugUtilsLabel(label);
+                    mDevice->fn.CmdBeginDebugUtilsLabelEXT(mCommands, &utilsLabel);
+                }
+            }
+
+            void operator()(SetBindGroupCmd* cmd) {
+                BindGroup* bindGroup = ToBackend(cmd->group);
+                uint32_t* dynamicOffsets = nullptr;
+                if (cmd->dynamicOffsetCount > 0) {
+                    dynamicOffsets = mIterator->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                }
+
+                mDescriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
+                                               dynamicOffsets);
+            }
+
+            void operator()(SetIndexBufferCmd* cmd) {
+                VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
+
+                mDevice->fn.CmdBindIndexBuffer(mCommands, indexBuffer, cmd->offset,
+                                               VulkanIndexType(cmd->format));
+            }
+
+            void operator()(SetRenderPipelineCmd* cmd) {
+                RenderPipeline* pipeline = ToBackend(cmd->pipeline);
+
+                mDevice->fn.CmdBindPipeline(mCommands, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                            pipeline->GetHandle());
+                mDescriptorSets.OnSetPipeline(pipeline);
+            }
+
+            void operator()(SetVertexBufferCmd* cmd) {
+                VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
+                VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+
+                mDevice->fn.CmdBindVertexBuffers(mCommands, static_cast<uint8_t>(cmd->slot), 1,
+                                                 &*buffer, &offset);
+            }
+
+            void operator()(SetBlendConstantCmd* cmd) {
+                const std::array<float, 4> blendConstants = ConvertToFloatColor(cmd->color);
+                mDevice->fn.CmdSetBlendConstants(mCommands, blendConstants.data());
+            }
+
+            void operator()(SetStencilReferenceCmd* cmd) {
+                mDevice->fn.CmdSetStencilReference(mCommands, VK_STENCIL_FRONT_AND_BACK,
+                                                   cmd->reference);
+            }
+
+            void operator()(SetViewportCmd* cmd) {
+                VkViewport viewport;
+                viewport.x = cmd->x;
+                viewport.y = cmd->y + cmd->height;
+                viewport.width = cmd->width;
+                viewport.height = -cmd->height;
+                viewport.minDepth = cmd->minDepth;
+                viewport.maxDepth = cmd->maxDepth;
+
+                // Vulkan disallows width = 0, but VK_KHR_maintenance1 which we require allows
+                // height = 0 so use that to do an empty viewport.
+                if (viewport.width == 0) {
+                    viewport.height = 0;
+
+                    // Set the viewport x range to a range that's always valid.
+                    viewport.x = 0;
+                    viewport.width = 1;
+                }
+
+                mDevice->fn.CmdSetViewport(mCommands, 0, 1, &viewport);
+            }
+
+            void operator()(SetScissorRectCmd* cmd) {
+                VkRect2D rect;
+                rect.offset.x = cmd->x;
+                rect.offset.y = cmd->y;
+                rect.extent.width = cmd->width;
+                rect.extent.height = cmd->height;
+
+                mDevice->fn.CmdSetScissor(mCommands, 0, 1, &rect);
+            }
+
+            void operator()(ExecuteBundlesCmd* cmd) {
+                auto bundles = mIterator->NextData<Ref<RenderBundleBase>>(cmd->count);
+
+                CommandIterator* passIterator = mIterator;
+                for (uint32_t i = 0; i < cmd->count; ++i) {
+                    // Iterate a view of the bundle's commands since the bundle can be executed
+                    // by render passes recorded concurrently.
+                    CommandIterator bundleIterator;
+                    bundleIterator.InitializeAsViewOf(*bundles[i]->GetCommands());
+                    bundleIterator.Reset();
+
+                    mIterator = &bundleIterator;
+                    VisitCommands(&bundleIterator, *this);
+                }
+                mIterator = passIterator;
+            }
+
+            void operator()(BeginOcclusionQueryCmd* cmd) {
+                mDevice->fn.CmdBeginQuery(mCommands, ToBackend(cmd->querySet.Get())->GetHandle(),
+                                          cmd->queryIndex, 0);
+            }
+
+            void operator()(EndOcclusionQueryCmd* cmd) {
+                mDevice->fn.CmdEndQuery(mCommands, ToBackend(cmd->querySet.Get())->GetHandle(),
+                                        cmd->queryIndex);
+            }
+
+            void operator()(WriteTimestampCmd* cmd) {
+                RecordWriteTimestampCmd(mCommands, mDevice, cmd);
+            }
+
+            template <typename T>
+            void operator()(T*) {
+                UNREACHABLE();
+            }
+
+          private:
+            static VkDebugUtilsLabelEXT MakeDebugUtilsLabel(const char* label) {
+                VkDebugUtilsLabelEXT utilsLabel;
+                utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+                utilsLabel.pNext = nullptr;
+                utilsLabel.pLabelName = label;
+                // Default color to black
+                utilsLabel.color[0] = 0.0;
+                utilsLabel.color[1] = 0.0;
+                utilsLabel.color[2] = 0.0;
+                utilsLabel.color[3] = 1.0;
+                return utilsLabel;
+            }
+
+            Device* mDevice;
+            VkCommandBuffer mCommands;
+            // The iterator of the commands being visited, which is the render pass' or a render
+            // bundle's. It is used to read the additional data of the commands.
+            CommandIterator* mIterator;
+            DescriptorSetTracker mDescriptorSets = {};
+            bool mHasEnded = false;
+        };
+
+        // Records the commands of a render pass after its BeginRenderPassCmd, up to and including
+        // its EndRenderPassCmd, in |commands|, which is either the command buffer where the render
+        // pass was begun or a secondary command buffer that continues it.
+        void RecordRenderPassCommands(Device* device,
+                                      VkCommandBuffer commands,
+                                      CommandIterator* passCommands,
+                                      BeginRenderPassCmd* renderPassCmd) {
+            // Set the default value for the dynamic state
+            {
+                device->fn.CmdSetLineWidth(commands, 1.0f);
+                device->fn.CmdSetDepthBounds(commands, 0.0f, 1.0f);
+
+                device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, 0);
+
+                float blendConstants[4] = {
+                    0.0f,
+                    0.0f,
+                    0.0f,
+                    0.0f,
+                };
+                device->fn.CmdSetBlendConstants(commands, blendConstants);
+
+                // The viewport and scissor default to cover all of the attachments
+                VkViewport viewport;
+                viewport.x = 0.0f;
+                viewport.y = static_cast<float>(renderPassCmd->height);
+                viewport.width = static_cast<float>(renderPassCmd->width);
+                viewport.height = -static_cast<float>(renderPassCmd->height);
+                viewport.minDepth = 0.0f;
+                viewport.maxDepth = 1.0f;
+                device->fn.CmdSetViewport(commands, 0, 1, &viewport);
+
+                VkRect2D scissorRect;
+                scissorRect.offset.x = 0;
+                scissorRect.offset.y = 0;
+                scissorRect.extent.width = renderPassCmd->width;
+                scissorRect.extent.height = renderPassCmd->height;
+                device->fn.CmdSetScissor(commands, 0, 1, &scissorRect);
+            }
+
+            RenderPassCommandRecorder recorder(device, commands, passCommands);
+            Command type;
+            while (!recorder.HasEnded() && passCommands->NextCommandId(&type)) {
+                VisitCommand(passCommands, type, recorder);
+            }
+
+            // EndRenderPass should have been called
+            ASSERT(recorder.HasEnded());
+        }
+
     }  // anonymous namespace
 
+    // Records the render passes of a command buffer in secondary command buffers. The passes are
+    // recorded in order by tasks on the AsyncTaskManager, and by the thread recording the primary
+    // command buffer when it needs a pass that no task started yet. The tasks keep a reference to
+    // this object since they can run after all the passes are recorded.
+    class RenderPassRecordingTasks : public RefCounted {
+      public:
+        explicit RenderPassRecordingTasks(Device* device) : mDevice(device) {
+        }
+
+        // |commands| must be positioned right after the pass' BeginRenderPassCmd.
+        void AddRenderPass(BeginRenderPassCmd* renderPassCmd, const CommandIterator& commands) {
+            mRenderPasses.emplace_back();
+            RenderPass& pass = mRenderPasses.back();
+            pass.cmd = renderPassCmd;
+            pass.commands.InitializeAsViewOf(commands);
+        }
+
+        size_t GetRenderPassCount() const {
+            return mRenderPasses.size();
+        }
+
+        // Gets the secondary command buffers of the passes, and the VkRenderPass they continue.
+        // The load operations of the passes can still be changed by the lazy clears, but they
+        // don't affect the compatibility of the VkRenderPass.
+        MaybeError Initialize() {
+            for (RenderPass& pass : mRenderPasses) {
+                DAWN_TRY_ASSIGN(pass.renderPass, QueryRenderPass(mDevice, pass.cmd));
+                DAWN_TRY_ASSIGN(pass.commandBuffer, mDevice->GetSecondaryCommandBuffer());
+            }
+            return {};
+        }
+
+        void Start() {
+            // The thread recording the primary command buffer records passes too.
+            size_t taskCount = std::min(mRenderPasses.size() - 1, kMaxRecordingTasks);
+            for (size_t i = 0; i < taskCount; ++i) {
+                Ref<RenderPassRecordingTasks> tasks = this;
+                mDevice->GetAsyncTaskManager()->PostTask([tasks]() {
+                    while (tasks->RecordNextRenderPass()) {
+                    }
+                });
+            }
+        }
+
+        // Returns the secondary command buffer of the |index|-th render pass once it is recorded.
+        ResultOrError<VkCommandBuffer> WaitForRenderPass(size_t index) {
+            ASSERT(index < mRenderPasses.size());
+            while (mNextRenderPass.load() <= index) {
+                RecordNextRenderPass();
+            }
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [&] { return mRenderPasses[index].recorded; });
+            if (mError != nullptr) {
+                return std::move(mError);
+            }
+            return mRenderPasses[index].commandBuffer;
+        }
+
+        // Waits for all the passes to be recorded, since the tasks use the commands.
+        void Finish() {
+            while (RecordNextRenderPass()) {
+            }
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [&] { return mRecordedRenderPassCount == mRenderPasses.size(); });
+        }
+
+      private:
+        static constexpr size_t kMaxRecordingTasks = 4;
+
+        struct RenderPass {
+            BeginRenderPassCmd* cmd = nullptr;
+            CommandIterator commands;
+            VkRenderPass renderPass = VK_NULL_HANDLE;
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            // Guarded by mMutex.
+            bool recorded = false;
+        };
+
+        // Records the first pass that isn't started yet. Returns false if there is none.
+        bool RecordNextRenderPass() {
+            size_t index = mNextRenderPass.fetch_add(1);
+            if (index >= mRenderPasses.size()) {
+                return false;
+            }
+
+            RenderPass& pass = mRenderPasses[index];
+            MaybeError result = RecordRenderPass(&pass);
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (result.IsError() && mError == nullptr) {
+                    mError = result.AcquireError();
+                }
+                pass.recorded = true;
+                mRecordedRenderPassCount++;
+            }
+            mCondition.notify_all();
+            return true;
+        }
+
+        MaybeError RecordRenderPass(RenderPass* pass) {
+            VkCommandBufferInheritanceInfo inheritanceInfo;
+            inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+            inheritanceInfo.pNext = nullptr;
+            inheritanceInfo.renderPass = pass->renderPass;
+            inheritanceInfo.subpass = 0;
+            inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+            inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+            inheritanceInfo.queryFlags = 0;
+            inheritanceInfo.pipelineStatistics = 0;
+
+            VkCommandBufferBeginInfo beginInfo;
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.pNext = nullptr;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                              VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+            beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+            DAWN_TRY(CheckVkSuccess(mDevice->fn.BeginCommandBuffer(pass->commandBuffer, &beginInfo),
+                                    "vkBeginCommandBuffer"));
+            RecordRenderPassCommands(mDevice, pass->commandBuffer, &pass->commands, pass->cmd);
+            return CheckVkSuccess(mDevice->fn.EndCommandBuffer(pass->commandBuffer),
+                                  "vkEndCommandBuffer");
+        }
+
+        Device* mDevice;
+        // A deque since the iterators cannot be moved.
+        std::deque<RenderPass> mRenderPasses;
+        std::atomic<size_t> mNextRenderPass{0};
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        size_t mRecordedRenderPassCount = 0;
+        std::unique_ptr<ErrorData> mError;
+    };
+
     // static
     Ref<CommandBuffer> CommandBuffer::Create(CommandEncoder* encoder,
                                              const CommandBufferDescriptor* descriptor) {
-        return AcquireRef(new CommandBuffer(encoder, descriptor));
+        return AcquireRef(new (encoder->GetDevice()) CommandBuffer(encoder, descriptor));
     }
 
     CommandBuffer::CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor)
@@ -496,6 +901,73 @@ namespace dawn_native { namespace vulkan {
 
     MaybeError CommandBuffer::RecordCommands(CommandRecordingContext* recordingContext) {
         Device* device = ToBackend(GetDevice());
+
+        Ref<RenderPassRecordingTasks> renderPassTasks;
+        if (device->IsToggleEnabled(Toggle::VulkanRecordRenderPassesInParallel)) {
+            DAWN_TRY_ASSIGN(renderPassTasks, StartRenderPassRecordingTasks());
+        }
+
+        MaybeError result = RecordCommandsImpl(recordingContext, renderPassTasks.Get());
+        if (renderPassTasks != nullptr) {
+            renderPassTasks->Finish();
+        }
+        return result;
+    }
+
+    ResultOrError<Ref<RenderPassRecordingTasks>> CommandBuffer::StartRenderPassRecordingTasks() {
+        Device* device = ToBackend(GetDevice());
+        Ref<RenderPassRecordingTasks> renderPassTasks =
+            AcquireRef(new RenderPassRecordingTasks(device));
+
+        // The buffer locations are used by the render passes, so they are updated before any pass
+        // is recorded. This is only correct if each location is updated once: the location of a
+        // DrawIndexedIndirect in a render bundle is shared by all the passes executing the bundle
+        // and updated before each of them.
+        std::unordered_set<BufferLocation*> updatedLocations;
+        bool hasSharedLocation = false;
+
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::BeginRenderPass: {
+                    BeginRenderPassCmd* cmd = mCommands.NextCommand<BeginRenderPassCmd>();
+                    renderPassTasks->AddRenderPass(cmd, mCommands);
+                    break;
+                }
+
+                case Command::SetValidatedBufferLocationsInternal: {
+                    SetValidatedBufferLocationsInternalCmd* cmd =
+                        mCommands.NextCommand<SetValidatedBufferLocationsInternalCmd>();
+                    for (const DeferredBufferLocationUpdate& update : cmd->updates) {
+                        if (!updatedLocations.insert(update.location.Get()).second) {
+                            hasSharedLocation = true;
+                        }
+                        update.location->Set(update.buffer.Get(), update.offset);
+                    }
+                    break;
+                }
+
+                default:
+                    SkipCommand(&mCommands, type);
+                    break;
+            }
+        }
+
+        // A single render pass isn't worth a secondary command buffer. Passes sharing a buffer
+        // location are recorded in the primary command buffer instead, which updates the
+        // locations again in order before each pass.
+        if (renderPassTasks->GetRenderPassCount() < 2 || hasSharedLocation) {
+            return Ref<RenderPassRecordingTasks>();
+        }
+
+        DAWN_TRY(renderPassTasks->Initialize());
+        renderPassTasks->Start();
+        return renderPassTasks;
+    }
+
+    MaybeError CommandBuffer::RecordCommandsImpl(CommandRecordingContext* recordingContext,
+                                                 RenderPassRecordingTasks* renderPassTasks) {
+        Device* device = ToBackend(GetDevice());
         VkCommandBuffer commands = recordingContext->commandBuffer;
 
         // Records the necessary barriers for the resource usage pre-computed by the frontend.
@@ -715,7 +1187,12 @@ namespace dawn_native { namespace vulkan {
                         GetResourceUsages().renderPasses[nextRenderPassNumber]);
 
                     LazyClearRenderPassAttachments(cmd);
-                    DAWN_TRY(RecordRenderPass(recordingContext, cmd));
+                    if (renderPassTasks != nullptr) {
+                        DAWN_TRY(RecordRenderPassWithSecondaryCommands(
+                            recordingContext, cmd, renderPassTasks, nextRenderPassNumber));
+                    } else {
+                        DAWN_TRY(RecordRenderPass(recordingContext, cmd));
+                    }
 
                     nextRenderPassNumber++;
                     break;
@@ -772,7 +1249,7 @@ namespace dawn_native { namespace vulkan {
                     device->fn.CmdResetQueryPool(commands, ToBackend(cmd->querySet)->GetHandle(),
                                                  cmd->queryIndex, 1);
 
-                    RecordWriteTimestampCmd(recordingContext, device, cmd);
+                    RecordWriteTimestampCmd(commands, device, cmd);
                     break;
                 }
 
@@ -827,7 +1304,12 @@ namespace dawn_native { namespace vulkan {
                 }
 
                 case Command::SetValidatedBufferLocationsInternal:
-                    DoNextSetValidatedBufferLocationsInternal();
+                    if (renderPassTasks != nullptr) {
+                        // Already done in StartRenderPassRecordingTasks.
+                        SkipCommand(&mCommands, type);
+                    } else {
+                        DoNextSetValidatedBufferLocationsInternal();
+                    }
                     break;
 
                 case Command::WriteBuffer: {
@@ -893,7 +1375,7 @@ namespace dawn_native { namespace vulkan {
 
                     TransitionAndClearForSyncScope(device, recordingContext,
                                                    resourceUsages.dispatchUsages[currentDispatch]);
-                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+                    descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_COMPUTE);
 
                     device->fn.CmdDispatch(commands, dispatch->x, dispatch->y, dispatch->z);
                     currentDispatch++;
@@ -906,7 +1388,7 @@ namespace dawn_native { namespace vulkan {
 
                     TransitionAndClearForSyncScope(device, recordingContext,
                                                    resourceUsages.dispatchUsages[currentDispatch]);
-                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_COMPUTE);
+                    descriptorSets.Apply(device, commands, VK_PIPELINE_BIND_POINT_COMPUTE);
 
                     device->fn.CmdDispatchIndirect(
                         commands, indirectBuffer,
@@ -918,7 +1400,7 @@ namespace dawn_native { namespace vulkan {
                 case Command::SetBindGroup: {
                     SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
 
-                    BindGroup* bindGroup = ToBackend(cmd->group.Get());
+                    BindGroup* bindGroup = ToBackend(cmd->group);
                     uint32_t* dynamicOffsets = nullptr;
                     if (cmd->dynamicOffsetCount > 0) {
                         dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
@@ -931,7 +1413,7 @@ namespace dawn_native { namespace vulkan {
 
                 case Command::SetComputePipeline: {
                     SetComputePipelineCmd* cmd = mCommands.NextCommand<SetComputePipelineCmd>();
-                    ComputePipeline* pipeline = ToBackend(cmd->pipeline).Get();
+                    ComputePipeline* pipeline = ToBackend(cmd->pipeline);
 
                     device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_COMPUTE,
                                                pipeline->GetHandle());
@@ -996,7 +1478,7 @@ namespace dawn_native { namespace vulkan {
                     device->fn.CmdResetQueryPool(commands, ToBackend(cmd->querySet)->GetHandle(),
                                                  cmd->queryIndex, 1);
 
-                    RecordWriteTimestampCmd(recordingContext, device, cmd);
+                    RecordWriteTimestampCmd(commands, device, cmd);
                     break;
                 }
 
@@ -1014,290 +1496,38 @@ namespace dawn_native { namespace vulkan {
         Device* device = ToBackend(GetDevice());
         VkCommandBuffer commands = recordingContext->commandBuffer;
 
-        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd));
-
-        // Set the default value for the dynamic state
-        {
-            device->fn.CmdSetLineWidth(commands, 1.0f);
-            device->fn.CmdSetDepthBounds(commands, 0.0f, 1.0f);
-
-            device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK, 0);
-
-            float blendConstants[4] = {
-                0.0f,
-                0.0f,
-                0.0f,
-                0.0f,
-            };
-            device->fn.CmdSetBlendConstants(commands, blendConstants);
-
-            // The viewport and scissor default to cover all of the attachments
-            VkViewport viewport;
-            viewport.x = 0.0f;
-            viewport.y = static_cast<float>(renderPassCmd->height);
-            viewport.width = static_cast<float>(renderPassCmd->width);
-            viewport.height = -static_cast<float>(renderPassCmd->height);
-            viewport.minDepth = 0.0f;
-            viewport.maxDepth = 1.0f;
-            device->fn.CmdSetViewport(commands, 0, 1, &viewport);
-
-            VkRect2D scissorRect;
-            scissorRect.offset.x = 0;
-            scissorRect.offset.y = 0;
-            scissorRect.extent.width = renderPassCmd->width;
-            scissorRect.extent.height = renderPassCmd->height;
-            device->fn.CmdSetScissor(commands, 0, 1, &scissorRect);
-        }
-
-        DescriptorSetTracker descriptorSets = {};
-        RenderPipeline* lastPipeline = nullptr;
-
-        auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
-            switch (type) {
-                case Command::Draw: {
-                    DrawCmd* draw = iter->NextCommand<DrawCmd>();
-
-                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
-                                       draw->firstVertex, draw->firstInstance);
-                    break;
-                }
-
-                case Command::DrawIndexed: {
-                    DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
-
-                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
-                                              draw->firstIndex, draw->baseVertex,
-                                              draw->firstInstance);
-                    break;
-                }
-
-                case Command::DrawIndirect: {
-                    DrawIndirectCmd* draw = iter->NextCommand<DrawIndirectCmd>();
-                    VkBuffer indirectBuffer = ToBackend(draw->indirectBuffer)->GetHandle();
-
-                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndirect(commands, indirectBuffer,
-                                               static_cast<VkDeviceSize>(draw->indirectOffset), 1,
-                                               0);
-                    break;
-                }
-
-                case Command::DrawIndexedIndirect: {
-                    DrawIndexedIndirectCmd* draw = iter->NextCommand<DrawIndexedIndirectCmd>();
-                    ASSERT(!draw->indirectBufferLocation->IsNull());
-                    VkBuffer indirectBuffer =
-                        ToBackend(draw->indirectBufferLocation->GetBuffer())->GetHandle();
-
-                    descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
-                    device->fn.CmdDrawIndexedIndirect(
-                        commands, indirectBuffer,
-                        static_cast<VkDeviceSize>(draw->indirectBufferLocation->GetOffset()), 1, 0);
-                    break;
-                }
-
-                case Command::InsertDebugMarker: {
-                    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                        InsertDebugMarkerCmd* cmd = iter->NextCommand<InsertDebugMarkerCmd>();
-                        const char* label = iter->NextData<char>(cmd->length + 1);
-                        VkDebugUtilsLabelEXT utilsLabel;
-                        utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                        utilsLabel.pNext = nullptr;
-                        utilsLabel.pLabelName = label;
-                        // Default color to black
-                        utilsLabel.color[0] = 0.0;
-                        utilsLabel.color[1] = 0.0;
-                        utilsLabel.color[2] = 0.0;
-                        utilsLabel.color[3] = 1.0;
-                        device->fn.CmdInsertDebugUtilsLabelEXT(commands, &utilsLabel);
-                    } else {
-                        SkipCommand(iter, Command::InsertDebugMarker);
-                    }
-                    break;
-                }
-
-                case Command::PopDebugGroup: {
-                    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                        iter->NextCommand<PopDebugGroupCmd>();
-                        device->fn.CmdEndDebugUtilsLabelEXT(commands);
-                    } else {
-                        SkipCommand(iter, Command::PopDebugGroup);
-                    }
-                    break;
-                }
-
-                case Command::PushDebugGroup: {
-                    if (device->GetGlobalInfo().HasExt(InstanceExt::DebugUtils)) {
-                        PushDebugGroupCmd* cmd = iter->NextCommand<PushDebugGroupCmd>();
-                        const char* label = iter->NextData<char>(cmd->length + 1);
-                        VkDebugUtilsLabelEXT utilsLabel;
-                        utilsLabel.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-                        utilsLabel.pNext = nullptr;
-                        utilsLabel.pLabelName = label;
-                        // Default color to black
-                        utilsLabel.color[0] = 0.0;
-                        utilsLabel.color[1] = 0.0;
-                        utilsLabel.color[2] = 0.0;
-                        utilsLabel.color[3] = 1.0;
-                        device->fn.CmdBeginDebugUtilsLabelEXT(commands, &utilsLabel);
-                    } else {
-                        SkipCommand(iter, Command::PushDebugGroup);
-                    }
-                    break;
-                }
-
-                case Command::SetBindGroup: {
-                    SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
-                    BindGroup* bindGroup = ToBackend(cmd->group.Get());
-                    uint32_t* dynamicOffsets = nullptr;
-                    if (cmd->dynamicOffsetCount > 0) {
-                        dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
-                    }
-
-                    descriptorSets.OnSetBindGroup(cmd->index, bindGroup, cmd->dynamicOffsetCount,
-                                                  dynamicOffsets);
-                    break;
-                }
-
-                case Command::SetIndexBuffer: {
-                    SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                    VkBuffer indexBuffer = ToBackend(cmd->buffer)->GetHandle();
-
-                    device->fn.CmdBindIndexBuffer(commands, indexBuffer, cmd->offset,
-                                                  VulkanIndexType(cmd->format));
-                    break;
-                }
-
-                case Command::SetRenderPipeline: {
-                    SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
-
-                    device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                               pipeline->GetHandle());
-                    lastPipeline = pipeline;
+        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                       VK_SUBPASS_CONTENTS_INLINE));
+        RecordRenderPassCommands(device, commands, &mCommands, renderPassCmd);
+        device->fn.CmdEndRenderPass(commands);
 
-                    descriptorSets.OnSetPipeline(pipeline);
-                    break;
-                }
+        return {};
+    }
 
-                case Command::SetVertexBuffer: {
-                    SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
-                    VkBuffer buffer = ToBackend(cmd->buffer)->GetHandle();
-                    VkDeviceSize offset = static_cast<VkDeviceSize>(cmd->offset);
+    MaybeError CommandBuffer::RecordRenderPassWithSecondaryCommands(
+        CommandRecordingContext* recordingContext,
+        BeginRenderPassCmd* renderPassCmd,
+        RenderPassRecordingTasks* renderPassTasks,
+        size_t renderPassIndex) {
+        Device* device = ToBackend(GetDevice());
+        VkCommandBuffer commands = recordingContext->commandBuffer;
 
-                    device->fn.CmdBindVertexBuffers(commands, static_cast<uint8_t>(cmd->slot), 1,
-                                                    &*buffer, &offset);
-                    break;
-                }
+        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                       VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS));
 
-                default:
-                    UNREACHABLE();
-                    break;
-            }
-        };
+        VkCommandBuffer secondaryCommands = VK_NULL_HANDLE;
+        DAWN_TRY_ASSIGN(secondaryCommands, renderPassTasks->WaitForRenderPass(renderPassIndex));
+        device->fn.CmdExecuteCommands(commands, 1, &secondaryCommands);
 
+        // The commands of the pass are in the secondary command buffer so they are skipped here.
         Command type;
         while (mCommands.NextCommandId(&type)) {
-            switch (type) {
-                case Command::EndRenderPass: {
-                    mCommands.NextCommand<EndRenderPassCmd>();
-                    device->fn.CmdEndRenderPass(commands);
-                    return {};
-                }
-
-                case Command::SetBlendConstant: {
-                    SetBlendConstantCmd* cmd = mCommands.NextCommand<SetBlendConstantCmd>();
-                    const std::array<float, 4> blendConstants = ConvertToFloatColor(cmd->color);
-                    device->fn.CmdSetBlendConstants(commands, blendConstants.data());
-                    break;
-                }
-
-                case Command::SetStencilReference: {
-                    SetStencilReferenceCmd* cmd = mCommands.NextCommand<SetStencilReferenceCmd>();
-                    device->fn.CmdSetStencilReference(commands, VK_STENCIL_FRONT_AND_BACK,
-                                                      cmd->reference);
-                    break;
-                }
-
-                case Command::SetViewport: {
-                    SetViewportCmd* cmd = mCommands.NextCommand<SetViewportCmd>();
-                    VkViewport viewport;
-                    viewport.x = cmd->x;
-                    viewport.y = cmd->y + cmd->height;
-                    viewport.width = cmd->width;
-                    viewport.height = -cmd->height;
-                    viewport.minDepth = cmd->minDepth;
-                    viewport.maxDepth = cmd->maxDepth;
-
-                    // Vulkan disallows width = 0, but VK_KHR_maintenance1 which we require allows
-                    // height = 0 so use that to do an empty viewport.
-                    if (viewport.width == 0) {
-                        viewport.height = 0;
-
-                        // Set the viewport x range to a range that's always valid.
-                        viewport.x = 0;
-                        viewport.width = 1;
-                    }
-
-                    device->fn.CmdSetViewport(commands, 0, 1, &viewport);
-                    break;
-                }
-
-                case Command::SetScissorRect: {
-                    SetScissorRectCmd* cmd = mCommands.NextCommand<SetScissorRectCmd>();
-                    VkRect2D rect;
-                    rect.offset.x = cmd->x;
-                    rect.offset.y = cmd->y;
-                    rect.extent.width = cmd->width;
-                    rect.extent.height = cmd->height;
-
-                    device->fn.CmdSetScissor(commands, 0, 1, &rect);
-                    break;
-                }
-
-                case Command::ExecuteBundles: {
-                    ExecuteBundlesCmd* cmd = mCommands.NextCommand<ExecuteBundlesCmd>();
-                    auto bundles = mCommands.NextData<Ref<RenderBundleBase>>(cmd->count);
-
-                    for (uint32_t i = 0; i < cmd->count; ++i) {
-                        CommandIterator* iter = bundles[i]->GetCommands();
-                        iter->Reset();
-                        while (iter->NextCommandId(&type)) {
-                            EncodeRenderBundleCommand(iter, type);
-                        }
-                    }
-                    break;
-                }
-
-                case Command::BeginOcclusionQuery: {
-                    BeginOcclusionQueryCmd* cmd = mCommands.NextCommand<BeginOcclusionQueryCmd>();
-
-                    device->fn.CmdBeginQuery(commands, ToBackend(cmd->querySet.Get())->GetHandle(),
-                                             cmd->queryIndex, 0);
-                    break;
-                }
-
-                case Command::EndOcclusionQuery: {
-                    EndOcclusionQueryCmd* cmd = mCommands.NextCommand<EndOcclusionQueryCmd>();
-
-                    device->fn.CmdEndQuery(commands, ToBackend(cmd->querySet.Get())->GetHandle(),
-                                           cmd->queryIndex);
-                    break;
-                }
-
-                case Command::WriteTimestamp: {
-                    WriteTimestampCmd* cmd = mCommands.NextCommand<WriteTimestampCmd>();
-
-                    RecordWriteTimestampCmd(recordingContext, device, cmd);
-                    break;
-                }
-
-                default: {
-                    EncodeRenderBundleCommand(&mCommands, type);
-                    break;
-                }
+            if (type == Command::EndRenderPass) {
+                mCommands.NextCommand<EndRenderPassCmd>();
+                device->fn.CmdEndRenderPass(commands);
+                return {};
             }
+            SkipCommand(&mCommands, type);
         }
 
         // EndRenderPass should have been called
@@ -29,6 +29,7 @@ namespace dawn_native { namespace vulkan {
 
     struct CommandRecordingContext;
     class Device;
+    class RenderPassRecordingTasks;
 
     class CommandBuffer final : public CommandBufferBase {
       public:
@@ -40,10 +41,20 @@ namespace dawn_native { namespace vulkan {
       private:
         CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor);
 
+        // Used when Toggle::VulkanRecordRenderPassesInParallel is enabled. Returns nullptr if the
+        // render passes are recorded in the primary command buffer.
+        ResultOrError<Ref<RenderPassRecordingTasks>> StartRenderPassRecordingTasks();
+        MaybeError RecordCommandsImpl(CommandRecordingContext* recordingContext,
+                                      RenderPassRecordingTasks* renderPassTasks);
+
         MaybeError RecordComputePass(CommandRecordingContext* recordingContext,
                                      const ComputePassResourceUsage& resourceUsages);
         MaybeError RecordRenderPass(CommandRecordingContext* recordingContext,
                                     BeginRenderPassCmd* renderPass);
+        MaybeError RecordRenderPassWithSecondaryCommands(CommandRecordingContext* recordingContext,
+                                                         BeginRenderPassCmd* renderPass,
+                                                         RenderPassRecordingTasks* renderPassTasks,
+                                                         size_t renderPassIndex);
         void RecordCopyImageWithTemporaryBuffer(CommandRecordingContext* recordingContext,
                                                 const TextureCopy& srcCopy,
                                                 const TextureCopy& dstCopy,
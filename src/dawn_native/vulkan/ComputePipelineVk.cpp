@@ -17,6 +17,7 @@
 #include "dawn_native/CreatePipelineAsyncTask.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/PipelineCache.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
 #include "dawn_native/vulkan/ShaderModuleVk.h"
 #include "dawn_native/vulkan/UtilsVulkan.h"
@@ -76,10 +77,11 @@ namespace dawn_native { namespace vulkan {
                 VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO_EXT);
         }
 
-        DAWN_TRY(CheckVkSuccess(
-            device->fn.CreateComputePipelines(device->GetVkDevice(), ::VK_NULL_HANDLE, 1,
-                                              &createInfo, nullptr, &*mHandle),
-            "CreateComputePipeline"));
+        VkPipelineCache cache = device->GetPipelineCache()->Acquire();
+        ::VkResult result = device->fn.CreateComputePipelines(device->GetVkDevice(), cache, 1,
+                                                              &createInfo, nullptr, &*mHandle);
+        device->GetPipelineCache()->Release(cache);
+        DAWN_TRY(CheckVkSuccess(result, "CreateComputePipeline"));
 
         SetLabelImpl();
 
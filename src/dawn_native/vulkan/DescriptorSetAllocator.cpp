@@ -115,6 +115,19 @@ namespace dawn_native { namespace vulkan {
         *allocationInfo = {};
     }
 
+    void DescriptorSetAllocator::DeallocateOnDestruction(DescriptorSetAllocation* allocationInfo) {
+        ASSERT(allocationInfo != nullptr);
+        ASSERT(allocationInfo->poolIndex < mDescriptorPools.size());
+
+        auto& freeSetIndices = mDescriptorPools[allocationInfo->poolIndex].freeSetIndices;
+        if (freeSetIndices.empty()) {
+            mAvailableDescriptorPoolIndices.emplace_back(allocationInfo->poolIndex);
+        }
+        freeSetIndices.emplace_back(allocationInfo->setIndex);
+
+        *allocationInfo = {};
+    }
+
     void DescriptorSetAllocator::FinishDeallocation(ExecutionSerial completedSerial) {
         for (const Deallocation& dealloc : mPendingDeallocations.IterateUpTo(completedSerial)) {
             ASSERT(dealloc.poolIndex < mDescriptorPools.size());
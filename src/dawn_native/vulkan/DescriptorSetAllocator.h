@@ -39,6 +39,9 @@ namespace dawn_native { namespace vulkan {
 
         ResultOrError<DescriptorSetAllocation> Allocate();
         void Deallocate(DescriptorSetAllocation* allocationInfo);
+        // Returns the set to its pool without waiting for the GPU. Only valid when the layout is
+        // destroyed, since the pools are then deleted with the FencedDeleter.
+        void DeallocateOnDestruction(DescriptorSetAllocation* allocationInfo);
         void FinishDeallocation(ExecutionSerial completedSerial);
 
       private:
@@ -28,6 +28,7 @@
 #include "dawn_native/vulkan/CommandBufferVk.h"
 #include "dawn_native/vulkan/ComputePipelineVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/PipelineCache.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
 #include "dawn_native/vulkan/QuerySetVk.h"
 #include "dawn_native/vulkan/QueueVk.h"
@@ -37,6 +38,7 @@
 #include "dawn_native/vulkan/SamplerVk.h"
 #include "dawn_native/vulkan/ShaderModuleVk.h"
 #include "dawn_native/vulkan/StagingBufferVk.h"
+#include "dawn_native/vulkan/SubmissionThread.h"
 #include "dawn_native/vulkan/SwapChainVk.h"
 #include "dawn_native/vulkan/TextureVk.h"
 #include "dawn_native/vulkan/UtilsVulkan.h"
@@ -84,6 +86,17 @@ namespace dawn_native { namespace vulkan {
             mDeleter = std::make_unique<FencedDeleter>(this);
         }
 
+        if (IsToggleEnabled(Toggle::VulkanUseTimelineSemaphore)) {
+            DAWN_TRY(CreateTimelineSemaphore());
+        }
+
+        // The error injector isn't thread-safe, so when it is enabled the Vulkan calls that
+        // would happen on the submission thread stay on this thread instead. Enabling the error
+        // injector after the device is created races with the thread.
+        if (IsToggleEnabled(Toggle::VulkanUseSubmissionThread) && !ErrorInjectorEnabled()) {
+            DAWN_TRY_ASSIGN(mSubmissionThread, SubmissionThread::Create(this));
+        }
+
         mRenderPassCache = std::make_unique<RenderPassCache>(this);
         mResourceMemoryAllocator = std::make_unique<ResourceMemoryAllocator>(this);
 
@@ -96,7 +109,12 @@ namespace dawn_native { namespace vulkan {
         // the decision if it is not applicable.
         ApplyDepth24PlusS8Toggle();
 
-        return DeviceBase::Initialize(Queue::Create(this));
+        DAWN_TRY(DeviceBase::Initialize(Queue::Create(this)));
+
+        // The pipeline cache is loaded from the PersistentCache created in DeviceBase::Initialize.
+        mPipelineCache = std::make_unique<PipelineCache>(this);
+
+        return {};
     }
 
     Device::~Device() {
@@ -144,6 +162,10 @@ namespace dawn_native { namespace vulkan {
         ShaderModuleParseResult* parseResult) {
         return ShaderModule::Create(this, descriptor, parseResult);
     }
+    Ref<ShaderModuleBase> Device::CreateUninitializedShaderModuleImpl(
+        const ShaderModuleDescriptor* descriptor) {
+        return ShaderModule::CreateUninitialized(this, descriptor);
+    }
     ResultOrError<Ref<SwapChainBase>> Device::CreateSwapChainImpl(
         const SwapChainDescriptor* descriptor) {
         return OldSwapChain::Create(this, descriptor);
@@ -188,6 +210,11 @@ namespace dawn_native { namespace vulkan {
         mResourceMemoryAllocator->Tick(completedSerial);
         mDeleter->Tick(completedSerial);
 
+        // The pipeline cache might not exist if the device failed to initialize.
+        if (mPipelineCache != nullptr) {
+            mPipelineCache->Tick();
+        }
+
         if (mRecordingContext.used) {
             DAWN_TRY(SubmitPendingCommands());
         }
@@ -218,10 +245,21 @@ namespace dawn_native { namespace vulkan {
         return mQueue;
     }
 
+    MaybeError Device::FlushSubmissions() {
+        if (mSubmissionThread != nullptr) {
+            DAWN_TRY(mSubmissionThread->Flush());
+        }
+        return {};
+    }
+
     FencedDeleter* Device::GetFencedDeleter() const {
         return mDeleter.get();
     }
 
+    PipelineCache* Device::GetPipelineCache() const {
+        return mPipelineCache.get();
+    }
+
     RenderPassCache* Device::GetRenderPassCache() const {
         return mRenderPassCache.get();
     }
@@ -248,31 +286,23 @@ namespace dawn_native { namespace vulkan {
         DAWN_TRY(CheckVkSuccess(fn.EndCommandBuffer(mRecordingContext.commandBuffer),
                                 "vkEndCommandBuffer"));
 
-        std::vector<VkPipelineStageFlags> dstStageMasks(mRecordingContext.waitSemaphores.size(),
-                                                        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        PendingSubmit submit;
+        submit.commandBuffer = mRecordingContext.commandBuffer;
+        submit.waitSemaphores = mRecordingContext.waitSemaphores;
+        submit.signalSemaphores = mRecordingContext.signalSemaphores;
+        submit.serial = GetPendingCommandSerial();
 
-        VkSubmitInfo submitInfo;
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submitInfo.pNext = nullptr;
-        submitInfo.waitSemaphoreCount =
-            static_cast<uint32_t>(mRecordingContext.waitSemaphores.size());
-        submitInfo.pWaitSemaphores = AsVkArray(mRecordingContext.waitSemaphores.data());
-        submitInfo.pWaitDstStageMask = dstStageMasks.data();
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &mRecordingContext.commandBuffer;
-        submitInfo.signalSemaphoreCount =
-            static_cast<uint32_t>(mRecordingContext.signalSemaphores.size());
-        submitInfo.pSignalSemaphores = AsVkArray(mRecordingContext.signalSemaphores.data());
+        if (mSubmissionThread != nullptr) {
+            mSubmissionThread->Enqueue(submit);
 
-        VkFence fence = VK_NULL_HANDLE;
-        DAWN_TRY_ASSIGN(fence, GetUnusedFence());
-        DAWN_TRY_WITH_CLEANUP(
-            CheckVkSuccess(fn.QueueSubmit(mQueue, 1, &submitInfo, fence), "vkQueueSubmit"), {
-                // If submitting to the queue fails, move the fence back into the unused fence
-                // list, as if it were never acquired. Not doing so would leak the fence since
-                // it would be neither in the unused list nor in the in-flight list.
-                mUnusedFences.push_back(fence);
-            });
+            // The signal semaphores are exported right after this, which is only valid once the
+            // commands signaling them are submitted.
+            if (!submit.signalSemaphores.empty()) {
+                DAWN_TRY(mSubmissionThread->Flush());
+            }
+        } else {
+            DAWN_TRY(SubmitToQueue(submit));
+        }
 
         // Enqueue the semaphores before incrementing the serial, so that they can be deleted as
         // soon as the current submission is finished.
@@ -285,7 +315,7 @@ namespace dawn_native { namespace vulkan {
 
         IncrementLastSubmittedCommandSerial();
         ExecutionSerial lastSubmittedSerial = GetLastSubmittedCommandSerial();
-        mFencesInFlight.emplace(fence, lastSubmittedSerial);
+        ASSERT(lastSubmittedSerial == submit.serial);
 
         CommandPoolAndBuffer submittedCommands = {mRecordingContext.commandPool,
                                                   mRecordingContext.commandBuffer};
@@ -296,6 +326,68 @@ namespace dawn_native { namespace vulkan {
         return {};
     }
 
+    // Once the SubmissionThread exists, only it touches mFencesInFlight and mUnusedFences, through
+    // SubmitToQueue, PollCompletedSerial and WaitForCompletedSerial. The API thread uses them again
+    // only after the thread is stopped, in WaitForIdleForDestruction and ShutDownImpl.
+    MaybeError Device::SubmitToQueue(const PendingSubmit& submit) {
+        std::vector<VkPipelineStageFlags> dstStageMasks(submit.waitSemaphores.size(),
+                                                        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+        VkSubmitInfo submitInfo;
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = nullptr;
+        submitInfo.waitSemaphoreCount = static_cast<uint32_t>(submit.waitSemaphores.size());
+        submitInfo.pWaitSemaphores = AsVkArray(submit.waitSemaphores.data());
+        submitInfo.pWaitDstStageMask = dstStageMasks.data();
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &submit.commandBuffer;
+        submitInfo.signalSemaphoreCount = static_cast<uint32_t>(submit.signalSemaphores.size());
+        submitInfo.pSignalSemaphores = AsVkArray(submit.signalSemaphores.data());
+
+        // With a timeline semaphore the submit signals it to the serial of the commands, in
+        // addition to the binary semaphores of the recording context whose signal values are
+        // ignored.
+        std::vector<VkSemaphore> signalSemaphores;
+        std::vector<uint64_t> signalValues;
+        VkTimelineSemaphoreSubmitInfoKHR timelineSubmitInfo;
+        VkFence fence = VK_NULL_HANDLE;
+        if (IsToggleEnabled(Toggle::VulkanUseTimelineSemaphore)) {
+            signalSemaphores = submit.signalSemaphores;
+            signalSemaphores.push_back(mTimelineSemaphore);
+            signalValues.resize(signalSemaphores.size(), 0);
+            signalValues.back() = static_cast<uint64_t>(submit.serial);
+
+            timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+            timelineSubmitInfo.pNext = nullptr;
+            timelineSubmitInfo.waitSemaphoreValueCount = 0;
+            timelineSubmitInfo.pWaitSemaphoreValues = nullptr;
+            timelineSubmitInfo.signalSemaphoreValueCount =
+                static_cast<uint32_t>(signalValues.size());
+            timelineSubmitInfo.pSignalSemaphoreValues = signalValues.data();
+
+            submitInfo.pNext = &timelineSubmitInfo;
+            submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+            submitInfo.pSignalSemaphores = AsVkArray(signalSemaphores.data());
+        } else {
+            DAWN_TRY_ASSIGN(fence, GetUnusedFence());
+        }
+
+        DAWN_TRY_WITH_CLEANUP(
+            CheckVkSuccess(fn.QueueSubmit(mQueue, 1, &submitInfo, fence), "vkQueueSubmit"), {
+                // If submitting to the queue fails, move the fence back into the unused fence
+                // list, as if it were never acquired. Not doing so would leak the fence since
+                // it would be neither in the unused list nor in the in-flight list.
+                if (fence != VK_NULL_HANDLE) {
+                    mUnusedFences.push_back(fence);
+                }
+            });
+
+        if (fence != VK_NULL_HANDLE) {
+            mFencesInFlight.emplace(fence, submit.serial);
+        }
+        return {};
+    }
+
     ResultOrError<VulkanDeviceKnobs> Device::CreateDevice(VkPhysicalDevice physicalDevice) {
         VulkanDeviceKnobs usedKnobs = {};
 
@@ -344,6 +436,18 @@ namespace dawn_native { namespace vulkan {
             mComputeSubgroupSize = FindComputeSubgroupSize();
         }
 
+        if (IsToggleEnabled(Toggle::VulkanUseTimelineSemaphore)) {
+            if (mDeviceInfo.HasExt(DeviceExt::TimelineSemaphore) &&
+                mDeviceInfo.timelineSemaphoreFeatures.timelineSemaphore == VK_TRUE) {
+                usedKnobs.timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+                featuresChain.Add(
+                    &usedKnobs.timelineSemaphoreFeatures,
+                    VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR);
+            } else {
+                ForceSetToggle(Toggle::VulkanUseTimelineSemaphore, false);
+            }
+        }
+
         if (mDeviceInfo.features.samplerAnisotropy == VK_TRUE) {
             usedKnobs.features.samplerAnisotropy = VK_TRUE;
         }
@@ -494,6 +598,10 @@ namespace dawn_native { namespace vulkan {
 
         // By default try to use D32S8 for Depth24PlusStencil8
         SetToggle(Toggle::VulkanUseD32S8, true);
+
+        // By default use a timeline semaphore to track the serials when it is supported. The
+        // toggle is turned off in CreateDevice otherwise.
+        SetToggle(Toggle::VulkanUseTimelineSemaphore, true);
     }
 
     void Device::ApplyDepth24PlusS8Toggle() {
@@ -552,7 +660,41 @@ namespace dawn_native { namespace vulkan {
         return fence;
     }
 
+    MaybeError Device::CreateTimelineSemaphore() {
+        VkSemaphoreTypeCreateInfoKHR typeCreateInfo;
+        typeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+        typeCreateInfo.pNext = nullptr;
+        typeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+        typeCreateInfo.initialValue = static_cast<uint64_t>(GetCompletedCommandSerial());
+
+        VkSemaphoreCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        createInfo.pNext = &typeCreateInfo;
+        createInfo.flags = 0;
+
+        return CheckVkSuccess(
+            fn.CreateSemaphore(mVkDevice, &createInfo, nullptr, &*mTimelineSemaphore),
+            "vkCreateSemaphore");
+    }
+
     ResultOrError<ExecutionSerial> Device::CheckAndUpdateCompletedSerials() {
+        if (mSubmissionThread != nullptr) {
+            return mSubmissionThread->GetCompletedSerial();
+        }
+        return PollCompletedSerial();
+    }
+
+    ResultOrError<ExecutionSerial> Device::PollCompletedSerial() {
+        // The value of the timeline semaphore is the last completed serial.
+        if (IsToggleEnabled(Toggle::VulkanUseTimelineSemaphore)) {
+            uint64_t value = 0;
+            VkResult result = VkResult::WrapUnsafe(INJECT_ERROR_OR_RUN(
+                fn.GetSemaphoreCounterValue(mVkDevice, mTimelineSemaphore, &value),
+                VK_ERROR_DEVICE_LOST));
+            DAWN_TRY(CheckVkSuccess(::VkResult(result), "vkGetSemaphoreCounterValue"));
+            return ExecutionSerial(value);
+        }
+
         ExecutionSerial fenceSerial(0);
         while (!mFencesInFlight.empty()) {
             VkFence fence = mFencesInFlight.front().first;
@@ -572,22 +714,84 @@ namespace dawn_native { namespace vulkan {
             fenceSerial = tentativeSerial;
 
             mUnusedFences.push_back(fence);
-
-            ASSERT(fenceSerial > GetCompletedCommandSerial());
             mFencesInFlight.pop();
         }
         return fenceSerial;
     }
 
+    ResultOrError<ExecutionSerial> Device::WaitForCompletedSerial(ExecutionSerial serial,
+                                                                  VkSemaphore wakeSemaphore,
+                                                                  uint64_t wakeValue,
+                                                                  uint64_t timeout) {
+        if (IsToggleEnabled(Toggle::VulkanUseTimelineSemaphore)) {
+            ASSERT(wakeSemaphore != VK_NULL_HANDLE);
+            VkSemaphore semaphores[2] = {mTimelineSemaphore, wakeSemaphore};
+            uint64_t values[2] = {static_cast<uint64_t>(serial), wakeValue};
+
+            VkSemaphoreWaitInfoKHR waitInfo;
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+            waitInfo.pNext = nullptr;
+            waitInfo.flags = VK_SEMAPHORE_WAIT_ANY_BIT_KHR;
+            waitInfo.semaphoreCount = 2;
+            waitInfo.pSemaphores = AsVkArray(semaphores);
+            waitInfo.pValues = values;
+
+            VkResult result =
+                VkResult::WrapUnsafe(fn.WaitSemaphores(mVkDevice, &waitInfo, timeout));
+            if (result != VK_TIMEOUT) {
+                DAWN_TRY(CheckVkSuccess(::VkResult(result), "vkWaitSemaphores"));
+            }
+        } else if (!mFencesInFlight.empty()) {
+            VkFence fence = mFencesInFlight.front().first;
+            VkResult result =
+                VkResult::WrapUnsafe(fn.WaitForFences(mVkDevice, 1, &*fence, true, timeout));
+            if (result != VK_TIMEOUT) {
+                DAWN_TRY(CheckVkSuccess(::VkResult(result), "vkWaitForFences"));
+            }
+        }
+
+        return PollCompletedSerial();
+    }
+
     MaybeError Device::PrepareRecordingContext() {
         ASSERT(!mRecordingContext.used);
         ASSERT(mRecordingContext.commandBuffer == VK_NULL_HANDLE);
         ASSERT(mRecordingContext.commandPool == VK_NULL_HANDLE);
 
+        CommandPoolAndBuffer commands;
+        DAWN_TRY_ASSIGN(commands,
+                        GetUnusedCommands(&mUnusedCommands, VK_COMMAND_BUFFER_LEVEL_PRIMARY));
+        mRecordingContext.commandBuffer = commands.commandBuffer;
+        mRecordingContext.commandPool = commands.pool;
+
+        // Start the recording of commands in the command buffer.
+        VkCommandBufferBeginInfo beginInfo;
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo = nullptr;
+
+        return CheckVkSuccess(fn.BeginCommandBuffer(mRecordingContext.commandBuffer, &beginInfo),
+                              "vkBeginCommandBuffer");
+    }
+
+    ResultOrError<VkCommandBuffer> Device::GetSecondaryCommandBuffer() {
+        CommandPoolAndBuffer commands;
+        DAWN_TRY_ASSIGN(commands, GetUnusedCommands(&mUnusedSecondaryCommands,
+                                                    VK_COMMAND_BUFFER_LEVEL_SECONDARY));
+        mSecondaryCommandsInFlight.Enqueue(commands, GetPendingCommandSerial());
+        return commands.commandBuffer;
+    }
+
+    ResultOrError<Device::CommandPoolAndBuffer> Device::GetUnusedCommands(
+        std::vector<CommandPoolAndBuffer>* unusedCommands,
+        VkCommandBufferLevel level) {
+        CommandPoolAndBuffer commands;
+
         // First try to recycle unused command pools.
-        if (!mUnusedCommands.empty()) {
-            CommandPoolAndBuffer commands = mUnusedCommands.back();
-            mUnusedCommands.pop_back();
+        if (!unusedCommands->empty()) {
+            commands = unusedCommands->back();
+            unusedCommands->pop_back();
             DAWN_TRY_WITH_CLEANUP(CheckVkSuccess(fn.ResetCommandPool(mVkDevice, commands.pool, 0),
                                                  "vkResetCommandPool"),
                                   {
@@ -604,42 +808,34 @@ namespace dawn_native { namespace vulkan {
                                                             &commands.commandBuffer);
                                       fn.DestroyCommandPool(mVkDevice, commands.pool, nullptr);
                                   });
+            return commands;
+        }
 
-            mRecordingContext.commandBuffer = commands.commandBuffer;
-            mRecordingContext.commandPool = commands.pool;
-        } else {
-            // Create a new command pool for our commands and allocate the command buffer.
-            VkCommandPoolCreateInfo createInfo;
-            createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-            createInfo.pNext = nullptr;
-            createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
-            createInfo.queueFamilyIndex = mQueueFamily;
-
-            DAWN_TRY(CheckVkSuccess(fn.CreateCommandPool(mVkDevice, &createInfo, nullptr,
-                                                         &*mRecordingContext.commandPool),
-                                    "vkCreateCommandPool"));
+        // Create a new command pool for our commands and allocate the command buffer.
+        VkCommandPoolCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        createInfo.queueFamilyIndex = mQueueFamily;
 
-            VkCommandBufferAllocateInfo allocateInfo;
-            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-            allocateInfo.pNext = nullptr;
-            allocateInfo.commandPool = mRecordingContext.commandPool;
-            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-            allocateInfo.commandBufferCount = 1;
+        DAWN_TRY(CheckVkSuccess(
+            fn.CreateCommandPool(mVkDevice, &createInfo, nullptr, &*commands.pool),
+            "vkCreateCommandPool"));
 
-            DAWN_TRY(CheckVkSuccess(fn.AllocateCommandBuffers(mVkDevice, &allocateInfo,
-                                                              &mRecordingContext.commandBuffer),
-                                    "vkAllocateCommandBuffers"));
-        }
+        VkCommandBufferAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.pNext = nullptr;
+        allocateInfo.commandPool = commands.pool;
+        allocateInfo.level = level;
+        allocateInfo.commandBufferCount = 1;
 
-        // Start the recording of commands in the command buffer.
-        VkCommandBufferBeginInfo beginInfo;
-        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        beginInfo.pNext = nullptr;
-        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        beginInfo.pInheritanceInfo = nullptr;
+        DAWN_TRY_WITH_CLEANUP(
+            CheckVkSuccess(
+                fn.AllocateCommandBuffers(mVkDevice, &allocateInfo, &commands.commandBuffer),
+                "vkAllocateCommandBuffers"),
+            { fn.DestroyCommandPool(mVkDevice, commands.pool, nullptr); });
 
-        return CheckVkSuccess(fn.BeginCommandBuffer(mRecordingContext.commandBuffer, &beginInfo),
-                              "vkBeginCommandBuffer");
+        return commands;
     }
 
     void Device::RecycleCompletedCommands() {
@@ -647,6 +843,11 @@ namespace dawn_native { namespace vulkan {
             mUnusedCommands.push_back(commands);
         }
         mCommandsInFlight.ClearUpTo(GetCompletedCommandSerial());
+
+        for (auto& commands : mSecondaryCommandsInFlight.IterateUpTo(GetCompletedCommandSerial())) {
+            mUnusedSecondaryCommands.push_back(commands);
+        }
+        mSecondaryCommandsInFlight.ClearUpTo(GetCompletedCommandSerial());
     }
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
@@ -863,6 +1064,12 @@ namespace dawn_native { namespace vulkan {
     }
 
     MaybeError Device::WaitForIdleForDestruction() {
+        // All pipeline creations are finished at this point. Save the pipeline cache while the
+        // PersistentCache is still alive.
+        if (mPipelineCache != nullptr) {
+            mPipelineCache->Flush();
+        }
+
         // Immediately tag the recording context as unused so we don't try to submit it in Tick.
         // Move the mRecordingContext.used to mUnusedCommands so it can be cleaned up in
         // ShutDownImpl
@@ -873,12 +1080,45 @@ namespace dawn_native { namespace vulkan {
             mRecordingContext = CommandRecordingContext();
         }
 
+        // Stopping the submission thread submits the commands it has left, and makes the queue
+        // and fences usable on this thread. Commands submitted later are submitted directly.
+        mSubmissionThread = nullptr;
+
         VkResult waitIdleResult = VkResult::WrapUnsafe(fn.QueueWaitIdle(mQueue));
         // Ignore the result of QueueWaitIdle: it can return OOM which we can't really do anything
         // about, Device lost, which means workloads running on the GPU are no longer accessible
         // (so they are as good as waited on) or success.
         DAWN_UNUSED(waitIdleResult);
 
+        // Make sure the timeline semaphore reached the last submitted serial by explicitly waiting
+        // on it.
+        if (IsToggleEnabled(Toggle::VulkanUseTimelineSemaphore)) {
+            uint64_t value = static_cast<uint64_t>(GetLastSubmittedCommandSerial());
+
+            VkSemaphoreWaitInfoKHR waitInfo;
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+            waitInfo.pNext = nullptr;
+            waitInfo.flags = 0;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &*mTimelineSemaphore;
+            waitInfo.pValues = &value;
+
+            VkResult result = VkResult::WrapUnsafe(VK_TIMEOUT);
+            do {
+                // See the comment in the fence loop below for why errors aren't injected when
+                // Disconnected.
+                if (GetState() == State::Disconnected) {
+                    result = VkResult::WrapUnsafe(
+                        fn.WaitSemaphores(mVkDevice, &waitInfo, UINT64_MAX));
+                    continue;
+                }
+
+                result = VkResult::WrapUnsafe(INJECT_ERROR_OR_RUN(
+                    fn.WaitSemaphores(mVkDevice, &waitInfo, UINT64_MAX), VK_ERROR_DEVICE_LOST));
+            } while (result == VK_TIMEOUT);
+            // Ignore errors from vkWaitSemaphores for the same reasons as for vkWaitForFences.
+        }
+
         // Make sure all fences are complete by explicitly waiting on them all
         while (!mFencesInFlight.empty()) {
             VkFence fence = mFencesInFlight.front().first;
@@ -934,6 +1174,10 @@ namespace dawn_native { namespace vulkan {
         // Enough of the Device's initialization happened that we can now do regular robust
         // deinitialization.
 
+        // The submission thread might still exist if the device was lost. Stop it before using
+        // the fences below.
+        mSubmissionThread = nullptr;
+
         // Immediately tag the recording context as unused so we don't try to submit it in Tick.
         mRecordingContext.used = false;
         if (mRecordingContext.commandPool != VK_NULL_HANDLE) {
@@ -961,6 +1205,17 @@ namespace dawn_native { namespace vulkan {
         RecycleCompletedCommands();
         ASSERT(mCommandsInFlight.Empty());
 
+        // Secondary command buffers of commands that were never submitted are still tagged with
+        // the pending serial.
+        for (const CommandPoolAndBuffer& commands : mSecondaryCommandsInFlight.IterateAll()) {
+            mUnusedCommands.push_back(commands);
+        }
+        mSecondaryCommandsInFlight.Clear();
+        for (const CommandPoolAndBuffer& commands : mUnusedSecondaryCommands) {
+            mUnusedCommands.push_back(commands);
+        }
+        mUnusedSecondaryCommands.clear();
+
         for (const CommandPoolAndBuffer& commands : mUnusedCommands) {
             // The VkCommandBuffer memory should be wholly owned by the pool and freed when it is
             // destroyed, but that's not the case in some drivers and the leak memory.
@@ -983,6 +1238,11 @@ namespace dawn_native { namespace vulkan {
         }
         mUnusedFences.clear();
 
+        if (mTimelineSemaphore != VK_NULL_HANDLE) {
+            fn.DestroySemaphore(mVkDevice, mTimelineSemaphore, nullptr);
+            mTimelineSemaphore = VK_NULL_HANDLE;
+        }
+
         ExecutionSerial completedSerial = GetCompletedCommandSerial();
         for (Ref<BindGroupLayout>& bgl :
              mBindGroupLayoutsPendingDeallocation.IterateUpTo(completedSerial)) {
@@ -1002,6 +1262,9 @@ namespace dawn_native { namespace vulkan {
         // to them are guaranteed to be finished executing.
         mRenderPassCache = nullptr;
 
+        // VkPipelineCaches aren't used by commands so they can be destroyed immediately.
+        mPipelineCache = nullptr;
+
         // We need handle deleting all child objects by calling Tick() again with a large serial to
         // force all operations to look as if they were completed, and delete all objects before
         // destroying the Deleter and vkDevice.
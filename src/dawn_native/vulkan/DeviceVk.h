@@ -37,8 +37,11 @@ namespace dawn_native { namespace vulkan {
     class BindGroupLayout;
     class BufferUploader;
     class FencedDeleter;
+    class PipelineCache;
     class RenderPassCache;
     class ResourceMemoryAllocator;
+    class SubmissionThread;
+    struct PendingSubmit;
 
     class Device : public DeviceBase {
       public:
@@ -56,13 +59,33 @@ namespace dawn_native { namespace vulkan {
         VkDevice GetVkDevice() const;
         uint32_t GetGraphicsQueueFamily() const;
         VkQueue GetQueue() const;
+        // Waits for the recorded commands to be submitted to the queue when they are submitted on
+        // the SubmissionThread, so that the VkQueue can be used directly.
+        MaybeError FlushSubmissions();
 
         FencedDeleter* GetFencedDeleter() const;
+        PipelineCache* GetPipelineCache() const;
         RenderPassCache* GetRenderPassCache() const;
         ResourceMemoryAllocator* GetResourceMemoryAllocator() const;
 
         CommandRecordingContext* GetPendingRecordingContext();
         MaybeError SubmitPendingCommands();
+        // Returns a secondary command buffer for the pending commands. It has its own command pool
+        // so it can be recorded on another thread, and is recycled when the pending commands
+        // complete.
+        ResultOrError<VkCommandBuffer> GetSecondaryCommandBuffer();
+
+        // Used by the SubmissionThread, or directly when there is none.
+        MaybeError SubmitToQueue(const PendingSubmit& submit);
+        ResultOrError<ExecutionSerial> PollCompletedSerial();
+        // Used by the SubmissionThread. Blocks until |serial| completes, until the timeline
+        // semaphore |wakeSemaphore| reaches |wakeValue|, or for at most |timeout| nanoseconds, then
+        // returns the last completed serial. Only waits on the oldest fence in flight when timeline
+        // semaphores aren't used, in which case |wakeSemaphore| is VK_NULL_HANDLE.
+        ResultOrError<ExecutionSerial> WaitForCompletedSerial(ExecutionSerial serial,
+                                                              VkSemaphore wakeSemaphore,
+                                                              uint64_t wakeValue,
+                                                              uint64_t timeout);
 
         void EnqueueDeferredDeallocation(BindGroupLayout* bindGroupLayout);
 
@@ -126,6 +149,8 @@ namespace dawn_native { namespace vulkan {
         ResultOrError<Ref<ShaderModuleBase>> CreateShaderModuleImpl(
             const ShaderModuleDescriptor* descriptor,
             ShaderModuleParseResult* parseResult) override;
+        Ref<ShaderModuleBase> CreateUninitializedShaderModuleImpl(
+            const ShaderModuleDescriptor* descriptor) override;
         ResultOrError<Ref<SwapChainBase>> CreateSwapChainImpl(
             const SwapChainDescriptor* descriptor) override;
         ResultOrError<Ref<NewSwapChainBase>> CreateSwapChainImpl(
@@ -167,19 +192,25 @@ namespace dawn_native { namespace vulkan {
 
         SerialQueue<ExecutionSerial, Ref<BindGroupLayout>> mBindGroupLayoutsPendingDeallocation;
         std::unique_ptr<FencedDeleter> mDeleter;
+        std::unique_ptr<SubmissionThread> mSubmissionThread;
         std::unique_ptr<ResourceMemoryAllocator> mResourceMemoryAllocator;
         std::unique_ptr<RenderPassCache> mRenderPassCache;
+        std::unique_ptr<PipelineCache> mPipelineCache;
 
         std::unique_ptr<external_memory::Service> mExternalMemoryService;
         std::unique_ptr<external_semaphore::Service> mExternalSemaphoreService;
 
         ResultOrError<VkFence> GetUnusedFence();
+        MaybeError CreateTimelineSemaphore();
         ResultOrError<ExecutionSerial> CheckAndUpdateCompletedSerials() override;
 
         // We track which operations are in flight on the GPU with an increasing serial.
-        // This works only because we have a single queue. Each submit to a queue is associated
-        // to a serial and a fence, such that when the fence is "ready" we know the operations
-        // have finished.
+        // This works only because we have a single queue. When VulkanUseTimelineSemaphore is
+        // enabled, each submit signals the timeline semaphore to its serial so that its value is
+        // the last completed serial.
+        VkSemaphore mTimelineSemaphore = VK_NULL_HANDLE;
+        // Otherwise each submit to a queue is associated to a serial and a fence, such that when
+        // the fence is "ready" we know the operations have finished.
         std::queue<std::pair<VkFence, ExecutionSerial>> mFencesInFlight;
         // Fences in the unused list aren't reset yet.
         std::vector<VkFence> mUnusedFences;
@@ -191,9 +222,17 @@ namespace dawn_native { namespace vulkan {
             VkCommandPool pool = VK_NULL_HANDLE;
             VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
         };
+        ResultOrError<CommandPoolAndBuffer> GetUnusedCommands(
+            std::vector<CommandPoolAndBuffer>* unusedCommands,
+            VkCommandBufferLevel level);
+
         SerialQueue<ExecutionSerial, CommandPoolAndBuffer> mCommandsInFlight;
         // Command pools in the unused list haven't been reset yet.
         std::vector<CommandPoolAndBuffer> mUnusedCommands;
+        // Same as above for the secondary command buffers used to record render passes in
+        // parallel.
+        SerialQueue<ExecutionSerial, CommandPoolAndBuffer> mSecondaryCommandsInFlight;
+        std::vector<CommandPoolAndBuffer> mUnusedSecondaryCommands;
         // There is always a valid recording context stored in mRecordingContext
         CommandRecordingContext mRecordingContext;
 
@@ -210,6 +210,10 @@ namespace dawn_native { namespace vulkan {
         presentInfo.pImageIndices = &mLastImageIndex;
         presentInfo.pResults = nullptr;
 
+        if (mDevice->ConsumedError(mDevice->FlushSubmissions())) {
+            return "Error submitting the commands before presenting";
+        }
+
         VkQueue queue = mDevice->GetQueue();
         if (mDevice->fn.QueuePresentKHR(queue, &presentInfo) != VK_SUCCESS) {
             ASSERT(false);
@@ -0,0 +1,191 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/PipelineCache.h"
+
+#include "common/Assert.h"
+#include "dawn_native/vulkan/DeviceVk.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace dawn_native { namespace vulkan {
+
+    PipelineCache::PipelineCache(Device* device) : mDevice(device), mKey(ComputeCacheKey()) {
+        ScopedCachedBlob blob = mDevice->GetPersistentCache()->LoadData(mKey);
+        mMainCache = CreateCache(blob.buffer.get(), blob.bufferSize);
+
+        // Drivers are supposed to ignore incompatible initial data but be defensive and start
+        // from an empty cache if the stored data is rejected.
+        if (mMainCache == VK_NULL_HANDLE && blob.bufferSize > 0) {
+            mMainCache = CreateCache(nullptr, 0);
+        }
+    }
+
+    PipelineCache::~PipelineCache() {
+        ASSERT(mAvailableCaches.size() == mCacheCount);
+
+        VkDevice device = mDevice->GetVkDevice();
+        for (VkPipelineCache cache : mAvailableCaches) {
+            mDevice->fn.DestroyPipelineCache(device, cache, nullptr);
+        }
+        if (mMainCache != VK_NULL_HANDLE) {
+            mDevice->fn.DestroyPipelineCache(device, mMainCache, nullptr);
+        }
+    }
+
+    VkPipelineCache PipelineCache::Acquire() {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        if (!mAvailableCaches.empty()) {
+            VkPipelineCache cache = mAvailableCaches.back();
+            mAvailableCaches.pop_back();
+            return cache;
+        }
+
+        // Without a main cache, pipelines are created without caching at all.
+        if (mMainCache == VK_NULL_HANDLE) {
+            return VK_NULL_HANDLE;
+        }
+
+        std::vector<uint8_t> initialData = GetCacheData(mMainCache);
+        VkPipelineCache cache = CreateCache(initialData.data(), initialData.size());
+        if (cache != VK_NULL_HANDLE) {
+            mCacheCount++;
+        }
+        return cache;
+    }
+
+    void PipelineCache::Release(VkPipelineCache cache) {
+        if (cache == VK_NULL_HANDLE) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mAvailableCaches.push_back(cache);
+        if (std::find(mReleasedCaches.begin(), mReleasedCaches.end(), cache) ==
+            mReleasedCaches.end()) {
+            mReleasedCaches.push_back(cache);
+        }
+    }
+
+    void PipelineCache::Tick() {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // Only store the main cache on the first Tick without new pipelines, so that it is done
+        // once at the end of a burst of pipeline creations.
+        if (!mReleasedCaches.empty()) {
+            MergeReleasedCaches();
+        } else if (mMainCacheDirty) {
+            StoreMainCache();
+        }
+    }
+
+    void PipelineCache::Flush() {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        MergeReleasedCaches();
+        if (mMainCacheDirty) {
+            StoreMainCache();
+        }
+    }
+
+    PersistentCacheKey PipelineCache::ComputeCacheKey() const {
+        const VkPhysicalDeviceProperties& properties = mDevice->GetDeviceInfo().properties;
+
+        std::stringstream stream;
+
+        // Prefix the key with the type to avoid collisions from another type that could have the
+        // same key.
+        stream << static_cast<uint32_t>(PersistentKeyType::VulkanPipelineCache);
+        stream << "\n";
+
+        // The driver checks the header of the data for compatibility but also key on the
+        // properties it contains so that data for different devices and drivers can coexist.
+        stream << "(VulkanPipelineCache";
+        stream << " vendorID=" << properties.vendorID;
+        stream << " deviceID=" << properties.deviceID;
+        stream << " driverVersion=" << properties.driverVersion;
+        stream << " pipelineCacheUUID=";
+        for (uint8_t byte : properties.pipelineCacheUUID) {
+            stream << static_cast<uint32_t>(byte) << ",";
+        }
+        stream << ")";
+        stream << "\n";
+
+        return PersistentCacheKey(std::istreambuf_iterator<char>{stream},
+                                  std::istreambuf_iterator<char>{});
+    }
+
+    VkPipelineCache PipelineCache::CreateCache(const void* initialData,
+                                               size_t initialDataSize) const {
+        VkPipelineCacheCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.initialDataSize = initialDataSize;
+        createInfo.pInitialData = initialData;
+
+        // Failing to create a cache only makes pipeline creation slower, so the error is ignored
+        // instead of being reported to the device.
+        VkPipelineCache cache = VK_NULL_HANDLE;
+        if (mDevice->fn.CreatePipelineCache(mDevice->GetVkDevice(), &createInfo, nullptr,
+                                            &*cache) != VK_SUCCESS) {
+            return VK_NULL_HANDLE;
+        }
+        return cache;
+    }
+
+    std::vector<uint8_t> PipelineCache::GetCacheData(VkPipelineCache cache) const {
+        VkDevice device = mDevice->GetVkDevice();
+
+        size_t size = 0;
+        if (mDevice->fn.GetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS) {
+            return {};
+        }
+
+        std::vector<uint8_t> data(size);
+        if (size == 0 ||
+            mDevice->fn.GetPipelineCacheData(device, cache, &size, data.data()) != VK_SUCCESS) {
+            return {};
+        }
+        data.resize(size);
+        return data;
+    }
+
+    void PipelineCache::MergeReleasedCaches() {
+        if (mReleasedCaches.empty()) {
+            return;
+        }
+
+        ASSERT(mMainCache != VK_NULL_HANDLE);
+        if (mDevice->fn.MergePipelineCaches(mDevice->GetVkDevice(), mMainCache,
+                                            static_cast<uint32_t>(mReleasedCaches.size()),
+                                            AsVkArray(mReleasedCaches.data())) == VK_SUCCESS) {
+            mMainCacheDirty = true;
+        }
+        mReleasedCaches.clear();
+    }
+
+    void PipelineCache::StoreMainCache() {
+        ASSERT(mMainCache != VK_NULL_HANDLE);
+
+        std::vector<uint8_t> data = GetCacheData(mMainCache);
+        if (!data.empty()) {
+            mDevice->GetPersistentCache()->StoreData(mKey, data.data(), data.size());
+        }
+        mMainCacheDirty = false;
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,80 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_PIPELINECACHE_H_
+#define DAWNNATIVE_VULKAN_PIPELINECACHE_H_
+
+#include "common/vulkan_platform.h"
+#include "dawn_native/Error.h"
+#include "dawn_native/PersistentCache.h"
+
+#include <mutex>
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    class Device;
+
+    // Owns the VkPipelineCaches used to create all the pipelines of a device, and keeps their
+    // content in the PersistentCache so that pipeline compilation is fast on warm starts.
+    //
+    // Pipelines can be created on multiple threads at once with Create*PipelineAsync, so instead
+    // of sharing a single VkPipelineCache (which the driver would synchronize internally), each
+    // pipeline creation acquires a cache of its own, so there is about one cache per worker
+    // thread. New caches are seeded with the content of the main cache, and the caches used since
+    // the last Tick() are merged back into it. The merged content is written to the
+    // PersistentCache once pipeline creation settles down, so that it isn't serialized repeatedly
+    // while an application creates many pipelines.
+    // All the operations on PipelineCache are guaranteed to be thread-safe.
+    class PipelineCache {
+      public:
+        explicit PipelineCache(Device* device);
+        ~PipelineCache();
+
+        // Returns a VkPipelineCache that isn't used by other threads. It can be VK_NULL_HANDLE if
+        // pipeline caches cannot be created. Each call must be matched with a call to Release().
+        VkPipelineCache Acquire();
+        void Release(VkPipelineCache cache);
+
+        void Tick();
+
+        // Merges all the released caches and stores the main cache in the PersistentCache. Called
+        // before the device is destroyed.
+        void Flush();
+
+      private:
+        PersistentCacheKey ComputeCacheKey() const;
+        VkPipelineCache CreateCache(const void* initialData, size_t initialDataSize) const;
+        std::vector<uint8_t> GetCacheData(VkPipelineCache cache) const;
+
+        void MergeReleasedCaches();
+        void StoreMainCache();
+
+        Device* mDevice = nullptr;
+        PersistentCacheKey mKey;
+
+        std::mutex mMutex;
+        VkPipelineCache mMainCache = VK_NULL_HANDLE;
+        // Caches that aren't in use by a pipeline creation.
+        std::vector<VkPipelineCache> mAvailableCaches;
+        // Caches released since the last merge, which may contain new pipelines.
+        std::vector<VkPipelineCache> mReleasedCaches;
+        uint32_t mCacheCount = 0;
+        // Whether the main cache has content not yet written to the PersistentCache.
+        bool mMainCacheDirty = false;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_PIPELINECACHE_H_
@@ -17,6 +17,7 @@
 #include "dawn_native/CreatePipelineAsyncTask.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
+#include "dawn_native/vulkan/PipelineCache.h"
 #include "dawn_native/vulkan/PipelineLayoutVk.h"
 #include "dawn_native/vulkan/RenderPassCache.h"
 #include "dawn_native/vulkan/ShaderModuleVk.h"
@@ -542,10 +543,11 @@ namespace dawn_native { namespace vulkan {
         createInfo.basePipelineHandle = VkPipeline{};
         createInfo.basePipelineIndex = -1;
 
-        DAWN_TRY(CheckVkSuccess(
-            device->fn.CreateGraphicsPipelines(device->GetVkDevice(), VkPipelineCache{}, 1,
-                                               &createInfo, nullptr, &*mHandle),
-            "CreateGraphicsPipeline"));
+        VkPipelineCache cache = device->GetPipelineCache()->Acquire();
+        ::VkResult result = device->fn.CreateGraphicsPipelines(device->GetVkDevice(), cache, 1,
+                                                               &createInfo, nullptr, &*mHandle);
+        device->GetPipelineCache()->Release(cache);
+        DAWN_TRY(CheckVkSuccess(result, "CreateGraphicsPipeline"));
 
         SetLabelImpl();
 
@@ -17,6 +17,7 @@
 #include "common/Math.h"
 #include "dawn_native/BuddyMemoryAllocator.h"
 #include "dawn_native/ResourceHeapAllocator.h"
+#include "dawn_native/TLSFMemoryAllocator.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/ResourceHeapVk.h"
@@ -37,8 +38,8 @@ namespace dawn_native { namespace vulkan {
 
     }  // anonymous namespace
 
-    // SingleTypeAllocator is a combination of a BuddyMemoryAllocator and its client and can
-    // service suballocation requests, but for a single Vulkan memory type.
+    // SingleTypeAllocator is a combination of a sub-allocator (buddy or TLSF) and its client and
+    // can service suballocation requests, but for a single Vulkan memory type.
 
     class ResourceMemoryAllocator::SingleTypeAllocator : public ResourceHeapAllocator {
       public:
@@ -46,15 +47,22 @@ namespace dawn_native { namespace vulkan {
             : mDevice(device),
               mMemoryTypeIndex(memoryTypeIndex),
               mMemoryHeapSize(memoryHeapSize),
-              mPooledMemoryAllocator(this),
-              mBuddySystem(
-                  // Round down to a power of 2 that's <= mMemoryHeapSize. This will always
-                  // be a multiple of kBuddyHeapsSize because kBuddyHeapsSize is a power of 2.
-                  uint64_t(1) << Log2(mMemoryHeapSize),
-                  // Take the min in the very unlikely case the memory heap is tiny.
-                  std::min(uint64_t(1) << Log2(mMemoryHeapSize), kBuddyHeapsSize),
-                  &mPooledMemoryAllocator) {
+              mPooledMemoryAllocator(this) {
             ASSERT(IsPowerOfTwo(kBuddyHeapsSize));
+
+            // Round down to a power of 2 that's <= mMemoryHeapSize. This will always be a
+            // multiple of kBuddyHeapsSize because kBuddyHeapsSize is a power of 2.
+            uint64_t maxSystemSize = uint64_t(1) << Log2(mMemoryHeapSize);
+            // Take the min in the very unlikely case the memory heap is tiny.
+            uint64_t memoryBlockSize = std::min(maxSystemSize, kBuddyHeapsSize);
+
+            if (mDevice->IsToggleEnabled(Toggle::UseTLSFSubAllocator)) {
+                mSubAllocator = std::make_unique<TLSFMemoryAllocator>(
+                    maxSystemSize, memoryBlockSize, &mPooledMemoryAllocator);
+            } else {
+                mSubAllocator = std::make_unique<BuddyMemoryAllocator>(
+                    maxSystemSize, memoryBlockSize, &mPooledMemoryAllocator);
+            }
         }
         ~SingleTypeAllocator() override = default;
 
@@ -63,14 +71,14 @@ namespace dawn_native { namespace vulkan {
         }
 
         ResultOrError<ResourceMemoryAllocation> AllocateMemory(uint64_t size, uint64_t alignment) {
-            return mBuddySystem.Allocate(size, alignment);
+            return mSubAllocator->Allocate(size, alignment);
         }
 
         void DeallocateMemory(const ResourceMemoryAllocation& allocation) {
-            mBuddySystem.Deallocate(allocation);
+            mSubAllocator->Deallocate(allocation);
         }
 
-        // Implementation of the MemoryAllocator interface to be a client of BuddyMemoryAllocator
+        // Implementation of the MemoryAllocator interface to be a client of the sub-allocator
 
         ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(
             uint64_t size) override {
@@ -105,7 +113,7 @@ namespace dawn_native { namespace vulkan {
         size_t mMemoryTypeIndex;
         VkDeviceSize mMemoryHeapSize;
         PooledResourceMemoryAllocator mPooledMemoryAllocator;
-        BuddyMemoryAllocator mBuddySystem;
+        std::unique_ptr<ResourceMemorySubAllocator> mSubAllocator;
     };
 
     // Implementation of ResourceMemoryAllocator
@@ -14,6 +14,7 @@
 
 #include "dawn_native/vulkan/ShaderModuleVk.h"
 
+#include "dawn_native/BoundsCheckAnalysis.h"
 #include "dawn_native/SpirvValidation.h"
 #include "dawn_native/TintUtils.h"
 #include "dawn_native/vulkan/BindGroupLayoutVk.h"
@@ -76,6 +77,12 @@ namespace dawn_native { namespace vulkan {
         return module;
     }
 
+    // static
+    Ref<ShaderModule> ShaderModule::CreateUninitialized(Device* device,
+                                                        const ShaderModuleDescriptor* descriptor) {
+        return AcquireRef(new ShaderModule(device, descriptor));
+    }
+
     ShaderModule::ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor)
         : ShaderModuleBase(device, descriptor), mTransformedShaderModuleCache(device) {
     }
@@ -84,12 +91,12 @@ namespace dawn_native { namespace vulkan {
         if (GetDevice()->IsRobustnessEnabled()) {
             ScopedTintICEHandler scopedICEHandler(GetDevice());
 
-            tint::transform::BoundArrayAccessors boundArrayAccessors;
+            ClampUnprovenIndexAccesses clampIndexAccesses;
             tint::transform::DataMap transformInputs;
 
             tint::Program program;
             DAWN_TRY_ASSIGN(program,
-                            RunTransforms(&boundArrayAccessors, parseResult->tintProgram.get(),
+                            RunTransforms(&clampIndexAccesses, parseResult->tintProgram.get(),
                                           transformInputs, nullptr, nullptr));
             // Rather than use a new ParseResult object, we just reuse the original parseResult
             parseResult->tintProgram = std::make_unique<tint::Program>(std::move(program));
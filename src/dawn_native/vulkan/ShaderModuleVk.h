@@ -32,6 +32,8 @@ namespace dawn_native { namespace vulkan {
         static ResultOrError<Ref<ShaderModule>> Create(Device* device,
                                                        const ShaderModuleDescriptor* descriptor,
                                                        ShaderModuleParseResult* parseResult);
+        static Ref<ShaderModule> CreateUninitialized(Device* device,
+                                                     const ShaderModuleDescriptor* descriptor);
 
         ResultOrError<VkShaderModule> GetTransformedModuleHandle(const char* entryPointName,
                                                                  PipelineLayout* layout);
@@ -39,7 +41,7 @@ namespace dawn_native { namespace vulkan {
       private:
         ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
         ~ShaderModule() override;
-        MaybeError Initialize(ShaderModuleParseResult* parseResult);
+        MaybeError Initialize(ShaderModuleParseResult* parseResult) override;
 
         // New handles created by GetTransformedModuleHandle at pipeline creation time
         class ConcurrentTransformedShaderModuleCache {
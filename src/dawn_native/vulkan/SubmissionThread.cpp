@@ -0,0 +1,209 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/SubmissionThread.h"
+
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/VulkanError.h"
+
+#include <algorithm>
+
+namespace dawn_native { namespace vulkan {
+
+    namespace {
+
+        // The longest the thread blocks in vkWaitSemaphores. It is woken up by the wake semaphore
+        // when there is work, so this only bounds how long a lost wake-up could last.
+        constexpr uint64_t kSemaphoreWaitTimeout = 100'000'000;  // 100ms in ns
+
+        // The longest the thread blocks in vkWaitForFences, which can't be woken up, before
+        // checking for newly enqueued commands.
+        constexpr uint64_t kFenceWaitTimeout = 1'000'000;  // 1ms in ns
+
+    }  // anonymous namespace
+
+    // static
+    ResultOrError<std::unique_ptr<SubmissionThread>> SubmissionThread::Create(Device* device) {
+        std::unique_ptr<SubmissionThread> thread(new SubmissionThread(device));
+        DAWN_TRY(thread->Initialize());
+        return std::move(thread);
+    }
+
+    SubmissionThread::SubmissionThread(Device* device) : mDevice(device) {
+    }
+
+    MaybeError SubmissionThread::Initialize() {
+        if (mDevice->IsToggleEnabled(Toggle::VulkanUseTimelineSemaphore)) {
+            VkSemaphoreTypeCreateInfoKHR typeCreateInfo;
+            typeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+            typeCreateInfo.pNext = nullptr;
+            typeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+            typeCreateInfo.initialValue = mWakeValue;
+
+            VkSemaphoreCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            createInfo.pNext = &typeCreateInfo;
+            createInfo.flags = 0;
+
+            DAWN_TRY(CheckVkSuccess(mDevice->fn.CreateSemaphore(mDevice->GetVkDevice(), &createInfo,
+                                                                nullptr, &*mWakeSemaphore),
+                                    "vkCreateSemaphore"));
+        }
+
+        mThread = std::thread(&SubmissionThread::ThreadMain, this);
+        return {};
+    }
+
+    SubmissionThread::~SubmissionThread() {
+        if (mThread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStopping = true;
+                WakeLocked();
+            }
+            mCondition.notify_all();
+            mThread.join();
+        }
+
+        if (mWakeSemaphore != VK_NULL_HANDLE) {
+            mDevice->fn.DestroySemaphore(mDevice->GetVkDevice(), mWakeSemaphore, nullptr);
+            mWakeSemaphore = VK_NULL_HANDLE;
+        }
+    }
+
+    void SubmissionThread::Enqueue(PendingSubmit submit) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ASSERT(!mStopping);
+            mPendingSubmits.push_back(std::move(submit));
+            WakeLocked();
+        }
+        mCondition.notify_all();
+    }
+
+    MaybeError SubmissionThread::Flush() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this] { return mPendingSubmits.empty() && !mSubmitting; });
+        return AcquireErrorLocked();
+    }
+
+    ResultOrError<ExecutionSerial> SubmissionThread::GetCompletedSerial() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        DAWN_TRY(AcquireErrorLocked());
+
+        ExecutionSerial completedSerial = mCompletedSerial;
+        return completedSerial;
+    }
+
+    void SubmissionThread::ThreadMain() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true) {
+            if (!mPendingSubmits.empty()) {
+                std::deque<PendingSubmit> submits;
+                submits.swap(mPendingSubmits);
+                mSubmitting = true;
+                bool failed = mFailed;
+                lock.unlock();
+
+                // Submits after an error are dropped: the device is lost when the error is
+                // returned to it.
+                MaybeError result = {};
+                if (!failed) {
+                    for (const PendingSubmit& submit : submits) {
+                        result = mDevice->SubmitToQueue(submit);
+                        if (result.IsError()) {
+                            break;
+                        }
+                    }
+                }
+
+                lock.lock();
+                mSubmitting = false;
+                if (result.IsError()) {
+                    SetErrorLocked(result.AcquireError());
+                } else if (!failed) {
+                    mSubmittedSerial = submits.back().serial;
+                }
+                mCondition.notify_all();
+                continue;
+            }
+
+            if (mStopping) {
+                return;
+            }
+
+            if (mFailed || mCompletedSerial == mSubmittedSerial) {
+                mCondition.wait(lock, [this] { return HasWorkLocked(); });
+                continue;
+            }
+
+            // Block until the next serial completes or until there is new work. Enqueue
+            // signals the wake semaphore past the value waited on here, even if it happens
+            // between unlocking and starting to wait.
+            ExecutionSerial nextSerial(static_cast<uint64_t>(mCompletedSerial) + 1);
+            uint64_t wakeValue = mWakeValue + 1;
+            uint64_t timeout =
+                mWakeSemaphore != VK_NULL_HANDLE ? kSemaphoreWaitTimeout : kFenceWaitTimeout;
+            lock.unlock();
+            ResultOrError<ExecutionSerial> completedSerial =
+                mDevice->WaitForCompletedSerial(nextSerial, mWakeSemaphore, wakeValue, timeout);
+            lock.lock();
+
+            if (completedSerial.IsError()) {
+                SetErrorLocked(completedSerial.AcquireError());
+                continue;
+            }
+            mCompletedSerial = std::max(mCompletedSerial, completedSerial.AcquireSuccess());
+        }
+    }
+
+    bool SubmissionThread::HasWorkLocked() const {
+        return !mPendingSubmits.empty() || mStopping;
+    }
+
+    void SubmissionThread::WakeLocked() {
+        if (mWakeSemaphore == VK_NULL_HANDLE) {
+            return;
+        }
+
+        mWakeValue++;
+
+        VkSemaphoreSignalInfoKHR signalInfo;
+        signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO_KHR;
+        signalInfo.pNext = nullptr;
+        signalInfo.semaphore = mWakeSemaphore;
+        signalInfo.value = mWakeValue;
+
+        // Ignore errors: they can only be a lost device or OOM, which the next wait of the thread
+        // reports, and the wait times out in any case.
+        VkResult result =
+            VkResult::WrapUnsafe(mDevice->fn.SignalSemaphore(mDevice->GetVkDevice(), &signalInfo));
+        DAWN_UNUSED(result);
+    }
+
+    void SubmissionThread::SetErrorLocked(std::unique_ptr<ErrorData> error) {
+        if (!mFailed) {
+            mFailed = true;
+            mError = std::move(error);
+        }
+    }
+
+    MaybeError SubmissionThread::AcquireErrorLocked() {
+        if (mError != nullptr) {
+            return std::move(mError);
+        }
+        return {};
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,102 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_SUBMISSIONTHREAD_H_
+#define DAWNNATIVE_VULKAN_SUBMISSIONTHREAD_H_
+
+#include "common/vulkan_platform.h"
+#include "dawn_native/Error.h"
+#include "dawn_native/IntegerTypes.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    class Device;
+
+    // The parts of a CommandRecordingContext needed to submit it once it is recorded.
+    struct PendingSubmit {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        std::vector<VkSemaphore> waitSemaphores;
+        std::vector<VkSemaphore> signalSemaphores;
+        // The serial that completes when the commands are finished.
+        ExecutionSerial serial = ExecutionSerial(0);
+    };
+
+    // A thread that calls vkQueueSubmit for the recorded commands of the device, and waits for
+    // their completion, so that neither blocks the thread calling the API. Used when
+    // Toggle::VulkanUseSubmissionThread is enabled.
+    //
+    // With timeline semaphores the thread blocks until either the next serial completes or a
+    // "wake" timeline semaphore, signaled from the host by Enqueue and the destructor, reaches its
+    // next value. Otherwise it waits on the oldest fence in flight with a short timeout so that
+    // newly enqueued commands are submitted promptly.
+    class SubmissionThread {
+      public:
+        static ResultOrError<std::unique_ptr<SubmissionThread>> Create(Device* device);
+        // Submits the enqueued commands, then stops the thread.
+        ~SubmissionThread();
+
+        // Queues |submit| to be submitted after the previously enqueued ones.
+        void Enqueue(PendingSubmit submit);
+
+        // Waits for the enqueued commands to be submitted, so that the VkQueue and the semaphores
+        // signaled by the commands can be used on the calling thread. Returns the error that
+        // happened on the thread, if any.
+        MaybeError Flush();
+
+        // Returns the last completed serial seen by the thread, or the error that happened on it.
+        ResultOrError<ExecutionSerial> GetCompletedSerial();
+
+      private:
+        explicit SubmissionThread(Device* device);
+        MaybeError Initialize();
+
+        void ThreadMain();
+        bool HasWorkLocked() const;
+        // Makes the thread stop waiting for completed commands and look at its state again.
+        void WakeLocked();
+        void SetErrorLocked(std::unique_ptr<ErrorData> error);
+        MaybeError AcquireErrorLocked();
+
+        Device* mDevice;
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<PendingSubmit> mPendingSubmits;
+        bool mSubmitting = false;
+        bool mStopping = false;
+
+        ExecutionSerial mSubmittedSerial = ExecutionSerial(0);
+        ExecutionSerial mCompletedSerial = ExecutionSerial(0);
+
+        // VK_NULL_HANDLE when timeline semaphores aren't used.
+        VkSemaphore mWakeSemaphore = VK_NULL_HANDLE;
+        uint64_t mWakeValue = 0;
+
+        // The thread stops calling Vulkan after the first error. The error is returned once.
+        bool mFailed = false;
+        std::unique_ptr<ErrorData> mError;
+
+        std::thread mThread;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_SUBMISSIONTHREAD_H_
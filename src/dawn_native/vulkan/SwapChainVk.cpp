@@ -527,6 +527,7 @@ namespace dawn_native { namespace vulkan {
         mTexture->APIDestroy();
         mTexture = nullptr;
 
+        DAWN_TRY(device->FlushSubmissions());
         VkResult result =
             VkResult::WrapUnsafe(device->fn.QueuePresentKHR(device->GetQueue(), &presentInfo));
 
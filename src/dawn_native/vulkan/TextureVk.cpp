@@ -1262,7 +1262,8 @@ namespace dawn_native { namespace vulkan {
     // static
     ResultOrError<Ref<TextureView>> TextureView::Create(TextureBase* texture,
                                                         const TextureViewDescriptor* descriptor) {
-        Ref<TextureView> view = AcquireRef(new TextureView(texture, descriptor));
+        Ref<TextureView> view =
+            AcquireRef(new (texture->GetDevice()) TextureView(texture, descriptor));
         DAWN_TRY(view->Initialize(descriptor));
         return view;
     }
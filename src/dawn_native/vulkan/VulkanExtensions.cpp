@@ -144,10 +144,13 @@ namespace dawn_native { namespace vulkan {
         {DeviceExt::ExternalSemaphore, "VK_KHR_external_semaphore", VulkanVersion_1_1},
         {DeviceExt::_16BitStorage, "VK_KHR_16bit_storage", VulkanVersion_1_1},
         {DeviceExt::SamplerYCbCrConversion, "VK_KHR_sampler_ycbcr_conversion", VulkanVersion_1_1},
+        {DeviceExt::DescriptorUpdateTemplate, "VK_KHR_descriptor_update_template",
+         VulkanVersion_1_1},
 
         {DeviceExt::DriverProperties, "VK_KHR_driver_properties", VulkanVersion_1_2},
         {DeviceExt::ImageFormatList, "VK_KHR_image_format_list", VulkanVersion_1_2},
         {DeviceExt::ShaderFloat16Int8, "VK_KHR_shader_float16_int8", VulkanVersion_1_2},
+        {DeviceExt::TimelineSemaphore, "VK_KHR_timeline_semaphore", VulkanVersion_1_2},
 
         {DeviceExt::ExternalMemoryFD, "VK_KHR_external_memory_fd", NeverPromoted},
         {DeviceExt::ExternalMemoryDmaBuf, "VK_EXT_external_memory_dma_buf", NeverPromoted},
@@ -200,6 +203,7 @@ namespace dawn_native { namespace vulkan {
                 case DeviceExt::Maintenance1:
                 case DeviceExt::ImageFormatList:
                 case DeviceExt::StorageBufferStorageClass:
+                case DeviceExt::DescriptorUpdateTemplate:
                     hasDependencies = true;
                     break;
 
@@ -239,6 +243,7 @@ namespace dawn_native { namespace vulkan {
 
                 case DeviceExt::DriverProperties:
                 case DeviceExt::ShaderFloat16Int8:
+                case DeviceExt::TimelineSemaphore:
                     hasDependencies = HasDep(DeviceExt::GetPhysicalDeviceProperties2);
                     break;
 
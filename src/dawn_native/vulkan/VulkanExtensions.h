@@ -83,11 +83,13 @@ namespace dawn_native { namespace vulkan {
         ExternalSemaphore,
         _16BitStorage,
         SamplerYCbCrConversion,
+        DescriptorUpdateTemplate,
 
         // Promoted to 1.2
         DriverProperties,
         ImageFormatList,
         ShaderFloat16Int8,
+        TimelineSemaphore,
 
         // External* extensions
         ExternalMemoryFD,
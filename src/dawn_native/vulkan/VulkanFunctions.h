@@ -267,6 +267,22 @@ namespace dawn_native { namespace vulkan {
         PFN_vkUpdateDescriptorSets UpdateDescriptorSets = nullptr;
         PFN_vkWaitForFences WaitForFences = nullptr;
 
+        // Core Vulkan 1.1 promoted device extensions, set if either the core version or the
+        // extension is present.
+
+        // VK_KHR_descriptor_update_template
+        PFN_vkCreateDescriptorUpdateTemplate CreateDescriptorUpdateTemplate = nullptr;
+        PFN_vkDestroyDescriptorUpdateTemplate DestroyDescriptorUpdateTemplate = nullptr;
+        PFN_vkUpdateDescriptorSetWithTemplate UpdateDescriptorSetWithTemplate = nullptr;
+
+        // Core Vulkan 1.2 promoted extensions, set if either the core version or the extension is
+        // present.
+
+        // VK_KHR_timeline_semaphore
+        PFN_vkGetSemaphoreCounterValue GetSemaphoreCounterValue = nullptr;
+        PFN_vkSignalSemaphore SignalSemaphore = nullptr;
+        PFN_vkWaitSemaphores WaitSemaphores = nullptr;
+
         // VK_KHR_swapchain
         PFN_vkCreateSwapchainKHR CreateSwapchainKHR = nullptr;
         PFN_vkDestroySwapchainKHR DestroySwapchainKHR = nullptr;
@@ -14,26 +14,70 @@
 
 #include "dawn_platform/DawnPlatform.h"
 #include "dawn_platform/WorkerThread.h"
+#include "dawn_platform/tracing/TraceRecorder.h"
 
 #include "common/Assert.h"
+#include "common/Log.h"
+#include "common/SystemUtils.h"
+
+#include <atomic>
 
 namespace dawn_platform {
 
+    namespace {
+
+        // Each Platform writes its own trace so that processes creating several of them, like
+        // the tests, don't overwrite the traces of the previous ones. The first Platform uses
+        // DAWN_TRACE_FILE as is and the following ones insert their index before the extension,
+        // e.g. trace.json, trace.1.json, trace.2.json...
+        std::atomic<uint32_t> sNextTraceFileIndex(0);
+
+        std::string GetTraceFilePath() {
+            std::string path = GetEnvironmentVar("DAWN_TRACE_FILE");
+            if (path.empty()) {
+                return path;
+            }
+
+            uint32_t index = sNextTraceFileIndex.fetch_add(1, std::memory_order_relaxed);
+            if (index == 0) {
+                return path;
+            }
+
+            size_t separator = path.find_last_of("/\\");
+            size_t extension = path.rfind('.');
+            if (extension == std::string::npos ||
+                (separator != std::string::npos && extension < separator)) {
+                extension = path.size();
+            }
+            return path.insert(extension, "." + std::to_string(index));
+        }
+
+    }  // anonymous namespace
+
     CachingInterface::CachingInterface() = default;
 
     CachingInterface::~CachingInterface() = default;
 
-    Platform::Platform() = default;
+    Platform::Platform()
+        : mTraceRecorder(std::make_unique<tracing::TraceRecorder>()),
+          mTraceFilePath(GetTraceFilePath()) {
+        if (!mTraceFilePath.empty()) {
+            mTraceRecorder->SetEnabled(true);
+        }
+    }
 
-    Platform::~Platform() = default;
+    Platform::~Platform() {
+        if (!mTraceFilePath.empty() && !WriteBuiltinTraceEventsToFile(mTraceFilePath.c_str())) {
+            dawn::WarningLog() << "Failed to write the trace to " << mTraceFilePath;
+        }
+    }
 
     const unsigned char* Platform::GetTraceCategoryEnabledFlag(TraceCategory category) {
-        static unsigned char disabled = 0;
-        return &disabled;
+        return tracing::TraceRecorder::GetCategoryEnabledFlag(category);
     }
 
     double Platform::MonotonicallyIncreasingTime() {
-        return 0;
+        return mTraceRecorder->MonotonicallyIncreasingTime();
     }
 
     uint64_t Platform::AddTraceEvent(char phase,
@@ -46,9 +90,11 @@ namespace dawn_platform {
                                      const unsigned char* argTypes,
                                      const uint64_t* argValues,
                                      unsigned char flags) {
-        // AddTraceEvent cannot be called if events are disabled.
-        ASSERT(false);
-        return 0;
+        // The category flags are shared by all the Platforms using the built-in recorder, so this
+        // can be called while this Platform's recorder is disabled, in which case it drops the
+        // event.
+        return mTraceRecorder->AddTraceEvent(phase, categoryGroupEnabled, name, id, timestamp,
+                                             numArgs, argNames, argTypes, argValues, flags);
     }
 
     dawn_platform::CachingInterface* Platform::GetCachingInterface(const void* fingerprint,
@@ -60,4 +106,26 @@ namespace dawn_platform {
         return std::make_unique<AsyncWorkerThreadPool>();
     }
 
+    void Platform::EnableBuiltinTracing(bool enable) {
+        mTraceRecorder->SetEnabled(enable);
+    }
+
+    bool Platform::IsBuiltinTracingEnabled() const {
+        return mTraceRecorder->IsEnabled();
+    }
+
+    std::string Platform::DumpBuiltinTraceEvents() const {
+        std::string json;
+        mTraceRecorder->DumpAsJSON(&json);
+        return json;
+    }
+
+    bool Platform::WriteBuiltinTraceEventsToFile(const char* path) const {
+        return mTraceRecorder->WriteToFile(path);
+    }
+
+    void Platform::ClearBuiltinTraceEvents() {
+        mTraceRecorder->Clear();
+    }
+
 }  // namespace dawn_platform
@@ -0,0 +1,363 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_platform/tracing/TraceRecorder.h"
+
+#include "common/Assert.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+namespace dawn_platform { namespace tracing {
+
+    namespace {
+
+        static_assert(static_cast<uint32_t>(TraceCategory::General) == 0, "");
+        static_assert(static_cast<uint32_t>(TraceCategory::Validation) == 1, "");
+        static_assert(static_cast<uint32_t>(TraceCategory::Recording) == 2, "");
+        static_assert(static_cast<uint32_t>(TraceCategory::GPUWork) == 3, "");
+
+        constexpr size_t kCategoryCount = 4;
+        constexpr const char* kCategoryNames[kCategoryCount] = {"general", "validation",
+                                                                "recording", "gpu_work"};
+
+        // The category flags returned to the TRACE_EVENT macros, and the number of recorders
+        // that are enabled.
+        unsigned char gCategoryEnabled[kCategoryCount] = {};
+        std::mutex gCategoryEnabledMutex;
+        uint32_t gEnabledRecorderCount = 0;
+
+        // Used to tell apart recorders that were allocated at the same address.
+        std::atomic<uint64_t> gNextRecorderId{1};
+
+        // Small sequential thread IDs are more readable in trace viewers than std::thread::id.
+        std::atomic<uint32_t> gNextThreadId{1};
+
+        uint32_t GetCurrentThreadTraceId() {
+            thread_local uint32_t threadId = gNextThreadId.fetch_add(1, std::memory_order_relaxed);
+            return threadId;
+        }
+
+        void AppendEscapedString(std::string* out, const char* string) {
+            out->push_back('"');
+            for (const char* c = string; *c != '\0'; ++c) {
+                switch (*c) {
+                    case '"':
+                        out->append("\\\"");
+                        break;
+                    case '\\':
+                        out->append("\\\\");
+                        break;
+                    case '\n':
+                        out->append("\\n");
+                        break;
+                    case '\t':
+                        out->append("\\t");
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(*c) < 0x20) {
+                            char escaped[8];
+                            snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                            out->append(escaped);
+                        } else {
+                            out->push_back(*c);
+                        }
+                        break;
+                }
+            }
+            out->push_back('"');
+        }
+
+        void AppendArgValue(std::string* out, unsigned char type, uint64_t value) {
+            char buffer[32];
+            switch (type) {
+                case TRACE_VALUE_TYPE_BOOL:
+                    out->append(value != 0 ? "true" : "false");
+                    return;
+                case TRACE_VALUE_TYPE_UINT:
+                    snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
+                    break;
+                case TRACE_VALUE_TYPE_INT:
+                    snprintf(buffer, sizeof(buffer), "%" PRId64, static_cast<int64_t>(value));
+                    break;
+                case TRACE_VALUE_TYPE_DOUBLE: {
+                    double asDouble;
+                    memcpy(&asDouble, &value, sizeof(double));
+                    snprintf(buffer, sizeof(buffer), "%.17g", asDouble);
+                    break;
+                }
+                case TRACE_VALUE_TYPE_POINTER:
+                    snprintf(buffer, sizeof(buffer), "\"0x%" PRIx64 "\"", value);
+                    break;
+                case TRACE_VALUE_TYPE_STRING:
+                case TRACE_VALUE_TYPE_COPY_STRING: {
+                    const char* string = reinterpret_cast<const char*>(value);
+                    AppendEscapedString(out, string != nullptr ? string : "");
+                    return;
+                }
+                default:
+                    out->append("null");
+                    return;
+            }
+            out->append(buffer);
+        }
+
+    }  // anonymous namespace
+
+    TraceRecorder::TraceRecorder()
+        : mRecorderId(gNextRecorderId.fetch_add(1, std::memory_order_relaxed)),
+          mOrigin(std::chrono::steady_clock::now()) {
+    }
+
+    TraceRecorder::~TraceRecorder() {
+        SetEnabled(false);
+
+        ThreadBuffer* buffer = mThreadBuffers.load(std::memory_order_acquire);
+        while (buffer != nullptr) {
+            Chunk* chunk = buffer->first.load(std::memory_order_acquire);
+            while (chunk != nullptr) {
+                Chunk* next = chunk->next.load(std::memory_order_acquire);
+                delete chunk;
+                chunk = next;
+            }
+
+            ThreadBuffer* nextBuffer = buffer->nextBuffer;
+            delete buffer;
+            buffer = nextBuffer;
+        }
+    }
+
+    void TraceRecorder::SetEnabled(bool enabled) {
+        std::lock_guard<std::mutex> lock(gCategoryEnabledMutex);
+        if (mEnabled.exchange(enabled) == enabled) {
+            return;
+        }
+
+        if (enabled) {
+            gEnabledRecorderCount++;
+        } else {
+            gEnabledRecorderCount--;
+        }
+        for (unsigned char& categoryEnabled : gCategoryEnabled) {
+            categoryEnabled = gEnabledRecorderCount > 0 ? 1 : 0;
+        }
+    }
+
+    bool TraceRecorder::IsEnabled() const {
+        return mEnabled.load(std::memory_order_relaxed);
+    }
+
+    // static
+    const unsigned char* TraceRecorder::GetCategoryEnabledFlag(TraceCategory category) {
+        size_t index = static_cast<size_t>(category);
+        ASSERT(index < kCategoryCount);
+        return &gCategoryEnabled[index];
+    }
+
+    double TraceRecorder::MonotonicallyIncreasingTime() const {
+        // Offset by one second so that the returned time is never 0, which EventTracer treats as
+        // "timing is disabled".
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mOrigin;
+        return elapsed.count() + 1.0;
+    }
+
+    TraceRecorder::ThreadBuffer* TraceRecorder::GetLocalThreadBuffer() {
+        struct LocalBufferCache {
+            uint64_t recorderId = 0;
+            ThreadBuffer* buffer = nullptr;
+        };
+        thread_local LocalBufferCache cache;
+
+        if (cache.recorderId == mRecorderId) {
+            return cache.buffer;
+        }
+
+        // The thread may already have a buffer if it alternates between several recorders. The
+        // list is append-only while the recorder is alive so it can be walked without a lock.
+        std::thread::id thisThread = std::this_thread::get_id();
+        for (ThreadBuffer* buffer = mThreadBuffers.load(std::memory_order_acquire);
+             buffer != nullptr; buffer = buffer->nextBuffer) {
+            if (buffer->owner == thisThread) {
+                cache.recorderId = mRecorderId;
+                cache.buffer = buffer;
+                return buffer;
+            }
+        }
+
+        ThreadBuffer* buffer = new ThreadBuffer();
+        buffer->owner = thisThread;
+        buffer->threadId = GetCurrentThreadTraceId();
+
+        ThreadBuffer* head = mThreadBuffers.load(std::memory_order_relaxed);
+        do {
+            buffer->nextBuffer = head;
+        } while (!mThreadBuffers.compare_exchange_weak(head, buffer, std::memory_order_release,
+                                                       std::memory_order_relaxed));
+
+        cache.recorderId = mRecorderId;
+        cache.buffer = buffer;
+        return buffer;
+    }
+
+    const char* TraceRecorder::InternString(const char* string) {
+        std::lock_guard<std::mutex> lock(mInternedStringsMutex);
+        return mInternedStrings.insert(string).first->c_str();
+    }
+
+    uint64_t TraceRecorder::AddTraceEvent(char phase,
+                                          const unsigned char* categoryGroupEnabled,
+                                          const char* name,
+                                          uint64_t id,
+                                          double timestamp,
+                                          int numArgs,
+                                          const char** argNames,
+                                          const unsigned char* argTypes,
+                                          const uint64_t* argValues,
+                                          unsigned char flags) {
+        ASSERT(numArgs <= kMaxArgs);
+        if (!IsEnabled()) {
+            return 0;
+        }
+
+        // The call site may have cached the category flag of another Platform, in which case
+        // the category is unknown.
+        size_t category = 0;
+        if (categoryGroupEnabled >= &gCategoryEnabled[0] &&
+            categoryGroupEnabled < &gCategoryEnabled[kCategoryCount]) {
+            category = static_cast<size_t>(categoryGroupEnabled - &gCategoryEnabled[0]);
+        }
+
+        ThreadBuffer* buffer = GetLocalThreadBuffer();
+
+        Chunk* chunk = buffer->current;
+        if (chunk == nullptr || chunk->count.load(std::memory_order_relaxed) == kEventsPerChunk) {
+            Chunk* newChunk = new Chunk();
+            if (chunk == nullptr) {
+                buffer->first.store(newChunk, std::memory_order_release);
+            } else {
+                chunk->next.store(newChunk, std::memory_order_release);
+            }
+            buffer->current = newChunk;
+            chunk = newChunk;
+        }
+
+        size_t index = chunk->count.load(std::memory_order_relaxed);
+        Event* event = &chunk->events[index];
+        event->phase = phase;
+        event->category = static_cast<unsigned char>(category);
+        event->flags = flags;
+        event->name = (flags & TRACE_EVENT_FLAG_COPY) ? InternString(name) : name;
+        event->id = id;
+        event->timestamp = timestamp;
+        event->numArgs = static_cast<unsigned char>(numArgs);
+        for (int i = 0; i < numArgs; ++i) {
+            event->argNames[i] = (flags & TRACE_EVENT_FLAG_COPY) ? InternString(argNames[i])
+                                                                 : argNames[i];
+            event->argTypes[i] = argTypes[i];
+            event->argValues[i] = argValues[i];
+            if (argTypes[i] == TRACE_VALUE_TYPE_COPY_STRING) {
+                event->argValues[i] = reinterpret_cast<uint64_t>(
+                    InternString(reinterpret_cast<const char*>(argValues[i])));
+            }
+        }
+
+        // Publish the event to concurrent calls to DumpAsJSON.
+        chunk->count.store(index + 1, std::memory_order_release);
+
+        return (static_cast<uint64_t>(buffer->threadId) << 32) | static_cast<uint64_t>(index);
+    }
+
+    void TraceRecorder::DumpAsJSON(std::string* json) const {
+        json->append("{\"traceEvents\":[");
+
+        bool first = true;
+        char buffer[64];
+        for (const ThreadBuffer* threadBuffer = mThreadBuffers.load(std::memory_order_acquire);
+             threadBuffer != nullptr; threadBuffer = threadBuffer->nextBuffer) {
+            for (const Chunk* chunk = threadBuffer->first.load(std::memory_order_acquire);
+                 chunk != nullptr; chunk = chunk->next.load(std::memory_order_acquire)) {
+                size_t count = chunk->count.load(std::memory_order_acquire);
+                for (size_t i = 0; i < count; ++i) {
+                    const Event& event = chunk->events[i];
+
+                    if (!first) {
+                        json->push_back(',');
+                    }
+                    first = false;
+
+                    json->append("{\"name\":");
+                    AppendEscapedString(json, event.name);
+                    json->append(",\"cat\":\"");
+                    json->append(kCategoryNames[event.category]);
+                    // Timestamps are in microseconds in the Trace Event Format.
+                    snprintf(buffer, sizeof(buffer),
+                             "\",\"ph\":\"%c\",\"pid\":0,\"tid\":%u,\"ts\":%.3f", event.phase,
+                             threadBuffer->threadId, event.timestamp * 1000000.0);
+                    json->append(buffer);
+
+                    if (event.flags & TRACE_EVENT_FLAG_HAS_ID) {
+                        snprintf(buffer, sizeof(buffer), ",\"id\":\"0x%" PRIx64 "\"", event.id);
+                        json->append(buffer);
+                    }
+
+                    if (event.numArgs > 0) {
+                        json->append(",\"args\":{");
+                        for (unsigned char arg = 0; arg < event.numArgs; ++arg) {
+                            if (arg != 0) {
+                                json->push_back(',');
+                            }
+                            AppendEscapedString(json, event.argNames[arg]);
+                            json->push_back(':');
+                            AppendArgValue(json, event.argTypes[arg], event.argValues[arg]);
+                        }
+                        json->push_back('}');
+                    }
+                    json->push_back('}');
+                }
+            }
+        }
+
+        json->append("],\"displayTimeUnit\":\"ms\"}");
+    }
+
+    bool TraceRecorder::WriteToFile(const char* path) const {
+        std::string json;
+        DumpAsJSON(&json);
+
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr) {
+            return false;
+        }
+        bool success = fwrite(json.data(), 1, json.size(), file) == json.size();
+        success = (fclose(file) == 0) && success;
+        return success;
+    }
+
+    void TraceRecorder::Clear() {
+        for (ThreadBuffer* buffer = mThreadBuffers.load(std::memory_order_acquire);
+             buffer != nullptr; buffer = buffer->nextBuffer) {
+            Chunk* chunk = buffer->first.exchange(nullptr, std::memory_order_acq_rel);
+            while (chunk != nullptr) {
+                Chunk* next = chunk->next.load(std::memory_order_acquire);
+                delete chunk;
+                chunk = next;
+            }
+            buffer->current = nullptr;
+        }
+    }
+
+}}  // namespace dawn_platform::tracing
@@ -0,0 +1,133 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNPLATFORM_TRACING_TRACERECORDER_H_
+#define DAWNPLATFORM_TRACING_TRACERECORDER_H_
+
+#include "common/NonCopyable.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+namespace dawn_platform {
+
+    enum class TraceCategory;
+
+    namespace tracing {
+
+        // TraceRecorder is the built-in backend for the TRACE_EVENT* macros that is used by the
+        // default dawn_platform::Platform. It is designed to be cheap enough to stay compiled in:
+        //  - When disabled, the category flags are zero and the macros never call into it. The
+        //    flags are process-wide because the TRACE_EVENT macros cache their address in a
+        //    static at each call site, so they are enabled while any recorder is enabled and
+        //    recorders that are disabled drop the events they receive.
+        //  - When enabled, each thread appends to its own chunked event buffer. Appending never
+        //    takes a lock: the owning thread is the only writer of its buffer, and a new chunk is
+        //    published with a release store so that a concurrent dump sees complete events.
+        //  - Per-thread buffers are registered in an intrusive list with a CAS on its head.
+        // Timestamps come from std::chrono::steady_clock which is monotonic.
+        //
+        // The recorded events can be dumped using the Chrome "Trace Event Format" JSON, which can
+        // be loaded in chrome://tracing or https://ui.perfetto.dev. TRACE_EVENT scopes produce
+        // matching 'B'/'E' events which the viewers display as a per-thread hierarchy.
+        class TraceRecorder : NonCopyable {
+          public:
+            TraceRecorder();
+            ~TraceRecorder();
+
+            void SetEnabled(bool enabled);
+            bool IsEnabled() const;
+
+            static const unsigned char* GetCategoryEnabledFlag(TraceCategory category);
+
+            // Returns the number of seconds since an arbitrary point in the past.
+            double MonotonicallyIncreasingTime() const;
+
+            uint64_t AddTraceEvent(char phase,
+                                   const unsigned char* categoryGroupEnabled,
+                                   const char* name,
+                                   uint64_t id,
+                                   double timestamp,
+                                   int numArgs,
+                                   const char** argNames,
+                                   const unsigned char* argTypes,
+                                   const uint64_t* argValues,
+                                   unsigned char flags);
+
+            // Appends all the events recorded so far to |json| as a Chrome trace JSON object.
+            // Recording can continue concurrently, but only the events that were fully recorded
+            // when a thread's chunk was read are included.
+            void DumpAsJSON(std::string* json) const;
+            bool WriteToFile(const char* path) const;
+
+            // Drops all the recorded events. Must only be called while no thread is recording.
+            void Clear();
+
+            static constexpr int kMaxArgs = 2;
+            static constexpr size_t kEventsPerChunk = 1024;
+
+          private:
+            struct Event {
+                double timestamp;
+                uint64_t id;
+                const char* name;
+                const char* argNames[kMaxArgs];
+                uint64_t argValues[kMaxArgs];
+                unsigned char argTypes[kMaxArgs];
+                unsigned char numArgs;
+                unsigned char category;
+                unsigned char flags;
+                char phase;
+            };
+
+            struct Chunk {
+                Event events[kEventsPerChunk];
+                // Number of events of |events| that are fully written. Only the owning thread
+                // writes it.
+                std::atomic<size_t> count{0};
+                std::atomic<Chunk*> next{nullptr};
+            };
+
+            struct ThreadBuffer {
+                std::thread::id owner;
+                uint32_t threadId;
+                std::atomic<Chunk*> first{nullptr};
+                // Only accessed by the owning thread.
+                Chunk* current = nullptr;
+                ThreadBuffer* nextBuffer = nullptr;
+            };
+
+            ThreadBuffer* GetLocalThreadBuffer();
+            const char* InternString(const char* string);
+
+            std::atomic<bool> mEnabled{false};
+            const uint64_t mRecorderId;
+            const std::chrono::steady_clock::time_point mOrigin;
+            std::atomic<ThreadBuffer*> mThreadBuffers{nullptr};
+
+            // Storage for the names of events recorded with TRACE_EVENT_FLAG_COPY. This is a rare
+            // path so it is guarded by a mutex.
+            std::mutex mInternedStringsMutex;
+            std::unordered_set<std::string> mInternedStrings;
+        };
+
+    }  // namespace tracing
+}  // namespace dawn_platform
+
+#endif  // DAWNPLATFORM_TRACING_TRACERECORDER_H_
@@ -0,0 +1,95 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/BatchedCommandSerializer.h"
+
+#include "common/Assert.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dawn_wire {
+
+    BatchedCommandSerializer::BatchedCommandSerializer(CommandSerializer* serializer)
+        : mSerializer(serializer) {
+        ASSERT(mSerializer != nullptr);
+    }
+
+    BatchedCommandSerializer::~BatchedCommandSerializer() = default;
+
+    void* BatchedCommandSerializer::GetCmdSpace(size_t size) {
+        ASSERT(size <= GetMaximumAllocationSize());
+        // The returned pointer is only used until the next call, so it is fine for the storage
+        // to be reallocated by the next resize.
+        size_t offset = mCommands.size();
+        mCommands.resize(offset + size);
+        mAllocationSizes.push_back(size);
+        return mCommands.data() + offset;
+    }
+
+    bool BatchedCommandSerializer::Flush() {
+        if (mAllocationSizes.empty()) {
+            return true;
+        }
+
+        size_t maxAllocationSize = GetMaximumAllocationSize();
+        const char* commands = mCommands.data();
+        bool success = true;
+
+        // Write runs of consecutive allocations that fit in a single allocation of the
+        // serializer.
+        for (size_t i = 0; i < mAllocationSizes.size();) {
+            size_t runSize = mAllocationSizes[i++];
+            while (i < mAllocationSizes.size() &&
+                   mAllocationSizes[i] <= maxAllocationSize - runSize) {
+                runSize += mAllocationSizes[i++];
+            }
+
+            void* dst = mSerializer->GetCmdSpace(runSize);
+            if (dst == nullptr) {
+                success = false;
+                break;
+            }
+            memcpy(dst, commands, runSize);
+            commands += runSize;
+        }
+
+        uint64_t batchBytes = mCommands.size();
+        mBatchesFlushed.fetch_add(1, std::memory_order_relaxed);
+        if (batchBytes > mLargestBatchBytes.load(std::memory_order_relaxed)) {
+            mLargestBatchBytes.store(batchBytes, std::memory_order_relaxed);
+        }
+
+        // Keep the capacity of the storage for the next batch.
+        mCommands.clear();
+        mAllocationSizes.clear();
+
+        return success && mSerializer->Flush();
+    }
+
+    size_t BatchedCommandSerializer::GetMaximumAllocationSize() const {
+        return mSerializer->GetMaximumAllocationSize();
+    }
+
+    void BatchedCommandSerializer::OnSerializeError() {
+        mSerializer->OnSerializeError();
+    }
+
+    void BatchedCommandSerializer::AddStatistics(WireStatistics* statistics) const {
+        statistics->batchesFlushed += mBatchesFlushed.load(std::memory_order_relaxed);
+        statistics->largestBatchBytes = std::max(
+            statistics->largestBatchBytes, mLargestBatchBytes.load(std::memory_order_relaxed));
+    }
+
+}  // namespace dawn_wire
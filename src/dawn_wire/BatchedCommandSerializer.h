@@ -0,0 +1,56 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_BATCHEDCOMMANDSERIALIZER_H_
+#define DAWNWIRE_BATCHEDCOMMANDSERIALIZER_H_
+
+#include "dawn_wire/Wire.h"
+
+#include <atomic>
+#include <vector>
+
+namespace dawn_wire {
+
+    // A CommandSerializer that buffers the commands serialized into it, and only writes them to
+    // the wrapped serializer on Flush, followed by a single Flush of the wrapped serializer. The
+    // commands are packed into as few allocations as possible, but a single allocation is never
+    // split so that chunked commands stay the same.
+    class BatchedCommandSerializer final : public CommandSerializer {
+      public:
+        explicit BatchedCommandSerializer(CommandSerializer* serializer);
+        ~BatchedCommandSerializer() override;
+
+        void* GetCmdSpace(size_t size) override;
+        // Does nothing and returns true if no command was serialized since the last Flush.
+        bool Flush() override;
+        size_t GetMaximumAllocationSize() const override;
+        void OnSerializeError() override;
+
+        // Adds the statistics of the batches flushed to |statistics|.
+        void AddStatistics(WireStatistics* statistics) const;
+
+      private:
+        CommandSerializer* mSerializer;
+
+        std::vector<char> mCommands;
+        // The sizes of the allocations returned by GetCmdSpace, in order.
+        std::vector<size_t> mAllocationSizes;
+
+        std::atomic<uint64_t> mBatchesFlushed{0};
+        std::atomic<uint64_t> mLargestBatchBytes{0};
+    };
+
+}  // namespace dawn_wire
+
+#endif  // DAWNWIRE_BATCHEDCOMMANDSERIALIZER_H_
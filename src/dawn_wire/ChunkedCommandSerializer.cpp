@@ -20,6 +20,18 @@ namespace dawn_wire {
         : mSerializer(serializer), mMaxAllocationSize(serializer->GetMaximumAllocationSize()) {
     }
 
+    void ChunkedCommandSerializer::SetSerializer(CommandSerializer* serializer) {
+        mSerializer = serializer;
+        mMaxAllocationSize = serializer->GetMaximumAllocationSize();
+    }
+
+    WireStatistics ChunkedCommandSerializer::GetStatistics() const {
+        WireStatistics statistics;
+        statistics.commandsSerialized = mCommandsSerialized.load(std::memory_order_relaxed);
+        statistics.bytesSerialized = mBytesSerialized.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
     void ChunkedCommandSerializer::SerializeChunkedCommand(const char* allocatedBuffer,
                                                            size_t remainingSize) {
         while (remainingSize > 0) {
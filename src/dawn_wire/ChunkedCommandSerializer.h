@@ -21,6 +21,7 @@
 #include "dawn_wire/WireCmd_autogen.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <memory>
 
@@ -30,6 +31,13 @@ namespace dawn_wire {
       public:
         ChunkedCommandSerializer(CommandSerializer* serializer);
 
+        // Makes the following commands be written to |serializer|.
+        void SetSerializer(CommandSerializer* serializer);
+
+        // The statistics are updated with relaxed atomics so that they can be read from another
+        // thread than the one serializing commands.
+        WireStatistics GetStatistics() const;
+
         template <typename Cmd>
         void SerializeCommand(const Cmd& cmd) {
             SerializeCommand(cmd, 0, [](SerializeBuffer*) { return WireResult::Success; });
@@ -84,7 +92,9 @@ namespace dawn_wire {
                     WireResult r2 = SerializeExtraSize(&serializeBuffer);
                     if (DAWN_UNLIKELY(r1 != WireResult::Success || r2 != WireResult::Success)) {
                         mSerializer->OnSerializeError();
+                        return;
                     }
+                    RecordSerializedCommand(requiredSize);
                 }
                 return;
             }
@@ -101,12 +111,21 @@ namespace dawn_wire {
                 return;
             }
             SerializeChunkedCommand(cmdSpace.get(), requiredSize);
+            RecordSerializedCommand(requiredSize);
         }
 
         void SerializeChunkedCommand(const char* allocatedBuffer, size_t remainingSize);
 
+        void RecordSerializedCommand(size_t size) {
+            mCommandsSerialized.fetch_add(1, std::memory_order_relaxed);
+            mBytesSerialized.fetch_add(size, std::memory_order_relaxed);
+        }
+
         CommandSerializer* mSerializer;
         size_t mMaxAllocationSize;
+
+        std::atomic<uint64_t> mCommandsSerialized{0};
+        std::atomic<uint64_t> mBytesSerialized{0};
     };
 
 }  // namespace dawn_wire
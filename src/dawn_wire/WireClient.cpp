@@ -14,6 +14,7 @@
 
 #include "dawn_wire/WireClient.h"
 #include "dawn_wire/client/Client.h"
+#include "dawn_wire/client/Device.h"
 
 namespace dawn_wire {
 
@@ -57,6 +58,16 @@ namespace dawn_wire {
         mImpl->Disconnect();
     }
 
+    WireStatistics WireClient::GetStatistics() const {
+        return mImpl->GetStatistics();
+    }
+
+    void WireClient::GetDeviceStatistics(WGPUDevice device,
+                                         DeviceStatisticsCallback callback,
+                                         void* userdata) {
+        client::FromAPI(device)->GetStatistics(callback, userdata);
+    }
+
     namespace client {
         MemoryTransferService::MemoryTransferService() = default;
 
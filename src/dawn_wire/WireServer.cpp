@@ -20,7 +20,10 @@ namespace dawn_wire {
     WireServer::WireServer(const WireServerDescriptor& descriptor)
         : mImpl(new server::Server(*descriptor.procs,
                                    descriptor.serializer,
-                                   descriptor.memoryTransferService)) {
+                                   descriptor.memoryTransferService,
+                                   descriptor.batchReturnCommands,
+                                   descriptor.partitionCommandsByDevice,
+                                   descriptor.getDeviceStatistics)) {
     }
 
     WireServer::~WireServer() {
@@ -28,7 +31,10 @@ namespace dawn_wire {
     }
 
     const volatile char* WireServer::HandleCommands(const volatile char* commands, size_t size) {
-        return mImpl->HandleCommands(commands, size);
+        const volatile char* result = mImpl->HandleCommands(commands, size);
+        // Send the return commands produced by this batch of commands at once.
+        mImpl->FlushReturnCommands();
+        return result;
     }
 
     bool WireServer::InjectTexture(WGPUTexture texture,
@@ -55,6 +61,14 @@ namespace dawn_wire {
         return mImpl->GetDevice(id, generation);
     }
 
+    bool WireServer::FlushReturnCommands() {
+        return mImpl->FlushReturnCommands();
+    }
+
+    WireStatistics WireServer::GetStatistics() const {
+        return mImpl->GetStatistics();
+    }
+
     namespace server {
         MemoryTransferService::MemoryTransferService() = default;
 
@@ -19,6 +19,8 @@
 #include "dawn_wire/client/Client.h"
 #include "dawn_wire/client/Device.h"
 
+#include <algorithm>
+
 namespace dawn_wire { namespace client {
 
     // static
@@ -33,42 +35,24 @@ namespace dawn_wire { namespace client {
             return device->CreateErrorBuffer();
         }
 
-        std::unique_ptr<MemoryTransferService::ReadHandle> readHandle = nullptr;
         std::unique_ptr<MemoryTransferService::WriteHandle> writeHandle = nullptr;
 
         DeviceCreateBufferCmd cmd;
         cmd.deviceId = device->id;
         cmd.descriptor = descriptor;
-        cmd.readHandleCreateInfoLength = 0;
-        cmd.readHandleCreateInfo = nullptr;
         cmd.writeHandleCreateInfoLength = 0;
         cmd.writeHandleCreateInfo = nullptr;
 
-        if (mappable) {
-            if ((descriptor->usage & WGPUBufferUsage_MapRead) != 0) {
-                // Create the read handle on buffer creation.
-                readHandle.reset(
-                    wireClient->GetMemoryTransferService()->CreateReadHandle(descriptor->size));
-                if (readHandle == nullptr) {
-                    device->InjectError(WGPUErrorType_OutOfMemory,
-                                        "Failed to create buffer mapping");
-                    return device->CreateErrorBuffer();
-                }
-                cmd.readHandleCreateInfoLength = readHandle->SerializeCreateSize();
-            }
-
-            if ((descriptor->usage & WGPUBufferUsage_MapWrite) != 0 ||
-                descriptor->mappedAtCreation) {
-                // Create the write handle on buffer creation.
-                writeHandle.reset(
-                    wireClient->GetMemoryTransferService()->CreateWriteHandle(descriptor->size));
-                if (writeHandle == nullptr) {
-                    device->InjectError(WGPUErrorType_OutOfMemory,
-                                        "Failed to create buffer mapping");
-                    return device->CreateErrorBuffer();
-                }
-                cmd.writeHandleCreateInfoLength = writeHandle->SerializeCreateSize();
+        // Staging memory for MapRead and MapWrite is only created by MapAsync, sized to the
+        // mapped range. Only mappedAtCreation needs a handle now, covering the whole buffer.
+        if (descriptor->mappedAtCreation) {
+            writeHandle.reset(
+                wireClient->GetMemoryTransferService()->CreateWriteHandle(descriptor->size));
+            if (writeHandle == nullptr) {
+                device->InjectError(WGPUErrorType_OutOfMemory, "Failed to create buffer mapping");
+                return device->CreateErrorBuffer();
             }
+            cmd.writeHandleCreateInfoLength = writeHandle->SerializeCreateSize();
         }
 
         // Create the buffer and send the creation command.
@@ -79,19 +63,10 @@ namespace dawn_wire { namespace client {
         buffer->mDevice = device;
         buffer->mDeviceIsAlive = device->GetAliveWeakPtr();
         buffer->mSize = descriptor->size;
-        buffer->mDestructWriteHandleOnUnmap = false;
 
         if (descriptor->mappedAtCreation) {
-            // If the buffer is mapped at creation, a write handle is created and will be
-            // destructed on unmap if the buffer doesn't have MapWrite usage
-            // The buffer is mapped right now.
+            // The buffer is mapped right now. The write handle is destroyed on unmap.
             buffer->mMapState = MapState::MappedAtCreation;
-
-            // This flag is for write handle created by mappedAtCreation
-            // instead of MapWrite usage. We don't have such a case for read handle
-            buffer->mDestructWriteHandleOnUnmap =
-                (descriptor->usage & WGPUBufferUsage_MapWrite) == 0;
-
             buffer->mMapOffset = 0;
             buffer->mMapSize = buffer->mSize;
             ASSERT(writeHandle != nullptr);
@@ -101,16 +76,7 @@ namespace dawn_wire { namespace client {
         cmd.result = ObjectHandle{buffer->id, bufferObjectAndSerial->generation};
 
         wireClient->SerializeCommand(
-            cmd, cmd.readHandleCreateInfoLength + cmd.writeHandleCreateInfoLength,
-            [&](SerializeBuffer* serializeBuffer) {
-                if (readHandle != nullptr) {
-                    char* readHandleBuffer;
-                    WIRE_TRY(
-                        serializeBuffer->NextN(cmd.readHandleCreateInfoLength, &readHandleBuffer));
-                    // Serialize the ReadHandle into the space after the command.
-                    readHandle->SerializeCreate(readHandleBuffer);
-                    buffer->mReadHandle = std::move(readHandle);
-                }
+            cmd, cmd.writeHandleCreateInfoLength, [&](SerializeBuffer* serializeBuffer) {
                 if (writeHandle != nullptr) {
                     char* writeHandleBuffer;
                     WIRE_TRY(serializeBuffer->NextN(cmd.writeHandleCreateInfoLength,
@@ -177,23 +143,61 @@ namespace dawn_wire { namespace client {
         request.userdata = userdata;
         request.offset = offset;
         request.size = size;
+
+        // Create the staging handle for the mapped range only. Out-of-bounds ranges are
+        // rejected by the server, so clamp the allocation to the buffer instead of letting the
+        // application make the client allocate an arbitrary amount of memory.
+        size_t handleSize = 0;
+        if (offset < mSize) {
+            handleSize = std::min(size, static_cast<size_t>(mSize - offset));
+        }
+        MemoryTransferService* memoryTransferService = client->GetMemoryTransferService();
+        size_t handleCreateInfoLength = 0;
         if (mode & WGPUMapMode_Read) {
             request.type = MapRequestType::Read;
+            request.readHandle.reset(memoryTransferService->CreateReadHandle(handleSize));
+            if (request.readHandle == nullptr) {
+                mDevice->InjectError(WGPUErrorType_OutOfMemory, "Failed to create buffer mapping");
+                return callback(WGPUBufferMapAsyncStatus_Error, userdata);
+            }
+            handleCreateInfoLength = request.readHandle->SerializeCreateSize();
         } else if (mode & WGPUMapMode_Write) {
             request.type = MapRequestType::Write;
+            request.writeHandle.reset(memoryTransferService->CreateWriteHandle(handleSize));
+            if (request.writeHandle == nullptr) {
+                mDevice->InjectError(WGPUErrorType_OutOfMemory, "Failed to create buffer mapping");
+                return callback(WGPUBufferMapAsyncStatus_Error, userdata);
+            }
+            handleCreateInfoLength = request.writeHandle->SerializeCreateSize();
         }
 
-        uint64_t serial = mRequests.Add(std::move(request));
-
         // Serialize the command to send to the server.
         BufferMapAsyncCmd cmd;
         cmd.bufferId = this->id;
-        cmd.requestSerial = serial;
         cmd.mode = mode;
         cmd.offset = offset;
         cmd.size = size;
-
-        client->SerializeCommand(cmd);
+        cmd.handleCreateInfoLength = handleCreateInfoLength;
+        cmd.handleCreateInfo = nullptr;
+
+        // Keep a pointer to the handles since the request is moved into the tracker before
+        // serialization, which needs the serial.
+        MemoryTransferService::ReadHandle* readHandle = request.readHandle.get();
+        MemoryTransferService::WriteHandle* writeHandle = request.writeHandle.get();
+        cmd.requestSerial = mRequests.Add(std::move(request));
+
+        client->SerializeCommand(
+            cmd, handleCreateInfoLength, [&](SerializeBuffer* serializeBuffer) {
+                char* handleBuffer;
+                WIRE_TRY(serializeBuffer->NextN(handleCreateInfoLength, &handleBuffer));
+                // Serialize the handle into the space after the command.
+                if (readHandle != nullptr) {
+                    readHandle->SerializeCreate(handleBuffer);
+                } else if (writeHandle != nullptr) {
+                    writeHandle->SerializeCreate(handleBuffer);
+                }
+                return WireResult::Success;
+            });
     }
 
     bool Buffer::OnMapAsyncCallback(uint64_t requestSerial,
@@ -226,25 +230,23 @@ namespace dawn_wire { namespace client {
                         return FailRequest();
                     }
 
-                    // Validate to prevent bad map request; buffer destroyed during map request
-                    if (mReadHandle == nullptr) {
-                        return FailRequest();
-                    }
-                    // Update user map data with server returned data
-                    if (!mReadHandle->DeserializeDataUpdate(
-                            readDataUpdateInfo, static_cast<size_t>(readDataUpdateInfoLength),
-                            request.offset, request.size)) {
+                    // Update user map data with server returned data. The handle only covers the
+                    // mapped range so the data starts at its beginning.
+                    ASSERT(request.readHandle != nullptr);
+                    if (!request.readHandle->DeserializeDataUpdate(
+                            readDataUpdateInfo, static_cast<size_t>(readDataUpdateInfoLength), 0,
+                            request.size)) {
                         return FailRequest();
                     }
                     mMapState = MapState::MappedForRead;
+                    mReadHandle = std::move(request.readHandle);
                     mMappedData = const_cast<void*>(mReadHandle->GetData());
                     break;
                 }
                 case MapRequestType::Write: {
-                    if (mWriteHandle == nullptr) {
-                        return FailRequest();
-                    }
+                    ASSERT(request.writeHandle != nullptr);
                     mMapState = MapState::MappedForWrite;
+                    mWriteHandle = std::move(request.writeHandle);
                     mMappedData = mWriteHandle->GetData();
                     break;
                 }
@@ -267,7 +269,8 @@ namespace dawn_wire { namespace client {
         if (!IsMappedForWriting() || !CheckGetMappedRangeOffsetSize(offset, size)) {
             return nullptr;
         }
-        return static_cast<uint8_t*>(mMappedData) + offset;
+        AddWrittenRange(offset - mMapOffset, size);
+        return static_cast<uint8_t*>(mMappedData) + (offset - mMapOffset);
     }
 
     const void* Buffer::GetConstMappedRange(size_t offset, size_t size) {
@@ -275,7 +278,7 @@ namespace dawn_wire { namespace client {
             !CheckGetMappedRangeOffsetSize(offset, size)) {
             return nullptr;
         }
-        return static_cast<uint8_t*>(mMappedData) + offset;
+        return static_cast<uint8_t*>(mMappedData) + (offset - mMapOffset);
     }
 
     void Buffer::Unmap() {
@@ -293,48 +296,13 @@ namespace dawn_wire { namespace client {
             mWriteHandle != nullptr) {
             // Writes need to be flushed before Unmap is sent. Unmap calls all associated
             // in-flight callbacks which may read the updated data.
-
-            // Get the serialization size of data update writes.
-            size_t writeDataUpdateInfoLength =
-                mWriteHandle->SizeOfSerializeDataUpdate(mMapOffset, mMapSize);
-
-            BufferUpdateMappedDataCmd cmd;
-            cmd.bufferId = id;
-            cmd.writeDataUpdateInfoLength = writeDataUpdateInfoLength;
-            cmd.writeDataUpdateInfo = nullptr;
-            cmd.offset = mMapOffset;
-            cmd.size = mMapSize;
-
-            client->SerializeCommand(
-                cmd, writeDataUpdateInfoLength, [&](SerializeBuffer* serializeBuffer) {
-                    char* writeHandleBuffer;
-                    WIRE_TRY(serializeBuffer->NextN(writeDataUpdateInfoLength, &writeHandleBuffer));
-
-                    // Serialize flush metadata into the space after the command.
-                    // This closes the handle for writing.
-                    mWriteHandle->SerializeDataUpdate(writeHandleBuffer, cmd.offset, cmd.size);
-
-                    return WireResult::Success;
-                });
-
-            // If mDestructWriteHandleOnUnmap is true, that means the write handle is merely
-            // for mappedAtCreation usage. It is destroyed on unmap after flush to server
-            // instead of at buffer destruction.
-            if (mMapState == MapState::MappedAtCreation && mDestructWriteHandleOnUnmap) {
-                mWriteHandle = nullptr;
-                if (mReadHandle) {
-                    // If it's both mappedAtCreation and MapRead we need to reset
-                    // mMappedData to readHandle's GetData(). This could be changed to
-                    // merging read/write handle in future
-                    mMappedData = const_cast<void*>(mReadHandle->GetData());
-                }
-            }
+            SerializeWrittenRanges();
         }
 
-        // Free map access tokens
+        // Free map access tokens and the staging data of the mapping, which is recreated by the
+        // next MapAsync.
         mMapState = MapState::Unmapped;
-        mMapOffset = 0;
-        mMapSize = 0;
+        FreeMappedData();
 
         // Tag all mapping requests still in flight as unmapped before callback.
         mRequests.ForAll([](MapRequestData* request) {
@@ -385,18 +353,71 @@ namespace dawn_wire { namespace client {
         return offsetInMappedRange <= mMapSize - size;
     }
 
+    void Buffer::AddWrittenRange(size_t offset, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        size_t end = offset + size;
+
+        // Find the first range that ends at or after |offset|, then merge it and all the
+        // following ranges that start before |end| into the new range.
+        auto first = std::lower_bound(mWrittenRanges.begin(), mWrittenRanges.end(), offset,
+                                      [](const WrittenRange& range, size_t value) {
+                                          return range.offset + range.size < value;
+                                      });
+        auto last = first;
+        for (; last != mWrittenRanges.end() && last->offset <= end; ++last) {
+            offset = std::min(offset, last->offset);
+            end = std::max(end, last->offset + last->size);
+        }
+
+        auto position = mWrittenRanges.erase(first, last);
+        mWrittenRanges.insert(position, {offset, end - offset});
+    }
+
+    void Buffer::SerializeWrittenRanges() {
+        ASSERT(mWriteHandle != nullptr);
+
+        // Send one data update per range the application could have written to, in increasing
+        // offset order. Nothing is sent if GetMappedRange was never called.
+        for (const WrittenRange& range : mWrittenRanges) {
+            // Get the serialization size of data update writes.
+            size_t writeDataUpdateInfoLength =
+                mWriteHandle->SizeOfSerializeDataUpdate(range.offset, range.size);
+
+            BufferUpdateMappedDataCmd cmd;
+            cmd.bufferId = id;
+            cmd.writeDataUpdateInfoLength = writeDataUpdateInfoLength;
+            cmd.writeDataUpdateInfo = nullptr;
+            cmd.offset = range.offset;
+            cmd.size = range.size;
+
+            client->SerializeCommand(
+                cmd, writeDataUpdateInfoLength, [&](SerializeBuffer* serializeBuffer) {
+                    char* writeHandleBuffer;
+                    WIRE_TRY(serializeBuffer->NextN(writeDataUpdateInfoLength, &writeHandleBuffer));
+
+                    // Serialize flush metadata into the space after the command.
+                    mWriteHandle->SerializeDataUpdate(writeHandleBuffer, cmd.offset, cmd.size);
+
+                    return WireResult::Success;
+                });
+        }
+    }
+
     void Buffer::FreeMappedData() {
 #if defined(DAWN_ENABLE_ASSERTS)
         // When in "debug" mode, 0xCA-out the mapped data when we free it so that in we can detect
         // use-after-free of the mapped data. This is particularly useful for WebGPU test about the
         // interaction of mapping and GC.
         if (mMappedData) {
-            memset(static_cast<uint8_t*>(mMappedData) + mMapOffset, 0xCA, mMapSize);
+            memset(mMappedData, 0xCA, mMapSize);
         }
 #endif  // defined(DAWN_ENABLE_ASSERTS)
 
         mMapOffset = 0;
         mMapSize = 0;
+        mWrittenRanges.clear();
         mReadHandle = nullptr;
         mWriteHandle = nullptr;
         mMappedData = nullptr;
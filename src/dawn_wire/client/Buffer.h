@@ -21,6 +21,8 @@
 #include "dawn_wire/client/ObjectBase.h"
 #include "dawn_wire/client/RequestTracker.h"
 
+#include <vector>
+
 namespace dawn_wire { namespace client {
 
     class Device;
@@ -56,6 +58,8 @@ namespace dawn_wire { namespace client {
         bool IsMappedForReading() const;
         bool IsMappedForWriting() const;
         bool CheckGetMappedRangeOffsetSize(size_t offset, size_t size) const;
+        void AddWrittenRange(size_t offset, size_t size);
+        void SerializeWrittenRanges();
 
         void FreeMappedData();
 
@@ -85,22 +89,38 @@ namespace dawn_wire { namespace client {
             WGPUBufferMapAsyncStatus clientStatus = WGPUBufferMapAsyncStatus_Success;
 
             MapRequestType type = MapRequestType::None;
+
+            // The staging handle for this mapping, sized to its range. It becomes the handle of
+            // the buffer if the request succeeds.
+            std::unique_ptr<MemoryTransferService::ReadHandle> readHandle = nullptr;
+            std::unique_ptr<MemoryTransferService::WriteHandle> writeHandle = nullptr;
         };
         RequestTracker<MapRequestData> mRequests;
         uint64_t mSize = 0;
 
         // Only one mapped pointer can be active at a time because Unmap clears all the in-flight
-        // requests.
+        // requests. The handles only hold the staging data of the current mapping and are
+        // destroyed on Unmap, so that client memory is proportional to what is mapped instead of
+        // to the size of the buffer.
         // TODO(enga): Use a tagged pointer to save space.
         std::unique_ptr<MemoryTransferService::ReadHandle> mReadHandle = nullptr;
         std::unique_ptr<MemoryTransferService::WriteHandle> mWriteHandle = nullptr;
         MapState mMapState = MapState::Unmapped;
-        bool mDestructWriteHandleOnUnmap = false;
 
+        // The staging data of the handle, which starts at mMapOffset in the buffer.
         void* mMappedData = nullptr;
         size_t mMapOffset = 0;
         size_t mMapSize = 0;
 
+        // The ranges returned by GetMappedRange while the buffer is mapped for writing, sorted
+        // and merged when they touch. Only these can have been written by the application so
+        // they are the only data sent to the server on Unmap.
+        struct WrittenRange {
+            size_t offset;
+            size_t size;
+        };
+        std::vector<WrittenRange> mWrittenRanges;
+
         std::weak_ptr<bool> mDeviceIsAlive;
     };
 
@@ -132,7 +132,7 @@ namespace dawn_wire { namespace client {
 
     void Client::Disconnect() {
         mDisconnected = true;
-        mSerializer = ChunkedCommandSerializer(NoopCommandSerializer::GetInstance());
+        mSerializer.SetSerializer(NoopCommandSerializer::GetInstance());
 
         auto& deviceList = mObjects[ObjectType::Device];
         {
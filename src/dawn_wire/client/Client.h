@@ -67,6 +67,10 @@ namespace dawn_wire { namespace client {
         void Disconnect();
         bool IsDisconnected() const;
 
+        WireStatistics GetStatistics() const {
+            return mSerializer.GetStatistics();
+        }
+
         template <typename T>
         void TrackObject(T* object) {
             mObjects[ObjectTypeToTypeEnum<T>::value].Append(object);
@@ -74,6 +74,21 @@ namespace dawn_wire { namespace client {
         return device->OnPopErrorScopeCallback(requestSerial, errorType, message);
     }
 
+    bool Client::DoDeviceGetStatisticsCallback(Device* device,
+                                               uint64_t requestSerial,
+                                               bool available,
+                                               uint64_t counterCount,
+                                               const uint64_t* counterValues,
+                                               uint64_t counterNamesSize,
+                                               const char* counterNames) {
+        if (device == nullptr) {
+            // The device might have been deleted or recreated so this isn't an error.
+            return true;
+        }
+        return device->OnGetStatisticsCallback(requestSerial, available, counterCount,
+                                               counterValues, counterNamesSize, counterNames);
+    }
+
     bool Client::DoBufferMapAsyncCallback(Buffer* buffer,
                                           uint64_t requestSerial,
                                           uint32_t status,
@@ -20,6 +20,8 @@
 #include "dawn_wire/client/Client.h"
 #include "dawn_wire/client/ObjectAllocator.h"
 
+#include <algorithm>
+
 namespace dawn_wire { namespace client {
 
     Device::Device(Client* clientIn, uint32_t initialRefcount, uint32_t initialId)
@@ -53,6 +55,9 @@ namespace dawn_wire { namespace client {
                               request->userdata);
         });
 
+        mStatisticsRequests.CloseAll(
+            [](StatisticsRequest* request) { request->callback(nullptr, request->userdata); });
+
         mCreatePipelineAsyncRequests.CloseAll([](CreatePipelineAsyncRequest* request) {
             if (request->createComputePipelineAsyncCallback != nullptr) {
                 request->createComputePipelineAsyncCallback(
@@ -92,6 +97,9 @@ namespace dawn_wire { namespace client {
             request->callback(WGPUErrorType_DeviceLost, "Device lost", request->userdata);
         });
 
+        mStatisticsRequests.CloseAll(
+            [](StatisticsRequest* request) { request->callback(nullptr, request->userdata); });
+
         mCreatePipelineAsyncRequests.CloseAll([](CreatePipelineAsyncRequest* request) {
             if (request->createComputePipelineAsyncCallback != nullptr) {
                 request->createComputePipelineAsyncCallback(
@@ -180,6 +188,52 @@ namespace dawn_wire { namespace client {
         return true;
     }
 
+    void Device::GetStatistics(DeviceStatisticsCallback callback, void* userdata) {
+        if (client->IsDisconnected()) {
+            callback(nullptr, userdata);
+            return;
+        }
+
+        uint64_t serial = mStatisticsRequests.Add({callback, userdata});
+
+        DeviceGetStatisticsCmd cmd;
+        cmd.deviceId = this->id;
+        cmd.requestSerial = serial;
+
+        client->SerializeCommand(cmd);
+    }
+
+    bool Device::OnGetStatisticsCallback(uint64_t requestSerial,
+                                         bool available,
+                                         uint64_t counterCount,
+                                         const uint64_t* counterValues,
+                                         uint64_t counterNamesSize,
+                                         const char* counterNames) {
+        // The names are sent as consecutive null-terminated strings, one per counter.
+        DeviceStatisticsCounters counters;
+        const char* name = counterNames;
+        const char* namesEnd = counterNames + counterNamesSize;
+        for (uint64_t i = 0; i < counterCount; ++i) {
+            const char* nameEnd = std::find(name, namesEnd, '\0');
+            if (nameEnd == namesEnd) {
+                return false;
+            }
+            counters.emplace_back(std::string(name, nameEnd), counterValues[i]);
+            name = nameEnd + 1;
+        }
+        if (name != namesEnd || (!available && counterCount != 0)) {
+            return false;
+        }
+
+        StatisticsRequest request;
+        if (!mStatisticsRequests.Acquire(requestSerial, &request)) {
+            return false;
+        }
+
+        request.callback(available ? &counters : nullptr, request.userdata);
+        return true;
+    }
+
     void Device::InjectError(WGPUErrorType type, const char* message) {
         DeviceInjectErrorCmd cmd;
         cmd.self = ToAPI(this);
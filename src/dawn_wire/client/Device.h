@@ -18,6 +18,7 @@
 #include <dawn/webgpu.h>
 
 #include "common/LinkedList.h"
+#include "dawn_wire/WireClient.h"
 #include "dawn_wire/WireCmd_autogen.h"
 #include "dawn_wire/client/ApiObjects_autogen.h"
 #include "dawn_wire/client/ObjectBase.h"
@@ -41,6 +42,7 @@ namespace dawn_wire { namespace client {
         void InjectError(WGPUErrorType type, const char* message);
         void PushErrorScope(WGPUErrorFilter filter);
         bool PopErrorScope(WGPUErrorCallback callback, void* userdata);
+        void GetStatistics(DeviceStatisticsCallback callback, void* userdata);
         WGPUBuffer CreateBuffer(const WGPUBufferDescriptor* descriptor);
         WGPUBuffer CreateErrorBuffer();
         WGPUComputePipeline CreateComputePipeline(WGPUComputePipelineDescriptor const* descriptor);
@@ -57,6 +59,12 @@ namespace dawn_wire { namespace client {
         bool OnPopErrorScopeCallback(uint64_t requestSerial,
                                      WGPUErrorType type,
                                      const char* message);
+        bool OnGetStatisticsCallback(uint64_t requestSerial,
+                                     bool available,
+                                     uint64_t counterCount,
+                                     const uint64_t* counterValues,
+                                     uint64_t counterNamesSize,
+                                     const char* counterNames);
         bool OnCreateComputePipelineAsyncCallback(uint64_t requestSerial,
                                                   WGPUCreatePipelineAsyncStatus status,
                                                   const char* message);
@@ -79,6 +87,12 @@ namespace dawn_wire { namespace client {
         RequestTracker<ErrorScopeData> mErrorScopes;
         uint64_t mErrorScopeStackSize = 0;
 
+        struct StatisticsRequest {
+            DeviceStatisticsCallback callback = nullptr;
+            void* userdata = nullptr;
+        };
+        RequestTracker<StatisticsRequest> mStatisticsRequests;
+
         struct CreatePipelineAsyncRequest {
             WGPUCreateComputePipelineAsyncCallback createComputePipelineAsyncCallback = nullptr;
             WGPUCreateRenderPipelineAsyncCallback createRenderPipelineAsyncCallback = nullptr;
@@ -17,8 +17,10 @@
 
 #include <dawn/webgpu.h>
 
+#include "common/DispatchableObject.h"
 #include "common/LinkedList.h"
 #include "dawn_wire/ObjectType_autogen.h"
+#include "dawn_wire/WireClient.h"
 
 namespace dawn_wire { namespace client {
 
@@ -29,9 +31,11 @@ namespace dawn_wire { namespace client {
     //  - The external reference count
     //  - An ID that is used to refer to this object when talking with the server side
     //  - A next/prev pointer. They are part of a linked list of objects of the same type.
-    struct ObjectBase : public LinkNode<ObjectBase> {
+    //  - The client proc table, at the same offset as for dawn_native objects, so that
+    //    dawnObjectDispatchProcTable can route calls on the handle.
+    struct ObjectBase : public DispatchableObject, public LinkNode<ObjectBase> {
         ObjectBase(Client* client, uint32_t refcount, uint32_t id)
-            : client(client), refcount(refcount), id(id) {
+            : DispatchableObject(&GetProcs()), client(client), refcount(refcount), id(id) {
         }
 
         ~ObjectBase() {
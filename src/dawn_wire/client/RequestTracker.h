@@ -19,33 +19,51 @@
 #include "common/NonCopyable.h"
 
 #include <cstdint>
-#include <map>
+#include <deque>
 
 namespace dawn_wire { namespace client {
 
     class Device;
     class MemoryTransferService;
 
+    // Tracks the in-flight requests of an object, indexed by the serial returned by Add. Serials
+    // are allocated in increasing order and requests usually complete in the same order, so
+    // they are stored in a deque indexed by the serial minus the serial of the oldest request
+    // still stored. Add and Acquire are O(1) and don't allocate a node per request. Completed
+    // requests leave a hole until all the requests before them have completed as well.
     template <typename Request>
     class RequestTracker : NonCopyable {
       public:
         ~RequestTracker() {
-            ASSERT(mRequests.empty());
+            ASSERT(mPendingCount == 0);
         }
 
         uint64_t Add(Request&& request) {
             mSerial++;
-            mRequests.emplace(mSerial, request);
+            ASSERT(mSerial == mBaseSerial + mRequests.size());
+            mRequests.push_back({true, std::move(request)});
+            mPendingCount++;
             return mSerial;
         }
 
         bool Acquire(uint64_t serial, Request* request) {
-            auto it = mRequests.find(serial);
-            if (it == mRequests.end()) {
+            // Serials that were never returned, or that were already acquired and removed from
+            // the front, are ignored. Unsigned wrap-around handles serials below the base.
+            uint64_t index = serial - mBaseSerial;
+            if (index >= mRequests.size() || !mRequests[index].pending) {
                 return false;
             }
-            *request = std::move(it->second);
-            mRequests.erase(it);
+
+            Entry& entry = mRequests[index];
+            *request = std::move(entry.request);
+            entry.pending = false;
+            mPendingCount--;
+
+            // Drop the completed requests at the front.
+            while (!mRequests.empty() && !mRequests.front().pending) {
+                mRequests.pop_front();
+                mBaseSerial++;
+            }
             return true;
         }
 
@@ -55,26 +73,42 @@ namespace dawn_wire { namespace client {
             // requests may add some additional requests. We guarantee all callbacks for requests
             // are called exactly onces, so keep closing new requests if the first batch added more.
             // It is fine to loop infinitely here if that's what the application makes use do.
-            while (!mRequests.empty()) {
+            while (mPendingCount != 0) {
                 // Move mRequests to a local variable so that further reentrant modifications of
-                // mRequests don't invalidate the iterators.
+                // mRequests don't invalidate the iterators. New requests start after the ones
+                // being closed.
                 auto allRequests = std::move(mRequests);
-                for (auto& it : allRequests) {
-                    closeFunc(&it.second);
+                mRequests.clear();
+                mBaseSerial = mSerial + 1;
+                mPendingCount = 0;
+                for (Entry& entry : allRequests) {
+                    if (entry.pending) {
+                        closeFunc(&entry.request);
+                    }
                 }
             }
         }
 
         template <typename F>
         void ForAll(F&& f) {
-            for (auto& it : mRequests) {
-                f(&it.second);
+            for (Entry& entry : mRequests) {
+                if (entry.pending) {
+                    f(&entry.request);
+                }
             }
         }
 
       private:
-        uint64_t mSerial;
-        std::map<uint64_t, Request> mRequests;
+        struct Entry {
+            bool pending;
+            Request request;
+        };
+
+        uint64_t mSerial = 0;
+        // The serial of mRequests.front().
+        uint64_t mBaseSerial = 1;
+        size_t mPendingCount = 0;
+        std::deque<Entry> mRequests;
     };
 
 }}  // namespace dawn_wire::client
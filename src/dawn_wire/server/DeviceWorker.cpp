@@ -0,0 +1,77 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/server/DeviceWorker.h"
+
+#include "common/Assert.h"
+#include "dawn_wire/server/Server.h"
+
+namespace dawn_wire { namespace server {
+
+    DeviceWorker::DeviceWorker(Server* server, const DeviceInfo* device)
+        : mServer(server), mDevice(device), mThread(&DeviceWorker::ThreadMain, this) {
+    }
+
+    DeviceWorker::~DeviceWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ASSERT(!mHasCommands);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        mThread.join();
+    }
+
+    void DeviceWorker::Start(std::vector<CommandRange>* commands) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ASSERT(!mHasCommands && mCommands.empty());
+            // Swap the vectors so that their storage is reused by the next commands.
+            mCommands.swap(*commands);
+            mHasCommands = true;
+        }
+        mCondition.notify_all();
+    }
+
+    bool DeviceWorker::Wait() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this] { return !mHasCommands; });
+
+        bool success = mSuccess;
+        mSuccess = true;
+        return success;
+    }
+
+    void DeviceWorker::ThreadMain() {
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (true) {
+            mCondition.wait(lock, [this] { return mHasCommands || mStopping; });
+            if (mStopping) {
+                return;
+            }
+
+            // The commands aren't modified until they are handled, so they can be used without
+            // holding the lock.
+            lock.unlock();
+            bool success = mServer->HandleCommandRanges(mDevice, mCommands, &mAllocator);
+            lock.lock();
+
+            mCommands.clear();
+            mSuccess = success;
+            mHasCommands = false;
+            mCondition.notify_all();
+        }
+    }
+
+}}  // namespace dawn_wire::server
@@ -0,0 +1,70 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_SERVER_DEVICEWORKER_H_
+#define DAWNWIRE_SERVER_DEVICEWORKER_H_
+
+#include "dawn_wire/WireDeserializeAllocator.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dawn_wire { namespace server {
+
+    class Server;
+    struct DeviceInfo;
+
+    // A single command in the buffer passed to HandleCommands.
+    struct CommandRange {
+        const volatile char* data;
+        size_t size;
+    };
+
+    // A thread handling the commands of one device when the server partitions its commands by
+    // device.
+    class DeviceWorker {
+      public:
+        DeviceWorker(Server* server, const DeviceInfo* device);
+        ~DeviceWorker();
+
+        // Starts handling |commands| in order on the thread. |commands| is left empty. The
+        // commands must stay valid until Wait returns.
+        void Start(std::vector<CommandRange>* commands);
+
+        // Waits for the commands given to Start to be handled. Returns false if one of them
+        // failed, in which case the following ones weren't handled.
+        bool Wait();
+
+      private:
+        void ThreadMain();
+
+        Server* mServer;
+        const DeviceInfo* mDevice;
+        WireDeserializeAllocator mAllocator;
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::vector<CommandRange> mCommands;
+        bool mHasCommands = false;
+        bool mSuccess = true;
+        bool mStopping = false;
+
+        std::thread mThread;
+    };
+
+}}  // namespace dawn_wire::server
+
+#endif  // DAWNWIRE_SERVER_DEVICEWORKER_H_
@@ -19,7 +19,9 @@
 #include "dawn_wire/WireServer.h"
 
 #include <algorithm>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <unordered_set>
 
 namespace dawn_wire { namespace server {
@@ -30,6 +32,11 @@ namespace dawn_wire { namespace server {
         ObjectHandle self;
     };
 
+    // Returns false if the current thread handles the commands of another device than |device|
+    // when the commands are partitioned by device. This keeps the worker of a device from using
+    // objects that the worker of another device could destroy at the same time.
+    bool IsDeviceAccessible(const DeviceInfo* device);
+
     // Whether this object has been allocated, or reserved for async object creation.
     // Used by the KnownObjects queries
     enum class AllocationState : uint32_t {
@@ -58,13 +65,9 @@ namespace dawn_wire { namespace server {
 
     template <>
     struct ObjectData<WGPUBuffer> : public ObjectDataBase<WGPUBuffer> {
-        // TODO(enga): Use a tagged pointer to save space.
-        std::unique_ptr<MemoryTransferService::ReadHandle> readHandle;
+        // The WriteHandle of the current mapping, destroyed on unmap.
         std::unique_ptr<MemoryTransferService::WriteHandle> writeHandle;
         BufferMapWriteState mapWriteState = BufferMapWriteState::Unmapped;
-        WGPUBufferUsageFlags usage = WGPUBufferUsage_None;
-        // Indicate if writeHandle needs to be destroyed on unmap
-        bool mappedAtCreation = false;
     };
 
     // Pack the ObjectType and ObjectId as a single value for storage in
@@ -108,6 +111,7 @@ namespace dawn_wire { namespace server {
         // Get a backend objects for a given client ID.
         // Returns nullptr if the ID hasn't previously been allocated.
         const Data* Get(uint32_t id, AllocationState expected = AllocationState::Allocated) const {
+            auto lock = Lock();
             if (id >= mKnown.size()) {
                 return nullptr;
             }
@@ -117,10 +121,14 @@ namespace dawn_wire { namespace server {
             if (data->state != expected) {
                 return nullptr;
             }
+            if (mThreadSafe && !IsDeviceAccessible(data->deviceInfo)) {
+                return nullptr;
+            }
 
             return data;
         }
         Data* Get(uint32_t id, AllocationState expected = AllocationState::Allocated) {
+            auto lock = Lock();
             if (id >= mKnown.size()) {
                 return nullptr;
             }
@@ -130,14 +138,18 @@ namespace dawn_wire { namespace server {
             if (data->state != expected) {
                 return nullptr;
             }
+            if (mThreadSafe && !IsDeviceAccessible(data->deviceInfo)) {
+                return nullptr;
+            }
 
             return data;
         }
 
         // Allocates the data for a given ID and returns it.
         // Returns nullptr if the ID is already allocated, or too far ahead, or if ID is 0 (ID 0 is
-        // reserved for nullptr). Invalidates all the Data*
+        // reserved for nullptr). The Data* of the other IDs stay valid.
         Data* Allocate(uint32_t id, AllocationState state = AllocationState::Allocated) {
+            auto lock = Lock();
             if (id == 0 || id > mKnown.size()) {
                 return nullptr;
             }
@@ -159,8 +171,26 @@ namespace dawn_wire { namespace server {
             return &mKnown[id];
         }
 
+        // Adds a free entry for |id| if it is the next ID after the known ones. Returns false if
+        // |id| is too far ahead. This lets IDs be allocated out of order once they are known.
+        bool Extend(uint32_t id) {
+            auto lock = Lock();
+            if (id == 0 || id > mKnown.size()) {
+                return false;
+            }
+
+            if (id == mKnown.size()) {
+                Data data;
+                data.state = AllocationState::Free;
+                data.handle = nullptr;
+                mKnown.push_back(std::move(data));
+            }
+            return true;
+        }
+
         // Marks an ID as deallocated
         void Free(uint32_t id) {
+            auto lock = Lock();
             ASSERT(id < mKnown.size());
             mKnown[id].state = AllocationState::Free;
         }
@@ -189,8 +219,25 @@ namespace dawn_wire { namespace server {
             return objects;
         }
 
+        // Makes Get, Allocate, Extend and Free safe to call from several threads at once, as long
+        // as each ID is only used by one thread at a time.
+        void SetThreadSafe(bool threadSafe) {
+            mThreadSafe = threadSafe;
+        }
+
       private:
-        std::vector<Data> mKnown;
+        std::unique_lock<std::mutex> Lock() const {
+            if (!mThreadSafe) {
+                return {};
+            }
+            return std::unique_lock<std::mutex>(mMutex);
+        }
+
+        // A deque so that allocating an ID doesn't move the data of the others.
+        std::deque<Data> mKnown;
+
+        bool mThreadSafe = false;
+        mutable std::mutex mMutex;
     };
 
     // ObjectIds are lost in deserialization. Store the ids of deserialized
@@ -17,18 +17,35 @@
 
 namespace dawn_wire { namespace server {
 
+    namespace {
+
+        // The device whose commands are being handled by this thread, when the commands are
+        // partitioned by device.
+        thread_local const DeviceInfo* tlPartitionDevice = nullptr;
+
+    }  // anonymous namespace
+
     Server::Server(const DawnProcTable& procs,
                    CommandSerializer* serializer,
-                   MemoryTransferService* memoryTransferService)
-        : mSerializer(serializer),
+                   MemoryTransferService* memoryTransferService,
+                   bool batchReturnCommands,
+                   bool partitionCommandsByDevice,
+                   DeviceStatisticsCounters (*getDeviceStatistics)(WGPUDevice device))
+        : mBatchedSerializer(batchReturnCommands
+                                 ? std::make_unique<BatchedCommandSerializer>(serializer)
+                                 : nullptr),
+          mSerializer(mBatchedSerializer != nullptr ? mBatchedSerializer.get() : serializer),
           mProcs(procs),
           mMemoryTransferService(memoryTransferService),
-          mIsAlive(std::make_shared<bool>(true)) {
+          mIsAlive(std::make_shared<bool>(true)),
+          mGetDeviceStatistics(getDeviceStatistics),
+          mPartitionCommandsByDevice(partitionCommandsByDevice) {
         if (mMemoryTransferService == nullptr) {
             // If a MemoryTransferService is not provided, fallback to inline memory.
             mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
             mMemoryTransferService = mOwnedMemoryTransferService.get();
         }
+        SetObjectsThreadSafe(mPartitionCommandsByDevice);
     }
 
     Server::~Server() {
@@ -40,6 +57,24 @@ namespace dawn_wire { namespace server {
         DestroyAllObjects(mProcs);
     }
 
+    bool Server::FlushReturnCommands() {
+        if (mBatchedSerializer == nullptr) {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(mSerializerMutex);
+        SerializePendingUncapturedError();
+        return mBatchedSerializer->Flush();
+    }
+
+    WireStatistics Server::GetStatistics() const {
+        WireStatistics statistics = mSerializer.GetStatistics();
+        if (mBatchedSerializer != nullptr) {
+            mBatchedSerializer->AddStatistics(&statistics);
+        }
+        statistics.errorsMerged = mErrorsMerged.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
     bool Server::InjectTexture(WGPUTexture texture,
                                uint32_t id,
                                uint32_t generation,
@@ -64,6 +99,9 @@ namespace dawn_wire { namespace server {
         if (!TrackDeviceChild(data->deviceInfo, ObjectType::Texture, id)) {
             return false;
         }
+        if (mPartitionCommandsByDevice) {
+            mObjectDevices[PackObjectTypeAndId(ObjectType::Texture, id)] = data->deviceInfo;
+        }
 
         // The texture is externally owned so it shouldn't be destroyed when we receive a destroy
         // message from the client. Add a reference to counterbalance the eventual release.
@@ -96,6 +134,9 @@ namespace dawn_wire { namespace server {
         if (!TrackDeviceChild(data->deviceInfo, ObjectType::SwapChain, id)) {
             return false;
         }
+        if (mPartitionCommandsByDevice) {
+            mObjectDevices[PackObjectTypeAndId(ObjectType::SwapChain, id)] = data->deviceInfo;
+        }
 
         // The texture is externally owned so it shouldn't be destroyed when we receive a destroy
         // message from the client. Add a reference to counterbalance the eventual release.
@@ -169,6 +210,179 @@ namespace dawn_wire { namespace server {
         mProcs.deviceSetDeviceLostCallback(device, nullptr, nullptr);
     }
 
+    const volatile char* Server::HandlePartitionedCommands(const volatile char* commands,
+                                                           size_t size) {
+        DeserializeBuffer deserializeBuffer(commands, size);
+
+        while (deserializeBuffer.AvailableSize() >= sizeof(CmdHeader) + sizeof(WireCmd)) {
+            switch (HandleChunkedCommands(deserializeBuffer.Buffer(),
+                                          deserializeBuffer.AvailableSize())) {
+                case ChunkedCommandsResult::Consumed:
+                    return HandleDevicePartitions() ? commands + size : nullptr;
+                case ChunkedCommandsResult::Error:
+                    HandleDevicePartitions();
+                    return nullptr;
+                case ChunkedCommandsResult::Passthrough:
+                    break;
+            }
+
+            // HandleChunkedCommands checked that the whole command is in the buffer.
+            size_t commandSize = static_cast<size_t>(
+                reinterpret_cast<const volatile CmdHeader*>(deserializeBuffer.Buffer())
+                    ->commandSize);
+            const volatile char* command;
+            CommandObjects objects;
+            if (deserializeBuffer.ReadN(commandSize, &command) != WireResult::Success ||
+                PeekCommandObjects(command, commandSize, &objects) != WireResult::Success) {
+                HandleDevicePartitions();
+                return nullptr;
+            }
+            WireCmd cmdId =
+                *reinterpret_cast<const volatile WireCmd*>(command + sizeof(CmdHeader));
+
+            DeviceInfo* device = GetCommandDevice(cmdId, objects);
+            if (device != nullptr) {
+                mDevicePartitions[device].commands.push_back({command, commandSize});
+                continue;
+            }
+
+            if (!HandleDevicePartitions()) {
+                return nullptr;
+            }
+
+            // Destroying a device destroys its children, so their partition goes away too.
+            DeviceInfo* destroyedDevice = nullptr;
+            if (cmdId == WireCmd::DestroyObject && objects.targetType == ObjectType::Device) {
+                ObjectData<WGPUDevice>* deviceData = DeviceObjects().Get(objects.targetId);
+                if (deviceData != nullptr) {
+                    destroyedDevice = deviceData->info.get();
+                }
+            }
+
+            DeserializeBuffer commandBuffer(command, commandSize);
+            if (!HandleCommand(&commandBuffer, &mAllocator)) {
+                return nullptr;
+            }
+
+            if (destroyedDevice != nullptr) {
+                RemoveDevicePartition(destroyedDevice);
+            }
+        }
+
+        if (!HandleDevicePartitions() || deserializeBuffer.AvailableSize() != 0) {
+            return nullptr;
+        }
+
+        return commands;
+    }
+
+    DeviceInfo* Server::GetCommandDevice(WireCmd cmdId, const CommandObjects& objects) {
+        uint64_t target = PackObjectTypeAndId(objects.targetType, objects.targetId);
+
+        DeviceInfo* device = nullptr;
+        if (objects.targetType == ObjectType::Device) {
+            // Destroying a device must wait for the commands of its children to be handled.
+            if (cmdId != WireCmd::DestroyObject) {
+                ObjectData<WGPUDevice>* deviceData = DeviceObjects().Get(objects.targetId);
+                if (deviceData != nullptr) {
+                    device = deviceData->info.get();
+                }
+            }
+        } else {
+            auto it = mObjectDevices.find(target);
+            if (it != mObjectDevices.end()) {
+                device = it->second;
+            }
+            if (cmdId == WireCmd::DestroyObject) {
+                mObjectDevices.erase(target);
+            }
+        }
+
+        if (objects.resultId != 0) {
+            // The IDs of the objects must be allocated in order, but the devices allocate them
+            // in parallel, so the entry of the result is added now.
+            uint64_t result = PackObjectTypeAndId(objects.resultType, objects.resultId);
+            if (device != nullptr && ExtendObjects(objects.resultType, objects.resultId)) {
+                mObjectDevices[result] = device;
+            } else {
+                mObjectDevices.erase(result);
+                device = nullptr;
+            }
+        }
+
+        return device;
+    }
+
+    bool Server::HandleDevicePartitions() {
+        std::vector<std::pair<DeviceInfo*, DevicePartition*>> partitions;
+        for (auto& it : mDevicePartitions) {
+            if (!it.second.commands.empty()) {
+                partitions.emplace_back(it.first, &it.second);
+            }
+        }
+
+        if (partitions.empty()) {
+            return true;
+        }
+
+        // Handle the commands of a single device on this thread to skip the handoff.
+        if (partitions.size() == 1) {
+            DevicePartition* partition = partitions[0].second;
+            bool success =
+                HandleCommandRanges(partitions[0].first, partition->commands, &mAllocator);
+            partition->commands.clear();
+            return success;
+        }
+
+        for (auto& it : partitions) {
+            DevicePartition* partition = it.second;
+            if (partition->worker == nullptr) {
+                partition->worker = std::make_unique<DeviceWorker>(this, it.first);
+            }
+            partition->worker->Start(&partition->commands);
+        }
+
+        bool success = true;
+        for (auto& it : partitions) {
+            success = it.second->worker->Wait() && success;
+        }
+        return success;
+    }
+
+    bool Server::HandleCommandRanges(const DeviceInfo* device,
+                                     const std::vector<CommandRange>& commands,
+                                     WireDeserializeAllocator* allocator) {
+        ASSERT(tlPartitionDevice == nullptr);
+        tlPartitionDevice = device;
+
+        bool success = true;
+        for (const CommandRange& command : commands) {
+            DeserializeBuffer deserializeBuffer(command.data, command.size);
+            if (!HandleCommand(&deserializeBuffer, allocator)) {
+                success = false;
+                break;
+            }
+        }
+
+        tlPartitionDevice = nullptr;
+        return success;
+    }
+
+    void Server::RemoveDevicePartition(DeviceInfo* device) {
+        mDevicePartitions.erase(device);
+        for (auto it = mObjectDevices.begin(); it != mObjectDevices.end();) {
+            if (it->second == device) {
+                it = mObjectDevices.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    bool IsDeviceAccessible(const DeviceInfo* device) {
+        return device == nullptr || tlPartitionDevice == nullptr || device == tlPartitionDevice;
+    }
+
     bool TrackDeviceChild(DeviceInfo* info, ObjectType type, ObjectId id) {
         auto it = info->childObjectTypesAndIds.insert(PackObjectTypeAndId(type, id));
         if (!it.second) {
@@ -15,9 +15,18 @@
 #ifndef DAWNWIRE_SERVER_SERVER_H_
 #define DAWNWIRE_SERVER_SERVER_H_
 
+#include "dawn_wire/BatchedCommandSerializer.h"
 #include "dawn_wire/ChunkedCommandSerializer.h"
+#include "dawn_wire/server/DeviceWorker.h"
 #include "dawn_wire/server/ServerBase_autogen.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace dawn_wire { namespace server {
 
     class Server;
@@ -115,6 +124,11 @@ namespace dawn_wire { namespace server {
         uint64_t offset;
         uint64_t size;
         WGPUMapModeFlags mode;
+
+        // The handle created for this mapping. ReadHandles are destroyed once the data is sent
+        // back, WriteHandles are moved to the buffer on success.
+        std::unique_ptr<MemoryTransferService::ReadHandle> readHandle;
+        std::unique_ptr<MemoryTransferService::WriteHandle> writeHandle;
     };
 
     struct ErrorScopeUserdata : CallbackUserdata {
@@ -150,7 +164,10 @@ namespace dawn_wire { namespace server {
       public:
         Server(const DawnProcTable& procs,
                CommandSerializer* serializer,
-               MemoryTransferService* memoryTransferService);
+               MemoryTransferService* memoryTransferService,
+               bool batchReturnCommands,
+               bool partitionCommandsByDevice,
+               DeviceStatisticsCounters (*getDeviceStatistics)(WGPUDevice device));
         ~Server() override;
 
         // ChunkedCommandHandler implementation
@@ -173,6 +190,11 @@ namespace dawn_wire { namespace server {
 
         WGPUDevice GetDevice(uint32_t id, uint32_t generation);
 
+        // Writes the return commands batched since the last call, if they are batched.
+        bool FlushReturnCommands();
+
+        WireStatistics GetStatistics() const;
+
         template <typename T,
                   typename Enable = std::enable_if<std::is_base_of<CallbackUserdata, T>::value>>
         std::unique_ptr<T> MakeUserdata() {
@@ -180,8 +202,14 @@ namespace dawn_wire { namespace server {
         }
 
       private:
+        friend class DeviceWorker;
+
+        // Return commands can be serialized from the device workers, so they are serialized
+        // while holding |mSerializerMutex|.
         template <typename Cmd>
         void SerializeCommand(const Cmd& cmd) {
+            std::lock_guard<std::mutex> lock(mSerializerMutex);
+            SerializePendingUncapturedError();
             mSerializer.SerializeCommand(cmd);
         }
 
@@ -189,9 +217,39 @@ namespace dawn_wire { namespace server {
         void SerializeCommand(const Cmd& cmd,
                               size_t extraSize,
                               ExtraSizeSerializeFn&& SerializeExtraSize) {
+            std::lock_guard<std::mutex> lock(mSerializerMutex);
+            SerializePendingUncapturedError();
             mSerializer.SerializeCommand(cmd, extraSize, SerializeExtraSize);
         }
 
+        // Serializes the uncaptured error waiting to be merged with the next ones, if any. It
+        // must be called before serializing any other return command to keep them in order.
+        // |mSerializerMutex| must be held.
+        void SerializePendingUncapturedError();
+
+        // Handles the command at the start of |deserializeBuffer|.
+        bool HandleCommand(DeserializeBuffer* deserializeBuffer,
+                           WireDeserializeAllocator* allocator);
+
+        // Implementation of HandleCommandsImpl when the commands are partitioned by device. The
+        // commands of each device are gathered, in order, until a command that isn't for a single
+        // device is found. The gathered commands are then handled, each device on its own
+        // worker, and the command is handled once they are all done.
+        const volatile char* HandlePartitionedCommands(const volatile char* commands,
+                                                       size_t size);
+        // Returns the device whose partition the command belongs to, or nullptr if it must be
+        // handled once the commands of all the devices are handled.
+        DeviceInfo* GetCommandDevice(WireCmd cmdId, const CommandObjects& objects);
+        // Handles the commands gathered for the devices and waits for them to be done.
+        bool HandleDevicePartitions();
+        // Handles the commands of |device| in order. Only the objects of |device| can be used
+        // by them, see IsDeviceAccessible.
+        bool HandleCommandRanges(const DeviceInfo* device,
+                                 const std::vector<CommandRange>& commands,
+                                 WireDeserializeAllocator* allocator);
+        // Forgets the partition of |device| and of its children when it is destroyed.
+        void RemoveDevicePartition(DeviceInfo* device);
+
         void ClearDeviceCallbacks(WGPUDevice device);
 
         // Error callbacks
@@ -218,12 +276,43 @@ namespace dawn_wire { namespace server {
 #include "dawn_wire/server/ServerPrototypes_autogen.inc"
 
         WireDeserializeAllocator mAllocator;
+        // Null if return commands are not batched. Otherwise mSerializer writes into it.
+        std::unique_ptr<BatchedCommandSerializer> mBatchedSerializer;
         ChunkedCommandSerializer mSerializer;
+        std::mutex mSerializerMutex;
         DawnProcTable mProcs;
         std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
         MemoryTransferService* mMemoryTransferService = nullptr;
 
         std::shared_ptr<bool> mIsAlive;
+
+        // Null if the statistics of the devices are not provided to the client.
+        DeviceStatisticsCounters (*mGetDeviceStatistics)(WGPUDevice device);
+
+        // When return commands are batched, the last uncaptured error is kept here until a
+        // different return command is serialized, so that the following errors with the same
+        // device and type can be merged into it.
+        struct PendingUncapturedError {
+            ObjectHandle device;
+            WGPUErrorType type;
+            std::string message;
+        };
+        bool mHasPendingUncapturedError = false;
+        PendingUncapturedError mPendingUncapturedError;
+        std::atomic<uint64_t> mErrorsMerged{0};
+
+        // The state used when the commands are partitioned by device.
+        struct DevicePartition {
+            // The commands gathered for the device since the last HandleDevicePartitions.
+            std::vector<CommandRange> commands;
+            // Created the first time the device has commands at the same time as another one.
+            std::unique_ptr<DeviceWorker> worker;
+        };
+        bool mPartitionCommandsByDevice;
+        std::unordered_map<DeviceInfo*, DevicePartition> mDevicePartitions;
+        // The device of the objects created by the commands of a device partition, or injected
+        // on a device. Keyed by PackObjectTypeAndId.
+        std::unordered_map<uint64_t, DeviceInfo*> mObjectDevices;
     };
 
     bool TrackDeviceChild(DeviceInfo* device, ObjectType type, ObjectId id);
@@ -25,13 +25,9 @@ namespace dawn_wire { namespace server {
         auto* buffer = BufferObjects().Get(cmd.selfId);
         DAWN_ASSERT(buffer != nullptr);
 
-        if (buffer->mappedAtCreation && !(buffer->usage & WGPUMapMode_Write)) {
-            // This indicates the writeHandle is for mappedAtCreation only. Destroy on unmap
-            // writeHandle could have possibly been deleted if buffer is already destroyed so we
-            // don't assert it's non-null
-            buffer->writeHandle = nullptr;
-        }
-
+        // WriteHandles are created for a single mapping so it can be destroyed now. It could
+        // have already been deleted if the buffer is destroyed so we don't assert it's non-null.
+        buffer->writeHandle = nullptr;
         buffer->mapWriteState = BufferMapWriteState::Unmapped;
 
         return true;
@@ -42,8 +38,7 @@ namespace dawn_wire { namespace server {
         auto* buffer = BufferObjects().Get(cmd.selfId);
         DAWN_ASSERT(buffer != nullptr);
 
-        // The buffer was destroyed. Clear the Read/WriteHandle.
-        buffer->readHandle = nullptr;
+        // The buffer was destroyed. Clear the WriteHandle.
         buffer->writeHandle = nullptr;
         buffer->mapWriteState = BufferMapWriteState::Unmapped;
 
@@ -54,7 +49,9 @@ namespace dawn_wire { namespace server {
                                   uint64_t requestSerial,
                                   WGPUMapModeFlags mode,
                                   uint64_t offset64,
-                                  uint64_t size64) {
+                                  uint64_t size64,
+                                  uint64_t handleCreateInfoLength,
+                                  const uint8_t* handleCreateInfo) {
         // These requests are just forwarded to the buffer, with userdata containing what the
         // client will require in the return command.
 
@@ -74,6 +71,32 @@ namespace dawn_wire { namespace server {
         userdata->requestSerial = requestSerial;
         userdata->mode = mode;
 
+        // This is the size of data deserialized from the command stream to create the handle,
+        // which must be CPU-addressable.
+        if (handleCreateInfoLength > std::numeric_limits<size_t>::max()) {
+            return false;
+        }
+
+        // Deserialize metadata produced from the client to create a companion server handle for
+        // this mapping. Like on the client it only covers the mapped range.
+        if (mode & WGPUMapMode_Read) {
+            MemoryTransferService::ReadHandle* readHandle = nullptr;
+            if (!mMemoryTransferService->DeserializeReadHandle(
+                    handleCreateInfo, static_cast<size_t>(handleCreateInfoLength), &readHandle)) {
+                return false;
+            }
+            ASSERT(readHandle != nullptr);
+            userdata->readHandle.reset(readHandle);
+        } else if (mode & WGPUMapMode_Write) {
+            MemoryTransferService::WriteHandle* writeHandle = nullptr;
+            if (!mMemoryTransferService->DeserializeWriteHandle(
+                    handleCreateInfo, static_cast<size_t>(handleCreateInfoLength), &writeHandle)) {
+                return false;
+            }
+            ASSERT(writeHandle != nullptr);
+            userdata->writeHandle.reset(writeHandle);
+        }
+
         if (offset64 > std::numeric_limits<size_t>::max() ||
             size64 > std::numeric_limits<size_t>::max()) {
             OnBufferMapAsyncCallback(WGPUBufferMapAsyncStatus_Error, userdata.get());
@@ -85,6 +108,9 @@ namespace dawn_wire { namespace server {
 
         userdata->offset = offset;
         userdata->size = size;
+        if (userdata->writeHandle != nullptr) {
+            userdata->writeHandle->SetDataLength(size);
+        }
 
         mProcs.bufferMapAsync(
             buffer->handle, mode, offset, size,
@@ -98,8 +124,6 @@ namespace dawn_wire { namespace server {
     bool Server::DoDeviceCreateBuffer(ObjectId deviceId,
                                       const WGPUBufferDescriptor* descriptor,
                                       ObjectHandle bufferResult,
-                                      uint64_t readHandleCreateInfoLength,
-                                      const uint8_t* readHandleCreateInfo,
                                       uint64_t writeHandleCreateInfoLength,
                                       const uint8_t* writeHandleCreateInfo) {
         auto* device = DeviceObjects().Get(deviceId);
@@ -115,67 +139,44 @@ namespace dawn_wire { namespace server {
         resultData->generation = bufferResult.generation;
         resultData->handle = mProcs.deviceCreateBuffer(device->handle, descriptor);
         resultData->deviceInfo = device->info.get();
-        resultData->usage = descriptor->usage;
-        resultData->mappedAtCreation = descriptor->mappedAtCreation;
         if (!TrackDeviceChild(resultData->deviceInfo, ObjectType::Buffer, bufferResult.id)) {
             return false;
         }
 
-        // isReadMode and isWriteMode could be true at the same time if usage contains
-        // WGPUMapMode_Read and buffer is mappedAtCreation
-        bool isReadMode = descriptor->usage & WGPUMapMode_Read;
-        bool isWriteMode = descriptor->usage & WGPUMapMode_Write || descriptor->mappedAtCreation;
+        // Only buffers mapped at creation have a WriteHandle, other mappings get their handles
+        // with BufferMapAsync.
+        if (!descriptor->mappedAtCreation) {
+            return true;
+        }
 
-        // This is the size of data deserialized from the command stream to create the read/write
+        // This is the size of data deserialized from the command stream to create the write
         // handle, which must be CPU-addressable.
-        if (readHandleCreateInfoLength > std::numeric_limits<size_t>::max() ||
-            writeHandleCreateInfoLength > std::numeric_limits<size_t>::max() ||
-            readHandleCreateInfoLength >
-                std::numeric_limits<size_t>::max() - writeHandleCreateInfoLength) {
+        if (writeHandleCreateInfoLength > std::numeric_limits<size_t>::max()) {
             return false;
         }
 
-        if (isWriteMode) {
-            MemoryTransferService::WriteHandle* writeHandle = nullptr;
-            // Deserialize metadata produced from the client to create a companion server handle.
-            if (!mMemoryTransferService->DeserializeWriteHandle(
-                    writeHandleCreateInfo, static_cast<size_t>(writeHandleCreateInfoLength),
-                    &writeHandle)) {
-                return false;
-            }
-            ASSERT(writeHandle != nullptr);
-            resultData->writeHandle.reset(writeHandle);
-            writeHandle->SetDataLength(descriptor->size);
-
-            if (descriptor->mappedAtCreation) {
-                void* mapping =
-                    mProcs.bufferGetMappedRange(resultData->handle, 0, descriptor->size);
-                if (mapping == nullptr) {
-                    // A zero mapping is used to indicate an allocation error of an error buffer.
-                    // This is a valid case and isn't fatal. Remember the buffer is an error so as
-                    // to skip subsequent mapping operations.
-                    resultData->mapWriteState = BufferMapWriteState::MapError;
-                    return true;
-                }
-                ASSERT(mapping != nullptr);
-                writeHandle->SetTarget(mapping);
-
-                resultData->mapWriteState = BufferMapWriteState::Mapped;
-            }
+        MemoryTransferService::WriteHandle* writeHandle = nullptr;
+        // Deserialize metadata produced from the client to create a companion server handle.
+        if (!mMemoryTransferService->DeserializeWriteHandle(
+                writeHandleCreateInfo, static_cast<size_t>(writeHandleCreateInfoLength),
+                &writeHandle)) {
+            return false;
         }
-
-        if (isReadMode) {
-            MemoryTransferService::ReadHandle* readHandle = nullptr;
-            // Deserialize metadata produced from the client to create a companion server handle.
-            if (!mMemoryTransferService->DeserializeReadHandle(
-                    readHandleCreateInfo, static_cast<size_t>(readHandleCreateInfoLength),
-                    &readHandle)) {
-                return false;
-            }
-            ASSERT(readHandle != nullptr);
-
-            resultData->readHandle.reset(readHandle);
+        ASSERT(writeHandle != nullptr);
+        resultData->writeHandle.reset(writeHandle);
+        writeHandle->SetDataLength(descriptor->size);
+
+        void* mapping = mProcs.bufferGetMappedRange(resultData->handle, 0, descriptor->size);
+        if (mapping == nullptr) {
+            // A zero mapping is used to indicate an allocation error of an error buffer. This is
+            // a valid case and isn't fatal. Remember the buffer is an error so as to skip
+            // subsequent mapping operations.
+            resultData->mapWriteState = BufferMapWriteState::MapError;
+            return true;
         }
+        writeHandle->SetTarget(mapping);
+
+        resultData->mapWriteState = BufferMapWriteState::Mapped;
 
         return true;
     }
@@ -217,7 +218,8 @@ namespace dawn_wire { namespace server {
         }
 
         // Deserialize the flush info and flush updated data from the handle into the target
-        // of the handle. The target is set via WriteHandle::SetTarget.
+        // of the handle. The target is set via WriteHandle::SetTarget to the start of the mapped
+        // range, and |offset| is relative to it.
         return buffer->writeHandle->DeserializeDataUpdate(
             writeDataUpdateInfo, static_cast<size_t>(writeDataUpdateInfoLength),
             static_cast<size_t>(offset), static_cast<size_t>(size));
@@ -247,21 +249,16 @@ namespace dawn_wire { namespace server {
                 readData =
                     mProcs.bufferGetConstMappedRange(data->bufferObj, data->offset, data->size);
                 cmd.readDataUpdateInfoLength =
-                    bufferData->readHandle->SizeOfSerializeDataUpdate(data->offset, data->size);
+                    data->readHandle->SizeOfSerializeDataUpdate(0, data->size);
             } else {
                 ASSERT(data->mode & WGPUMapMode_Write);
                 // The in-flight map request returned successfully.
                 bufferData->mapWriteState = BufferMapWriteState::Mapped;
-                // Set the target of the WriteHandle to the mapped buffer data.
-                // writeHandle Target always refers to the buffer base address.
-                // but we call getMappedRange exactly with the range of data that is potentially
-                // modified (i.e. we don't want getMappedRange(0, wholeBufferSize) if only a
-                // subset of the buffer is actually mapped) in case the implementation does some
-                // range tracking.
+                // The WriteHandle of the request becomes the handle of the current mapping and
+                // its target is the start of the mapped range.
+                bufferData->writeHandle = std::move(data->writeHandle);
                 bufferData->writeHandle->SetTarget(
-                    static_cast<uint8_t*>(
-                        mProcs.bufferGetMappedRange(data->bufferObj, data->offset, data->size)) -
-                    data->offset);
+                    mProcs.bufferGetMappedRange(data->bufferObj, data->offset, data->size));
             }
         }
 
@@ -269,9 +266,9 @@ namespace dawn_wire { namespace server {
             if (isSuccess && isRead) {
                 char* readHandleBuffer;
                 WIRE_TRY(serializeBuffer->NextN(cmd.readDataUpdateInfoLength, &readHandleBuffer));
-                // The in-flight map request returned successfully.
-                bufferData->readHandle->SerializeDataUpdate(readData, data->offset, data->size,
-                                                            readHandleBuffer);
+                // The in-flight map request returned successfully. The ReadHandle is destroyed
+                // with the request once the data is serialized.
+                data->readHandle->SerializeDataUpdate(readData, 0, data->size, readHandleBuffer);
             }
             return WireResult::Success;
         });
@@ -48,15 +48,55 @@ namespace dawn_wire { namespace server {
             }
         }
 
+        // Merged uncaptured errors are sent once their message reaches this size so that a
+        // flood of errors doesn't produce an arbitrarily large message.
+        constexpr size_t kMaxMergedErrorMessageLength = 4096;
+
     }  // anonymous namespace
 
     void Server::OnUncapturedError(ObjectHandle device, WGPUErrorType type, const char* message) {
+        if (mBatchedSerializer == nullptr) {
+            ReturnDeviceUncapturedErrorCallbackCmd cmd;
+            cmd.device = device;
+            cmd.type = type;
+            cmd.message = message;
+
+            SerializeCommand(cmd);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mSerializerMutex);
+
+        // Merge the error with the previous one if they are for the same device and type.
+        if (mHasPendingUncapturedError && mPendingUncapturedError.device.id == device.id &&
+            mPendingUncapturedError.device.generation == device.generation &&
+            mPendingUncapturedError.type == type &&
+            mPendingUncapturedError.message.size() < kMaxMergedErrorMessageLength) {
+            mPendingUncapturedError.message += '\n';
+            mPendingUncapturedError.message += message;
+            mErrorsMerged.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        SerializePendingUncapturedError();
+        mHasPendingUncapturedError = true;
+        mPendingUncapturedError.device = device;
+        mPendingUncapturedError.type = type;
+        mPendingUncapturedError.message = message;
+    }
+
+    void Server::SerializePendingUncapturedError() {
+        if (!mHasPendingUncapturedError) {
+            return;
+        }
+        mHasPendingUncapturedError = false;
+
         ReturnDeviceUncapturedErrorCallbackCmd cmd;
-        cmd.device = device;
-        cmd.type = type;
-        cmd.message = message;
+        cmd.device = mPendingUncapturedError.device;
+        cmd.type = mPendingUncapturedError.type;
+        cmd.message = mPendingUncapturedError.message.c_str();
 
-        SerializeCommand(cmd);
+        mSerializer.SerializeCommand(cmd);
     }
 
     void Server::OnDeviceLost(ObjectHandle device,
@@ -101,6 +141,39 @@ namespace dawn_wire { namespace server {
         return success;
     }
 
+    bool Server::DoDeviceGetStatistics(ObjectId deviceId, uint64_t requestSerial) {
+        auto* device = DeviceObjects().Get(deviceId);
+        if (device == nullptr) {
+            return false;
+        }
+
+        DeviceStatisticsCounters counters;
+        if (mGetDeviceStatistics != nullptr) {
+            counters = mGetDeviceStatistics(device->handle);
+        }
+
+        // The names are sent as consecutive null-terminated strings, one per counter.
+        std::vector<uint64_t> counterValues;
+        std::string counterNames;
+        counterValues.reserve(counters.size());
+        for (const auto& counter : counters) {
+            counterValues.push_back(counter.second);
+            counterNames.append(counter.first.c_str(), counter.first.size() + 1);
+        }
+
+        ReturnDeviceGetStatisticsCallbackCmd cmd;
+        cmd.device = ObjectHandle{deviceId, device->generation};
+        cmd.requestSerial = requestSerial;
+        cmd.available = mGetDeviceStatistics != nullptr;
+        cmd.counterCount = counterValues.size();
+        cmd.counterValues = counterValues.data();
+        cmd.counterNamesSize = counterNames.size();
+        cmd.counterNames = counterNames.data();
+
+        SerializeCommand(cmd);
+        return true;
+    }
+
     void Server::OnDevicePopErrorScope(WGPUErrorType type,
                                        const char* message,
                                        ErrorScopeUserdata* userdata) {
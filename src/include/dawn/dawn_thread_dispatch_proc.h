@@ -26,6 +26,14 @@ extern "C" {
 WGPU_EXPORT extern DawnProcTable dawnThreadDispatchProcTable;
 WGPU_EXPORT void dawnProcSetPerThreadProcs(const DawnProcTable* procs);
 
+// Call dawnProcSetProcs(&dawnObjectDispatchProcTable) to dispatch each call to the procs of the
+// implementation that created the object it is made on, so that objects of dawn_native and of
+// dawn_wire clients can be used in the same process without setting procs per thread. A call costs
+// a load of the procs from the object and an indirect jump. The objects of both implementations
+// store their DawnProcTable right after their vtable pointer. Calls that aren't made on an object,
+// wgpuCreateInstance and wgpuGetProcAddress with a null device, use the per-thread procs.
+WGPU_EXPORT extern DawnProcTable dawnObjectDispatchProcTable;
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
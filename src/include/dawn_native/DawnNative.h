@@ -20,6 +20,7 @@
 #include <dawn_native/dawn_native_export.h>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace dawn_platform {
@@ -185,6 +186,12 @@ namespace dawn_native {
 
         void SetPlatform(dawn_platform::Platform* platform);
 
+        // Returns the events recorded by the trace event recorder built into
+        // dawn_platform::Platform in the Chrome "Trace Event Format" JSON. The recorder is enabled
+        // by creating a device with the "enable_builtin_tracing" toggle or with the
+        // DAWN_TRACE_FILE environment variable.
+        std::string DumpBuiltinTraceEvents();
+
         // Returns the underlying WGPUInstance object.
         WGPUInstance Get() const;
 
@@ -204,6 +211,117 @@ namespace dawn_native {
     // Backdoor to get the number of deprecation warnings for testing
     DAWN_NATIVE_EXPORT size_t GetDeprecationWarningCountForTesting(WGPUDevice device);
 
+    struct DAWN_NATIVE_EXPORT CacheStatistics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    // A snapshot of the counters of the CPU work done by a device since its creation. The
+    // counters are always enabled and cheap to update. They are read independently so they might
+    // be slightly out of sync with each other if the device is used concurrently.
+    struct DAWN_NATIVE_EXPORT DeviceStatistics {
+        // Number of commands recorded by command and render bundle encoders, and number and total
+        // size of the CommandAllocator blocks used to store them.
+        uint64_t commandsEncoded = 0;
+        uint64_t commandAllocatorBlocks = 0;
+        uint64_t commandAllocatorBytes = 0;
+
+        // Size of the command blocks currently held by command buffers and render bundles.
+        // Command buffers release their commands when they are submitted, even if the
+        // application still references them.
+        uint64_t commandBytesInUse = 0;
+
+        // Cumulative CPU time spent parsing, transforming and generating shaders with Tint.
+        uint64_t tintCompileTimeNs = 0;
+
+        // Number of bytes suballocated from the DynamicUploader, for example for WriteBuffer.
+        uint64_t dynamicUploaderBytes = 0;
+
+        // Number of deferred callbacks called when flushing the callback queue.
+        uint64_t callbacksFlushed = 0;
+
+        // Number of frontend objects allocated from the device's object pools, and the memory
+        // reserved by the pools' slabs.
+        uint64_t pooledObjects = 0;
+        uint64_t objectPoolReservedBytes = 0;
+
+        CacheStatistics attachmentStateCache;
+        CacheStatistics bindGroupLayoutCache;
+        CacheStatistics computePipelineCache;
+        CacheStatistics pipelineLayoutCache;
+        CacheStatistics renderPipelineCache;
+        CacheStatistics samplerCache;
+        CacheStatistics shaderModuleCache;
+
+        // The number of objects returned to the application that are still alive, for each object
+        // type. Types are named like in the API, for example "BindGroupLayout".
+        std::vector<std::pair<const char*, uint64_t>> objectsAlive;
+    };
+
+    // Query the CPU statistics counters of a device.
+    DAWN_NATIVE_EXPORT DeviceStatistics GetDeviceStatistics(WGPUDevice device);
+
+    // The same statistics as a flat list of named counters, for example "commandsEncoded",
+    // "samplerCache.hits" or "objectsAlive.Buffer". This is the format dawn_wire uses to forward
+    // them to the client, see dawn_wire::WireServerDescriptor::getDeviceStatistics.
+    DAWN_NATIVE_EXPORT std::vector<std::pair<std::string, uint64_t>> GetDeviceStatisticsCounters(
+        WGPUDevice device);
+
+    class ReadbackStreamBase;
+
+    struct DAWN_NATIVE_EXPORT ReadbackStreamDescriptor {
+        // The size of each staging buffer, which is the maximum size of a readback. Rounded up to
+        // a multiple of 4.
+        uint64_t chunkSize = 0;
+        // The number of staging buffers, which is the maximum number of readbacks in flight.
+        uint32_t chunkCount = 0;
+    };
+
+    // Called when a readback completes. On success |data| points to the |size| bytes copied, and
+    // is only valid for the duration of the call. Otherwise |data| is null, for example if the
+    // device was lost or the stream was destroyed before the readback completed.
+    using ReadbackCallback = void (*)(WGPUBufferMapAsyncStatus status,
+                                      const void* data,
+                                      uint64_t size,
+                                      uint64_t tag,
+                                      void* userdata);
+
+    // Streams data from GPU buffers back to the CPU through a fixed ring of MapRead staging
+    // buffers that are reused for each readback, so that the application doesn't have to manage
+    // staging buffers and map requests itself. Callbacks are called in the order the copies were
+    // enqueued, from the device's Tick like the MapAsync callbacks. Like the device, the stream
+    // must be externally synchronized.
+    class DAWN_NATIVE_EXPORT ReadbackStream {
+      public:
+        ReadbackStream(WGPUDevice device,
+                       const ReadbackStreamDescriptor* descriptor,
+                       ReadbackCallback callback,
+                       void* userdata);
+        // Readbacks that haven't completed are cancelled and their callbacks are called with
+        // WGPUBufferMapAsyncStatus_DestroyedBeforeCallback.
+        ~ReadbackStream();
+
+        ReadbackStream(const ReadbackStream& other) = delete;
+        ReadbackStream& operator=(const ReadbackStream& other) = delete;
+
+        // Enqueues a copy of |size| bytes of |buffer| starting at |offset| into a free staging
+        // buffer. |tag| is passed back to the callback. Returns false without enqueuing anything
+        // if there is no free staging buffer, if |size| is 0 or larger than the chunk size, or if
+        // the copy is invalid, in which case a validation error is reported on the device.
+        bool EnqueueCopy(WGPUBuffer buffer, uint64_t offset, uint64_t size, uint64_t tag);
+
+        // Submits the copies enqueued since the last Flush and starts reading them back. If the
+        // copies can't be submitted, for example because a source buffer was destroyed since it
+        // was enqueued, their callbacks are called with WGPUBufferMapAsyncStatus_Error.
+        void Flush();
+
+        // Returns the number of staging buffers that can be used by EnqueueCopy.
+        uint32_t GetFreeChunkCount() const;
+
+      private:
+        ReadbackStreamBase* mImpl = nullptr;
+    };
+
     //  Query if texture has been initialized
     DAWN_NATIVE_EXPORT bool IsTextureSubresourceInitialized(
         WGPUTexture texture,
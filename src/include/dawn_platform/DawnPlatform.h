@@ -20,11 +20,16 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
 
 #include <dawn/webgpu.h>
 
 namespace dawn_platform {
 
+    namespace tracing {
+        class TraceRecorder;
+    }  // namespace tracing
+
     enum class TraceCategory {
         General,     // General trace events
         Validation,  // Dawn validation
@@ -106,9 +111,26 @@ namespace dawn_platform {
                                                       size_t fingerprintSize);
         virtual std::unique_ptr<WorkerTaskPool> CreateWorkerTaskPool();
 
+        // Dawn has a built-in trace event recorder that backs the default implementations of
+        // GetTraceCategoryEnabledFlag, MonotonicallyIncreasingTime and AddTraceEvent, so that
+        // traces can be collected without implementing a custom Platform. It is disabled by
+        // default and can be enabled either with EnableBuiltinTracing or by setting the
+        // DAWN_TRACE_FILE environment variable to a path where the trace is written when the
+        // Platform is destroyed. Platforms created after the first one insert their index before
+        // the extension of that path. Traces use the Chrome "Trace Event Format" JSON.
+        // These have no effect for platforms that override the trace methods above.
+        void EnableBuiltinTracing(bool enable);
+        bool IsBuiltinTracingEnabled() const;
+        std::string DumpBuiltinTraceEvents() const;
+        bool WriteBuiltinTraceEventsToFile(const char* path) const;
+        void ClearBuiltinTraceEvents();
+
       private:
         Platform(const Platform&) = delete;
         Platform& operator=(const Platform&) = delete;
+
+        std::unique_ptr<tracing::TraceRecorder> mTraceRecorder;
+        std::string mTraceFilePath;
     };
 
 }  // namespace dawn_platform
@@ -17,6 +17,9 @@
 
 #include <cstdint>
 #include <limits>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "dawn/webgpu.h"
 #include "dawn_wire/dawn_wire_export.h"
@@ -50,6 +53,24 @@ namespace dawn_wire {
         virtual const volatile char* HandleCommands(const volatile char* commands, size_t size) = 0;
     };
 
+    // Counters of the commands serialized by a WireClient or WireServer since its creation.
+    struct DAWN_WIRE_EXPORT WireStatistics {
+        uint64_t commandsSerialized = 0;
+        uint64_t bytesSerialized = 0;
+
+        // Only counted by a WireServer that batches its return commands. The average size of
+        // the batches is bytesSerialized / batchesFlushed.
+        uint64_t batchesFlushed = 0;
+        uint64_t largestBatchBytes = 0;
+        // The number of uncaptured errors that were merged with the previous one instead of
+        // being sent in their own command.
+        uint64_t errorsMerged = 0;
+    };
+
+    // Named counters of the CPU work done by a device of the server, in the format of
+    // dawn_native::GetDeviceStatisticsCounters, so that the wire doesn't depend on dawn_native.
+    using DeviceStatisticsCounters = std::vector<std::pair<std::string, uint64_t>>;
+
     DAWN_WIRE_EXPORT size_t
     SerializedWGPUDevicePropertiesSize(const WGPUDeviceProperties* deviceProperties);
 
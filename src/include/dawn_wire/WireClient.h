@@ -52,6 +52,12 @@ namespace dawn_wire {
         uint32_t generation;
     };
 
+    // Called with the statistics of a device of the server, or with null if they are
+    // unavailable, for example if the server doesn't provide them or if the device was destroyed
+    // or the client disconnected before they were received.
+    using DeviceStatisticsCallback = void (*)(const DeviceStatisticsCounters* counters,
+                                              void* userdata);
+
     struct DAWN_WIRE_EXPORT WireClientDescriptor {
         CommandSerializer* serializer;
         client::MemoryTransferService* memoryTransferService = nullptr;
@@ -77,6 +83,15 @@ namespace dawn_wire {
         // Commands allocated after this point will not be sent.
         void Disconnect();
 
+        // Statistics of the commands serialized to the server.
+        WireStatistics GetStatistics() const;
+
+        // Queries the statistics of the work done by |device| on the server. The callback is
+        // called when the reply is handled by HandleCommands.
+        void GetDeviceStatistics(WGPUDevice device,
+                                 DeviceStatisticsCallback callback,
+                                 void* userdata);
+
       private:
         std::unique_ptr<client::Client> mImpl;
     };
@@ -91,10 +106,14 @@ namespace dawn_wire {
             class WriteHandle;
 
             // Create a handle for reading server data.
+            // Handles are created for each MapAsync and only cover the mapped range, so offsets
+            // given to the handle are relative to the start of that range.
             // This may fail and return nullptr.
             virtual ReadHandle* CreateReadHandle(size_t) = 0;
 
             // Create a handle for writing server data.
+            // Handles are created for each MapAsync, or for the whole buffer if it is
+            // mappedAtCreation, and are destroyed on unmap.
             // This may fail and return nullptr.
             virtual WriteHandle* CreateWriteHandle(size_t) = 0;
 
@@ -151,7 +170,9 @@ namespace dawn_wire {
 
                 // Serialize a command to send the modified contents of
                 // the subrange (offset, offset + size) of the allocation at buffer unmap
-                // This subrange is always the whole mapped region for now
+                // At unmap, this is called once for each disjoint subrange the application got
+                // with GetMappedRange, in increasing offset order, and not at all if it never
+                // called GetMappedRange.
                 // There could be nothing to be serialized (if using shared memory)
                 virtual void SerializeDataUpdate(void* serializePointer,
                                                  size_t offset,
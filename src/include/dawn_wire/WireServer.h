@@ -32,6 +32,29 @@ namespace dawn_wire {
         const DawnProcTable* procs;
         CommandSerializer* serializer;
         server::MemoryTransferService* memoryTransferService = nullptr;
+
+        // When true, the return commands are buffered by the server instead of being written to
+        // |serializer| as soon as they are produced. They are written, followed by a single
+        // Flush of |serializer|, at the end of each HandleCommands and in FlushReturnCommands.
+        // Consecutive uncaptured errors of the same type on the same device are also merged into
+        // a single callback whose message contains all the messages, one per line.
+        bool batchReturnCommands = false;
+
+        // When true, the commands are partitioned by the device they are for, and the commands
+        // of different devices are handled in parallel, each device on its own thread, so that a
+        // busy device doesn't hold up the others. The commands of a device are still handled in
+        // order. Commands that aren't for a single device, like destroying a device, wait for
+        // all the previous commands to be handled. HandleCommands returns once all the commands
+        // are handled. The procs and the memory transfer service must support being called
+        // from several threads at once for different devices. A command using the objects of
+        // another device than the one it is for is a fatal error in this mode.
+        bool partitionCommandsByDevice = false;
+
+        // Returns the statistics of a device for WireClient::GetDeviceStatistics, typically
+        // dawn_native::GetDeviceStatisticsCounters. When null, the client is told that the
+        // statistics are unavailable. Called while handling commands, so it must support being
+        // called from several threads at once when the commands are partitioned by device.
+        DeviceStatisticsCounters (*getDeviceStatistics)(WGPUDevice device) = nullptr;
     };
 
     class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
@@ -64,6 +87,17 @@ namespace dawn_wire {
         // previously injected devices, and observing if GetDevice(id, generation) returns non-null.
         WGPUDevice GetDevice(uint32_t id, uint32_t generation);
 
+        // Writes the return commands buffered since the last flush to the serializer, and
+        // flushes it if there were any. This should be called after ticking the devices, since
+        // their callbacks produce return commands outside of HandleCommands. Does nothing if
+        // return commands are not batched. Returns false if the serializer failed.
+        bool FlushReturnCommands();
+
+        // Statistics of the return commands serialized to the client. The statistics of the work
+        // done by the devices can be queried with dawn_native::GetDeviceStatistics, or by the
+        // client with WireClient::GetDeviceStatistics.
+        WireStatistics GetStatistics() const;
+
       private:
         std::unique_ptr<server::Server> mImpl;
     };
@@ -78,7 +112,7 @@ namespace dawn_wire {
             class WriteHandle;
 
             // Deserialize data to create Read/Write handles. These handles are for the client
-            // to Read/Write data.
+            // to Read/Write data. They are created for each mapping and only cover its range.
             virtual bool DeserializeReadHandle(const void* deserializePointer,
                                                size_t deserializeSize,
                                                ReadHandle** readHandle) = 0;
@@ -121,7 +155,8 @@ namespace dawn_wire {
                 void SetDataLength(size_t dataLength);
 
                 // This function takes in the serialized result of
-                // client::MemoryTransferService::WriteHandle::SerializeDataUpdate.
+                // client::MemoryTransferService::WriteHandle::SerializeDataUpdate, once for each
+                // subrange the client sends at unmap.
                 // Needs to check potential offset/size OOB and overflow
                 virtual bool DeserializeDataUpdate(const void* deserializePointer,
                                                    size_t deserializeSize,
@@ -1565,6 +1565,67 @@ TEST_P(BindGroupTests, ReallyLargeBindGroup) {
     EXPECT_BUFFER_U32_EQ(1, result, 0);
 }
 
+// Test that bind groups with the same resources can be used independently of each other, and
+// that bind groups that differ only in their buffer offset don't alias. Backends may share the
+// state of identical bind groups.
+TEST_P(BindGroupTests, IdenticalBindGroups) {
+    wgpu::ComputePipelineDescriptor pipelineDesc;
+    pipelineDesc.compute.module = utils::CreateShaderModule(device, R"(
+        [[block]] struct Buffer {
+            value : u32;
+        };
+        [[group(0), binding(0)]] var<uniform> src : Buffer;
+        [[group(0), binding(1)]] var<storage, read_write> dst : Buffer;
+
+        [[stage(compute), workgroup_size(1)]] fn main() {
+            dst.value = src.value;
+        })");
+    pipelineDesc.compute.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDesc);
+
+    constexpr uint64_t kOffset = 256;
+    std::array<uint32_t, kOffset / sizeof(uint32_t) + 1> srcData = {};
+    srcData[0] = 1;
+    srcData[kOffset / sizeof(uint32_t)] = 2;
+    wgpu::Buffer src = utils::CreateBufferFromData(device, srcData.data(), sizeof(srcData),
+                                                   wgpu::BufferUsage::Uniform);
+
+    wgpu::BufferDescriptor dstDesc;
+    dstDesc.size = sizeof(uint32_t);
+    dstDesc.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopySrc;
+    wgpu::Buffer dst0 = device.CreateBuffer(&dstDesc);
+    wgpu::Buffer dst1 = device.CreateBuffer(&dstDesc);
+
+    auto makeBindGroup = [&](uint64_t srcOffset, wgpu::Buffer dst) {
+        return utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0),
+                                    {{0, src, srcOffset, sizeof(uint32_t)}, {1, dst}});
+    };
+
+    // Create a bind group, release the first identical one, and check the second still works.
+    wgpu::BindGroup bindGroup = makeBindGroup(0, dst0);
+    {
+        wgpu::BindGroup identicalBindGroup = makeBindGroup(0, dst0);
+        bindGroup = nullptr;
+        bindGroup = identicalBindGroup;
+    }
+    wgpu::BindGroup offsetBindGroup = makeBindGroup(kOffset, dst1);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bindGroup);
+    pass.Dispatch(1);
+    pass.SetBindGroup(0, offsetBindGroup);
+    pass.Dispatch(1);
+    pass.EndPass();
+
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_BUFFER_U32_EQ(1, dst0, 0);
+    EXPECT_BUFFER_U32_EQ(2, dst1, 0);
+}
+
 // This is a regression test for crbug.com/dawn/319 where creating a bind group with a
 // destroyed resource would crash the backend.
 TEST_P(BindGroupTests, CreateWithDestroyedResource) {
@@ -534,7 +534,9 @@ DAWN_INSTANTIATE_TEST(BufferMappingTests,
                       MetalBackend(),
                       OpenGLBackend(),
                       OpenGLESBackend(),
-                      VulkanBackend());
+                      VulkanBackend(),
+                      VulkanBackend({}, {"vulkan_use_timeline_semaphore"}),
+                      VulkanBackend({"vulkan_use_submission_thread"}));
 
 class BufferMappedAtCreationTests : public DawnTest {
   protected:
@@ -500,6 +500,59 @@ TEST_P(DrawIndexedIndirectTest, ValidateWithBundlesInSamePass) {
     EXPECT_PIXEL_RGBA8_EQ(notFilled, renderPass.color, 3, 1);
 }
 
+// Test that draws using the same indirect buffer with index buffers of different sizes, from the
+// render pass and from a render bundle, are validated with their own index buffer size, alongside
+// draws using another indirect buffer.
+TEST_P(DrawIndexedIndirectTest, ValidateMixedIndexBuffersInSamePass) {
+    // TODO(crbug.com/dawn/789): Test is failing under SwANGLE on Windows only.
+    DAWN_SUPPRESS_TEST_IF(IsANGLE() && IsWindows());
+
+    // It doesn't make sense to test invalid inputs when validation is disabled.
+    DAWN_SUPPRESS_TEST_IF(HasToggleEnabled("skip_validation"));
+
+    RGBA8 filled(0, 255, 0, 255);
+    RGBA8 notFilled(0, 0, 0, 0);
+
+    wgpu::Buffer indirectBuffer = CreateIndirectBuffer({3, 1, 6, 0, 0});
+    wgpu::Buffer otherIndirectBuffer = CreateIndirectBuffer({3, 1, 0, 0, 0, 10, 1, 0, 0, 0});
+    wgpu::Buffer smallIndexBuffer = CreateIndexBuffer({0, 1, 2, 0, 1, 2});
+    wgpu::Buffer largeIndexBuffer = CreateIndexBuffer({0, 1, 2, 0, 1, 2, 0, 3, 1});
+
+    // The draw in the bundle is out of bounds of the small index buffer.
+    wgpu::RenderBundle bundle;
+    {
+        utils::ComboRenderBundleEncoderDescriptor desc = {};
+        desc.colorFormatsCount = 1;
+        desc.cColorFormats[0] = wgpu::TextureFormat::RGBA8Unorm;
+        wgpu::RenderBundleEncoder bundleEncoder = device.CreateRenderBundleEncoder(&desc);
+        bundleEncoder.SetPipeline(pipeline);
+        bundleEncoder.SetVertexBuffer(0, vertexBuffer);
+        bundleEncoder.SetIndexBuffer(smallIndexBuffer, wgpu::IndexFormat::Uint32, 0);
+        bundleEncoder.DrawIndexedIndirect(indirectBuffer, 0);
+        bundle = bundleEncoder.Finish();
+    }
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    {
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.ExecuteBundles(1, &bundle);
+        pass.SetPipeline(pipeline);
+        pass.SetVertexBuffer(0, vertexBuffer);
+        pass.SetIndexBuffer(largeIndexBuffer, wgpu::IndexFormat::Uint32, 0);
+        // The same parameters are in bounds of the large index buffer and draw the top right
+        // triangle.
+        pass.DrawIndexedIndirect(indirectBuffer, 0);
+        // Out of bounds of the large index buffer.
+        pass.DrawIndexedIndirect(otherIndirectBuffer, 20);
+        pass.EndPass();
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+
+    queue.Submit(1, &commands);
+    EXPECT_PIXEL_RGBA8_EQ(notFilled, renderPass.color, 1, 3);
+    EXPECT_PIXEL_RGBA8_EQ(filled, renderPass.color, 3, 1);
+}
+
 TEST_P(DrawIndexedIndirectTest, ValidateWithBundlesInDifferentPasses) {
     // TODO(crbug.com/dawn/789): Test is failing under SwANGLE on Windows only.
     DAWN_SUPPRESS_TEST_IF(IsANGLE() && IsWindows());
@@ -656,4 +709,5 @@ DAWN_INSTANTIATE_TEST(DrawIndexedIndirectTest,
                       MetalBackend(),
                       OpenGLBackend(),
                       OpenGLESBackend(),
-                      VulkanBackend());
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_record_render_passes_in_parallel"}));
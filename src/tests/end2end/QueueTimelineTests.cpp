@@ -98,4 +98,6 @@ DAWN_INSTANTIATE_TEST(QueueTimelineTests,
                       MetalBackend(),
                       OpenGLBackend(),
                       OpenGLESBackend(),
-                      VulkanBackend());
+                      VulkanBackend(),
+                      VulkanBackend({}, {"vulkan_use_timeline_semaphore"}),
+                      VulkanBackend({"vulkan_use_submission_thread"}));
@@ -0,0 +1,207 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "dawn_native/DawnNative.h"
+#include "utils/WGPUHelpers.h"
+
+#include <memory>
+#include <vector>
+
+class ReadbackStreamTests : public DawnTest {
+  protected:
+    void SetUp() override {
+        DawnTest::SetUp();
+        // The readback stream is only available in dawn_native.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+        std::vector<uint32_t> data(kSourceSize / sizeof(uint32_t));
+        for (uint32_t i = 0; i < data.size(); ++i) {
+            data[i] = i;
+        }
+        mSource = utils::CreateBufferFromData(device, data.data(), kSourceSize,
+                                              wgpu::BufferUsage::CopySrc);
+    }
+
+    struct Readback {
+        WGPUBufferMapAsyncStatus status;
+        std::vector<uint32_t> data;
+        uint64_t tag;
+    };
+
+    std::unique_ptr<dawn_native::ReadbackStream> CreateStream(uint64_t chunkSize,
+                                                              uint32_t chunkCount) {
+        dawn_native::ReadbackStreamDescriptor descriptor;
+        descriptor.chunkSize = chunkSize;
+        descriptor.chunkCount = chunkCount;
+        return std::make_unique<dawn_native::ReadbackStream>(backendDevice, &descriptor,
+                                                             OnReadback, this);
+    }
+
+    static void OnReadback(WGPUBufferMapAsyncStatus status,
+                           const void* data,
+                           uint64_t size,
+                           uint64_t tag,
+                           void* userdata) {
+        Readback readback = {status, {}, tag};
+        if (data != nullptr) {
+            const uint32_t* words = static_cast<const uint32_t*>(data);
+            readback.data.assign(words, words + size / sizeof(uint32_t));
+        }
+        static_cast<ReadbackStreamTests*>(userdata)->mReadbacks.push_back(std::move(readback));
+    }
+
+    void WaitForReadbacks(size_t count) {
+        while (mReadbacks.size() < count) {
+            WaitABit();
+        }
+    }
+
+    static constexpr uint64_t kSourceSize = 1024;
+    wgpu::Buffer mSource;
+    std::vector<Readback> mReadbacks;
+};
+
+// Test reading back a single chunk.
+TEST_P(ReadbackStreamTests, Basic) {
+    auto stream = CreateStream(16, 1);
+    ASSERT_TRUE(stream->EnqueueCopy(mSource.Get(), 8, 16, 42));
+    stream->Flush();
+    WaitForReadbacks(1);
+
+    ASSERT_EQ(mReadbacks.size(), 1u);
+    EXPECT_EQ(mReadbacks[0].status, WGPUBufferMapAsyncStatus_Success);
+    EXPECT_EQ(mReadbacks[0].tag, 42u);
+    EXPECT_EQ(mReadbacks[0].data, std::vector<uint32_t>({2, 3, 4, 5}));
+}
+
+// Test that the chunks are reused once their readback completed, and that the callbacks are
+// called in the order the copies were enqueued.
+TEST_P(ReadbackStreamTests, ChunksAreReused) {
+    constexpr uint32_t kChunkCount = 3;
+    constexpr uint64_t kChunkSize = 8;
+    auto stream = CreateStream(kChunkSize, kChunkCount);
+
+    uint64_t tag = 0;
+    for (uint32_t round = 0; round < 4; ++round) {
+        ASSERT_EQ(stream->GetFreeChunkCount(), kChunkCount);
+        for (uint32_t i = 0; i < kChunkCount; ++i) {
+            ASSERT_TRUE(stream->EnqueueCopy(mSource.Get(), tag * kChunkSize, kChunkSize, tag));
+            tag++;
+        }
+        // All the chunks are in use.
+        EXPECT_FALSE(stream->EnqueueCopy(mSource.Get(), 0, kChunkSize, tag));
+        EXPECT_EQ(stream->GetFreeChunkCount(), 0u);
+
+        stream->Flush();
+        WaitForReadbacks(tag);
+    }
+
+    ASSERT_EQ(mReadbacks.size(), tag);
+    for (uint32_t i = 0; i < tag; ++i) {
+        EXPECT_EQ(mReadbacks[i].status, WGPUBufferMapAsyncStatus_Success);
+        EXPECT_EQ(mReadbacks[i].tag, i);
+        EXPECT_EQ(mReadbacks[i].data, std::vector<uint32_t>({2 * i, 2 * i + 1}));
+    }
+}
+
+// Test that copies that don't fit in a chunk are rejected.
+TEST_P(ReadbackStreamTests, CopyLargerThanChunk) {
+    auto stream = CreateStream(16, 1);
+    EXPECT_FALSE(stream->EnqueueCopy(mSource.Get(), 0, 20, 0));
+    EXPECT_FALSE(stream->EnqueueCopy(mSource.Get(), 0, 0, 0));
+    EXPECT_EQ(stream->GetFreeChunkCount(), 1u);
+}
+
+// Test that an invalid copy is rejected by EnqueueCopy without making the other copies of the
+// batch fail.
+TEST_P(ReadbackStreamTests, InvalidSource) {
+    DAWN_TEST_UNSUPPORTED_IF(HasToggleEnabled("skip_validation"));
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 16;
+    descriptor.usage = wgpu::BufferUsage::Uniform;
+    wgpu::Buffer invalidSource = device.CreateBuffer(&descriptor);
+
+    auto stream = CreateStream(16, 2);
+    ASSERT_TRUE(stream->EnqueueCopy(mSource.Get(), 0, 16, 0));
+    bool enqueued = true;
+    ASSERT_DEVICE_ERROR(enqueued = stream->EnqueueCopy(invalidSource.Get(), 0, 16, 1));
+    EXPECT_FALSE(enqueued);
+    EXPECT_EQ(stream->GetFreeChunkCount(), 1u);
+
+    stream->Flush();
+    WaitForReadbacks(1);
+
+    ASSERT_EQ(mReadbacks.size(), 1u);
+    EXPECT_EQ(mReadbacks[0].status, WGPUBufferMapAsyncStatus_Success);
+    EXPECT_EQ(mReadbacks[0].tag, 0u);
+    EXPECT_EQ(mReadbacks[0].data, std::vector<uint32_t>({0, 1, 2, 3}));
+}
+
+// Test that when a batch of copies fails to be submitted, all its readbacks complete with an error
+// instead of stale data, and the chunks can be used again.
+TEST_P(ReadbackStreamTests, SourceDestroyedBeforeFlush) {
+    DAWN_TEST_UNSUPPORTED_IF(HasToggleEnabled("skip_validation"));
+
+    wgpu::Buffer destroyedSource =
+        utils::CreateBufferFromData<uint32_t>(device, wgpu::BufferUsage::CopySrc, {1, 2, 3, 4});
+
+    auto stream = CreateStream(16, 2);
+    ASSERT_TRUE(stream->EnqueueCopy(mSource.Get(), 0, 16, 0));
+    ASSERT_TRUE(stream->EnqueueCopy(destroyedSource.Get(), 0, 16, 1));
+    destroyedSource.Destroy();
+    ASSERT_DEVICE_ERROR(stream->Flush());
+    WaitForReadbacks(2);
+
+    ASSERT_EQ(mReadbacks.size(), 2u);
+    for (uint32_t i = 0; i < 2; ++i) {
+        EXPECT_EQ(mReadbacks[i].status, WGPUBufferMapAsyncStatus_Error);
+        EXPECT_EQ(mReadbacks[i].tag, i);
+        EXPECT_TRUE(mReadbacks[i].data.empty());
+    }
+
+    EXPECT_EQ(stream->GetFreeChunkCount(), 2u);
+    ASSERT_TRUE(stream->EnqueueCopy(mSource.Get(), 16, 16, 2));
+    stream->Flush();
+    WaitForReadbacks(3);
+    EXPECT_EQ(mReadbacks[2].status, WGPUBufferMapAsyncStatus_Success);
+    EXPECT_EQ(mReadbacks[2].data, std::vector<uint32_t>({4, 5, 6, 7}));
+}
+
+// Test that destroying the stream cancels the readbacks that didn't complete, whether they were
+// flushed or not, in the order the copies were enqueued.
+TEST_P(ReadbackStreamTests, DestroyBeforeCompletion) {
+    auto stream = CreateStream(4, 3);
+    ASSERT_TRUE(stream->EnqueueCopy(mSource.Get(), 0, 4, 0));
+    ASSERT_TRUE(stream->EnqueueCopy(mSource.Get(), 4, 4, 1));
+    stream->Flush();
+    ASSERT_TRUE(stream->EnqueueCopy(mSource.Get(), 8, 4, 2));
+    stream = nullptr;
+
+    ASSERT_EQ(mReadbacks.size(), 3u);
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(mReadbacks[i].status, WGPUBufferMapAsyncStatus_DestroyedBeforeCallback);
+        EXPECT_EQ(mReadbacks[i].tag, i);
+        EXPECT_TRUE(mReadbacks[i].data.empty());
+    }
+}
+
+DAWN_INSTANTIATE_TEST(ReadbackStreamTests,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      OpenGLESBackend(),
+                      VulkanBackend());
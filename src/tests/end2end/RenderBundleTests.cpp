@@ -198,4 +198,5 @@ DAWN_INSTANTIATE_TEST(RenderBundleTest,
                       MetalBackend(),
                       OpenGLBackend(),
                       OpenGLESBackend(),
-                      VulkanBackend());
+                      VulkanBackend(),
+                      VulkanBackend({"vulkan_record_render_passes_in_parallel"}));
@@ -0,0 +1,139 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "utils/WGPUHelpers.h"
+
+#include <unordered_map>
+
+namespace {
+
+    // In-memory persistent cache that counts the loads that hit and the stores.
+    class FakePersistentCache : public dawn_platform::CachingInterface {
+      public:
+        void StoreData(const WGPUDevice device,
+                       const void* key,
+                       size_t keySize,
+                       const void* value,
+                       size_t valueSize) override {
+            const std::string keyStr(reinterpret_cast<const char*>(key), keySize);
+            const uint8_t* valueStart = reinterpret_cast<const uint8_t*>(value);
+            // The pipeline cache is stored again each time new pipelines are merged into it.
+            mCache[keyStr] = std::vector<uint8_t>(valueStart, valueStart + valueSize);
+            mStoreCount++;
+        }
+
+        size_t LoadData(const WGPUDevice device,
+                        const void* key,
+                        size_t keySize,
+                        void* value,
+                        size_t valueSize) override {
+            const std::string keyStr(reinterpret_cast<const char*>(key), keySize);
+            auto entry = mCache.find(keyStr);
+            if (entry == mCache.end()) {
+                return 0;
+            }
+            if (valueSize >= entry->second.size()) {
+                memcpy(value, entry->second.data(), entry->second.size());
+                mHitCount++;
+            }
+            return entry->second.size();
+        }
+
+        std::unordered_map<std::string, std::vector<uint8_t>> mCache;
+        size_t mHitCount = 0;
+        size_t mStoreCount = 0;
+    };
+
+    class CachingPlatform : public dawn_platform::Platform {
+      public:
+        CachingPlatform(dawn_platform::CachingInterface* cachingInterface)
+            : mCachingInterface(cachingInterface) {
+        }
+
+        dawn_platform::CachingInterface* GetCachingInterface(const void* fingerprint,
+                                                             size_t fingerprintSize) override {
+            return mCachingInterface;
+        }
+
+      private:
+        dawn_platform::CachingInterface* mCachingInterface = nullptr;
+    };
+
+}  // anonymous namespace
+
+class VulkanPipelineCacheTests : public DawnTest {
+  protected:
+    void SetUp() override {
+        DawnTest::SetUp();
+        // Other devices are created directly with dawn_native.
+        DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+    }
+
+    std::unique_ptr<dawn_platform::Platform> CreateTestPlatform() override {
+        return std::make_unique<CachingPlatform>(&mPersistentCache);
+    }
+
+    // Creates a device, creates a compute pipeline on it and destroys it.
+    void CreatePipelineOnNewDevice() {
+        wgpu::Device otherDevice = wgpu::Device::Acquire(GetAdapter().CreateDevice());
+
+        wgpu::ComputePipelineDescriptor descriptor;
+        descriptor.compute.module = utils::CreateShaderModule(otherDevice, R"(
+            [[block]] struct Data {
+                value : u32;
+            };
+            [[group(0), binding(0)]] var<storage, read_write> data : Data;
+
+            [[stage(compute), workgroup_size(1)]] fn main() {
+                data.value = data.value + 1u;
+            })");
+        descriptor.compute.entryPoint = "main";
+        otherDevice.CreateComputePipeline(&descriptor);
+    }
+
+    FakePersistentCache mPersistentCache;
+};
+
+// Test that the pipeline cache is stored when the device is destroyed.
+TEST_P(VulkanPipelineCacheTests, StoredOnDeviceDestruction) {
+    size_t storesBefore = mPersistentCache.mStoreCount;
+    CreatePipelineOnNewDevice();
+
+    EXPECT_EQ(mPersistentCache.mStoreCount, storesBefore + 1);
+    EXPECT_EQ(mPersistentCache.mCache.size(), 1u);
+}
+
+// Test that a new device loads the pipeline cache stored by a previous one, and that the same
+// entry is updated instead of adding new ones.
+TEST_P(VulkanPipelineCacheTests, LoadedByNewDevice) {
+    CreatePipelineOnNewDevice();
+    size_t hitsBefore = mPersistentCache.mHitCount;
+
+    CreatePipelineOnNewDevice();
+    EXPECT_EQ(mPersistentCache.mHitCount, hitsBefore + 1);
+    EXPECT_EQ(mPersistentCache.mCache.size(), 1u);
+}
+
+// Test that a device without pipelines doesn't store its pipeline cache.
+TEST_P(VulkanPipelineCacheTests, NotStoredWithoutPipelines) {
+    size_t storesBefore = mPersistentCache.mStoreCount;
+    {
+        wgpu::Device otherDevice = wgpu::Device::Acquire(GetAdapter().CreateDevice());
+    }
+    EXPECT_EQ(mPersistentCache.mStoreCount, storesBefore);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanPipelineCacheTests, VulkanBackend());
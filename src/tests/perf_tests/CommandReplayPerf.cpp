@@ -0,0 +1,190 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/WGPUHelpers.h"
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 50;
+    constexpr uint32_t kDrawsPerPass = 1000;
+    constexpr uint32_t kDrawsForMemoryReport = 1000000;
+    constexpr uint32_t kTextureSize = 64;
+
+    enum class CommandMix {
+        // Only draws, the state is set once at the start of the pass.
+        DrawsOnly,
+        // The pipeline, a bind group with a dynamic offset and a vertex buffer are set before
+        // each draw, so commands of various sizes and with additional data are replayed.
+        StateChanges,
+    };
+
+    struct CommandReplayParams : AdapterTestParam {
+        CommandReplayParams(const AdapterTestParam& param, CommandMix commandMix)
+            : AdapterTestParam(param), commandMix(commandMix) {
+        }
+
+        CommandMix commandMix;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const CommandReplayParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        switch (param.commandMix) {
+            case CommandMix::DrawsOnly:
+                ostream << "_DrawsOnly";
+                break;
+            case CommandMix::StateChanges:
+                ostream << "_StateChanges";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the performance of replaying commands in the backends. The draws are encoded once in a
+// render bundle that each submitted render pass executes, so the backend replays kDrawsPerPass
+// draws per pass while the frontend only encodes and validates one ExecuteBundles command. The
+// time spent replaying is reported by DawnPerfTest as recording_time. The memory used to store the
+// commands of a million draws is reported as well.
+class CommandReplayPerf : public DawnPerfTestWithParams<CommandReplayParams> {
+  public:
+    CommandReplayPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~CommandReplayPerf() override = default;
+
+    void SetUp() override;
+
+    // Reports the size of the command blocks used to encode kDrawsForMemoryReport draws.
+    void ReportCommandMemory();
+
+  private:
+    void Step() override;
+
+    template <typename Encoder>
+    void EncodeDraws(Encoder encoder, uint32_t drawCount);
+
+    wgpu::RenderPipeline mPipeline;
+    wgpu::BindGroup mBindGroup;
+    wgpu::Buffer mVertexBuffer;
+    wgpu::TextureView mColorAttachment;
+    wgpu::RenderBundle mRenderBundle;
+};
+
+void CommandReplayPerf::SetUp() {
+    DawnPerfTestWithParams<CommandReplayParams>::SetUp();
+
+    wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Vertex, wgpu::BufferBindingType::Uniform, true}});
+
+    utils::ComboRenderPipelineDescriptor pipelineDesc;
+    pipelineDesc.layout = utils::MakeBasicPipelineLayout(device, &bgl);
+    pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+        [[block]] struct Uniforms {
+            offset : vec4<f32>;
+        };
+        [[group(0), binding(0)]] var<uniform> uniforms : Uniforms;
+
+        [[stage(vertex)]] fn main([[location(0)]] pos : vec4<f32>) -> [[builtin(position)]] vec4<f32> {
+            return pos + uniforms.offset;
+        })");
+    pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+        [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+            return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+        })");
+    pipelineDesc.vertex.bufferCount = 1;
+    pipelineDesc.cBuffers[0].arrayStride = 4 * sizeof(float);
+    pipelineDesc.cBuffers[0].attributeCount = 1;
+    pipelineDesc.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+    pipelineDesc.cAttributes[0].shaderLocation = 0;
+    mPipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+    const float kVertexData[12] = {0.0f, 0.5f, 0.0f, 1.0f,  -0.5f, -0.5f,
+                                   0.0f, 1.0f, 0.5f, -0.5f, 0.0f,  1.0f};
+    mVertexBuffer = utils::CreateBufferFromData(device, kVertexData, sizeof(kVertexData),
+                                                wgpu::BufferUsage::Vertex);
+
+    wgpu::BufferDescriptor uniformDesc;
+    uniformDesc.size = 512;
+    uniformDesc.usage = wgpu::BufferUsage::Uniform;
+    wgpu::Buffer uniformBuffer = device.CreateBuffer(&uniformDesc);
+    mBindGroup = utils::MakeBindGroup(device, bgl, {{0, uniformBuffer, 0, 4 * sizeof(float)}});
+
+    wgpu::TextureDescriptor textureDesc;
+    textureDesc.size = {kTextureSize, kTextureSize, 1};
+    textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+    mColorAttachment = device.CreateTexture(&textureDesc).CreateView();
+
+    wgpu::RenderBundleEncoderDescriptor bundleDesc = {};
+    bundleDesc.colorFormatsCount = 1;
+    bundleDesc.colorFormats = &textureDesc.format;
+    wgpu::RenderBundleEncoder bundleEncoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    EncodeDraws(bundleEncoder, kDrawsPerPass);
+    mRenderBundle = bundleEncoder.Finish();
+}
+
+template <typename Encoder>
+void CommandReplayPerf::EncodeDraws(Encoder encoder, uint32_t drawCount) {
+    for (uint32_t draw = 0; draw < drawCount; ++draw) {
+        if (draw == 0 || GetParam().commandMix == CommandMix::StateChanges) {
+            uint32_t dynamicOffset = (draw % 2) * 256;
+            encoder.SetPipeline(mPipeline);
+            encoder.SetBindGroup(0, mBindGroup, 1, &dynamicOffset);
+            encoder.SetVertexBuffer(0, mVertexBuffer);
+        }
+        encoder.Draw(3);
+    }
+}
+
+void CommandReplayPerf::ReportCommandMemory() {
+    FlushWire();
+    uint64_t bytesBefore = dawn_native::GetDeviceStatistics(backendDevice).commandAllocatorBytes;
+
+    wgpu::CommandEncoder commands = device.CreateCommandEncoder();
+    utils::ComboRenderPassDescriptor renderPass({mColorAttachment});
+    wgpu::RenderPassEncoder pass = commands.BeginRenderPass(&renderPass);
+    EncodeDraws(pass, kDrawsForMemoryReport);
+    pass.EndPass();
+    wgpu::CommandBuffer commandBuffer = commands.Finish();
+
+    FlushWire();
+    uint64_t bytesAfter = dawn_native::GetDeviceStatistics(backendDevice).commandAllocatorBytes;
+    PrintResult("command_bytes_per_1M_draws", static_cast<double>(bytesAfter - bytesBefore),
+                "bytes", true);
+}
+
+void CommandReplayPerf::Step() {
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        wgpu::CommandEncoder commands = device.CreateCommandEncoder();
+        utils::ComboRenderPassDescriptor renderPass({mColorAttachment});
+        wgpu::RenderPassEncoder pass = commands.BeginRenderPass(&renderPass);
+        pass.ExecuteBundles(1, &mRenderBundle);
+        pass.EndPass();
+
+        wgpu::CommandBuffer commandBuffer = commands.Finish();
+        queue.Submit(1, &commandBuffer);
+    }
+}
+
+TEST_P(CommandReplayPerf, Run) {
+    ReportCommandMemory();
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(CommandReplayPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {CommandMix::DrawsOnly, CommandMix::StateChanges});
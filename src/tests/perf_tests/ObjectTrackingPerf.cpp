@@ -0,0 +1,97 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 50;
+    constexpr unsigned int kViewsPerIteration = 100;
+
+    struct ObjectTrackingParams : AdapterTestParam {
+        ObjectTrackingParams(const AdapterTestParam& param, uint32_t threadCount)
+            : AdapterTestParam(param), threadCount(threadCount) {
+        }
+
+        uint32_t threadCount;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ObjectTrackingParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_threads_" << param.threadCount;
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the performance of creating and releasing objects on multiple threads at the same time.
+// Each thread creates and releases texture views, which are cheap to create in all backends, so
+// most of the time is spent in the frontend, including tracking the objects in their device.
+class ObjectTrackingPerf : public DawnPerfTestWithParams<ObjectTrackingParams> {
+  public:
+    ObjectTrackingPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~ObjectTrackingPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::Texture mTexture;
+};
+
+void ObjectTrackingPerf::SetUp() {
+    DawnPerfTestWithParams<ObjectTrackingParams>::SetUp();
+
+    // The wire client isn't thread-safe.
+    DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+    wgpu::TextureDescriptor descriptor;
+    descriptor.size = {4, 4, 1};
+    descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+    descriptor.usage = wgpu::TextureUsage::TextureBinding;
+    mTexture = device.CreateTexture(&descriptor);
+}
+
+void ObjectTrackingPerf::Step() {
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < GetParam().threadCount; ++t) {
+        threads.emplace_back([this]() {
+            std::vector<wgpu::TextureView> views(kViewsPerIteration);
+            for (unsigned int i = 0; i < kNumIterations; ++i) {
+                for (wgpu::TextureView& view : views) {
+                    view = mTexture.CreateView();
+                }
+                for (wgpu::TextureView& view : views) {
+                    view = nullptr;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST_P(ObjectTrackingPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(ObjectTrackingPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {1, 2, 4, 8});
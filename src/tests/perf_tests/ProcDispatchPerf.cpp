@@ -0,0 +1,126 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn/dawn_proc.h"
+#include "dawn/dawn_thread_dispatch_proc.h"
+#include "dawn_wire/WireClient.h"
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 50;
+    constexpr unsigned int kCallsPerIteration = 10000;
+
+    enum class Dispatch {
+        Direct,
+        PerThread,
+        PerObject,
+    };
+
+    struct ProcDispatchParams : AdapterTestParam {
+        ProcDispatchParams(const AdapterTestParam& param, Dispatch dispatch)
+            : AdapterTestParam(param), dispatch(dispatch) {
+        }
+
+        Dispatch dispatch;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ProcDispatchParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        switch (param.dispatch) {
+            case Dispatch::Direct:
+                break;
+            case Dispatch::PerThread:
+                ostream << "_per_thread_dispatch";
+                break;
+            case Dispatch::PerObject:
+                ostream << "_per_object_dispatch";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the overhead of calling an API function through the procs. Each call references or
+// releases a buffer, which is one of the cheapest calls both in dawn_native and in the wire
+// client, so the time is dominated by the dispatch. The procs are called directly, or through
+// dawnThreadDispatchProcTable with the procs set for the thread, or through
+// dawnObjectDispatchProcTable which finds the procs in the buffer. Run with --use-wire to measure
+// the wire client procs instead of the dawn_native ones.
+class ProcDispatchPerf : public DawnPerfTestWithParams<ProcDispatchParams> {
+  public:
+    ProcDispatchPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~ProcDispatchPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+
+    const DawnProcTable* GetImplementationProcs() const;
+
+    wgpu::Buffer mBuffer;
+};
+
+const DawnProcTable* ProcDispatchPerf::GetImplementationProcs() const {
+    return UsesWire() ? &dawn_wire::client::GetProcs() : &dawn_native::GetProcs();
+}
+
+void ProcDispatchPerf::SetUp() {
+    DawnPerfTestWithParams<ProcDispatchParams>::SetUp();
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::Uniform;
+    mBuffer = device.CreateBuffer(&descriptor);
+
+    if (GetParam().dispatch == Dispatch::PerThread) {
+        dawnProcSetPerThreadProcs(GetImplementationProcs());
+        dawnProcSetProcs(&dawnThreadDispatchProcTable);
+    } else if (GetParam().dispatch == Dispatch::PerObject) {
+        dawnProcSetProcs(&dawnObjectDispatchProcTable);
+    }
+}
+
+void ProcDispatchPerf::TearDown() {
+    if (GetParam().dispatch == Dispatch::PerThread) {
+        dawnProcSetProcs(GetImplementationProcs());
+        dawnProcSetPerThreadProcs(nullptr);
+    } else if (GetParam().dispatch == Dispatch::PerObject) {
+        dawnProcSetProcs(GetImplementationProcs());
+    }
+
+    DawnPerfTestWithParams<ProcDispatchParams>::TearDown();
+}
+
+void ProcDispatchPerf::Step() {
+    WGPUBuffer buffer = mBuffer.Get();
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        for (unsigned int j = 0; j < kCallsPerIteration; ++j) {
+            wgpuBufferReference(buffer);
+            wgpuBufferRelease(buffer);
+        }
+    }
+}
+
+TEST_P(ProcDispatchPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(ProcDispatchPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {Dispatch::Direct, Dispatch::PerThread, Dispatch::PerObject});
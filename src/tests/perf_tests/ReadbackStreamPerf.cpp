@@ -0,0 +1,178 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_native/DawnNative.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 50;
+    constexpr uint32_t kChunkCount = 16;
+    constexpr uint64_t kChunkSize = 64 * 1024;
+
+    enum class ReadbackMethod {
+        // A new MapRead buffer is created, copied to and mapped for each readback.
+        MapAsync,
+        // The readbacks go through a dawn_native::ReadbackStream.
+        ReadbackStream,
+    };
+
+    struct ReadbackParams : AdapterTestParam {
+        ReadbackParams(const AdapterTestParam& param, ReadbackMethod method)
+            : AdapterTestParam(param), method(method) {
+        }
+
+        ReadbackMethod method;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ReadbackParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        switch (param.method) {
+            case ReadbackMethod::MapAsync:
+                ostream << "_MapAsync";
+                break;
+            case ReadbackMethod::ReadbackStream:
+                ostream << "_ReadbackStream";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the throughput of streaming data from a GPU buffer back to the CPU. Each iteration reads
+// back kChunkCount chunks of kChunkSize bytes. On the null backend the copies are memcpys so most
+// of the time is spent managing the staging buffers and their map requests.
+class ReadbackStreamPerf : public DawnPerfTestWithParams<ReadbackParams> {
+  public:
+    ReadbackStreamPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~ReadbackStreamPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    void Step() override;
+
+    void ReadbackWithMapAsync();
+    void ReadbackWithStream();
+    void WaitForPendingReadbacks();
+
+    wgpu::Buffer mSource;
+    std::unique_ptr<dawn_native::ReadbackStream> mStream;
+    uint32_t mPendingReadbacks = 0;
+};
+
+void ReadbackStreamPerf::SetUp() {
+    DawnPerfTestWithParams<ReadbackParams>::SetUp();
+
+    // The readback stream is only available in dawn_native.
+    DAWN_TEST_UNSUPPORTED_IF(UsesWire());
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = kChunkSize * kChunkCount;
+    descriptor.usage = wgpu::BufferUsage::CopySrc;
+    mSource = device.CreateBuffer(&descriptor);
+
+    if (GetParam().method == ReadbackMethod::ReadbackStream) {
+        dawn_native::ReadbackStreamDescriptor streamDesc;
+        streamDesc.chunkSize = kChunkSize;
+        streamDesc.chunkCount = kChunkCount;
+        mStream = std::make_unique<dawn_native::ReadbackStream>(
+            backendDevice, &streamDesc,
+            [](WGPUBufferMapAsyncStatus status, const void*, uint64_t, uint64_t, void* userdata) {
+                EXPECT_EQ(status, WGPUBufferMapAsyncStatus_Success);
+                static_cast<ReadbackStreamPerf*>(userdata)->mPendingReadbacks--;
+            },
+            this);
+    }
+}
+
+void ReadbackStreamPerf::TearDown() {
+    mStream = nullptr;
+    DawnPerfTestWithParams<ReadbackParams>::TearDown();
+}
+
+void ReadbackStreamPerf::Step() {
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        switch (GetParam().method) {
+            case ReadbackMethod::MapAsync:
+                ReadbackWithMapAsync();
+                break;
+            case ReadbackMethod::ReadbackStream:
+                ReadbackWithStream();
+                break;
+        }
+    }
+}
+
+void ReadbackStreamPerf::ReadbackWithMapAsync() {
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = kChunkSize;
+    descriptor.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst;
+
+    std::vector<wgpu::Buffer> buffers(kChunkCount);
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (uint32_t c = 0; c < kChunkCount; ++c) {
+        buffers[c] = device.CreateBuffer(&descriptor);
+        encoder.CopyBufferToBuffer(mSource, c * kChunkSize, buffers[c], 0, kChunkSize);
+    }
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    for (wgpu::Buffer& buffer : buffers) {
+        mPendingReadbacks++;
+        buffer.MapAsync(
+            wgpu::MapMode::Read, 0, kChunkSize,
+            [](WGPUBufferMapAsyncStatus status, void* userdata) {
+                EXPECT_EQ(status, WGPUBufferMapAsyncStatus_Success);
+                static_cast<ReadbackStreamPerf*>(userdata)->mPendingReadbacks--;
+            },
+            this);
+    }
+    WaitForPendingReadbacks();
+
+    for (wgpu::Buffer& buffer : buffers) {
+        buffer.Unmap();
+    }
+}
+
+void ReadbackStreamPerf::ReadbackWithStream() {
+    for (uint32_t c = 0; c < kChunkCount; ++c) {
+        mPendingReadbacks++;
+        EXPECT_TRUE(mStream->EnqueueCopy(mSource.Get(), c * kChunkSize, kChunkSize, c));
+    }
+    mStream->Flush();
+    WaitForPendingReadbacks();
+}
+
+void ReadbackStreamPerf::WaitForPendingReadbacks() {
+    // Don't use WaitABit() since sleeping would hide the cost of the readbacks.
+    while (mPendingReadbacks != 0) {
+        device.Tick();
+    }
+}
+
+TEST_P(ReadbackStreamPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(ReadbackStreamPerf,
+                        {NullBackend()},
+                        {ReadbackMethod::MapAsync, ReadbackMethod::ReadbackStream});
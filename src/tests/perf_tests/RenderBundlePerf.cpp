@@ -0,0 +1,149 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "utils/ComboRenderBundleEncoderDescriptor.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/WGPUHelpers.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 50;
+    constexpr uint32_t kDrawsPerBundle = 100;
+    constexpr uint32_t kBundlesPerPass = 20;
+    constexpr uint32_t kTextureSize = 64;
+
+    struct RenderBundleParams : AdapterTestParam {
+        RenderBundleParams(const AdapterTestParam& param, bool redundantState)
+            : AdapterTestParam(param), redundantState(redundantState) {
+        }
+
+        // Whether all the state is set again before each draw of the bundle, like engines that
+        // don't track the state they set often do.
+        bool redundantState;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const RenderBundleParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        if (param.redundantState) {
+            ostream << "_RedundantState";
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the performance of replaying render bundles. Each step executes the same bundle many times
+// in a render pass, so most of the CPU time is spent by the backend replaying the commands of the
+// bundle.
+class RenderBundlePerf : public DawnPerfTestWithParams<RenderBundleParams> {
+  public:
+    RenderBundlePerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~RenderBundlePerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    wgpu::RenderBundle mBundle;
+    wgpu::Texture mColorAttachment;
+};
+
+void RenderBundlePerf::SetUp() {
+    DawnPerfTestWithParams<RenderBundleParams>::SetUp();
+
+    wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Vertex, wgpu::BufferBindingType::Uniform}});
+
+    utils::ComboRenderPipelineDescriptor pipelineDesc;
+    pipelineDesc.layout = utils::MakeBasicPipelineLayout(device, &bgl);
+    pipelineDesc.vertex.module = utils::CreateShaderModule(device, R"(
+        [[block]] struct Uniforms {
+            offset : vec4<f32>;
+        };
+        [[group(0), binding(0)]] var<uniform> uniforms : Uniforms;
+
+        [[stage(vertex)]] fn main([[location(0)]] pos : vec4<f32>) -> [[builtin(position)]] vec4<f32> {
+            return pos + uniforms.offset;
+        })");
+    pipelineDesc.cFragment.module = utils::CreateShaderModule(device, R"(
+        [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+            return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+        })");
+    pipelineDesc.vertex.bufferCount = 1;
+    pipelineDesc.cBuffers[0].arrayStride = 4 * sizeof(float);
+    pipelineDesc.cBuffers[0].attributeCount = 1;
+    pipelineDesc.cAttributes[0].format = wgpu::VertexFormat::Float32x4;
+    pipelineDesc.cAttributes[0].shaderLocation = 0;
+    wgpu::RenderPipeline pipeline = device.CreateRenderPipeline(&pipelineDesc);
+
+    const float kVertexData[12] = {0.0f, 0.5f, 0.0f, 1.0f,  -0.5f, -0.5f,
+                                   0.0f, 1.0f, 0.5f, -0.5f, 0.0f,  1.0f};
+    wgpu::Buffer vertexBuffer = utils::CreateBufferFromData(device, kVertexData,
+                                                            sizeof(kVertexData),
+                                                            wgpu::BufferUsage::Vertex);
+
+    const float kUniformData[4] = {};
+    wgpu::Buffer uniformBuffer = utils::CreateBufferFromData(
+        device, kUniformData, sizeof(kUniformData), wgpu::BufferUsage::Uniform);
+    wgpu::BindGroup bindGroup =
+        utils::MakeBindGroup(device, bgl, {{0, uniformBuffer, 0, sizeof(kUniformData)}});
+
+    utils::ComboRenderBundleEncoderDescriptor bundleDesc = {};
+    bundleDesc.colorFormatsCount = 1;
+    bundleDesc.cColorFormats[0] = wgpu::TextureFormat::RGBA8Unorm;
+    wgpu::RenderBundleEncoder encoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    for (uint32_t i = 0; i < kDrawsPerBundle; ++i) {
+        if (i == 0 || GetParam().redundantState) {
+            encoder.SetPipeline(pipeline);
+            encoder.SetBindGroup(0, bindGroup);
+            encoder.SetVertexBuffer(0, vertexBuffer);
+        }
+        encoder.Draw(3);
+    }
+    mBundle = encoder.Finish();
+
+    wgpu::TextureDescriptor textureDesc;
+    textureDesc.size = {kTextureSize, kTextureSize, 1};
+    textureDesc.format = wgpu::TextureFormat::RGBA8Unorm;
+    textureDesc.usage = wgpu::TextureUsage::RenderAttachment;
+    mColorAttachment = device.CreateTexture(&textureDesc);
+}
+
+void RenderBundlePerf::Step() {
+    std::vector<wgpu::RenderBundle> bundles(kBundlesPerPass, mBundle);
+
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        wgpu::CommandEncoder commands = device.CreateCommandEncoder();
+        utils::ComboRenderPassDescriptor renderPass({mColorAttachment.CreateView()});
+        wgpu::RenderPassEncoder pass = commands.BeginRenderPass(&renderPass);
+        pass.ExecuteBundles(kBundlesPerPass, bundles.data());
+        pass.EndPass();
+
+        wgpu::CommandBuffer commandBuffer = commands.Finish();
+        queue.Submit(1, &commandBuffer);
+    }
+}
+
+TEST_P(RenderBundlePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(RenderBundlePerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {false, true});
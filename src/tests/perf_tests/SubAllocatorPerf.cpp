@@ -0,0 +1,270 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_native/BuddyMemoryAllocator.h"
+#include "dawn_native/ResourceHeapAllocator.h"
+#include "dawn_native/TLSFMemoryAllocator.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 1;
+
+    // The configuration used by the Vulkan backend.
+    constexpr uint64_t kHeapSize = 8ull * 1024ull * 1024ull;
+    constexpr uint64_t kMaxSystemSize = 1ull << 34;
+
+    enum class SubAllocator {
+        Buddy,
+        TLSF,
+    };
+
+    // Allocation traces modelled after common workloads. They are generated from a fixed seed so
+    // that each run replays exactly the same sequence of allocations and deallocations.
+    enum class AllocationTrace {
+        // Many small uniform and vertex buffers of arbitrary sizes with a short lifetime.
+        SmallBuffers,
+        // Textures and buffers of all sizes with a long lifetime, like when loading a scene.
+        MixedResources,
+    };
+
+    struct SubAllocatorParams : AdapterTestParam {
+        SubAllocatorParams(const AdapterTestParam& param,
+                           SubAllocator subAllocator,
+                           AllocationTrace trace)
+            : AdapterTestParam(param), subAllocator(subAllocator), trace(trace) {
+        }
+
+        SubAllocator subAllocator;
+        AllocationTrace trace;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const SubAllocatorParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.subAllocator) {
+            case SubAllocator::Buddy:
+                ostream << "_Buddy";
+                break;
+            case SubAllocator::TLSF:
+                ostream << "_TLSF";
+                break;
+        }
+
+        switch (param.trace) {
+            case AllocationTrace::SmallBuffers:
+                ostream << "_SmallBuffers";
+                break;
+            case AllocationTrace::MixedResources:
+                ostream << "_MixedResources";
+                break;
+        }
+
+        return ostream;
+    }
+
+    class DummyResourceHeapAllocator : public dawn_native::ResourceHeapAllocator {
+      public:
+        dawn_native::ResultOrError<std::unique_ptr<dawn_native::ResourceHeapBase>>
+        AllocateResourceHeap(uint64_t size) override {
+            return std::make_unique<dawn_native::ResourceHeapBase>();
+        }
+        void DeallocateResourceHeap(
+            std::unique_ptr<dawn_native::ResourceHeapBase> allocation) override {
+        }
+    };
+
+    struct TraceOperation {
+        // The allocation to free, or kAllocate to make a new allocation.
+        static constexpr size_t kAllocate = ~size_t(0);
+        size_t allocationToFree;
+        // The size of the allocation made or freed.
+        uint64_t size;
+        uint64_t alignment;
+    };
+
+    std::vector<TraceOperation> GenerateTrace(AllocationTrace trace) {
+        std::mt19937 generator(0);
+        std::vector<TraceOperation> operations;
+        std::vector<size_t> liveAllocations;
+        std::vector<uint64_t> allocationSizes;
+
+        auto Allocate = [&](uint64_t size, uint64_t alignment) {
+            operations.push_back({TraceOperation::kAllocate, size, alignment});
+            liveAllocations.push_back(allocationSizes.size());
+            allocationSizes.push_back(size);
+        };
+        auto FreeRandom = [&]() {
+            size_t index = generator() % liveAllocations.size();
+            size_t allocation = liveAllocations[index];
+            operations.push_back({allocation, allocationSizes[allocation], 0});
+            liveAllocations.erase(liveAllocations.begin() + index);
+        };
+
+        switch (trace) {
+            case AllocationTrace::SmallBuffers: {
+                std::uniform_int_distribution<uint64_t> sizes(16, 64 * 1024);
+                for (uint32_t i = 0; i < 20000; i++) {
+                    if (liveAllocations.size() > 2000 ||
+                        (!liveAllocations.empty() && generator() % 3 == 0)) {
+                        FreeRandom();
+                    } else {
+                        Allocate(sizes(generator), 256);
+                    }
+                }
+                break;
+            }
+
+            case AllocationTrace::MixedResources: {
+                // Textures are 64KB aligned and have sizes that are multiples of their tiles.
+                std::uniform_int_distribution<uint64_t> textureTiles(1, 64);
+                std::uniform_int_distribution<uint64_t> bufferSizes(256, 2 * 1024 * 1024);
+                for (uint32_t i = 0; i < 5000; i++) {
+                    if (!liveAllocations.empty() && generator() % 4 == 0) {
+                        FreeRandom();
+                    } else if (generator() % 2 == 0) {
+                        Allocate(textureTiles(generator) * 64 * 1024, 64 * 1024);
+                    } else {
+                        Allocate(bufferSizes(generator), 256);
+                    }
+                }
+                break;
+            }
+        }
+
+        // Free everything at the end so that the trace can be replayed.
+        while (!liveAllocations.empty()) {
+            FreeRandom();
+        }
+        return operations;
+    }
+
+}  // namespace
+
+// Test the throughput and the memory efficiency of the resource sub-allocators when replaying
+// allocation traces. The memory efficiency is reported as the ratio of the size of the heaps in
+// use to the size of the allocations alive, at the point where the most heaps are used.
+class SubAllocatorPerf : public DawnPerfTestWithParams<SubAllocatorParams> {
+  public:
+    SubAllocatorPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~SubAllocatorPerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    void ReportMemoryEfficiency();
+
+  private:
+    void Step() override;
+
+    // Replays the trace. If |peakHeapCount| isn't nullptr, it also computes the largest number of
+    // heaps used at the same time, along with the size of the allocations alive at that time.
+    template <typename Allocator>
+    void ReplayTrace(Allocator* allocator, uint64_t* peakHeapCount, uint64_t* peakAllocatedSize);
+
+    DummyResourceHeapAllocator mHeapAllocator;
+    std::vector<TraceOperation> mTrace;
+    std::vector<dawn_native::ResourceMemoryAllocation> mAllocations;
+};
+
+void SubAllocatorPerf::SetUp() {
+    DawnPerfTestWithParams<SubAllocatorParams>::SetUp();
+    mTrace = GenerateTrace(GetParam().trace);
+}
+
+template <typename Allocator>
+void SubAllocatorPerf::ReplayTrace(Allocator* allocator,
+                                   uint64_t* peakHeapCount,
+                                   uint64_t* peakAllocatedSize) {
+    mAllocations.clear();
+    uint64_t allocatedSize = 0;
+    for (const TraceOperation& operation : mTrace) {
+        if (operation.allocationToFree == TraceOperation::kAllocate) {
+            dawn_native::ResultOrError<dawn_native::ResourceMemoryAllocation> result =
+                allocator->Allocate(operation.size, operation.alignment);
+            ASSERT_TRUE(result.IsSuccess());
+            mAllocations.push_back(result.AcquireSuccess());
+            allocatedSize += operation.size;
+        } else {
+            allocator->Deallocate(mAllocations[operation.allocationToFree]);
+            allocatedSize -= operation.size;
+        }
+
+        if (peakHeapCount != nullptr) {
+            uint64_t heapCount = allocator->ComputeTotalNumOfHeapsForTesting();
+            if (heapCount > *peakHeapCount) {
+                *peakHeapCount = heapCount;
+                *peakAllocatedSize = allocatedSize;
+            }
+        }
+    }
+}
+
+void SubAllocatorPerf::Step() {
+    switch (GetParam().subAllocator) {
+        case SubAllocator::Buddy: {
+            dawn_native::BuddyMemoryAllocator allocator(kMaxSystemSize, kHeapSize,
+                                                        &mHeapAllocator);
+            ReplayTrace(&allocator, nullptr, nullptr);
+            break;
+        }
+        case SubAllocator::TLSF: {
+            dawn_native::TLSFMemoryAllocator allocator(kMaxSystemSize, kHeapSize,
+                                                       &mHeapAllocator);
+            ReplayTrace(&allocator, nullptr, nullptr);
+            break;
+        }
+    }
+}
+
+void SubAllocatorPerf::ReportMemoryEfficiency() {
+    uint64_t peakHeapCount = 0;
+    uint64_t peakAllocatedSize = 0;
+    switch (GetParam().subAllocator) {
+        case SubAllocator::Buddy: {
+            dawn_native::BuddyMemoryAllocator allocator(kMaxSystemSize, kHeapSize,
+                                                        &mHeapAllocator);
+            ReplayTrace(&allocator, &peakHeapCount, &peakAllocatedSize);
+            break;
+        }
+        case SubAllocator::TLSF: {
+            dawn_native::TLSFMemoryAllocator allocator(kMaxSystemSize, kHeapSize,
+                                                       &mHeapAllocator);
+            ReplayTrace(&allocator, &peakHeapCount, &peakAllocatedSize);
+            break;
+        }
+    }
+
+    PrintResult("peak_heaps", static_cast<unsigned int>(peakHeapCount), "count", true);
+    PrintResult("heap_size_to_allocated_size",
+                static_cast<double>(peakHeapCount * kHeapSize) /
+                    static_cast<double>(std::max(peakAllocatedSize, uint64_t(1))),
+                "ratio", true);
+}
+
+TEST_P(SubAllocatorPerf, Run) {
+    ReportMemoryEfficiency();
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(SubAllocatorPerf,
+                        {NullBackend()},
+                        {SubAllocator::Buddy, SubAllocator::TLSF},
+                        {AllocationTrace::SmallBuffers, AllocationTrace::MixedResources});
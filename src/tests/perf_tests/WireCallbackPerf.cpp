@@ -0,0 +1,141 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 10;
+    constexpr unsigned int kRequestsPerIteration = 64;
+
+    enum class RequestType {
+        OnSubmittedWorkDone,
+        MapAsync,
+    };
+
+    struct WireCallbackParams : AdapterTestParam {
+        WireCallbackParams(const AdapterTestParam& param, RequestType requestType)
+            : AdapterTestParam(param), requestType(requestType) {
+        }
+
+        RequestType requestType;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireCallbackParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.requestType) {
+            case RequestType::OnSubmittedWorkDone:
+                ostream << "_OnSubmittedWorkDone";
+                break;
+            case RequestType::MapAsync:
+                ostream << "_MapAsync";
+                break;
+        }
+
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the throughput of requests with callbacks going through the wire. Many requests are kept
+// in flight at once so that most of the time is spent tracking them in the client and the server
+// and sending their callbacks back.
+class WireCallbackPerf : public DawnPerfTestWithParams<WireCallbackParams> {
+  public:
+    WireCallbackPerf() : DawnPerfTestWithParams(kNumIterations, 1) {
+    }
+    ~WireCallbackPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    void WaitForPendingRequests();
+
+    std::vector<wgpu::Buffer> mBuffers;
+    unsigned int mPendingRequests = 0;
+};
+
+void WireCallbackPerf::SetUp() {
+    DawnPerfTestWithParams<WireCallbackParams>::SetUp();
+
+    DAWN_TEST_UNSUPPORTED_IF(!UsesWire());
+
+    if (GetParam().requestType == RequestType::MapAsync) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = 4;
+        descriptor.usage = wgpu::BufferUsage::MapRead;
+        for (unsigned int i = 0; i < kRequestsPerIteration; ++i) {
+            mBuffers.push_back(device.CreateBuffer(&descriptor));
+        }
+    }
+}
+
+void WireCallbackPerf::Step() {
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        switch (GetParam().requestType) {
+            case RequestType::OnSubmittedWorkDone:
+                for (unsigned int r = 0; r < kRequestsPerIteration; ++r) {
+                    mPendingRequests++;
+                    queue.OnSubmittedWorkDone(
+                        0u,
+                        [](WGPUQueueWorkDoneStatus status, void* userdata) {
+                            EXPECT_EQ(status, WGPUQueueWorkDoneStatus_Success);
+                            static_cast<WireCallbackPerf*>(userdata)->mPendingRequests--;
+                        },
+                        this);
+                }
+                break;
+
+            case RequestType::MapAsync:
+                for (wgpu::Buffer& buffer : mBuffers) {
+                    mPendingRequests++;
+                    buffer.MapAsync(
+                        wgpu::MapMode::Read, 0, 4,
+                        [](WGPUBufferMapAsyncStatus status, void* userdata) {
+                            EXPECT_EQ(status, WGPUBufferMapAsyncStatus_Success);
+                            static_cast<WireCallbackPerf*>(userdata)->mPendingRequests--;
+                        },
+                        this);
+                }
+                break;
+        }
+
+        WaitForPendingRequests();
+
+        for (wgpu::Buffer& buffer : mBuffers) {
+            buffer.Unmap();
+        }
+    }
+}
+
+void WireCallbackPerf::WaitForPendingRequests() {
+    // Don't use WaitABit() since sleeping would hide the cost of the requests.
+    while (mPendingRequests != 0) {
+        device.Tick();
+        FlushWire();
+    }
+}
+
+TEST_P(WireCallbackPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST_P(WireCallbackPerf,
+                        {D3D12Backend(), MetalBackend(), OpenGLBackend(), VulkanBackend()},
+                        {RequestType::OnSubmittedWorkDone, RequestType::MapAsync});
@@ -501,3 +501,145 @@ TEST(CommandAllocator, AcquireCommandBlocks) {
     ASSERT_FALSE(iterator.NextCommandId(&type));
     iterator.MakeEmptyAsDataWasDestroyed();
 }
+
+// Test that a view of an iterator starts at the position of the iterator, and iterates over the
+// commands independently of it.
+TEST(CommandAllocator, InitializeAsViewOf) {
+    CommandAllocator allocator;
+    for (uint32_t i = 0; i < 3; ++i) {
+        CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+        draw->first = i;
+        draw->count = 2 * i;
+    }
+
+    CommandIterator iterator(std::move(allocator));
+    CommandType type;
+    ASSERT_TRUE(iterator.NextCommandId(&type));
+    ASSERT_EQ(iterator.NextCommand<CommandDraw>()->first, 0u);
+
+    {
+        CommandIterator view;
+        view.InitializeAsViewOf(iterator);
+
+        for (uint32_t i = 1; i < 3; ++i) {
+            ASSERT_TRUE(view.NextCommandId(&type));
+            ASSERT_EQ(type, CommandType::Draw);
+            CommandDraw* draw = view.NextCommand<CommandDraw>();
+            ASSERT_EQ(draw->first, i);
+            ASSERT_EQ(draw->count, 2 * i);
+        }
+        ASSERT_FALSE(view.NextCommandId(&type));
+
+        // Like other iterators, the view restarts from the beginning of the commands.
+        ASSERT_TRUE(view.NextCommandId(&type));
+        ASSERT_EQ(view.NextCommand<CommandDraw>()->first, 0u);
+    }
+
+    // Iterating the view didn't move the iterator.
+    ASSERT_TRUE(iterator.NextCommandId(&type));
+    ASSERT_EQ(iterator.NextCommand<CommandDraw>()->first, 1u);
+
+    iterator.MakeEmptyAsDataWasDestroyed();
+}
+
+class RetainedObject : public RefCounted {
+  public:
+    RetainedObject(bool* deleted) : mDeleted(deleted) {
+    }
+
+  protected:
+    ~RetainedObject() override {
+        *mDeleted = true;
+    }
+
+  private:
+    bool* mDeleted;
+};
+
+// Test that retained objects are referenced once per allocator and kept alive until the commands
+// are destroyed, including when the allocators are flattened with AcquireCommandBlocks.
+TEST(CommandAllocator, RetainObject) {
+    bool deleted = false;
+    RetainedObject* object = new RetainedObject(&deleted);
+
+    std::vector<CommandAllocator> allocators(2);
+    for (CommandAllocator& allocator : allocators) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            CommandPipeline* pipeline = allocator.Allocate<CommandPipeline>(CommandType::Pipeline);
+            pipeline->pipeline = reinterpret_cast<uintptr_t>(object);
+            allocator.RetainObject(object);
+        }
+    }
+    EXPECT_EQ(object->GetRefCountForTesting(), 3u);
+
+    CommandIterator iterator;
+    iterator.AcquireCommandBlocks(std::move(allocators));
+    object->Release();
+    EXPECT_FALSE(deleted);
+    EXPECT_EQ(object->GetRefCountForTesting(), 2u);
+
+    iterator.MakeEmptyAsDataWasDestroyed();
+    EXPECT_TRUE(deleted);
+}
+
+// Test that moving an allocator moves its retained objects, and that both the moved-to and the
+// moved-from allocators retain objects correctly afterwards.
+TEST(CommandAllocator, RetainObjectAfterMove) {
+    bool deleted = false;
+    RetainedObject* object = new RetainedObject(&deleted);
+
+    CommandAllocator allocator;
+    allocator.RetainObject(object);
+    EXPECT_EQ(object->GetRefCountForTesting(), 2u);
+
+    CommandAllocator movedTo(std::move(allocator));
+    movedTo.RetainObject(object);
+    EXPECT_EQ(object->GetRefCountForTesting(), 2u);
+
+    allocator.RetainObject(object);
+    EXPECT_EQ(object->GetRefCountForTesting(), 3u);
+
+    CommandAllocator assigned;
+    assigned = std::move(movedTo);
+    assigned.RetainObject(object);
+    EXPECT_EQ(object->GetRefCountForTesting(), 3u);
+    movedTo.RetainObject(object);
+    EXPECT_EQ(object->GetRefCountForTesting(), 4u);
+
+    allocator.Reset();
+    movedTo.Reset();
+    assigned.Reset();
+    EXPECT_EQ(object->GetRefCountForTesting(), 1u);
+    object->Release();
+    EXPECT_TRUE(deleted);
+}
+
+// Test that retaining many objects in an interleaved order references each object once, both while
+// they are found with a linear scan and after the allocator switches to a set.
+TEST(CommandAllocator, RetainManyObjects) {
+    constexpr uint32_t kObjectCount = 64;
+    bool deletedFlags[kObjectCount] = {};
+    std::vector<RetainedObject*> objects;
+    for (uint32_t i = 0; i < kObjectCount; ++i) {
+        objects.push_back(new RetainedObject(&deletedFlags[i]));
+    }
+
+    CommandAllocator allocator;
+    for (uint32_t pass = 0; pass < 3; ++pass) {
+        for (uint32_t i = 0; i < kObjectCount; ++i) {
+            allocator.RetainObject(objects[i]);
+            allocator.RetainObject(objects[i]);
+            allocator.RetainObject(objects[(i * 7) % kObjectCount]);
+        }
+    }
+
+    for (RetainedObject* object : objects) {
+        EXPECT_EQ(object->GetRefCountForTesting(), 2u);
+        object->Release();
+    }
+
+    allocator.Reset();
+    for (uint32_t i = 0; i < kObjectCount; ++i) {
+        EXPECT_TRUE(deletedFlags[i]);
+    }
+}
@@ -0,0 +1,166 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/Math.h"
+#include "dawn_native/ObjectPool.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace dawn_native;
+
+// Test that allocations are tracked per type and that memory is reused after deallocation.
+TEST(ObjectPoolTests, AllocateAndDeallocate) {
+    Ref<DeviceObjectPool> pool = AcquireRef(new DeviceObjectPool());
+
+    void* buffer = pool->Allocate(ObjectType::Buffer, 100);
+    void* view = pool->Allocate(ObjectType::TextureView, 100);
+    EXPECT_NE(buffer, view);
+    EXPECT_TRUE(IsPtrAligned(buffer, alignof(std::max_align_t)));
+    EXPECT_TRUE(IsPtrAligned(view, alignof(std::max_align_t)));
+
+    EXPECT_EQ(pool->GetStatistics(ObjectType::Buffer).objectsInUse, 1u);
+    EXPECT_EQ(pool->GetStatistics(ObjectType::TextureView).objectsInUse, 1u);
+    EXPECT_EQ(pool->GetStatistics(ObjectType::Sampler).objectsInUse, 0u);
+    EXPECT_EQ(pool->GetTotalStatistics().objectsInUse, 2u);
+    EXPECT_GT(pool->GetTotalStatistics().reservedBytes, 0u);
+
+    DeviceObjectPool::Deallocate(buffer);
+    EXPECT_EQ(pool->GetStatistics(ObjectType::Buffer).objectsInUse, 0u);
+
+    // The block just freed is reused for the next allocation of the same size.
+    void* buffer2 = pool->Allocate(ObjectType::Buffer, 100);
+    EXPECT_EQ(buffer, buffer2);
+    EXPECT_EQ(pool->GetStatistics(ObjectType::Buffer).slabCount, 1u);
+
+    DeviceObjectPool::Deallocate(buffer2);
+    DeviceObjectPool::Deallocate(view);
+    EXPECT_EQ(pool->GetTotalStatistics().objectsInUse, 0u);
+}
+
+// Test that objects of different sizes can be allocated for the same type.
+TEST(ObjectPoolTests, MultipleSizes) {
+    Ref<DeviceObjectPool> pool = AcquireRef(new DeviceObjectPool());
+
+    char* small = static_cast<char*>(pool->Allocate(ObjectType::Buffer, 8));
+    char* large = static_cast<char*>(pool->Allocate(ObjectType::Buffer, 1000));
+    memset(small, 0x11, 8);
+    memset(large, 0x22, 1000);
+    EXPECT_EQ(small[7], 0x11);
+    EXPECT_EQ(large[0], 0x22);
+    EXPECT_EQ(pool->GetStatistics(ObjectType::Buffer).objectsInUse, 2u);
+    EXPECT_EQ(pool->GetStatistics(ObjectType::Buffer).slabCount, 2u);
+
+    DeviceObjectPool::Deallocate(small);
+    DeviceObjectPool::Deallocate(large);
+    EXPECT_EQ(pool->GetStatistics(ObjectType::Buffer).objectsInUse, 0u);
+}
+
+// Test that the memory stays valid when the owner of the pool drops its reference first, like
+// when an object outlives its device.
+TEST(ObjectPoolTests, OutlivesOwner) {
+    Ref<DeviceObjectPool> pool = AcquireRef(new DeviceObjectPool());
+    char* object = static_cast<char*>(pool->Allocate(ObjectType::CommandBuffer, 64));
+    pool = nullptr;
+
+    memset(object, 0x33, 64);
+    EXPECT_EQ(object[63], 0x33);
+    DeviceObjectPool::Deallocate(object);
+}
+
+// Test that the blocks of deleted objects are kept in the thread cache and not counted as in use.
+TEST(ObjectPoolTests, ThreadCache) {
+    Ref<DeviceObjectPool> pool = AcquireRef(new DeviceObjectPool());
+
+    void* first = pool->Allocate(ObjectType::TextureView, 64);
+    void* second = pool->Allocate(ObjectType::TextureView, 64);
+    DeviceObjectPool::Deallocate(first);
+    DeviceObjectPool::Deallocate(second);
+
+    ObjectPoolStatistics statistics = pool->GetStatistics(ObjectType::TextureView);
+    EXPECT_EQ(statistics.objectsInUse, 0u);
+    EXPECT_EQ(statistics.cachedBlocks, 2u);
+
+    // The most recently freed block is reused first.
+    EXPECT_EQ(pool->Allocate(ObjectType::TextureView, 64), second);
+    EXPECT_EQ(pool->GetStatistics(ObjectType::TextureView).cachedBlocks, 1u);
+    DeviceObjectPool::Deallocate(second);
+}
+
+// Test that the slabs left empty are freed when there are too many of them, and that Trim frees
+// all of them.
+TEST(ObjectPoolTests, EmptySlabsAreReleased) {
+    Ref<DeviceObjectPool> pool = AcquireRef(new DeviceObjectPool());
+
+    std::vector<void*> objects;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        objects.push_back(pool->Allocate(ObjectType::CommandBuffer, 100));
+    }
+    uint64_t slabCount = pool->GetStatistics(ObjectType::CommandBuffer).slabCount;
+    EXPECT_GT(slabCount, 4u);
+
+    for (void* object : objects) {
+        DeviceObjectPool::Deallocate(object);
+    }
+    ObjectPoolStatistics statistics = pool->GetStatistics(ObjectType::CommandBuffer);
+    EXPECT_EQ(statistics.objectsInUse, 0u);
+    EXPECT_LT(statistics.slabCount, slabCount);
+
+    pool->Trim();
+    statistics = pool->GetStatistics(ObjectType::CommandBuffer);
+    EXPECT_EQ(statistics.cachedBlocks, 0u);
+    EXPECT_EQ(statistics.slabCount, 0u);
+    EXPECT_EQ(statistics.reservedBytes, 0u);
+
+    // The pool is still usable after being trimmed.
+    void* object = pool->Allocate(ObjectType::CommandBuffer, 100);
+    EXPECT_EQ(pool->GetStatistics(ObjectType::CommandBuffer).slabCount, 1u);
+    DeviceObjectPool::Deallocate(object);
+}
+
+// Test allocating and deallocating objects from multiple threads at the same time.
+TEST(ObjectPoolTests, MultipleThreads) {
+    Ref<DeviceObjectPool> pool = AcquireRef(new DeviceObjectPool());
+
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kIterations = 1000;
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&pool, t]() {
+            ObjectType type = t % 2 == 0 ? ObjectType::Buffer : ObjectType::CommandEncoder;
+            std::vector<uint32_t*> objects;
+            for (uint32_t i = 0; i < kIterations; ++i) {
+                uint32_t* object = static_cast<uint32_t*>(pool->Allocate(type, 32));
+                *object = t;
+                objects.push_back(object);
+                if (i % 3 == 0) {
+                    DeviceObjectPool::Deallocate(objects.front());
+                    objects.erase(objects.begin());
+                }
+            }
+            for (uint32_t* object : objects) {
+                EXPECT_EQ(*object, t);
+                DeviceObjectPool::Deallocate(object);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(pool->GetTotalStatistics().objectsInUse, 0u);
+}
@@ -116,3 +116,23 @@ TEST_F(PerThreadProcTests, DispatchesPerThread) {
 
     dawnProcSetProcs(nullptr);
 }
+
+// Test that dawnObjectDispatchProcTable forwards calls to the procs of the implementation that
+// created the object, without per-thread procs being set.
+TEST_F(PerThreadProcTests, DispatchesPerObject) {
+    dawnProcSetProcs(&dawnObjectDispatchProcTable);
+
+    wgpu::Device device =
+        wgpu::Device::Acquire(reinterpret_cast<WGPUDevice>(mNativeAdapter.CreateDevice(nullptr)));
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+    EXPECT_NE(buffer.Get(), nullptr);
+    EXPECT_EQ(buffer.GetSize(), 4u);
+
+    buffer = nullptr;
+    device = nullptr;
+    dawnProcSetProcs(nullptr);
+}
@@ -0,0 +1,126 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    size_t CountOccurrences(const std::string& haystack, const std::string& needle) {
+        size_t count = 0;
+        for (size_t pos = haystack.find(needle); pos != std::string::npos;
+             pos = haystack.find(needle, pos + needle.size())) {
+            count++;
+        }
+        return count;
+    }
+
+}  // anonymous namespace
+
+// Test that the built-in tracing of the default platform is disabled by default.
+TEST(PlatformTracingTests, DisabledByDefault) {
+    dawn_platform::Platform platform;
+    ASSERT_FALSE(platform.IsBuiltinTracingEnabled());
+
+    TRACE_EVENT0(&platform, General, "ShouldNotBeRecorded");
+
+    std::string json = platform.DumpBuiltinTraceEvents();
+    EXPECT_EQ(json.find("ShouldNotBeRecorded"), std::string::npos);
+}
+
+// Test that scoped events are recorded as matching begin and end events, in the trace JSON.
+TEST(PlatformTracingTests, ScopedEventsAreNested) {
+    dawn_platform::Platform platform;
+    platform.EnableBuiltinTracing(true);
+
+    {
+        TRACE_EVENT0(&platform, General, "Outer");
+        TRACE_EVENT0(&platform, Validation, "Inner");
+    }
+
+    std::string json = platform.DumpBuiltinTraceEvents();
+    EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"Outer\""), 2u);
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"Inner\""), 2u);
+    EXPECT_EQ(CountOccurrences(json, "\"ph\":\"B\""), 2u);
+    EXPECT_EQ(CountOccurrences(json, "\"ph\":\"E\""), 2u);
+    EXPECT_NE(json.find("\"cat\":\"validation\""), std::string::npos);
+
+    // Events are in order of recording for a given thread: Outer begins before Inner.
+    EXPECT_LT(json.find("\"name\":\"Outer\""), json.find("\"name\":\"Inner\""));
+}
+
+// Test that disabling the tracing stops recording and that clearing drops events.
+TEST(PlatformTracingTests, DisableAndClear) {
+    dawn_platform::Platform platform;
+    platform.EnableBuiltinTracing(true);
+    TRACE_EVENT_INSTANT0(&platform, General, "First");
+
+    platform.EnableBuiltinTracing(false);
+    TRACE_EVENT_INSTANT0(&platform, General, "Second");
+
+    std::string json = platform.DumpBuiltinTraceEvents();
+    EXPECT_NE(json.find("First"), std::string::npos);
+    EXPECT_EQ(json.find("Second"), std::string::npos);
+
+    platform.ClearBuiltinTraceEvents();
+    json = platform.DumpBuiltinTraceEvents();
+    EXPECT_EQ(json.find("First"), std::string::npos);
+}
+
+// Test that each thread records into its own buffer and that no event is lost, even when more
+// events are recorded than fit in a single chunk.
+TEST(PlatformTracingTests, MultipleThreads) {
+    dawn_platform::Platform platform;
+    platform.EnableBuiltinTracing(true);
+
+    constexpr size_t kThreadCount = 4;
+    constexpr size_t kEventsPerThread = 3000;
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadCount; ++i) {
+        threads.emplace_back([&platform]() {
+            for (size_t j = 0; j < kEventsPerThread; ++j) {
+                TRACE_EVENT_INSTANT0(&platform, Recording, "ThreadEvent");
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::string json = platform.DumpBuiltinTraceEvents();
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"ThreadEvent\""), kThreadCount * kEventsPerThread);
+}
+
+// Test that names of events recorded with the COPY variants outlive the original string.
+TEST(PlatformTracingTests, CopiedNames) {
+    dawn_platform::Platform platform;
+    platform.EnableBuiltinTracing(true);
+
+    {
+        std::string name = "Dynamic\"Name";
+        TRACE_EVENT_COPY_INSTANT0(&platform, General, name.c_str());
+        name = "Overwritten";
+    }
+
+    std::string json = platform.DumpBuiltinTraceEvents();
+    EXPECT_NE(json.find("\"name\":\"Dynamic\\\"Name\""), std::string::npos);
+}
@@ -17,6 +17,8 @@
 #include "common/Math.h"
 #include "common/SlabAllocator.h"
 
+#include <cstring>
+
 namespace {
 
     struct Foo : public PlacementAllocated {
@@ -178,3 +180,96 @@ TEST(SlabAllocatorTests, AllocateDeallocateMany) {
         allocator.Deallocate(object);
     }
 }
+
+// Test that the statistics of the allocator track the blocks and slabs in use.
+TEST(SlabAllocatorTests, Statistics) {
+    SlabAllocator<Foo> allocator(4 * sizeof(Foo));
+    EXPECT_EQ(allocator.GetBlocksInUse(), 0u);
+    EXPECT_EQ(allocator.GetSlabCount(), 0u);
+    EXPECT_EQ(allocator.GetReservedBytes(), 0u);
+
+    std::vector<Foo*> objects;
+    for (int i = 0; i < 5; ++i) {
+        objects.push_back(allocator.Allocate(i));
+    }
+    EXPECT_EQ(allocator.GetBlocksInUse(), 5u);
+    EXPECT_EQ(allocator.GetSlabCount(), 2u);
+    EXPECT_GE(allocator.GetReservedBytes(), 8 * sizeof(Foo));
+
+    // Slabs are recycled, not freed, so the reserved memory stays the same.
+    size_t reservedBytes = allocator.GetReservedBytes();
+    for (Foo* object : objects) {
+        allocator.Deallocate(object);
+    }
+    EXPECT_EQ(allocator.GetBlocksInUse(), 0u);
+    EXPECT_EQ(allocator.GetSlabCount(), 2u);
+    EXPECT_EQ(allocator.GetReservedBytes(), reservedBytes);
+}
+
+// Test that ReleaseEmptySlabs frees only the slabs without blocks in use, down to the number of
+// empty slabs to keep.
+TEST(SlabAllocatorTests, ReleaseEmptySlabs) {
+    SlabAllocator<Foo> allocator(4 * sizeof(Foo));
+
+    std::vector<Foo*> objects;
+    for (int i = 0; i < 16; ++i) {
+        objects.push_back(allocator.Allocate(i));
+    }
+    EXPECT_EQ(allocator.GetSlabCount(), 4u);
+    EXPECT_EQ(allocator.GetEmptySlabCount(), 0u);
+
+    // Empty the first three slabs.
+    for (int i = 0; i < 12; ++i) {
+        allocator.Deallocate(objects[i]);
+    }
+    EXPECT_EQ(allocator.GetEmptySlabCount(), 3u);
+
+    EXPECT_EQ(allocator.ReleaseEmptySlabs(1), 2u);
+    EXPECT_EQ(allocator.GetSlabCount(), 2u);
+    EXPECT_EQ(allocator.GetEmptySlabCount(), 1u);
+
+    // The kept slab is reused, then new slabs are allocated.
+    for (int i = 0; i < 8; ++i) {
+        objects[i] = allocator.Allocate(i);
+    }
+    EXPECT_EQ(allocator.GetSlabCount(), 3u);
+    EXPECT_EQ(allocator.GetEmptySlabCount(), 0u);
+
+    // Slabs with blocks in use are never released.
+    EXPECT_EQ(allocator.ReleaseEmptySlabs(0), 0u);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(objects[i]->value, i);
+        allocator.Deallocate(objects[i]);
+    }
+    for (int i = 12; i < 16; ++i) {
+        allocator.Deallocate(objects[i]);
+    }
+    EXPECT_EQ(allocator.ReleaseEmptySlabs(0), 3u);
+    EXPECT_EQ(allocator.GetSlabCount(), 0u);
+    EXPECT_EQ(allocator.GetReservedBytes(), 0u);
+}
+
+// Test that the UntypedSlabAllocator returns distinct blocks of the requested size and alignment.
+TEST(SlabAllocatorTests, Untyped) {
+    constexpr uint32_t kBlockSize = 48;
+    constexpr uint32_t kAlignment = 32;
+    UntypedSlabAllocator allocator(3, kBlockSize, kAlignment);
+
+    std::vector<char*> blocks;
+    for (int i = 0; i < 10; ++i) {
+        char* block = static_cast<char*>(allocator.Allocate());
+        EXPECT_TRUE(IsPtrAligned(block, kAlignment));
+        memset(block, i, kBlockSize);
+        blocks.push_back(block);
+    }
+    EXPECT_EQ(allocator.GetBlocksInUse(), 10u);
+
+    // Check that the blocks didn't overlap.
+    for (int i = 0; i < 10; ++i) {
+        for (uint32_t j = 0; j < kBlockSize; ++j) {
+            EXPECT_EQ(blocks[i][j], static_cast<char>(i));
+        }
+        allocator.Deallocate(blocks[i]);
+    }
+    EXPECT_EQ(allocator.GetBlocksInUse(), 0u);
+}
@@ -0,0 +1,168 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/TLSFAllocator.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace dawn_native;
+
+constexpr uint64_t TLSFAllocator::kInvalidOffset;
+
+// Verify that a single allocation uses exactly the size requested.
+TEST(TLSFAllocatorTests, SingleBlock) {
+    constexpr uint64_t poolSize = 1024;
+    TLSFAllocator allocator(poolSize, poolSize);
+
+    // Cannot allocate more than the pool size or nothing.
+    ASSERT_EQ(allocator.Allocate(poolSize * 2), TLSFAllocator::kInvalidOffset);
+    ASSERT_EQ(allocator.Allocate(0), TLSFAllocator::kInvalidOffset);
+
+    // Allocate a size that is not a power-of-two: the rest of the pool stays free.
+    ASSERT_EQ(allocator.Allocate(100), 0u);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 1u);
+    ASSERT_EQ(allocator.Allocate(poolSize - 100), 100u);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 0u);
+
+    // The pool is full.
+    ASSERT_EQ(allocator.Allocate(1), TLSFAllocator::kInvalidOffset);
+
+    allocator.Deallocate(0);
+    allocator.Deallocate(100);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 1u);
+
+    // The blocks were merged back so the whole pool can be allocated.
+    ASSERT_EQ(allocator.Allocate(poolSize), 0u);
+}
+
+// Verify that freed blocks are merged with their free neighbors.
+TEST(TLSFAllocatorTests, MergeFreeBlocks) {
+    constexpr uint64_t poolSize = 1024;
+    TLSFAllocator allocator(poolSize, poolSize);
+
+    std::vector<uint64_t> offsets;
+    for (uint64_t i = 0; i < 8; i++) {
+        offsets.push_back(allocator.Allocate(128));
+        ASSERT_EQ(offsets.back(), i * 128);
+    }
+
+    // Free every other block: none of them can be merged.
+    for (uint64_t i = 0; i < 8; i += 2) {
+        allocator.Deallocate(offsets[i]);
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 4u);
+    ASSERT_EQ(allocator.Allocate(256), TLSFAllocator::kInvalidOffset);
+
+    // Free block 1, which merges with blocks 0 and 2.
+    allocator.Deallocate(offsets[1]);
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 3u);
+    ASSERT_EQ(allocator.Allocate(384), 0u);
+}
+
+// Verify that allocations respect the requested alignment and that the padding is reusable.
+TEST(TLSFAllocatorTests, Alignment) {
+    constexpr uint64_t poolSize = 1024;
+    TLSFAllocator allocator(poolSize, poolSize);
+
+    ASSERT_EQ(allocator.Allocate(10), 0u);
+    ASSERT_EQ(allocator.Allocate(64, 256), 256u);
+
+    // The padding between the two allocations is free and can be reused.
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 2u);
+    ASSERT_EQ(allocator.Allocate(200), 10u);
+
+    // Cannot align more than the pool size.
+    ASSERT_EQ(allocator.Allocate(1, poolSize * 2), TLSFAllocator::kInvalidOffset);
+}
+
+// Verify that pools are added on demand and that allocations don't straddle pools.
+TEST(TLSFAllocatorTests, MultiplePools) {
+    constexpr uint64_t poolSize = 256;
+    constexpr uint64_t maxSize = poolSize * 4;
+    TLSFAllocator allocator(maxSize, poolSize);
+
+    // Each allocation takes more than half a pool so they are all in a different pool.
+    std::vector<uint64_t> offsets;
+    for (uint64_t i = 0; i < 4; i++) {
+        offsets.push_back(allocator.Allocate(200));
+        ASSERT_EQ(offsets.back(), i * poolSize);
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 4u);
+    ASSERT_EQ(allocator.Allocate(200), TLSFAllocator::kInvalidOffset);
+
+    // The rest of the pools can still be used.
+    for (uint64_t i = 0; i < 4; i++) {
+        ASSERT_EQ(allocator.Allocate(56) % poolSize, 200u);
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 0u);
+
+    // A freed pool can be fully reused.
+    allocator.Deallocate(2 * poolSize);
+    allocator.Deallocate(2 * poolSize + 200);
+    ASSERT_EQ(allocator.Allocate(poolSize), 2 * poolSize);
+}
+
+// Verify that random allocations and deallocations never overlap and that the allocator goes back
+// to its initial state once everything is freed.
+TEST(TLSFAllocatorTests, RandomAllocations) {
+    constexpr uint64_t poolSize = 1 << 20;
+    constexpr uint64_t maxSize = poolSize * 16;
+    TLSFAllocator allocator(maxSize, poolSize);
+
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<uint64_t> sizeDistribution(1, poolSize / 64);
+    std::uniform_int_distribution<uint32_t> alignmentLog2Distribution(0, 12);
+
+    struct Allocation {
+        uint64_t offset;
+        uint64_t size;
+    };
+    std::vector<Allocation> allocations;
+    for (uint32_t i = 0; i < 2000; i++) {
+        if (!allocations.empty() && generator() % 3 == 0) {
+            size_t index = generator() % allocations.size();
+            allocator.Deallocate(allocations[index].offset);
+            allocations.erase(allocations.begin() + index);
+            continue;
+        }
+
+        uint64_t size = sizeDistribution(generator);
+        uint64_t alignment = uint64_t(1) << alignmentLog2Distribution(generator);
+        uint64_t offset = allocator.Allocate(size, alignment);
+        ASSERT_NE(offset, TLSFAllocator::kInvalidOffset);
+        ASSERT_EQ(offset % alignment, 0u);
+        ASSERT_EQ(offset / poolSize, (offset + size - 1) / poolSize);
+        allocations.push_back({offset, size});
+    }
+
+    std::sort(allocations.begin(), allocations.end(),
+              [](const Allocation& a, const Allocation& b) { return a.offset < b.offset; });
+    for (size_t i = 1; i < allocations.size(); i++) {
+        ASSERT_LE(allocations[i - 1].offset + allocations[i - 1].size, allocations[i].offset);
+    }
+
+    for (const Allocation& allocation : allocations) {
+        allocator.Deallocate(allocation.offset);
+    }
+    // There is one free block for each pool that was used, and they are all whole pools.
+    uint64_t freeBlockCount = allocator.ComputeTotalNumOfFreeBlocksForTesting();
+    for (uint64_t i = 0; i < freeBlockCount; i++) {
+        ASSERT_EQ(allocator.Allocate(poolSize) % poolSize, 0u);
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfFreeBlocksForTesting(), 0u);
+}
@@ -0,0 +1,193 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/PooledResourceMemoryAllocator.h"
+#include "dawn_native/ResourceHeapAllocator.h"
+#include "dawn_native/TLSFMemoryAllocator.h"
+
+#include <set>
+#include <vector>
+
+using namespace dawn_native;
+
+namespace {
+
+    class TLSFDummyResourceHeapAllocator : public ResourceHeapAllocator {
+      public:
+        ResultOrError<std::unique_ptr<ResourceHeapBase>> AllocateResourceHeap(
+            uint64_t size) override {
+            if (mFailNextAllocation) {
+                mFailNextAllocation = false;
+                return DAWN_OUT_OF_MEMORY_ERROR("Dummy out of memory");
+            }
+            return std::make_unique<ResourceHeapBase>();
+        }
+        void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
+        }
+
+        void FailNextAllocation() {
+            mFailNextAllocation = true;
+        }
+
+      private:
+        bool mFailNextAllocation = false;
+    };
+
+    class DummyTLSFResourceAllocator {
+      public:
+        DummyTLSFResourceAllocator(uint64_t maxSystemSize,
+                                   uint64_t memorySize,
+                                   ResourceHeapAllocator* heapAllocator)
+            : mAllocator(maxSystemSize, memorySize, heapAllocator) {
+        }
+
+        ResourceMemoryAllocation Allocate(uint64_t allocationSize, uint64_t alignment = 1) {
+            ResultOrError<ResourceMemoryAllocation> result =
+                mAllocator.Allocate(allocationSize, alignment);
+            return (result.IsSuccess()) ? result.AcquireSuccess() : ResourceMemoryAllocation{};
+        }
+
+        void Deallocate(ResourceMemoryAllocation& allocation) {
+            mAllocator.Deallocate(allocation);
+        }
+
+        uint64_t ComputeTotalNumOfHeapsForTesting() const {
+            return mAllocator.ComputeTotalNumOfHeapsForTesting();
+        }
+
+      private:
+        TLSFMemoryAllocator mAllocator;
+    };
+
+}  // anonymous namespace
+
+// Verify that allocations that aren't a power-of-two are packed in a single heap.
+TEST(TLSFMemoryAllocatorTests, PacksArbitrarySizes) {
+    constexpr uint64_t heapSize = 1024;
+    constexpr uint64_t maxSystemSize = heapSize * 4;
+    TLSFDummyResourceHeapAllocator heapAllocator;
+    DummyTLSFResourceAllocator allocator(maxSystemSize, heapSize, &heapAllocator);
+
+    // Cannot allocate greater than heap size.
+    ResourceMemoryAllocation invalidAllocation = allocator.Allocate(heapSize * 2);
+    ASSERT_EQ(invalidAllocation.GetInfo().mMethod, AllocationMethod::kInvalid);
+
+    // Three allocations of 300 bytes would need 1536 bytes in a buddy system, so two heaps.
+    std::vector<ResourceMemoryAllocation> allocations;
+    for (uint32_t i = 0; i < 3; i++) {
+        ResourceMemoryAllocation allocation = allocator.Allocate(300);
+        ASSERT_EQ(allocation.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+        ASSERT_EQ(allocation.GetOffset(), i * 300);
+        allocations.push_back(std::move(allocation));
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+    ASSERT_EQ(allocations[0].GetResourceHeap(), allocations[2].GetResourceHeap());
+
+    // The next allocation doesn't fit in the first heap anymore.
+    ResourceMemoryAllocation allocation = allocator.Allocate(300);
+    ASSERT_EQ(allocation.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+    ASSERT_EQ(allocation.GetOffset(), 0u);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 2u);
+
+    allocator.Deallocate(allocation);
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 1u);
+    for (ResourceMemoryAllocation& a : allocations) {
+        allocator.Deallocate(a);
+    }
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+}
+
+// Verify that the offset in the heap respects the alignment.
+TEST(TLSFMemoryAllocatorTests, Alignment) {
+    constexpr uint64_t heapSize = 1024;
+    constexpr uint64_t maxSystemSize = heapSize * 4;
+    TLSFDummyResourceHeapAllocator heapAllocator;
+    DummyTLSFResourceAllocator allocator(maxSystemSize, heapSize, &heapAllocator);
+
+    ResourceMemoryAllocation allocation1 = allocator.Allocate(10);
+    ResourceMemoryAllocation allocation2 = allocator.Allocate(100, 256);
+    ASSERT_EQ(allocation1.GetOffset(), 0u);
+    ASSERT_EQ(allocation2.GetOffset(), 256u);
+    ASSERT_EQ(allocation1.GetResourceHeap(), allocation2.GetResourceHeap());
+
+    allocator.Deallocate(allocation1);
+    allocator.Deallocate(allocation2);
+}
+
+// Verify that a failure to create a heap is returned and leaves the allocator usable.
+TEST(TLSFMemoryAllocatorTests, HeapAllocationFailure) {
+    constexpr uint64_t heapSize = 1024;
+    constexpr uint64_t maxSystemSize = heapSize * 4;
+    TLSFDummyResourceHeapAllocator heapAllocator;
+    TLSFMemoryAllocator allocator(maxSystemSize, heapSize, &heapAllocator);
+
+    heapAllocator.FailNextAllocation();
+    ResultOrError<ResourceMemoryAllocation> result = allocator.Allocate(heapSize, 1);
+    ASSERT_TRUE(result.IsError());
+    result.AcquireError();
+    ASSERT_EQ(allocator.ComputeTotalNumOfHeapsForTesting(), 0u);
+
+    // The space that was allocated for the failed allocation was returned.
+    for (uint32_t i = 0; i < maxSystemSize / heapSize; i++) {
+        ResultOrError<ResourceMemoryAllocation> allocation = allocator.Allocate(heapSize, 1);
+        ASSERT_TRUE(allocation.IsSuccess());
+        ASSERT_EQ(allocation.AcquireSuccess().GetInfo().mMethod,
+                  AllocationMethod::kSubAllocated);
+    }
+}
+
+// Verify resource heaps will be reused from a pool.
+TEST(TLSFMemoryAllocatorTests, ReuseFreedHeaps) {
+    constexpr uint64_t kHeapSize = 128;
+    constexpr uint64_t kMaxSystemSize = 4096;
+
+    TLSFDummyResourceHeapAllocator heapAllocator;
+    PooledResourceMemoryAllocator poolAllocator(&heapAllocator);
+    DummyTLSFResourceAllocator allocator(kMaxSystemSize, kHeapSize, &poolAllocator);
+
+    std::set<ResourceHeapBase*> heaps = {};
+    std::vector<ResourceMemoryAllocation> allocations = {};
+
+    constexpr uint32_t kNumOfAllocations = 100;
+
+    // Allocate |kNumOfAllocations|.
+    for (uint32_t i = 0; i < kNumOfAllocations; i++) {
+        ResourceMemoryAllocation allocation = allocator.Allocate(5);
+        ASSERT_EQ(allocation.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+        heaps.insert(allocation.GetResourceHeap());
+        allocations.push_back(std::move(allocation));
+    }
+
+    // 25 allocations of 5 bytes fit in each heap of 128 bytes.
+    ASSERT_EQ(heaps.size(), 4u);
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 0u);
+
+    // Return the allocations to the pool.
+    for (ResourceMemoryAllocation& allocation : allocations) {
+        allocator.Deallocate(allocation);
+    }
+
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), heaps.size());
+
+    // Allocate again reusing the same heaps.
+    for (uint32_t i = 0; i < kNumOfAllocations; i++) {
+        ResourceMemoryAllocation allocation = allocator.Allocate(5);
+        ASSERT_EQ(allocation.GetInfo().mMethod, AllocationMethod::kSubAllocated);
+        ASSERT_FALSE(heaps.insert(allocation.GetResourceHeap()).second);
+    }
+
+    ASSERT_EQ(poolAllocator.GetPoolSizeForTesting(), 0u);
+}
@@ -0,0 +1,169 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/ComboRenderBundleEncoderDescriptor.h"
+#include "utils/WGPUHelpers.h"
+
+#include <cstring>
+
+class DeviceStatisticsTest : public ValidationTest {
+  protected:
+    dawn_native::DeviceStatistics GetStatistics() {
+        FlushWire();
+        return dawn_native::GetDeviceStatistics(backendDevice);
+    }
+
+    static uint64_t GetObjectsAlive(const dawn_native::DeviceStatistics& statistics,
+                                    const char* type) {
+        for (const auto& entry : statistics.objectsAlive) {
+            if (strcmp(entry.first, type) == 0) {
+                return entry.second;
+            }
+        }
+        ADD_FAILURE() << "Unknown object type " << type;
+        return 0;
+    }
+};
+
+// Test that creating the same cached object twice is counted as one miss and one hit.
+TEST_F(DeviceStatisticsTest, CacheHitsAndMisses) {
+    dawn_native::DeviceStatistics before = GetStatistics();
+
+    wgpu::SamplerDescriptor descriptor;
+    descriptor.lodMaxClamp = 12.0f;
+    wgpu::Sampler sampler1 = device.CreateSampler(&descriptor);
+    dawn_native::DeviceStatistics afterFirst = GetStatistics();
+    EXPECT_EQ(afterFirst.samplerCache.misses, before.samplerCache.misses + 1);
+    EXPECT_EQ(afterFirst.samplerCache.hits, before.samplerCache.hits);
+
+    wgpu::Sampler sampler2 = device.CreateSampler(&descriptor);
+    dawn_native::DeviceStatistics afterSecond = GetStatistics();
+    EXPECT_EQ(afterSecond.samplerCache.misses, afterFirst.samplerCache.misses);
+    EXPECT_EQ(afterSecond.samplerCache.hits, afterFirst.samplerCache.hits + 1);
+}
+
+// Test that the objects returned to the application are counted while they are alive, and that
+// an object returned twice is counted once.
+TEST_F(DeviceStatisticsTest, ObjectsAlive) {
+    uint64_t buffersBefore = GetObjectsAlive(GetStatistics(), "Buffer");
+    uint64_t layoutsBefore = GetObjectsAlive(GetStatistics(), "BindGroupLayout");
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::Uniform;
+    wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+    EXPECT_EQ(GetObjectsAlive(GetStatistics(), "Buffer"), buffersBefore + 1);
+
+    // Cached objects are deduplicated so they are the same object on the native side.
+    wgpu::BindGroupLayout layout1 = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform}});
+    wgpu::BindGroupLayout layout2 = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::BufferBindingType::Uniform}});
+    EXPECT_EQ(GetObjectsAlive(GetStatistics(), "BindGroupLayout"), layoutsBefore + 1);
+
+    buffer = nullptr;
+    layout1 = nullptr;
+    layout2 = nullptr;
+    dawn_native::DeviceStatistics after = GetStatistics();
+    EXPECT_EQ(GetObjectsAlive(after, "Buffer"), buffersBefore);
+    EXPECT_EQ(GetObjectsAlive(after, "BindGroupLayout"), layoutsBefore);
+}
+
+// Test that the encoded commands and the data written with WriteBuffer are counted.
+TEST_F(DeviceStatisticsTest, EncodingAndUploads) {
+    dawn_native::DeviceStatistics before = GetStatistics();
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 16;
+    descriptor.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer source = device.CreateBuffer(&descriptor);
+    wgpu::Buffer destination = device.CreateBuffer(&descriptor);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(source, 0, destination, 0, 16);
+    encoder.CopyBufferToBuffer(destination, 0, source, 0, 16);
+    wgpu::CommandBuffer commands = encoder.Finish();
+
+    uint32_t data[4] = {};
+    device.GetQueue().WriteBuffer(destination, 0, data, sizeof(data));
+
+    dawn_native::DeviceStatistics after = GetStatistics();
+    EXPECT_GE(after.commandsEncoded, before.commandsEncoded + 2);
+    EXPECT_GT(after.commandAllocatorBlocks, before.commandAllocatorBlocks);
+    EXPECT_GT(after.commandAllocatorBytes, before.commandAllocatorBytes);
+    EXPECT_GE(after.dynamicUploaderBytes, before.dynamicUploaderBytes + sizeof(data));
+}
+
+// Test that shader module creation accounts time spent in Tint.
+TEST_F(DeviceStatisticsTest, TintCompileTime) {
+    dawn_native::DeviceStatistics before = GetStatistics();
+
+    utils::CreateShaderModule(device, R"(
+        [[stage(compute), workgroup_size(1)]] fn main() {
+        })");
+
+    dawn_native::DeviceStatistics after = GetStatistics();
+    EXPECT_GT(after.tintCompileTimeNs, before.tintCompileTimeNs);
+    EXPECT_EQ(after.shaderModuleCache.misses, before.shaderModuleCache.misses + 1);
+}
+
+// Test that buffers are allocated from the device's object pool.
+TEST_F(DeviceStatisticsTest, ObjectPool) {
+    dawn_native::DeviceStatistics before = GetStatistics();
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::Uniform;
+    wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+
+    dawn_native::DeviceStatistics after = GetStatistics();
+    EXPECT_EQ(after.pooledObjects, before.pooledObjects + 1);
+    EXPECT_GT(after.objectPoolReservedBytes, 0u);
+
+    buffer = nullptr;
+    EXPECT_EQ(GetStatistics().pooledObjects, before.pooledObjects);
+}
+
+// Test that command buffers release their commands when they are submitted, even if they are
+// still referenced, and that render bundles hold their commands until they are released.
+TEST_F(DeviceStatisticsTest, CommandBytesInUse) {
+    uint64_t bytesBefore = GetStatistics().commandBytesInUse;
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 16;
+    descriptor.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer source = device.CreateBuffer(&descriptor);
+    wgpu::Buffer destination = device.CreateBuffer(&descriptor);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(source, 0, destination, 0, 16);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    EXPECT_GT(GetStatistics().commandBytesInUse, bytesBefore);
+
+    device.GetQueue().Submit(1, &commands);
+    EXPECT_EQ(GetStatistics().commandBytesInUse, bytesBefore);
+
+    utils::ComboRenderBundleEncoderDescriptor bundleDesc = {};
+    bundleDesc.colorFormatsCount = 1;
+    bundleDesc.cColorFormats[0] = wgpu::TextureFormat::RGBA8Unorm;
+    wgpu::RenderBundleEncoder bundleEncoder = device.CreateRenderBundleEncoder(&bundleDesc);
+    bundleEncoder.InsertDebugMarker("marker");
+    wgpu::RenderBundle bundle = bundleEncoder.Finish();
+    EXPECT_GT(GetStatistics().commandBytesInUse, bytesBefore);
+
+    bundle = nullptr;
+    EXPECT_EQ(GetStatistics().commandBytesInUse, bytesBefore);
+}
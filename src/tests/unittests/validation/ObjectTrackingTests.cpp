@@ -0,0 +1,124 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "dawn_native/Device.h"
+#include "dawn_native/Texture.h"
+#include "utils/WGPUHelpers.h"
+
+#include <thread>
+#include <vector>
+
+class ObjectTrackingTest : public ValidationTest {
+  protected:
+    dawn_native::DeviceBase* GetDeviceBase() {
+        return reinterpret_cast<dawn_native::DeviceBase*>(backendDevice);
+    }
+
+    // Returns the number of live objects of |type| tracked by the device.
+    size_t CountTrackedObjects(dawn_native::ObjectType type) {
+        FlushWire();
+        size_t count = 0;
+        GetDeviceBase()->GetApiObjectList()->ForEach([&](dawn_native::ApiObjectBase* object) {
+            if (object->GetType() == type) {
+                count++;
+            }
+        });
+        return count;
+    }
+};
+
+// Test that objects are tracked by the device while they are alive, including error objects.
+TEST_F(ObjectTrackingTest, TrackedWhileAlive) {
+    size_t buffersBefore = CountTrackedObjects(dawn_native::ObjectType::Buffer);
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::Uniform;
+    wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+    EXPECT_EQ(CountTrackedObjects(dawn_native::ObjectType::Buffer), buffersBefore + 1);
+
+    descriptor.usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::MapWrite;
+    wgpu::Buffer errorBuffer;
+    ASSERT_DEVICE_ERROR(errorBuffer = device.CreateBuffer(&descriptor));
+    EXPECT_EQ(CountTrackedObjects(dawn_native::ObjectType::Buffer), buffersBefore + 2);
+
+    buffer = nullptr;
+    errorBuffer = nullptr;
+    EXPECT_EQ(CountTrackedObjects(dawn_native::ObjectType::Buffer), buffersBefore);
+}
+
+// Test that the blueprints used to look up cached objects aren't left in the device's list. This
+// is a regression test for blueprints on the stack staying linked after they are destroyed.
+TEST_F(ObjectTrackingTest, CachedObjects) {
+    size_t samplersBefore = CountTrackedObjects(dawn_native::ObjectType::Sampler);
+    size_t layoutsBefore = CountTrackedObjects(dawn_native::ObjectType::BindGroupLayout);
+
+    wgpu::Sampler sampler1 = device.CreateSampler();
+    wgpu::Sampler sampler2 = device.CreateSampler();
+    wgpu::BindGroupLayout layout1 = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::SamplerBindingType::Filtering}});
+    wgpu::BindGroupLayout layout2 = utils::MakeBindGroupLayout(
+        device, {{0, wgpu::ShaderStage::Fragment, wgpu::SamplerBindingType::Filtering}});
+    EXPECT_EQ(CountTrackedObjects(dawn_native::ObjectType::Sampler), samplersBefore + 1);
+    EXPECT_EQ(CountTrackedObjects(dawn_native::ObjectType::BindGroupLayout), layoutsBefore + 1);
+
+    sampler1 = nullptr;
+    sampler2 = nullptr;
+    layout1 = nullptr;
+    layout2 = nullptr;
+    EXPECT_EQ(CountTrackedObjects(dawn_native::ObjectType::Sampler), samplersBefore);
+    EXPECT_EQ(CountTrackedObjects(dawn_native::ObjectType::BindGroupLayout), layoutsBefore);
+}
+
+// Test that objects created and released on multiple threads are all tracked and untracked.
+TEST_F(ObjectTrackingTest, MultipleThreads) {
+    size_t viewsBefore = CountTrackedObjects(dawn_native::ObjectType::TextureView);
+
+    // Use the native objects directly since the wire client isn't thread-safe.
+    dawn_native::TextureDescriptor descriptor;
+    descriptor.size = {4, 4, 1};
+    descriptor.format = wgpu::TextureFormat::RGBA8Unorm;
+    descriptor.usage = wgpu::TextureUsage::TextureBinding;
+    Ref<dawn_native::TextureBase> texture =
+        AcquireRef(GetDeviceBase()->APICreateTexture(&descriptor));
+
+    constexpr uint32_t kThreadCount = 8;
+    constexpr uint32_t kViewsPerThread = 100;
+    std::vector<std::vector<Ref<dawn_native::TextureViewBase>>> views(kThreadCount);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint32_t i = 0; i < kViewsPerThread; ++i) {
+                views[t].push_back(AcquireRef(texture->APICreateView(nullptr)));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(CountTrackedObjects(dawn_native::ObjectType::TextureView),
+              viewsBefore + kThreadCount * kViewsPerThread);
+
+    // Release the views on other threads than the ones that created them.
+    threads.clear();
+    for (uint32_t t = 0; t < kThreadCount; ++t) {
+        threads.emplace_back([&, t]() { views[(t + 1) % kThreadCount].clear(); });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(CountTrackedObjects(dawn_native::ObjectType::TextureView), viewsBefore);
+}
@@ -0,0 +1,215 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "dawn_native/Commands.h"
+#include "dawn_native/RenderBundle.h"
+#include "utils/ComboRenderBundleEncoderDescriptor.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/WGPUHelpers.h"
+
+#include <vector>
+
+using dawn_native::Command;
+
+// Tests for the form render bundles commands are stored in for replay, which has the redundant
+// state commands removed.
+class RenderBundleReplayTest : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+
+        // These tests look at the commands of the dawn_native::RenderBundleBase backing the
+        // bundle, which is not the case on the wire.
+        DAWN_SKIP_TEST_IF(UsesWire());
+
+        wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Vertex, wgpu::BufferBindingType::Uniform}});
+
+        utils::ComboRenderPipelineDescriptor descriptor;
+        descriptor.layout = utils::MakeBasicPipelineLayout(device, &bgl);
+        descriptor.vertex.module = utils::CreateShaderModule(device, R"(
+            [[block]] struct S {
+                transform : mat2x2<f32>;
+            };
+            [[group(0), binding(0)]] var<uniform> uniforms : S;
+
+            [[stage(vertex)]] fn main([[location(0)]] pos : vec2<f32>) -> [[builtin(position)]] vec4<f32> {
+                return vec4<f32>(uniforms.transform * pos, 0.0, 1.0);
+            })");
+        descriptor.cFragment.module = utils::CreateShaderModule(device, R"(
+            [[stage(fragment)]] fn main() -> [[location(0)]] vec4<f32> {
+                return vec4<f32>(0.0, 1.0, 0.0, 1.0);
+            })");
+        descriptor.vertex.bufferCount = 1;
+        descriptor.cBuffers[0].arrayStride = 2 * sizeof(float);
+        descriptor.cBuffers[0].attributeCount = 1;
+        descriptor.cAttributes[0].format = wgpu::VertexFormat::Float32x2;
+        descriptor.cAttributes[0].shaderLocation = 0;
+        pipeline = device.CreateRenderPipeline(&descriptor);
+
+        wgpu::BufferDescriptor bufferDesc;
+        bufferDesc.size = 256;
+        bufferDesc.usage = wgpu::BufferUsage::Uniform;
+        wgpu::Buffer uniformBuffer = device.CreateBuffer(&bufferDesc);
+        bindGroup = utils::MakeBindGroup(device, bgl, {{0, uniformBuffer, 0, 16}});
+
+        bufferDesc.usage = wgpu::BufferUsage::Vertex;
+        vertexBuffer = device.CreateBuffer(&bufferDesc);
+    }
+
+    wgpu::RenderBundleEncoder CreateRenderBundleEncoder() {
+        utils::ComboRenderBundleEncoderDescriptor desc = {};
+        desc.colorFormatsCount = 1;
+        desc.cColorFormats[0] = wgpu::TextureFormat::RGBA8Unorm;
+        return device.CreateRenderBundleEncoder(&desc);
+    }
+
+    // Returns the commands stored in the bundle for replay.
+    std::vector<Command> GetReplayedCommands(const wgpu::RenderBundle& bundle) {
+        dawn_native::CommandIterator* commands =
+            reinterpret_cast<dawn_native::RenderBundleBase*>(bundle.Get())->GetCommands();
+
+        std::vector<Command> result;
+        Command type;
+        while (commands->NextCommandId(&type)) {
+            result.push_back(type);
+            switch (type) {
+                case Command::SetRenderPipeline:
+                    commands->NextCommand<dawn_native::SetRenderPipelineCmd>();
+                    break;
+                case Command::SetBindGroup: {
+                    dawn_native::SetBindGroupCmd* cmd =
+                        commands->NextCommand<dawn_native::SetBindGroupCmd>();
+                    if (cmd->dynamicOffsetCount > 0) {
+                        commands->NextData<uint32_t>(cmd->dynamicOffsetCount);
+                    }
+                    break;
+                }
+                case Command::SetIndexBuffer:
+                    commands->NextCommand<dawn_native::SetIndexBufferCmd>();
+                    break;
+                case Command::SetVertexBuffer: {
+                    dawn_native::SetVertexBufferCmd* cmd =
+                        commands->NextCommand<dawn_native::SetVertexBufferCmd>();
+                    lastVertexBufferOffset = cmd->offset;
+                    break;
+                }
+                case Command::Draw:
+                    commands->NextCommand<dawn_native::DrawCmd>();
+                    break;
+                case Command::DrawIndexed:
+                    commands->NextCommand<dawn_native::DrawIndexedCmd>();
+                    break;
+                case Command::InsertDebugMarker: {
+                    dawn_native::InsertDebugMarkerCmd* cmd =
+                        commands->NextCommand<dawn_native::InsertDebugMarkerCmd>();
+                    commands->NextData<char>(cmd->length + 1);
+                    break;
+                }
+                case Command::PushDebugGroup: {
+                    dawn_native::PushDebugGroupCmd* cmd =
+                        commands->NextCommand<dawn_native::PushDebugGroupCmd>();
+                    commands->NextData<char>(cmd->length + 1);
+                    break;
+                }
+                case Command::PopDebugGroup:
+                    commands->NextCommand<dawn_native::PopDebugGroupCmd>();
+                    break;
+                default:
+                    ADD_FAILURE() << "Unexpected command in the bundle";
+                    return result;
+            }
+        }
+        return result;
+    }
+
+    wgpu::RenderPipeline pipeline;
+    wgpu::BindGroup bindGroup;
+    wgpu::Buffer vertexBuffer;
+    uint64_t lastVertexBufferOffset = 0;
+};
+
+// Test that state set again to the same value between draws is not replayed.
+TEST_F(RenderBundleReplayTest, RedundantStateIsRemoved) {
+    wgpu::RenderBundleEncoder encoder = CreateRenderBundleEncoder();
+    for (uint32_t i = 0; i < 3; ++i) {
+        encoder.SetPipeline(pipeline);
+        encoder.SetBindGroup(0, bindGroup);
+        encoder.SetVertexBuffer(0, vertexBuffer);
+        encoder.Draw(3);
+    }
+    wgpu::RenderBundle bundle = encoder.Finish();
+
+    std::vector<Command> expected = {Command::SetRenderPipeline, Command::SetBindGroup,
+                                     Command::SetVertexBuffer,   Command::Draw,
+                                     Command::Draw,              Command::Draw};
+    EXPECT_EQ(GetReplayedCommands(bundle), expected);
+}
+
+// Test that state that changes between draws is replayed.
+TEST_F(RenderBundleReplayTest, ChangedStateIsKept) {
+    wgpu::RenderBundleEncoder encoder = CreateRenderBundleEncoder();
+    encoder.SetPipeline(pipeline);
+    encoder.SetBindGroup(0, bindGroup);
+    encoder.SetVertexBuffer(0, vertexBuffer);
+    encoder.Draw(3);
+    encoder.SetVertexBuffer(0, vertexBuffer, 64);
+    encoder.SetBindGroup(0, bindGroup);
+    encoder.Draw(3);
+    wgpu::RenderBundle bundle = encoder.Finish();
+
+    std::vector<Command> expected = {Command::SetRenderPipeline, Command::SetBindGroup,
+                                     Command::SetVertexBuffer,   Command::Draw,
+                                     Command::SetVertexBuffer,   Command::Draw};
+    EXPECT_EQ(GetReplayedCommands(bundle), expected);
+    EXPECT_EQ(lastVertexBufferOffset, 64u);
+}
+
+// Test that state that is overwritten before a draw, or never drawn with, is not replayed.
+TEST_F(RenderBundleReplayTest, UnusedStateIsRemoved) {
+    wgpu::RenderBundleEncoder encoder = CreateRenderBundleEncoder();
+    encoder.SetPipeline(pipeline);
+    encoder.SetVertexBuffer(0, vertexBuffer, 32);
+    encoder.SetBindGroup(0, bindGroup);
+    encoder.SetVertexBuffer(0, vertexBuffer, 128);
+    encoder.Draw(3);
+    encoder.SetVertexBuffer(0, vertexBuffer, 0);
+    encoder.SetPipeline(pipeline);
+    wgpu::RenderBundle bundle = encoder.Finish();
+
+    std::vector<Command> expected = {Command::SetRenderPipeline, Command::SetBindGroup,
+                                     Command::SetVertexBuffer, Command::Draw};
+    EXPECT_EQ(GetReplayedCommands(bundle), expected);
+    EXPECT_EQ(lastVertexBufferOffset, 128u);
+}
+
+// Test that debug markers are replayed in order with the draws.
+TEST_F(RenderBundleReplayTest, DebugMarkersAreKept) {
+    wgpu::RenderBundleEncoder encoder = CreateRenderBundleEncoder();
+    encoder.PushDebugGroup("Group");
+    encoder.SetPipeline(pipeline);
+    encoder.SetBindGroup(0, bindGroup);
+    encoder.SetVertexBuffer(0, vertexBuffer);
+    encoder.InsertDebugMarker("Marker");
+    encoder.Draw(3);
+    encoder.PopDebugGroup();
+    wgpu::RenderBundle bundle = encoder.Finish();
+
+    std::vector<Command> expected = {Command::PushDebugGroup,   Command::InsertDebugMarker,
+                                     Command::SetRenderPipeline, Command::SetBindGroup,
+                                     Command::SetVertexBuffer,  Command::Draw,
+                                     Command::PopDebugGroup};
+    EXPECT_EQ(GetReplayedCommands(bundle), expected);
+}
@@ -21,6 +21,8 @@
 #include "utils/WGPUHelpers.h"
 
 #include <sstream>
+#include <thread>
+#include <vector>
 
 class ShaderModuleValidationTest : public ValidationTest {};
 
@@ -213,6 +215,152 @@ TEST_F(ShaderModuleValidationTest, GetCompilationMessages) {
     shaderModule.GetCompilationInfo(callback, nullptr);
 }
 
+// Tests that the bounds checks are skipped for the index accesses that are statically in bounds,
+// and that it is reported in the compilation messages.
+TEST_F(ShaderModuleValidationTest, BoundsChecksElidedForStaticIndices) {
+    // This test works assuming ShaderModule is backed by a dawn_native::ShaderModuleBase, which
+    // is not the case on the wire.
+    DAWN_SKIP_TEST_IF(UsesWire());
+
+    wgpu::ShaderModule shaderModule = utils::CreateShaderModule(device, R"(
+        var<private> values : array<f32, 4>;
+
+        [[stage(compute), workgroup_size(1)]] fn main() {
+            for (var i : i32 = 0; i < 4; i = i + 1) {
+                values[i] = f32(i);
+            }
+            let v = vec4<f32>(1.0, 2.0, 3.0, 4.0);
+            values[3] = v[2];
+        })");
+
+    dawn_native::ShaderModuleBase* shaderModuleBase =
+        reinterpret_cast<dawn_native::ShaderModuleBase*>(shaderModule.Get());
+    dawn_native::BoundsCheckAnalysis analysis =
+        dawn_native::AnalyzeBoundsChecks(shaderModuleBase->GetTintProgram());
+    EXPECT_EQ(3u, analysis.indexAccessCount);
+    EXPECT_EQ(3u, analysis.inBoundsAccesses.size());
+
+    const WGPUCompilationInfo* info =
+        shaderModuleBase->GetCompilationMessages()->GetCompilationInfo();
+    ASSERT_EQ(1u, info->messageCount);
+    EXPECT_EQ(WGPUCompilationMessageType_Info, info->messages[0].type);
+    EXPECT_STREQ("3 of 3 bounds checks elided: the index accesses are statically in bounds.",
+                 info->messages[0].message);
+}
+
+// Tests that the bounds checks are kept for the index accesses that can't be proven to be in
+// bounds, and skipped for the others in the same module.
+TEST_F(ShaderModuleValidationTest, BoundsChecksKeptForDynamicIndices) {
+    // This test works assuming ShaderModule is backed by a dawn_native::ShaderModuleBase, which
+    // is not the case on the wire.
+    DAWN_SKIP_TEST_IF(UsesWire());
+
+    // The loop bound is larger than the array, the counter is written in the loop, and the size
+    // of the runtime-sized array isn't known without a pipeline layout.
+    const char* kShaders[] = {
+        R"(
+        var<private> values : array<f32, 4>;
+
+        [[stage(compute), workgroup_size(1)]] fn main() {
+            for (var i : i32 = 0; i < 5; i = i + 1) {
+                values[i] = 1.0;
+            }
+        })",
+        R"(
+        var<private> values : array<f32, 4>;
+
+        [[stage(compute), workgroup_size(1)]] fn main() {
+            for (var i : i32 = 0; i < 4; i = i + 1) {
+                values[i] = 1.0;
+                i = i + 1;
+            }
+        })",
+        R"(
+        [[block]] struct Data {
+            values : array<f32>;
+        };
+        [[group(0), binding(0)]] var<storage, read_write> data : Data;
+
+        [[stage(compute), workgroup_size(1)]] fn main() {
+            data.values[0] = 1.0;
+        })",
+    };
+
+    for (const char* shader : kShaders) {
+        wgpu::ShaderModule shaderModule = utils::CreateShaderModule(device, shader);
+
+        dawn_native::ShaderModuleBase* shaderModuleBase =
+            reinterpret_cast<dawn_native::ShaderModuleBase*>(shaderModule.Get());
+        dawn_native::BoundsCheckAnalysis analysis =
+            dawn_native::AnalyzeBoundsChecks(shaderModuleBase->GetTintProgram());
+        EXPECT_EQ(1u, analysis.indexAccessCount);
+        EXPECT_TRUE(analysis.inBoundsAccesses.empty());
+
+        const WGPUCompilationInfo* info =
+            shaderModuleBase->GetCompilationMessages()->GetCompilationInfo();
+        EXPECT_EQ(0u, info->messageCount);
+    }
+
+    // Only the access with the dynamic index keeps its bounds check.
+    wgpu::ShaderModule shaderModule = utils::CreateShaderModule(device, R"(
+        var<private> values : array<f32, 4>;
+        var<private> index : i32;
+
+        [[stage(compute), workgroup_size(1)]] fn main() {
+            values[1] = values[index];
+        })");
+
+    dawn_native::ShaderModuleBase* shaderModuleBase =
+        reinterpret_cast<dawn_native::ShaderModuleBase*>(shaderModule.Get());
+    const WGPUCompilationInfo* info =
+        shaderModuleBase->GetCompilationMessages()->GetCompilationInfo();
+    ASSERT_EQ(1u, info->messageCount);
+    EXPECT_STREQ("1 of 2 bounds checks elided: the index accesses are statically in bounds.",
+                 info->messages[0].message);
+}
+
+// Tests that the accesses to runtime-sized arrays are proven to be in bounds with the minimum
+// binding size of the pipeline layout.
+TEST_F(ShaderModuleValidationTest, BoundsChecksElidedWithMinBindingSize) {
+    // This test works assuming ShaderModule is backed by a dawn_native::ShaderModuleBase, which
+    // is not the case on the wire.
+    DAWN_SKIP_TEST_IF(UsesWire());
+
+    wgpu::ShaderModule shaderModule = utils::CreateShaderModule(device, R"(
+        [[block]] struct Data {
+            header : vec4<f32>;
+            values : array<f32>;
+        };
+        [[group(0), binding(0)]] var<storage, read_write> data : Data;
+
+        [[stage(compute), workgroup_size(1)]] fn main() {
+            for (var i : u32 = 0u; i < 8u; i = i + 1u) {
+                data.values[i] = 1.0;
+            }
+        })");
+    dawn_native::ShaderModuleBase* shaderModuleBase =
+        reinterpret_cast<dawn_native::ShaderModuleBase*>(shaderModule.Get());
+
+    // The values start at offset 16, so 8 of them need a binding of at least 48 bytes.
+    for (uint64_t minBindingSize : {44u, 48u}) {
+        wgpu::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+            device, {{0, wgpu::ShaderStage::Compute, wgpu::BufferBindingType::Storage, false,
+                      minBindingSize}});
+        wgpu::PipelineLayout layout = utils::MakeBasicPipelineLayout(device, &bgl);
+
+        dawn_native::MinBufferBindingSizes sizes = dawn_native::GetMinBufferBindingSizes(
+            shaderModuleBase->GetEntryPoint("main"),
+            reinterpret_cast<dawn_native::PipelineLayoutBase*>(layout.Get()));
+        ASSERT_EQ(1u, sizes.size());
+        EXPECT_EQ(minBindingSize, sizes.begin()->second);
+
+        dawn_native::BoundsCheckAnalysis analysis =
+            dawn_native::AnalyzeBoundsChecks(shaderModuleBase->GetTintProgram(), sizes);
+        EXPECT_EQ(1u, analysis.indexAccessCount);
+        EXPECT_EQ(minBindingSize >= 48u ? 1u : 0u, analysis.inBoundsAccesses.size());
+    }
+}
+
 // Validate the maximum location of effective inter-stage variables cannot be greater than 14
 // (kMaxInterStageShaderComponents / 4 - 1).
 TEST_F(ShaderModuleValidationTest, MaximumShaderIOLocations) {
@@ -511,4 +659,91 @@ TEST_F(ShaderModuleValidationTest, OverridableConstantsNumericIDConflicts) {
     buf.data[0] = c0;
     buf.data[1] = c1;
 })"));
-}
\ No newline at end of file
+}
+
+class AsyncShaderModuleValidationTest : public ValidationTest {
+  protected:
+    WGPUDevice CreateTestDevice() override {
+        dawn_native::DeviceDescriptor descriptor;
+        descriptor.forceEnabledToggles.push_back("async_shader_module_creation");
+        return adapter.CreateDevice(&descriptor);
+    }
+
+    wgpu::ComputePipeline CreateComputePipeline(wgpu::ShaderModule module) {
+        wgpu::ComputePipelineDescriptor descriptor;
+        descriptor.compute.module = module;
+        descriptor.compute.entryPoint = "main";
+        return device.CreateComputePipeline(&descriptor);
+    }
+};
+
+// Test that a module created asynchronously can be used to create a pipeline right away.
+TEST_F(AsyncShaderModuleValidationTest, UseRightAfterCreation) {
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        [[stage(compute), workgroup_size(1)]] fn main() {
+        })");
+    CreateComputePipeline(module);
+}
+
+// Test that the errors of a module created asynchronously are reported when creating a pipeline.
+TEST_F(AsyncShaderModuleValidationTest, ErrorReportedAtPipelineCreation) {
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        [[stage(compute), workgroup_size(1)]] fn main() {
+            let a : u32 = 1.0;
+        })");
+    ASSERT_DEVICE_ERROR(CreateComputePipeline(module));
+
+    // The error is reported again each time the module is used.
+    ASSERT_DEVICE_ERROR(CreateComputePipeline(module));
+}
+
+// Test that modules created asynchronously with the same source are deduplicated.
+TEST_F(AsyncShaderModuleValidationTest, Deduplication) {
+    // This test compares the dawn_native::ShaderModuleBase of the modules, which are different
+    // objects on the wire.
+    DAWN_SKIP_TEST_IF(UsesWire());
+
+    const char* kShader = R"(
+        [[stage(compute), workgroup_size(1)]] fn main() {
+        })";
+    wgpu::ShaderModule module1 = utils::CreateShaderModule(device, kShader);
+    wgpu::ShaderModule module2 = utils::CreateShaderModule(device, kShader);
+    EXPECT_EQ(module1.Get(), module2.Get());
+
+    CreateComputePipeline(module2);
+}
+
+class AsyncShaderModuleLoggingValidationTest : public AsyncShaderModuleValidationTest {
+  protected:
+    WGPUDevice CreateTestDevice() override {
+        dawn_native::DeviceDescriptor descriptor;
+        descriptor.forceEnabledToggles.push_back("async_shader_module_creation");
+        descriptor.forceEnabledToggles.push_back("dump_shaders");
+        return adapter.CreateDevice(&descriptor);
+    }
+};
+
+// Test that the logs produced by the initialization of a module created asynchronously are
+// emitted on the device's thread, and not on the worker thread that initialized the module.
+TEST_F(AsyncShaderModuleLoggingValidationTest, LogsEmittedOnDeviceThread) {
+    // The logging callback is called on the client's thread when using the wire.
+    DAWN_SKIP_TEST_IF(UsesWire());
+
+    std::vector<std::thread::id> logThreads;
+    device.SetLoggingCallback(
+        [](WGPULoggingType, const char*, void* userdata) {
+            static_cast<std::vector<std::thread::id>*>(userdata)->push_back(
+                std::this_thread::get_id());
+        },
+        &logThreads);
+
+    wgpu::ShaderModule module = utils::CreateShaderModule(device, R"(
+        [[stage(compute), workgroup_size(1)]] fn main() {
+        })");
+    CreateComputePipeline(module);
+    device.Tick();
+
+    // The WGSL source is dumped once.
+    ASSERT_EQ(logThreads.size(), 1u);
+    EXPECT_EQ(logThreads[0], std::this_thread::get_id());
+}
@@ -14,6 +14,8 @@
 
 #include "tests/unittests/wire/WireTest.h"
 
+#include "dawn_wire/WireClient.h"
+
 using namespace testing;
 using namespace dawn_wire;
 
@@ -78,3 +80,27 @@ TEST_F(WireBasicTests, ReleaseCalledOnRefCount0) {
 
     FlushClient();
 }
+
+// Test that the client counts the commands and bytes it serializes.
+TEST_F(WireBasicTests, ClientStatistics) {
+    WireStatistics before = GetWireClient()->GetStatistics();
+
+    wgpuDeviceCreateCommandEncoder(device, nullptr);
+    WireStatistics afterOne = GetWireClient()->GetStatistics();
+    EXPECT_EQ(afterOne.commandsSerialized, before.commandsSerialized + 1);
+    EXPECT_GT(afterOne.bytesSerialized, before.bytesSerialized);
+
+    wgpuDeviceCreateCommandEncoder(device, nullptr);
+    WireStatistics afterTwo = GetWireClient()->GetStatistics();
+    EXPECT_EQ(afterTwo.commandsSerialized, before.commandsSerialized + 2);
+    EXPECT_EQ(afterTwo.bytesSerialized - afterOne.bytesSerialized,
+              afterOne.bytesSerialized - before.bytesSerialized);
+
+    WGPUCommandEncoder apiEncoder1 = api.GetNewCommandEncoder();
+    WGPUCommandEncoder apiEncoder2 = api.GetNewCommandEncoder();
+    EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+        .WillOnce(Return(apiEncoder1))
+        .WillOnce(Return(apiEncoder2));
+
+    FlushClient();
+}
@@ -16,6 +16,8 @@
 
 #include "dawn_wire/WireClient.h"
 
+#include <array>
+
 using namespace testing;
 using namespace dawn_wire;
 
@@ -409,6 +411,52 @@ TEST_F(WireBufferMappingWriteTests, MappingForWriteSuccessBuffer) {
     ASSERT_EQ(serverBufferContent, updatedContent);
 }
 
+// Check that only the ranges returned by GetMappedRange are sent to the server on Unmap.
+TEST_F(WireBufferMappingWriteTests, MappingForWriteOnlySendsWrittenRanges) {
+    constexpr uint64_t kLargeBufferSize = 8 * sizeof(uint32_t);
+
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = kLargeBufferSize;
+    descriptor.usage = WGPUBufferUsage_MapWrite;
+    WGPUBuffer largeBuffer = wgpuDeviceCreateBuffer(device, &descriptor);
+    WGPUBuffer apiLargeBuffer = api.GetNewBuffer();
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiLargeBuffer));
+    FlushClient();
+
+    wgpuBufferMapAsync(largeBuffer, WGPUMapMode_Write, 0, kLargeBufferSize,
+                       ToMockBufferMapCallback, nullptr);
+
+    std::array<uint32_t, 8> serverBufferContent = {1, 2, 3, 4, 5, 6, 7, 8};
+    EXPECT_CALL(api, OnBufferMapAsync(apiLargeBuffer, WGPUMapMode_Write, 0, kLargeBufferSize, _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallBufferMapAsyncCallback(apiLargeBuffer, WGPUBufferMapAsyncStatus_Success);
+        }));
+    EXPECT_CALL(api, BufferGetMappedRange(apiLargeBuffer, 0, kLargeBufferSize))
+        .WillOnce(Return(serverBufferContent.data()));
+    FlushClient();
+
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Success, _)).Times(1);
+    FlushServer();
+
+    // Write the third element, and the fifth and sixth with two overlapping ranges.
+    uint32_t* third = static_cast<uint32_t*>(wgpuBufferGetMappedRange(largeBuffer, 8, 4));
+    *third = 42;
+    uint32_t* fifth = static_cast<uint32_t*>(wgpuBufferGetMappedRange(largeBuffer, 16, 4));
+    fifth[0] = 43;
+    uint32_t* fifthAndSixth =
+        static_cast<uint32_t*>(wgpuBufferGetMappedRange(largeBuffer, 16, 8));
+    fifthAndSixth[1] = 44;
+
+    wgpuBufferUnmap(largeBuffer);
+    EXPECT_CALL(api, BufferUnmap(apiLargeBuffer)).Times(1);
+    FlushClient();
+
+    // The elements outside of the mapped ranges keep their server-side content instead of
+    // being overwritten with the client's zero-initialized staging data.
+    std::array<uint32_t, 8> expected = {1, 2, 42, 4, 43, 44, 7, 8};
+    EXPECT_EQ(serverBufferContent, expected);
+}
+
 // Check that things work correctly when a validation error happens when mapping the buffer for
 // writing
 TEST_F(WireBufferMappingWriteTests, ErrorWhileMappingForWrite) {
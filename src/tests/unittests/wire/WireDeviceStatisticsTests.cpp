@@ -0,0 +1,98 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "tests/MockCallback.h"
+
+using namespace testing;
+using namespace dawn_wire;
+
+namespace {
+
+    // The device the server statistics were last queried for.
+    WGPUDevice gLastStatisticsDevice = nullptr;
+
+    DeviceStatisticsCounters GetStatisticsForTesting(WGPUDevice device) {
+        gLastStatisticsDevice = device;
+        return {{"commandsEncoded", 42}, {"samplerCache.hits", 0}, {"objectsAlive.Buffer", 3}};
+    }
+
+    // WireDeviceStatisticsTests test a WireServer that provides the statistics of its devices.
+    class WireDeviceStatisticsTests : public WireTest {
+      protected:
+        void SetUp() override {
+            WireTest::SetUp();
+            gLastStatisticsDevice = nullptr;
+        }
+
+        MockCallback<DeviceStatisticsCallback> mockStatisticsCallback;
+
+      private:
+        GetDeviceStatisticsProc GetServerDeviceStatisticsProc() override {
+            return GetStatisticsForTesting;
+        }
+    };
+
+    class WireDeviceStatisticsUnavailableTests : public WireTest {
+      protected:
+        MockCallback<DeviceStatisticsCallback> mockStatisticsCallback;
+    };
+
+}  // anonymous namespace
+
+// Test that the counters of the device are forwarded to the client, in order.
+TEST_F(WireDeviceStatisticsTests, CountersAreForwarded) {
+    GetWireClient()->GetDeviceStatistics(device, mockStatisticsCallback.Callback(),
+                                         mockStatisticsCallback.MakeUserdata(this));
+    FlushClient();
+    EXPECT_EQ(gLastStatisticsDevice, apiDevice);
+
+    EXPECT_CALL(mockStatisticsCallback,
+                Call(Pointee(ElementsAre(Pair("commandsEncoded", 42u), Pair("samplerCache.hits", 0u),
+                                         Pair("objectsAlive.Buffer", 3u))),
+                     this))
+        .Times(1);
+    FlushServer();
+}
+
+// Test that the callback is called with null if the server doesn't provide statistics.
+TEST_F(WireDeviceStatisticsUnavailableTests, CallbackWithNull) {
+    GetWireClient()->GetDeviceStatistics(device, mockStatisticsCallback.Callback(),
+                                         mockStatisticsCallback.MakeUserdata(this));
+    FlushClient();
+
+    EXPECT_CALL(mockStatisticsCallback, Call(nullptr, this)).Times(1);
+    FlushServer();
+}
+
+// Test that the callback is called with null if the client disconnects before the reply.
+TEST_F(WireDeviceStatisticsTests, DisconnectBeforeReply) {
+    GetWireClient()->GetDeviceStatistics(device, mockStatisticsCallback.Callback(),
+                                         mockStatisticsCallback.MakeUserdata(this));
+    FlushClient();
+
+    EXPECT_CALL(mockStatisticsCallback, Call(nullptr, this)).Times(1);
+    GetWireClient()->Disconnect();
+}
+
+// Test that the callback is called with null right away if the client is disconnected.
+TEST_F(WireDeviceStatisticsTests, QueryAfterDisconnect) {
+    GetWireClient()->Disconnect();
+
+    EXPECT_CALL(mockStatisticsCallback, Call(nullptr, this)).Times(1);
+    GetWireClient()->GetDeviceStatistics(device, mockStatisticsCallback.Callback(),
+                                         mockStatisticsCallback.MakeUserdata(this));
+}
@@ -329,21 +329,18 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadSuccess) {
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
-    // The client should create and serialize a ReadHandle on creation.
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
+    FlushClient();
+
+    // The client should create and serialize a ReadHandle on mapping for reading.
     ClientReadHandle* clientHandle = ExpectReadHandleCreation();
     ExpectReadHandleSerialization(clientHandle);
 
-    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
     // The server should deserialize the read handle from the client and then serialize
-    // an initialization message.
+    // a data update on the mapAsync callback.
     ServerReadHandle* serverHandle = ExpectServerReadHandleDeserialize();
-
-    FlushClient();
-
-    wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
-
-    // The handle serialize data update on mapAsync cmd
     ExpectServerReadHandleSerializeDataUpdate(serverHandle);
 
     // Mock a successful callback
@@ -351,11 +348,12 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadSuccess) {
         .WillOnce(InvokeWithoutArgs([&]() {
             api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
         }));
-    EXPECT_CALL(clientMemoryTransferService, OnReadHandleGetData(clientHandle))
-        .WillOnce(Return(&mBufferContent));
     EXPECT_CALL(api, BufferGetConstMappedRange(apiBuffer, 0, kBufferSize))
         .WillOnce(Return(&mBufferContent));
 
+    // The server handle is destroyed once the data update is serialized.
+    EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverHandle)).Times(1);
+
     FlushClient();
 
     // The client receives a successful callback.
@@ -363,43 +361,67 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadSuccess) {
 
     // The client should receive the handle data update message from the server.
     ExpectClientReadHandleDeserializeDataUpdate(clientHandle, &mBufferContent);
+    EXPECT_CALL(clientMemoryTransferService, OnReadHandleGetData(clientHandle))
+        .WillOnce(Return(&mBufferContent));
 
     FlushServer();
 
+    // The client handle is destroyed on unmap.
+    EXPECT_CALL(clientMemoryTransferService, OnReadHandleDestroy(clientHandle)).Times(1);
     wgpuBufferUnmap(buffer);
     EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
 
     FlushClient();
-
-    // The handle is destroyed once the buffer is destroyed.
-    EXPECT_CALL(clientMemoryTransferService, OnReadHandleDestroy(clientHandle)).Times(1);
-    EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverHandle)).Times(1);
 }
 
-// Test ReadHandle destroy behavior
-TEST_F(WireMemoryTransferServiceTests, BufferMapReadDestroy) {
+// Test that no ReadHandle is created for a MapRead buffer that is never mapped.
+TEST_F(WireMemoryTransferServiceTests, BufferMapReadNoHandleWithoutMapping) {
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
-    // The client should create and serialize a ReadHandle on creation.
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
+    FlushClient();
+
+    wgpuBufferDestroy(buffer);
+    EXPECT_CALL(api, BufferDestroy(apiBuffer)).Times(1);
+
+    FlushClient();
+}
+
+// Test that the ReadHandle only covers the mapped range.
+TEST_F(WireMemoryTransferServiceTests, BufferMapReadHandleSizedToRange) {
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = 64 * kBufferSize;
+    descriptor.usage = WGPUBufferUsage_MapRead;
+
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+    FlushClient();
+
+    // The handle is created with the size of the mapping, not of the buffer.
     ClientReadHandle* clientHandle = ExpectReadHandleCreation();
     ExpectReadHandleSerialization(clientHandle);
 
-    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 8 * kBufferSize, kBufferSize,
+                       ToMockBufferMapCallback, nullptr);
 
-    // The server should deserialize the read handle from the client and then serialize
-    // an initialization message.
+    // Mock a failed callback.
     ServerReadHandle* serverHandle = ExpectServerReadHandleDeserialize();
+    EXPECT_CALL(api,
+                OnBufferMapAsync(apiBuffer, WGPUMapMode_Read, 8 * kBufferSize, kBufferSize, _, _))
+        .WillOnce(InvokeWithoutArgs(
+            [&]() { api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Error); }));
+    EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverHandle)).Times(1);
 
     FlushClient();
 
-    // The handle is destroyed once the buffer is destroyed.
+    // The client receives an error callback and the handle of the request is destroyed.
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Error, _)).Times(1);
     EXPECT_CALL(clientMemoryTransferService, OnReadHandleDestroy(clientHandle)).Times(1);
-    wgpuBufferDestroy(buffer);
-    EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverHandle)).Times(1);
-    EXPECT_CALL(api, BufferDestroy(apiBuffer)).Times(1);
 
-    FlushClient();
+    FlushServer();
 }
 
 // Test unsuccessful mapping for reading.
@@ -407,27 +429,31 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadError) {
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
-    // The client should create and serialize a ReadHandle on creation.
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
+    FlushClient();
+
+    // The client should create and serialize a ReadHandle on mapping for reading.
     ClientReadHandle* clientHandle = ExpectReadHandleCreation();
     ExpectReadHandleSerialization(clientHandle);
 
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
+
     // The server should deserialize the ReadHandle from the client.
     ServerReadHandle* serverHandle = ExpectServerReadHandleDeserialize();
 
-    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
-    FlushClient();
-
-    wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
-
     // Mock a failed callback.
     EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Read, 0, kBufferSize, _, _))
         .WillOnce(InvokeWithoutArgs(
             [&]() { api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Error); }));
 
+    // The server handle is destroyed with the failed request.
+    EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverHandle)).Times(1);
+
     FlushClient();
 
-    // The client receives an error callback.
+    // The client receives an error callback and destroys the handle of the request.
     EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Error, _)).Times(1);
+    EXPECT_CALL(clientMemoryTransferService, OnReadHandleDestroy(clientHandle)).Times(1);
 
     FlushServer();
 
@@ -436,22 +462,26 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadError) {
     EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
 
     FlushClient();
-
-    // The handle is destroyed once the buffer is destroyed.
-    EXPECT_CALL(clientMemoryTransferService, OnReadHandleDestroy(clientHandle)).Times(1);
-    EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverHandle)).Times(1);
 }
 
 // Test ReadHandle creation failure.
 TEST_F(WireMemoryTransferServiceTests, BufferMapReadHandleCreationFailure) {
-    // Mock a ReadHandle creation failure
+    WGPUBuffer buffer;
+    WGPUBuffer apiBuffer;
+
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
+    FlushClient();
+
+    // Mock a ReadHandle creation failure. The mapping fails synchronously.
     MockReadHandleCreationFailure();
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Error, _)).Times(1);
 
-    WGPUBufferDescriptor descriptor = {};
-    descriptor.size = kBufferSize;
-    descriptor.usage = WGPUBufferUsage_MapRead;
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
-    wgpuDeviceCreateBuffer(device, &descriptor);
+    // Only the out-of-memory error reaches the server.
+    EXPECT_CALL(api, DeviceInjectError(apiDevice, WGPUErrorType_OutOfMemory, _)).Times(1);
+
+    FlushClient();
 }
 
 // Test MapRead DeserializeReadHandle failure.
@@ -459,18 +489,23 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadDeserializeReadHandleFailure
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
-    // The client should create and serialize a ReadHandle on mapping for reading..
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
+    FlushClient();
+
+    // The client should create and serialize a ReadHandle on mapping for reading.
     ClientReadHandle* clientHandle = ExpectReadHandleCreation();
     ExpectReadHandleSerialization(clientHandle);
 
-    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
     // Mock a Deserialization failure.
     MockServerReadHandleDeserializeFailure();
 
     FlushClient(false);
 
-    // The handle is destroyed once the buffer is destroyed.
+    // The request never completes so its handle is destroyed once the buffer is destroyed.
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_DestroyedBeforeCallback, _))
+        .Times(1);
     EXPECT_CALL(clientMemoryTransferService, OnReadHandleDestroy(clientHandle)).Times(1);
 }
 
@@ -479,20 +514,18 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadDeserializeDataUpdateFailure
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
+    FlushClient();
+
     // The client should create and serialize a ReadHandle on mapping for reading.
     ClientReadHandle* clientHandle = ExpectReadHandleCreation();
     ExpectReadHandleSerialization(clientHandle);
 
-    // The server should deserialize the read handle from the client and then serialize
-    // an initialization message.
-    ServerReadHandle* serverHandle = ExpectServerReadHandleDeserialize();
-
-    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
-    FlushClient();
-
     wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
-    // The handle serialize data update on mapAsync cmd
+    // The server should deserialize the read handle from the client and then serialize
+    // a data update on the mapAsync callback.
+    ServerReadHandle* serverHandle = ExpectServerReadHandleDeserialize();
     ExpectServerReadHandleSerializeDataUpdate(serverHandle);
 
     // Mock a successful callback
@@ -502,6 +535,7 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadDeserializeDataUpdateFailure
         }));
     EXPECT_CALL(api, BufferGetConstMappedRange(apiBuffer, 0, kBufferSize))
         .WillOnce(Return(&mBufferContent));
+    EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverHandle)).Times(1);
 
     FlushClient();
 
@@ -510,14 +544,11 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadDeserializeDataUpdateFailure
     MockClientReadHandleDeserializeDataUpdateFailure(clientHandle);
 
     // Failed deserialization is a fatal failure and the client synchronously receives a
-    // DEVICE_LOST callback.
+    // DEVICE_LOST callback. The handle is destroyed with the failed request.
     EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_DeviceLost, _)).Times(1);
+    EXPECT_CALL(clientMemoryTransferService, OnReadHandleDestroy(clientHandle)).Times(1);
 
     FlushServer(false);
-
-    // The handle is destroyed once the buffer is destroyed.
-    EXPECT_CALL(clientMemoryTransferService, OnReadHandleDestroy(clientHandle)).Times(1);
-    EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverHandle)).Times(1);
 }
 
 // Test mapping for reading destroying the buffer before unmapping on the client side.
@@ -525,20 +556,18 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadDestroyBeforeUnmap) {
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
-    // The client should create and serialize a ReadHandle on mapping for reading..
-    ClientReadHandle* clientHandle = ExpectReadHandleCreation();
-    ExpectReadHandleSerialization(clientHandle);
-
-    // The server should deserialize the read handle from the client and then serialize
-    // an initialization message.
-    ServerReadHandle* serverHandle = ExpectServerReadHandleDeserialize();
-
     std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapRead);
     FlushClient();
 
+    // The client should create and serialize a ReadHandle on mapping for reading.
+    ClientReadHandle* clientHandle = ExpectReadHandleCreation();
+    ExpectReadHandleSerialization(clientHandle);
+
     wgpuBufferMapAsync(buffer, WGPUMapMode_Read, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
-    // The handle serialize data update on mapAsync cmd
+    // The server should deserialize the read handle from the client and then serialize
+    // a data update on the mapAsync callback.
+    ServerReadHandle* serverHandle = ExpectServerReadHandleDeserialize();
     ExpectServerReadHandleSerializeDataUpdate(serverHandle);
 
     // Mock a successful callback
@@ -546,10 +575,9 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadDestroyBeforeUnmap) {
         .WillOnce(InvokeWithoutArgs([&]() {
             api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
         }));
-    EXPECT_CALL(clientMemoryTransferService, OnReadHandleGetData(clientHandle))
-        .WillOnce(Return(&mBufferContent));
     EXPECT_CALL(api, BufferGetConstMappedRange(apiBuffer, 0, kBufferSize))
         .WillOnce(Return(&mBufferContent));
+    EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverHandle)).Times(1);
 
     FlushClient();
 
@@ -558,16 +586,17 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapReadDestroyBeforeUnmap) {
 
     // The client should receive the handle data update message from the server.
     ExpectClientReadHandleDeserializeDataUpdate(clientHandle, &mBufferContent);
+    EXPECT_CALL(clientMemoryTransferService, OnReadHandleGetData(clientHandle))
+        .WillOnce(Return(&mBufferContent));
 
     FlushServer();
 
     // THIS IS THE TEST: destroy the buffer before unmapping and check it destroyed the mapping
-    // immediately, both in the client and server side.
+    // immediately on the client side.
     {
         EXPECT_CALL(clientMemoryTransferService, OnReadHandleDestroy(clientHandle)).Times(1);
         wgpuBufferDestroy(buffer);
 
-        EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverHandle)).Times(1);
         EXPECT_CALL(api, BufferDestroy(apiBuffer)).Times(1);
         FlushClient();
 
@@ -584,25 +613,23 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteSuccess) {
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    FlushClient();
+
+    // The client should create and serialize a WriteHandle on mapping for writing.
     ClientWriteHandle* clientHandle = ExpectWriteHandleCreation(false);
     ExpectWriteHandleSerialization(clientHandle);
 
-    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
     // The server should then deserialize the WriteHandle from the client.
     ServerWriteHandle* serverHandle = ExpectServerWriteHandleDeserialization();
 
-    FlushClient();
-
-    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
-
     // Mock a successful callback.
     EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Write, 0, kBufferSize, _, _))
         .WillOnce(InvokeWithoutArgs([&]() {
             api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
         }));
-    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleGetData(clientHandle))
-        .WillOnce(Return(&mBufferContent));
     EXPECT_CALL(api, BufferGetMappedRange(apiBuffer, 0, kBufferSize))
         .WillOnce(Return(&mMappedBufferContent));
 
@@ -610,48 +637,39 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteSuccess) {
 
     // The client receives a successful callback.
     EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Success, _)).Times(1);
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleGetData(clientHandle))
+        .WillOnce(Return(&mBufferContent));
 
     FlushServer();
 
-    // The client writes to the handle contents.
+    // The client gets the mapped range and writes to the handle contents.
+    ASSERT_NE(nullptr, wgpuBufferGetMappedRange(buffer, 0, kBufferSize));
     mMappedBufferContent = mUpdatedBufferContent;
 
     // The client will then serialize data update and destroy the handle on Unmap()
     ExpectClientWriteHandleSerializeDataUpdate(clientHandle);
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
 
     wgpuBufferUnmap(buffer);
 
-    // The server deserializes the data update message.
+    // The server deserializes the data update message and destroys the handle on unmap.
     ExpectServerWriteHandleDeserializeDataUpdate(serverHandle, mUpdatedBufferContent);
+    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
 
     EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
 
     FlushClient();
-
-    // The handle is destroyed once the buffer is destroyed.
-    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
-    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
 }
 
-// Test WriteHandle destroy behavior
-TEST_F(WireMemoryTransferServiceTests, BufferMapWriteDestroy) {
+// Test that no WriteHandle is created for a MapWrite buffer that is never mapped.
+TEST_F(WireMemoryTransferServiceTests, BufferMapWriteNoHandleWithoutMapping) {
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
-    ClientWriteHandle* clientHandle = ExpectWriteHandleCreation(false);
-    ExpectWriteHandleSerialization(clientHandle);
-
     std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
-
-    // The server should then deserialize the WriteHandle from the client.
-    ServerWriteHandle* serverHandle = ExpectServerWriteHandleDeserialization();
-
     FlushClient();
 
-    // The handle is destroyed once the buffer is destroyed.
-    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
     wgpuBufferDestroy(buffer);
-    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
     EXPECT_CALL(api, BufferDestroy(apiBuffer)).Times(1);
 
     FlushClient();
@@ -662,29 +680,31 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteError) {
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
-    // The client should create and serialize a WriteHandle on buffer creation with MapWrite usage.
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    FlushClient();
+
+    // The client should create and serialize a WriteHandle on mapping for writing.
     ClientWriteHandle* clientHandle = ExpectWriteHandleCreation(false);
     ExpectWriteHandleSerialization(clientHandle);
 
-    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
     // The server should then deserialize the WriteHandle from the client.
     ServerWriteHandle* serverHandle = ExpectServerWriteHandleDeserialization();
 
-    FlushClient();
-
-    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
-
     // Mock an error callback.
     EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Write, 0, kBufferSize, _, _))
         .WillOnce(InvokeWithoutArgs(
             [&]() { api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Error); }));
 
+    // The server handle is destroyed with the failed request.
+    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
 
     FlushClient();
 
-    // The client receives an error callback.
+    // The client receives an error callback and destroys the handle of the request.
     EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Error, _)).Times(1);
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
 
     FlushServer();
 
@@ -693,22 +713,26 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteError) {
     EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
 
     FlushClient();
-
-    // The handle is destroyed once the buffer is destroyed.
-    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
-    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
 }
 
 // Test WriteHandle creation failure.
 TEST_F(WireMemoryTransferServiceTests, BufferMapWriteHandleCreationFailure) {
-    // Mock a WriteHandle creation failure
+    WGPUBuffer buffer;
+    WGPUBuffer apiBuffer;
+
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    FlushClient();
+
+    // Mock a WriteHandle creation failure. The mapping fails synchronously.
     MockWriteHandleCreationFailure();
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Error, _)).Times(1);
 
-    WGPUBufferDescriptor descriptor = {};
-    descriptor.size = kBufferSize;
-    descriptor.usage = WGPUBufferUsage_MapWrite;
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
-    wgpuDeviceCreateBuffer(device, &descriptor);
+    // Only the out-of-memory error reaches the server.
+    EXPECT_CALL(api, DeviceInjectError(apiDevice, WGPUErrorType_OutOfMemory, _)).Times(1);
+
+    FlushClient();
 }
 
 // Test MapWrite DeserializeWriteHandle failure.
@@ -716,18 +740,23 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteDeserializeWriteHandleFailu
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
-    // The client should create and serialize a WriteHandle on buffer creation with MapWrite usage.
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    FlushClient();
+
+    // The client should create and serialize a WriteHandle on mapping for writing.
     ClientWriteHandle* clientHandle = ExpectWriteHandleCreation(false);
     ExpectWriteHandleSerialization(clientHandle);
 
-    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
     // Mock a deserialization failure.
     MockServerWriteHandleDeserializeFailure();
 
     FlushClient(false);
 
-    // The handle is destroyed once the buffer is destroyed.
+    // The request never completes so its handle is destroyed once the buffer is destroyed.
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_DestroyedBeforeCallback, _))
+        .Times(1);
     EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
 }
 
@@ -736,25 +765,23 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteDeserializeDataUpdateFailur
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    FlushClient();
+
+    // The client should create and serialize a WriteHandle on mapping for writing.
     ClientWriteHandle* clientHandle = ExpectWriteHandleCreation(false);
     ExpectWriteHandleSerialization(clientHandle);
 
-    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
     // The server should then deserialize the WriteHandle from the client.
     ServerWriteHandle* serverHandle = ExpectServerWriteHandleDeserialization();
 
-    FlushClient();
-
-    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
-
     // Mock a successful callback.
     EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Write, 0, kBufferSize, _, _))
         .WillOnce(InvokeWithoutArgs([&]() {
             api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
         }));
-    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleGetData(clientHandle))
-        .WillOnce(Return(&mBufferContent));
     EXPECT_CALL(api, BufferGetMappedRange(apiBuffer, 0, kBufferSize))
         .WillOnce(Return(&mMappedBufferContent));
 
@@ -762,14 +789,18 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteDeserializeDataUpdateFailur
 
     // The client receives a success callback.
     EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Success, _)).Times(1);
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleGetData(clientHandle))
+        .WillOnce(Return(&mBufferContent));
 
     FlushServer();
 
-    // The client writes to the handle contents.
+    // The client gets the mapped range and writes to the handle contents.
+    ASSERT_NE(nullptr, wgpuBufferGetMappedRange(buffer, 0, kBufferSize));
     mMappedBufferContent = mUpdatedBufferContent;
 
-    // The client will then serialize data update
+    // The client will then serialize data update and destroy the handle on Unmap().
     ExpectClientWriteHandleSerializeDataUpdate(clientHandle);
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
 
     wgpuBufferUnmap(buffer);
 
@@ -778,8 +809,8 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteDeserializeDataUpdateFailur
 
     FlushClient(false);
 
-    // The handle is destroyed once the buffer is destroyed.
-    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
+    // Failed BufferUpdateMappedData cmd will early return so BufferUnmap is not processed.
+    // The server side writeHandle is destructed at buffer destruction.
     EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
 }
 
@@ -788,25 +819,23 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteDestroyBeforeUnmap) {
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
 
+    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    FlushClient();
+
+    // The client should create and serialize a WriteHandle on mapping for writing.
     ClientWriteHandle* clientHandle = ExpectWriteHandleCreation(false);
     ExpectWriteHandleSerialization(clientHandle);
 
-    std::tie(apiBuffer, buffer) = CreateBuffer(WGPUBufferUsage_MapWrite);
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
 
     // The server should then deserialize the WriteHandle from the client.
     ServerWriteHandle* serverHandle = ExpectServerWriteHandleDeserialization();
 
-    FlushClient();
-
-    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
-
     // Mock a successful callback.
     EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Write, 0, kBufferSize, _, _))
         .WillOnce(InvokeWithoutArgs([&]() {
             api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Success);
         }));
-    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleGetData(clientHandle))
-        .WillOnce(Return(&mBufferContent));
     EXPECT_CALL(api, BufferGetMappedRange(apiBuffer, 0, kBufferSize))
         .WillOnce(Return(&mMappedBufferContent));
 
@@ -814,6 +843,8 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteDestroyBeforeUnmap) {
 
     // The client receives a successful callback.
     EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Success, _)).Times(1);
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleGetData(clientHandle))
+        .WillOnce(Return(&mBufferContent));
 
     FlushServer();
 
@@ -823,7 +854,6 @@ TEST_F(WireMemoryTransferServiceTests, BufferMapWriteDestroyBeforeUnmap) {
     // THIS IS THE TEST: destroy the buffer before unmapping and check it destroyed the mapping
     // immediately, both in the client and server side.
     {
-        // The handle is destroyed once the buffer is destroyed.
         EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
 
         wgpuBufferDestroy(buffer);
@@ -854,7 +884,8 @@ TEST_F(WireMemoryTransferServiceTests, MappedAtCreationSuccess) {
     std::tie(apiBuffer, buffer) = CreateBufferMapped();
     FlushClient();
 
-    // Update the mapped contents.
+    // Get and update the mapped contents.
+    ASSERT_NE(nullptr, wgpuBufferGetMappedRange(buffer, 0, kBufferSize));
     mMappedBufferContent = mUpdatedBufferContent;
 
     // When the client Unmaps the buffer, it will serialize data update writes to the handle and
@@ -926,7 +957,8 @@ TEST_F(WireMemoryTransferServiceTests, MappedAtCreationDeserializeDataUpdateFail
     std::tie(apiBuffer, buffer) = CreateBufferMapped();
     FlushClient();
 
-    // Update the mapped contents.
+    // Get and update the mapped contents.
+    ASSERT_NE(nullptr, wgpuBufferGetMappedRange(buffer, 0, kBufferSize));
     mMappedBufferContent = mUpdatedBufferContent;
 
     // When the client Unmaps the buffer, it will serialize data update writes to the handle and
@@ -981,51 +1013,43 @@ TEST_F(WireMemoryTransferServiceTests, MappedAtCreationDestroyBeforeUnmap) {
     }
 }
 
-// Test a buffer with mappedAtCreation and MapRead usage destroy WriteHandle on unmap and switch
-// data pointer to ReadHandle
+// Test that a buffer with mappedAtCreation and MapRead usage only creates a WriteHandle, which is
+// destroyed on unmap.
 TEST_F(WireMemoryTransferServiceTests, MappedAtCreationAndMapReadSuccess) {
-    // The client should create and serialize a ReadHandle and a WriteHandle on createBufferMapped.
-    ClientReadHandle* clientReadHandle = ExpectReadHandleCreation();
-    ExpectReadHandleSerialization(clientReadHandle);
-    ClientWriteHandle* clientWriteHandle = ExpectWriteHandleCreation(true);
-    ExpectWriteHandleSerialization(clientWriteHandle);
+    // The client should create and serialize only a WriteHandle on createBufferMapped.
+    ClientWriteHandle* clientHandle = ExpectWriteHandleCreation(true);
+    ExpectWriteHandleSerialization(clientHandle);
 
-    // The server should then deserialize a ReadHandle and a WriteHandle from the client.
-    ServerReadHandle* serverReadHandle = ExpectServerReadHandleDeserialize();
-    ServerWriteHandle* serverWriteHandle = ExpectServerWriteHandleDeserialization();
+    // The server should then deserialize the WriteHandle from the client.
+    ServerWriteHandle* serverHandle = ExpectServerWriteHandleDeserialization();
 
     WGPUBuffer buffer;
     WGPUBuffer apiBuffer;
     std::tie(apiBuffer, buffer) = CreateBufferMapped(WGPUBufferUsage_MapRead);
     FlushClient();
 
-    // Update the mapped contents.
+    // Get and update the mapped contents.
+    ASSERT_NE(nullptr, wgpuBufferGetMappedRange(buffer, 0, kBufferSize));
     mMappedBufferContent = mUpdatedBufferContent;
 
     // When the client Unmaps the buffer, it will serialize data update writes to the handle and
     // destroy it.
-    ExpectClientWriteHandleSerializeDataUpdate(clientWriteHandle);
-    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientWriteHandle)).Times(1);
-    EXPECT_CALL(clientMemoryTransferService, OnReadHandleGetData(clientReadHandle))
-        .WillOnce(Return(&mBufferContent));
+    ExpectClientWriteHandleSerializeDataUpdate(clientHandle);
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
     wgpuBufferUnmap(buffer);
 
     // The server deserializes the data update message.
-    ExpectServerWriteHandleDeserializeDataUpdate(serverWriteHandle, mUpdatedBufferContent);
+    ExpectServerWriteHandleDeserializeDataUpdate(serverHandle, mUpdatedBufferContent);
     EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
-    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverWriteHandle)).Times(1);
+    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
     FlushClient();
-
-    // The ReadHandle will be destoryed on buffer destroy.
-    EXPECT_CALL(clientMemoryTransferService, OnReadHandleDestroy(clientReadHandle)).Times(1);
-    EXPECT_CALL(serverMemoryTransferService, OnReadHandleDestroy(serverReadHandle)).Times(1);
 }
 
-// Test WriteHandle preserves after unmap for a buffer with mappedAtCreation and MapWrite usage
+// Test that the WriteHandle of a buffer with mappedAtCreation and MapWrite usage is destroyed on
+// unmap, and later mappings create their own.
 TEST_F(WireMemoryTransferServiceTests, MappedAtCreationAndMapWriteSuccess) {
     // The client should create and serialize a WriteHandle on createBufferMapped.
     ClientWriteHandle* clientHandle = ExpectWriteHandleCreation(true);
-
     ExpectWriteHandleSerialization(clientHandle);
 
     // The server should then deserialize the WriteHandle from the client.
@@ -1036,21 +1060,41 @@ TEST_F(WireMemoryTransferServiceTests, MappedAtCreationAndMapWriteSuccess) {
     std::tie(apiBuffer, buffer) = CreateBufferMapped(WGPUBufferUsage_MapWrite);
     FlushClient();
 
-    // Update the mapped contents.
+    // Get and update the mapped contents.
+    ASSERT_NE(nullptr, wgpuBufferGetMappedRange(buffer, 0, kBufferSize));
     mMappedBufferContent = mUpdatedBufferContent;
 
-    // When the client Unmaps the buffer, it will serialize data update writes to the handle.
+    // When the client Unmaps the buffer, it will serialize data update writes to the handle and
+    // destroy it.
     ExpectClientWriteHandleSerializeDataUpdate(clientHandle);
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
 
     wgpuBufferUnmap(buffer);
 
-    // The server deserializes the data update message.
+    // The server deserializes the data update message and destroys the handle.
     ExpectServerWriteHandleDeserializeDataUpdate(serverHandle, mUpdatedBufferContent);
+    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
     EXPECT_CALL(api, BufferUnmap(apiBuffer)).Times(1);
 
     FlushClient();
 
-    // The writeHandle is preserved after unmap and is destroyed once the buffer is destroyed.
-    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(clientHandle)).Times(1);
-    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(serverHandle)).Times(1);
-}
\ No newline at end of file
+    // Mapping the buffer again creates a new WriteHandle.
+    ClientWriteHandle* mapClientHandle = ExpectWriteHandleCreation(false);
+    ExpectWriteHandleSerialization(mapClientHandle);
+
+    wgpuBufferMapAsync(buffer, WGPUMapMode_Write, 0, kBufferSize, ToMockBufferMapCallback, nullptr);
+
+    // Mock an error callback, which destroys the handles of the request.
+    ServerWriteHandle* mapServerHandle = ExpectServerWriteHandleDeserialization();
+    EXPECT_CALL(api, OnBufferMapAsync(apiBuffer, WGPUMapMode_Write, 0, kBufferSize, _, _))
+        .WillOnce(InvokeWithoutArgs(
+            [&]() { api.CallBufferMapAsyncCallback(apiBuffer, WGPUBufferMapAsyncStatus_Error); }));
+    EXPECT_CALL(serverMemoryTransferService, OnWriteHandleDestroy(mapServerHandle)).Times(1);
+
+    FlushClient();
+
+    EXPECT_CALL(*mockBufferMapCallback, Call(WGPUBufferMapAsyncStatus_Error, _)).Times(1);
+    EXPECT_CALL(clientMemoryTransferService, OnWriteHandleDestroy(mapClientHandle)).Times(1);
+
+    FlushServer();
+}
@@ -0,0 +1,171 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireServer.h"
+
+using namespace testing;
+using namespace dawn_wire;
+
+// WirePartitionedCommandsTests test a WireServer that handles the commands of each device on its
+// own thread.
+class WirePartitionedCommandsTests : public WireTest {
+  public:
+    WirePartitionedCommandsTests() {
+    }
+    ~WirePartitionedCommandsTests() override = default;
+
+    void SetUp() override {
+        WireTest::SetUp();
+
+        ReservedDevice reservation = GetWireClient()->ReserveDevice();
+        otherApiDevice = api.GetNewDevice();
+        EXPECT_CALL(api, DeviceReference(otherApiDevice));
+        EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(otherApiDevice, _, _));
+        EXPECT_CALL(api, OnDeviceSetLoggingCallback(otherApiDevice, _, _));
+        EXPECT_CALL(api, OnDeviceSetDeviceLostCallback(otherApiDevice, _, _));
+        ASSERT_TRUE(GetWireServer()->InjectDevice(otherApiDevice, reservation.id,
+                                                  reservation.generation));
+        otherDevice = reservation.device;
+    }
+
+    void TearDown() override {
+        if (otherApiDevice != nullptr) {
+            // Called on shutdown.
+            EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(otherApiDevice, nullptr, nullptr))
+                .Times(Exactly(1));
+            EXPECT_CALL(api, OnDeviceSetLoggingCallback(otherApiDevice, nullptr, nullptr))
+                .Times(Exactly(1));
+            EXPECT_CALL(api, OnDeviceSetDeviceLostCallback(otherApiDevice, nullptr, nullptr))
+                .Times(Exactly(1));
+        }
+        WireTest::TearDown();
+    }
+
+  protected:
+    WGPUDevice otherDevice;
+    WGPUDevice otherApiDevice;
+
+  private:
+    bool PartitionsCommandsByDevice() override {
+        return true;
+    }
+};
+
+// Test that the commands of each device are handled in order when several devices have commands.
+TEST_F(WirePartitionedCommandsTests, CommandsOfEachDeviceInOrder) {
+    constexpr size_t kBufferCount = 16;
+
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = 4;
+    descriptor.usage = WGPUBufferUsage_CopyDst;
+
+    Sequence deviceSequence;
+    Sequence otherDeviceSequence;
+    for (size_t i = 0; i < kBufferCount; ++i) {
+        WGPUBuffer buffer = wgpuDeviceCreateBuffer(device, &descriptor);
+        WGPUBuffer otherBuffer = wgpuDeviceCreateBuffer(otherDevice, &descriptor);
+        wgpuBufferDestroy(buffer);
+        wgpuBufferDestroy(otherBuffer);
+
+        WGPUBuffer apiBuffer = api.GetNewBuffer();
+        WGPUBuffer otherApiBuffer = api.GetNewBuffer();
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _))
+            .InSequence(deviceSequence)
+            .WillOnce(Return(apiBuffer));
+        EXPECT_CALL(api, BufferDestroy(apiBuffer)).InSequence(deviceSequence);
+        EXPECT_CALL(api, DeviceCreateBuffer(otherApiDevice, _))
+            .InSequence(otherDeviceSequence)
+            .WillOnce(Return(otherApiBuffer));
+        EXPECT_CALL(api, BufferDestroy(otherApiBuffer)).InSequence(otherDeviceSequence);
+    }
+    FlushClient();
+}
+
+// Test that the commands on an object go to the device of the object, even when the object is
+// created in the same batch of commands.
+TEST_F(WirePartitionedCommandsTests, CommandsOnCreatedObjects) {
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(device, nullptr);
+    WGPUCommandEncoder otherEncoder = wgpuDeviceCreateCommandEncoder(otherDevice, nullptr);
+    wgpuCommandEncoderFinish(encoder, nullptr);
+    wgpuCommandEncoderFinish(otherEncoder, nullptr);
+
+    WGPUCommandEncoder apiEncoder = api.GetNewCommandEncoder();
+    WGPUCommandEncoder otherApiEncoder = api.GetNewCommandEncoder();
+    WGPUCommandBuffer apiCommandBuffer = api.GetNewCommandBuffer();
+    WGPUCommandBuffer otherApiCommandBuffer = api.GetNewCommandBuffer();
+    {
+        InSequence sequence;
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+            .WillOnce(Return(apiEncoder));
+        EXPECT_CALL(api, CommandEncoderFinish(apiEncoder, nullptr))
+            .WillOnce(Return(apiCommandBuffer));
+    }
+    {
+        InSequence sequence;
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(otherApiDevice, nullptr))
+            .WillOnce(Return(otherApiEncoder));
+        EXPECT_CALL(api, CommandEncoderFinish(otherApiEncoder, nullptr))
+            .WillOnce(Return(otherApiCommandBuffer));
+    }
+    FlushClient();
+}
+
+// Test that destroying a device waits for the commands of its children, and that the other
+// device keeps working after it.
+TEST_F(WirePartitionedCommandsTests, DestroyDevice) {
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = 4;
+    descriptor.usage = WGPUBufferUsage_CopyDst;
+
+    WGPUBuffer otherBuffer = wgpuDeviceCreateBuffer(otherDevice, &descriptor);
+    wgpuBufferDestroy(otherBuffer);
+    wgpuDeviceRelease(otherDevice);
+    wgpuDeviceCreateBuffer(device, &descriptor);
+
+    WGPUBuffer otherApiBuffer = api.GetNewBuffer();
+    WGPUBuffer apiBuffer = api.GetNewBuffer();
+    {
+        InSequence sequence;
+        EXPECT_CALL(api, DeviceCreateBuffer(otherApiDevice, _)).WillOnce(Return(otherApiBuffer));
+        EXPECT_CALL(api, BufferDestroy(otherApiBuffer));
+        EXPECT_CALL(api, BufferRelease(otherApiBuffer));
+        EXPECT_CALL(api, OnDeviceSetUncapturedErrorCallback(otherApiDevice, nullptr, nullptr));
+        EXPECT_CALL(api, OnDeviceSetLoggingCallback(otherApiDevice, nullptr, nullptr));
+        EXPECT_CALL(api, OnDeviceSetDeviceLostCallback(otherApiDevice, nullptr, nullptr));
+        EXPECT_CALL(api, DeviceRelease(otherApiDevice));
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+    }
+    FlushClient();
+
+    otherApiDevice = nullptr;
+}
+
+// Test that it is a fatal error for a command of a device to use the objects of another device.
+TEST_F(WirePartitionedCommandsTests, ObjectOfOtherDeviceIsError) {
+    WGPUBufferDescriptor descriptor = {};
+    descriptor.size = 4;
+    descriptor.usage = WGPUBufferUsage_CopyDst;
+
+    WGPUBuffer otherBuffer = wgpuDeviceCreateBuffer(otherDevice, &descriptor);
+    WGPUBuffer otherApiBuffer = api.GetNewBuffer();
+    EXPECT_CALL(api, DeviceCreateBuffer(otherApiDevice, _)).WillOnce(Return(otherApiBuffer));
+    FlushClient();
+
+    uint32_t data = 0;
+    wgpuQueueWriteBuffer(queue, otherBuffer, 0, &data, sizeof(data));
+    FlushClient(false);
+}
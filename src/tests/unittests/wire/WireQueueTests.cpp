@@ -16,6 +16,8 @@
 
 #include "dawn_wire/WireClient.h"
 
+#include <vector>
+
 using namespace testing;
 using namespace dawn_wire;
 
@@ -73,6 +75,41 @@ TEST_F(WireQueueTests, OnSubmittedWorkDoneError) {
     FlushServer();
 }
 
+// Test that OnSubmittedWorkDone callbacks completing out of order are forwarded to the right
+// client callbacks, and that the requests can still be completed after the first one.
+TEST_F(WireQueueTests, OnSubmittedWorkDoneOutOfOrder) {
+    constexpr size_t kNumRequests = 4;
+    int userdata[kNumRequests] = {};
+
+    std::vector<std::pair<WGPUQueueWorkDoneCallback, void*>> serverCallbacks;
+    EXPECT_CALL(api, OnQueueOnSubmittedWorkDone(apiQueue, 0u, _, _))
+        .Times(kNumRequests)
+        .WillRepeatedly(WithArgs<2, 3>([&](WGPUQueueWorkDoneCallback callback, void* data) {
+            serverCallbacks.emplace_back(callback, data);
+        }));
+    for (int& data : userdata) {
+        wgpuQueueOnSubmittedWorkDone(queue, 0u, ToMockQueueWorkDone, &data);
+    }
+    FlushClient();
+    ASSERT_EQ(serverCallbacks.size(), kNumRequests);
+
+    // Complete the second request, then the others in reverse order.
+    serverCallbacks[1].first(WGPUQueueWorkDoneStatus_Success, serverCallbacks[1].second);
+    for (size_t i : {3, 2, 0}) {
+        serverCallbacks[i].first(WGPUQueueWorkDoneStatus_Success, serverCallbacks[i].second);
+    }
+
+    {
+        InSequence sequence;
+        for (size_t i : {1, 3, 2, 0}) {
+            EXPECT_CALL(*mockQueueWorkDoneCallback,
+                        Call(WGPUQueueWorkDoneStatus_Success, &userdata[i]))
+                .Times(1);
+        }
+    }
+    FlushServer();
+}
+
 // Test registering an OnSubmittedWorkDone then disconnecting the wire calls the callback with
 // device loss
 TEST_F(WireQueueTests, OnSubmittedWorkDoneBeforeDisconnect) {
@@ -0,0 +1,154 @@
+// Copyright 2021 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include "dawn_wire/WireServer.h"
+
+using namespace testing;
+using namespace dawn_wire;
+
+namespace {
+
+    // Mock class to add expectations on the wire calling callbacks
+    class MockDeviceErrorCallback {
+      public:
+        MOCK_METHOD(void, Call, (WGPUErrorType type, const char* message, void* userdata));
+    };
+
+    std::unique_ptr<StrictMock<MockDeviceErrorCallback>> mockDeviceErrorCallback;
+    void ToMockDeviceErrorCallback(WGPUErrorType type, const char* message, void* userdata) {
+        mockDeviceErrorCallback->Call(type, message, userdata);
+    }
+
+}  // anonymous namespace
+
+// WireReturnBatchingTests test a WireServer that batches its return commands.
+class WireReturnBatchingTests : public WireTest {
+  public:
+    WireReturnBatchingTests() {
+    }
+    ~WireReturnBatchingTests() override = default;
+
+    void SetUp() override {
+        WireTest::SetUp();
+
+        mockDeviceErrorCallback = std::make_unique<StrictMock<MockDeviceErrorCallback>>();
+        wgpuDeviceSetUncapturedErrorCallback(device, ToMockDeviceErrorCallback, this);
+    }
+
+    void TearDown() override {
+        WireTest::TearDown();
+
+        mockDeviceErrorCallback = nullptr;
+    }
+
+  protected:
+    // Make each injected error call the uncaptured error callback of the server right away.
+    void ForwardInjectedErrors(size_t count) {
+        EXPECT_CALL(api, DeviceInjectError(apiDevice, _, _))
+            .Times(count)
+            .WillRepeatedly(WithArgs<1, 2>([&](WGPUErrorType type, const char* message) {
+                api.CallDeviceSetUncapturedErrorCallbackCallback(apiDevice, type, message);
+            }));
+    }
+
+  private:
+    bool BatchesReturnCommands() override {
+        return true;
+    }
+};
+
+// Test that the return commands produced while handling commands are sent at the end of
+// HandleCommands in a single batch.
+TEST_F(WireReturnBatchingTests, ReturnCommandsSentAfterHandleCommands) {
+    wgpuDeviceInjectError(device, WGPUErrorType_Validation, "First");
+    wgpuDeviceInjectError(device, WGPUErrorType_OutOfMemory, "Second");
+    ForwardInjectedErrors(2);
+
+    // The callbacks are received without flushing the server.
+    {
+        InSequence sequence;
+        EXPECT_CALL(*mockDeviceErrorCallback, Call(WGPUErrorType_Validation, StrEq("First"), this))
+            .Times(1);
+        EXPECT_CALL(*mockDeviceErrorCallback,
+                    Call(WGPUErrorType_OutOfMemory, StrEq("Second"), this))
+            .Times(1);
+    }
+    FlushClient();
+
+    WireStatistics statistics = GetWireServer()->GetStatistics();
+    EXPECT_EQ(statistics.commandsSerialized, 2u);
+    EXPECT_EQ(statistics.batchesFlushed, 1u);
+    EXPECT_EQ(statistics.largestBatchBytes, statistics.bytesSerialized);
+}
+
+// Test that the return commands produced outside of HandleCommands are only sent on
+// FlushReturnCommands.
+TEST_F(WireReturnBatchingTests, ReturnCommandsBufferedUntilFlushReturnCommands) {
+    api.CallDeviceSetUncapturedErrorCallbackCallback(apiDevice, WGPUErrorType_Validation,
+                                                     "Some error message");
+
+    // Nothing was written to the serializer yet.
+    FlushServer();
+    Mock::VerifyAndClearExpectations(mockDeviceErrorCallback.get());
+
+    EXPECT_CALL(*mockDeviceErrorCallback,
+                Call(WGPUErrorType_Validation, StrEq("Some error message"), this))
+        .Times(1);
+    EXPECT_TRUE(GetWireServer()->FlushReturnCommands());
+
+    // Flushing again doesn't send anything.
+    EXPECT_TRUE(GetWireServer()->FlushReturnCommands());
+    EXPECT_EQ(GetWireServer()->GetStatistics().batchesFlushed, 1u);
+}
+
+// Test that consecutive uncaptured errors of the same type are merged in a single callback.
+TEST_F(WireReturnBatchingTests, ConsecutiveErrorsMerged) {
+    wgpuDeviceInjectError(device, WGPUErrorType_Validation, "First");
+    wgpuDeviceInjectError(device, WGPUErrorType_Validation, "Second");
+    wgpuDeviceInjectError(device, WGPUErrorType_Validation, "Third");
+    ForwardInjectedErrors(3);
+
+    EXPECT_CALL(*mockDeviceErrorCallback,
+                Call(WGPUErrorType_Validation, StrEq("First\nSecond\nThird"), this))
+        .Times(1);
+    FlushClient();
+
+    WireStatistics statistics = GetWireServer()->GetStatistics();
+    EXPECT_EQ(statistics.commandsSerialized, 1u);
+    EXPECT_EQ(statistics.errorsMerged, 2u);
+}
+
+// Test that errors of different types aren't merged and stay in order.
+TEST_F(WireReturnBatchingTests, ErrorsOfDifferentTypesNotMerged) {
+    wgpuDeviceInjectError(device, WGPUErrorType_Validation, "First");
+    wgpuDeviceInjectError(device, WGPUErrorType_OutOfMemory, "Second");
+    wgpuDeviceInjectError(device, WGPUErrorType_Validation, "Third");
+    ForwardInjectedErrors(3);
+
+    {
+        InSequence sequence;
+        EXPECT_CALL(*mockDeviceErrorCallback, Call(WGPUErrorType_Validation, StrEq("First"), this))
+            .Times(1);
+        EXPECT_CALL(*mockDeviceErrorCallback,
+                    Call(WGPUErrorType_OutOfMemory, StrEq("Second"), this))
+            .Times(1);
+        EXPECT_CALL(*mockDeviceErrorCallback, Call(WGPUErrorType_Validation, StrEq("Third"), this))
+            .Times(1);
+    }
+    FlushClient();
+
+    EXPECT_EQ(GetWireServer()->GetStatistics().errorsMerged, 0u);
+}
@@ -36,6 +36,18 @@ server::MemoryTransferService* WireTest::GetServerMemoryTransferService() {
     return nullptr;
 }
 
+bool WireTest::BatchesReturnCommands() {
+    return false;
+}
+
+bool WireTest::PartitionsCommandsByDevice() {
+    return false;
+}
+
+WireTest::GetDeviceStatisticsProc WireTest::GetServerDeviceStatisticsProc() {
+    return nullptr;
+}
+
 void WireTest::SetUp() {
     DawnProcTable mockProcs;
     WGPUDevice mockDevice;
@@ -54,6 +66,9 @@ void WireTest::SetUp() {
     serverDesc.procs = &mockProcs;
     serverDesc.serializer = mS2cBuf.get();
     serverDesc.memoryTransferService = GetServerMemoryTransferService();
+    serverDesc.batchReturnCommands = BatchesReturnCommands();
+    serverDesc.partitionCommandsByDevice = PartitionsCommandsByDevice();
+    serverDesc.getDeviceStatistics = GetServerDeviceStatisticsProc();
 
     mWireServer.reset(new WireServer(serverDesc));
     mC2sBuf->SetHandler(mWireServer.get());
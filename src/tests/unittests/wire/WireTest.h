@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dawn/mock_webgpu.h"
+#include "dawn_wire/Wire.h"
 #include "gtest/gtest.h"
 
 #include <memory>
@@ -142,6 +143,10 @@ class WireTest : public testing::Test {
 
     virtual dawn_wire::client::MemoryTransferService* GetClientMemoryTransferService();
     virtual dawn_wire::server::MemoryTransferService* GetServerMemoryTransferService();
+    virtual bool BatchesReturnCommands();
+    virtual bool PartitionsCommandsByDevice();
+    using GetDeviceStatisticsProc = dawn_wire::DeviceStatisticsCounters (*)(WGPUDevice device);
+    virtual GetDeviceStatisticsProc GetServerDeviceStatisticsProc();
 
     std::unique_ptr<dawn_wire::WireServer> mWireServer;
     std::unique_ptr<dawn_wire::WireClient> mWireClient;